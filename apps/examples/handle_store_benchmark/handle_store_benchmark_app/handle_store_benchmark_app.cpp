@@ -0,0 +1,338 @@
+#include "handle_store_benchmark_app.h"
+#include "le_log.h"
+#include "le_renderer.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Benchmarks producing texture handles, and image and buffer resource handles
+ * (via LE_IMG_RESOURCE, and LE_BUF_RESOURCE) by name, with 1 and with 8 threads
+ * producing handles at the same time.
+ *
+ * We compare le_renderer's lock-free handle stores with mutex-guarded stores,
+ * which work just like le_renderer's handle stores used to work: a multimap
+ * from name to handle, guarded by a single mutex.
+ *
+ * Each thread produces handles for names picked at random from either a small
+ * set of names ("hot" - typical for handles which get produced every frame), or
+ * a large set of names ("cold"). These names are produced once upfront, so that
+ * we measure lookups, not insertions.
+ *
+ * For resource handles, we also measure creating handles for names which have
+ * never been produced before ("new"): each round has its own set of new names,
+ * which every thread visits once, in its own order - so that threads race to
+ * insert new handles, and then find handles which other threads just inserted.
+ *
+ * Times are wall-clock time divided by the number of handles produced by all
+ * threads: on a machine with at least 8 cores, a store which scales perfectly
+ * produces handles 8x faster with 8 threads than with 1 thread.
+ *
+ */
+
+static constexpr uint32_t NUM_HOT_NAMES      = 16;
+static constexpr uint32_t NUM_COLD_NAMES     = 1 << 14;
+static constexpr uint32_t NUM_NEW_NAMES      = 1 << 12; // per round and thread count - must be a power of two
+static constexpr uint32_t OPS_PER_THREAD     = 1 << 20;
+static constexpr uint32_t NUM_ROUNDS         = 3;
+static constexpr uint32_t THREAD_COUNTS[ 2 ] = { 1, 8 };
+
+// ----------------------------------------------------------------------
+// Mutex-guarded handle store, for comparison.
+struct mutex_texture_handle_t {
+	std::string debug_name;
+};
+
+struct mutex_texture_handle_store_t {
+	std::unordered_multimap<std::string, mutex_texture_handle_t> texture_handles;
+	std::mutex                                                   mtx;
+};
+
+static mutex_texture_handle_t *mutex_store_produce_handle( mutex_texture_handle_store_t *store, char const *name ) {
+	std::scoped_lock lock( store->mtx );
+
+	auto it = store->texture_handles.find( name );
+
+	if ( it == store->texture_handles.end() ) {
+		return &store->texture_handles.emplace( name, mutex_texture_handle_t{ name } )->second;
+	}
+
+	return &it->second;
+}
+
+// ----------------------------------------------------------------------
+// Mutex-guarded resource handle store, for comparison - keyed by name and type.
+struct mutex_resource_handle_t {
+	std::string debug_name;
+	bool        is_image; // image if true, buffer otherwise
+
+	bool operator==( mutex_resource_handle_t const &rhs ) const {
+		return is_image == rhs.is_image && debug_name == rhs.debug_name;
+	}
+};
+
+struct mutex_resource_handle_hash_t {
+	size_t operator()( mutex_resource_handle_t const &key ) const {
+		return std::hash<std::string>()( key.debug_name ) ^ size_t( key.is_image );
+	}
+};
+
+struct mutex_resource_handle_store_t {
+	std::unordered_multimap<mutex_resource_handle_t, mutex_resource_handle_t, mutex_resource_handle_hash_t> resource_handles;
+	std::mutex                                                                                               mtx;
+};
+
+static mutex_resource_handle_t *mutex_store_produce_resource_handle( mutex_resource_handle_store_t *store, char const *name, bool is_image ) {
+	std::scoped_lock lock( store->mtx );
+
+	mutex_resource_handle_t key{ name, is_image };
+
+	auto it = store->resource_handles.find( key );
+
+	if ( it == store->resource_handles.end() ) {
+		return &store->resource_handles.emplace( key, key )->second;
+	}
+
+	return &it->second;
+}
+
+// ----------------------------------------------------------------------
+
+struct handle_store_benchmark_app_o {
+	uint32_t                      round = 0;
+	le_log_channel_o *            logger;
+	std::vector<std::string>      names; // first NUM_HOT_NAMES names are hot names
+	mutex_texture_handle_store_t  mutex_store;
+	mutex_resource_handle_store_t mutex_resource_store;
+};
+
+typedef handle_store_benchmark_app_o app_o;
+
+// ----------------------------------------------------------------------
+
+static void app_initialize() {
+	// nothing to do: we don't use the job system, but our own threads.
+};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate() {
+};
+
+// ----------------------------------------------------------------------
+// Runs `num_threads` threads, each of which produces `ops_per_thread` handles,
+// by calling `produce( thread_idx, op_idx, random )` for each handle.
+// Returns average time per produced handle in nanoseconds.
+template <typename ProduceFun>
+static double run_threads( uint32_t num_threads, uint32_t ops_per_thread, ProduceFun const &produce ) {
+
+	std::atomic<bool>     go{ false };
+	std::atomic<uint32_t> ready{ 0 };
+	std::atomic<uint64_t> checksum{ 0 }; // so that the compiler can't discard produced handles
+
+	std::vector<std::thread> threads;
+	threads.reserve( num_threads );
+
+	for ( uint32_t t = 0; t != num_threads; t++ ) {
+		threads.emplace_back( [ &, t ]() {
+			uint32_t  seed = 0x9e3779b9 * ( t + 1 );
+			uintptr_t sum  = 0;
+
+			ready++;
+
+			while ( !go.load( std::memory_order_acquire ) ) {
+			}
+
+			for ( uint32_t i = 0; i != ops_per_thread; i++ ) {
+				seed ^= seed << 13;
+				seed ^= seed >> 17;
+				seed ^= seed << 5;
+				sum += reinterpret_cast<uintptr_t>( produce( t, i, seed ) );
+			}
+
+			checksum += sum;
+		} );
+	}
+
+	while ( ready.load() != num_threads ) {
+	}
+
+	auto t_start = std::chrono::high_resolution_clock::now();
+
+	go.store( true, std::memory_order_release );
+
+	for ( auto &t : threads ) {
+		t.join();
+	}
+
+	auto t_end = std::chrono::high_resolution_clock::now();
+
+	return std::chrono::duration<double, std::nano>( t_end - t_start ).count() / ( double( ops_per_thread ) * num_threads );
+}
+
+// ----------------------------------------------------------------------
+
+static handle_store_benchmark_app_o *handle_store_benchmark_app_create() {
+	auto app = new ( handle_store_benchmark_app_o );
+
+	app->logger = le_log_api_i->get_channel( "handle_store_benchmark" );
+
+	app->names.reserve( NUM_COLD_NAMES );
+
+	for ( uint32_t i = 0; i != NUM_COLD_NAMES; i++ ) {
+		app->names.emplace_back( "benchmark_texture_" + std::to_string( i ) );
+	}
+
+	// Produce all handles once, so that we measure lookups only.
+
+	for ( auto const &name : app->names ) {
+		le::Renderer::produceTextureHandle( name.c_str() );
+		mutex_store_produce_handle( &app->mutex_store, name.c_str() );
+		LE_IMG_RESOURCE( name.c_str() );
+		LE_BUF_RESOURCE( name.c_str() );
+		mutex_store_produce_resource_handle( &app->mutex_resource_store, name.c_str(), true );
+		mutex_store_produce_resource_handle( &app->mutex_resource_store, name.c_str(), false );
+	}
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+
+static bool handle_store_benchmark_app_update( handle_store_benchmark_app_o *self ) {
+
+	auto logger = LeLog( self->logger );
+
+	// -- Texture handles
+
+	for ( uint32_t num_threads : THREAD_COUNTS ) {
+		for ( uint32_t num_names : { NUM_HOT_NAMES, NUM_COLD_NAMES } ) {
+
+			auto produce_lock_free = [ self, num_names ]( uint32_t, uint32_t, uint32_t random ) -> void const * {
+				return le::Renderer::produceTextureHandle( self->names[ random % num_names ].c_str() );
+			};
+
+			auto produce_mutex = [ self, num_names ]( uint32_t, uint32_t, uint32_t random ) -> void const * {
+				return mutex_store_produce_handle( &self->mutex_store, self->names[ random % num_names ].c_str() );
+			};
+
+			double ns_mutex     = run_threads( num_threads, OPS_PER_THREAD, produce_mutex );
+			double ns_lock_free = run_threads( num_threads, OPS_PER_THREAD, produce_lock_free );
+
+			logger.info( "round %d: %d thread(s), %5d names (%s), texture handles : mutex %7.2fns/handle, lock-free %7.2fns/handle (%.1fx)",
+			             self->round,
+			             num_threads,
+			             num_names,
+			             num_names == NUM_HOT_NAMES ? "hot " : "cold",
+			             ns_mutex,
+			             ns_lock_free,
+			             ns_mutex / ns_lock_free );
+		}
+	}
+
+	// -- Image and buffer resource handles, for names which exist already.
+	// We alternate between image and buffer handles at random.
+
+	for ( uint32_t num_threads : THREAD_COUNTS ) {
+		for ( uint32_t num_names : { NUM_HOT_NAMES, NUM_COLD_NAMES } ) {
+
+			auto produce_lock_free = [ self, num_names ]( uint32_t, uint32_t, uint32_t random ) -> void const * {
+				char const *name = self->names[ random % num_names ].c_str();
+				if ( random & 0x80000000 ) {
+					return LE_IMG_RESOURCE( name );
+				}
+				return LE_BUF_RESOURCE( name );
+			};
+
+			auto produce_mutex = [ self, num_names ]( uint32_t, uint32_t, uint32_t random ) -> void const * {
+				return mutex_store_produce_resource_handle( &self->mutex_resource_store, self->names[ random % num_names ].c_str(), 0 != ( random & 0x80000000 ) );
+			};
+
+			double ns_mutex     = run_threads( num_threads, OPS_PER_THREAD, produce_mutex );
+			double ns_lock_free = run_threads( num_threads, OPS_PER_THREAD, produce_lock_free );
+
+			logger.info( "round %d: %d thread(s), %5d names (%s), resource handles: mutex %7.2fns/handle, lock-free %7.2fns/handle (%.1fx)",
+			             self->round,
+			             num_threads,
+			             num_names,
+			             num_names == NUM_HOT_NAMES ? "hot " : "cold",
+			             ns_mutex,
+			             ns_lock_free,
+			             ns_mutex / ns_lock_free );
+		}
+	}
+
+	// -- Image and buffer resource handles, for names which have never been produced before.
+	// Names with even indices are images, names with odd indices are buffers. Each thread
+	// visits every new name exactly once, in an order which is different for each thread.
+
+	std::vector<std::string> new_names( NUM_NEW_NAMES );
+
+	for ( uint32_t num_threads : THREAD_COUNTS ) {
+
+		// Names are unique per round and thread count, so that they are new to both stores.
+		for ( uint32_t i = 0; i != NUM_NEW_NAMES; i++ ) {
+			new_names[ i ] = "benchmark_resource_" + std::to_string( self->round ) + "_" + std::to_string( num_threads ) + "_" + std::to_string( i );
+		}
+
+		// Multiplying by an odd number is a permutation modulo a power of two: each thread
+		// visits all new names, starting at a different offset.
+		auto new_name_index = [ num_threads ]( uint32_t thread_idx, uint32_t op_idx ) -> uint32_t {
+			return ( op_idx * 0x9e3779b1u + thread_idx * ( NUM_NEW_NAMES / num_threads ) ) & ( NUM_NEW_NAMES - 1 );
+		};
+
+		auto produce_lock_free = [ & ]( uint32_t thread_idx, uint32_t op_idx, uint32_t ) -> void const * {
+			uint32_t const idx = new_name_index( thread_idx, op_idx );
+			if ( idx & 1 ) {
+				return LE_BUF_RESOURCE( new_names[ idx ].c_str() );
+			}
+			return LE_IMG_RESOURCE( new_names[ idx ].c_str() );
+		};
+
+		auto produce_mutex = [ & ]( uint32_t thread_idx, uint32_t op_idx, uint32_t ) -> void const * {
+			uint32_t const idx = new_name_index( thread_idx, op_idx );
+			return mutex_store_produce_resource_handle( &self->mutex_resource_store, new_names[ idx ].c_str(), 0 == ( idx & 1 ) );
+		};
+
+		double ns_mutex     = run_threads( num_threads, NUM_NEW_NAMES, produce_mutex );
+		double ns_lock_free = run_threads( num_threads, NUM_NEW_NAMES, produce_lock_free );
+
+		logger.info( "round %d: %d thread(s), %5d names (new ), resource handles: mutex %7.2fns/handle, lock-free %7.2fns/handle (%.1fx)",
+		             self->round,
+		             num_threads,
+		             NUM_NEW_NAMES,
+		             ns_mutex,
+		             ns_lock_free,
+		             ns_mutex / ns_lock_free );
+	}
+
+	self->round++;
+
+	return self->round < NUM_ROUNDS; // keep app alive until all rounds are done
+}
+
+// ----------------------------------------------------------------------
+
+static void handle_store_benchmark_app_destroy( handle_store_benchmark_app_o *self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( handle_store_benchmark_app, api ) {
+
+	auto  handle_store_benchmark_app_api_i = static_cast<handle_store_benchmark_app_api *>( api );
+	auto &handle_store_benchmark_app_i     = handle_store_benchmark_app_api_i->handle_store_benchmark_app_i;
+
+	handle_store_benchmark_app_i.initialize = app_initialize;
+	handle_store_benchmark_app_i.terminate  = app_terminate;
+
+	handle_store_benchmark_app_i.create  = handle_store_benchmark_app_create;
+	handle_store_benchmark_app_i.destroy = handle_store_benchmark_app_destroy;
+	handle_store_benchmark_app_i.update  = handle_store_benchmark_app_update;
+}
@@ -0,0 +1,65 @@
+#ifndef GUARD_handle_store_benchmark_app_H
+#define GUARD_handle_store_benchmark_app_H
+
+#include "le_core.h"
+
+// Headless benchmark for le_renderer handle stores: compares producing texture handles, and
+// image and buffer resource handles from many threads at once with the lock-free stores, and
+// with mutex-guarded stores.
+
+struct handle_store_benchmark_app_o;
+
+// clang-format off
+struct handle_store_benchmark_app_api {
+
+	struct handle_store_benchmark_app_interface_t {
+		handle_store_benchmark_app_o * ( *create     )();
+		void                           ( *destroy    )( handle_store_benchmark_app_o *self );
+		bool                           ( *update     )( handle_store_benchmark_app_o *self );
+		void                           ( *initialize )(); // static methods
+		void                           ( *terminate  )(); // static methods
+	};
+
+	handle_store_benchmark_app_interface_t handle_store_benchmark_app_i;
+};
+// clang-format on
+
+LE_MODULE( handle_store_benchmark_app );
+LE_MODULE_LOAD_DEFAULT( handle_store_benchmark_app );
+
+#ifdef __cplusplus
+
+namespace handle_store_benchmark_app {
+static const auto &api                          = handle_store_benchmark_app_api_i;
+static const auto &handle_store_benchmark_app_i = api -> handle_store_benchmark_app_i;
+} // namespace handle_store_benchmark_app
+
+class HandleStoreBenchmarkApp : NoCopy, NoMove {
+
+	handle_store_benchmark_app_o *self;
+
+  public:
+	HandleStoreBenchmarkApp()
+	    : self( handle_store_benchmark_app::handle_store_benchmark_app_i.create() ) {
+	}
+
+	bool update() {
+		return handle_store_benchmark_app::handle_store_benchmark_app_i.update( self );
+	}
+
+	~HandleStoreBenchmarkApp() {
+		handle_store_benchmark_app::handle_store_benchmark_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		handle_store_benchmark_app::handle_store_benchmark_app_i.initialize();
+	}
+
+	static void terminate() {
+		handle_store_benchmark_app::handle_store_benchmark_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+#include "handle_store_benchmark_app/handle_store_benchmark_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const *argv[] ) {
+
+	HandleStoreBenchmarkApp::initialize();
+
+	{
+		// We instantiate HandleStoreBenchmarkApp in its own scope - so that
+		// it will be destroyed before HandleStoreBenchmarkApp::terminate
+		// is called.
+
+		HandleStoreBenchmarkApp HandleStoreBenchmarkApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = HandleStoreBenchmarkApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last HandleStoreBenchmarkApp is destroyed
+	HandleStoreBenchmarkApp::terminate();
+
+	return 0;
+}
@@ -0,0 +1,33 @@
+#include "mesh_benchmark_app/mesh_benchmark_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const *argv[] ) {
+
+	MeshBenchmarkApp::initialize();
+
+	{
+		// We instantiate MeshBenchmarkApp in its own scope - so that
+		// it will be destroyed before MeshBenchmarkApp::terminate
+		// is called.
+
+		MeshBenchmarkApp MeshBenchmarkApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = MeshBenchmarkApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last MeshBenchmarkApp is destroyed
+	MeshBenchmarkApp::terminate();
+
+	return 0;
+}
@@ -0,0 +1,474 @@
+#include "mesh_benchmark_app.h"
+#include "le_log.h"
+#include "le_mesh.h"
+#include "le_mesh_generator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/*
+ * Benchmarks le_mesh with two meshes:
+ *
+ * - a sphere, as generated by le_mesh_generator, with vertices and triangles
+ *   in generator order - rows of quads around the sphere.
+ * - a plane, with vertices and triangles shuffled - this is the worst case for
+ *   vertex caches, and not unlike meshes exported by tools which don't care
+ *   about vertex order.
+ *
+ * For each mesh, we log post-transform vertex cache efficiency (ACMR, ATVR),
+ * and vertex fetch efficiency, before and after calling `optimise`, and how
+ * long `optimise` takes.
+ *
+ * We then split each optimised mesh into meshlets, and log how full meshlets
+ * are, and which fraction of triangles survives meshlet culling, seen from
+ * cameras placed around the mesh - half of them above, half below the mesh.
+ *
+ * Finally, we build a level-of-detail chain for each mesh, and check the error
+ * which each level reports against the distance by which the level actually
+ * strays from the surface that the mesh approximates: for the sphere, that's
+ * the distance from the unit sphere, which includes the error of the original
+ * tessellation; for the plane, it's the distance from y = 0.
+ *
+ */
+
+static constexpr uint32_t    VERTEX_CACHE_SIZE = 16;
+static constexpr uint32_t    GRID_SEGMENTS     = 400; // plane has GRID_SEGMENTS^2 quads
+static constexpr char const *SHUFFLED_PLY_PATH = "./mesh_benchmark_shuffled.ply";
+static constexpr uint32_t    NUM_CAMERAS       = 64;      // camera positions used for meshlet culling
+static constexpr float       CAMERA_DISTANCE   = 1.2f;    // close enough for the sphere to overlap the frustum
+static constexpr float       CAMERA_HALF_FOV   = 0.5236f; // 30 degrees
+static constexpr uint32_t    LOD_MAX_LEVELS    = 8;
+static constexpr uint32_t    LOD_SAMPLES       = 4;      // samples per triangle edge when measuring how far a level strays from its surface
+static constexpr float       PROJECTION_SCALE  = 935.3f; // pixels per unit at distance 1: 1080 / ( 2 * tan( 30 degrees ) )
+
+struct mesh_benchmark_app_o {
+	le_log_channel_o *logger;
+};
+
+typedef mesh_benchmark_app_o app_o;
+
+// ----------------------------------------------------------------------
+
+static void app_initialize() {
+};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate() {
+};
+
+// ----------------------------------------------------------------------
+
+static double ms_since( std::chrono::high_resolution_clock::time_point t_start ) {
+	return std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - t_start ).count();
+}
+
+// ----------------------------------------------------------------------
+// Writes positions and normals of `mesh` into a binary ply file, with vertices,
+// and triangles in random order.
+static bool write_shuffled_ply( le_mesh_o *mesh, char const *path ) {
+	using namespace le_mesh;
+
+	size_t          num_vertices = 0;
+	size_t          num_normals  = 0;
+	size_t          num_indices  = 0;
+	float const *   vertices     = nullptr;
+	float const *   normals      = nullptr;
+	uint32_t const *indices      = nullptr;
+
+	le_mesh_i.get_vertices( mesh, num_vertices, &vertices );
+	le_mesh_i.get_normals( mesh, num_normals, &normals );
+	le_mesh_i.get_indices_u32( mesh, num_indices, &indices );
+
+	bool const has_normals = ( num_normals == num_vertices );
+
+	uint32_t seed = 0x9e3779b9;
+
+	auto shuffle = [ &seed ]( std::vector<uint32_t> &order ) {
+		for ( size_t i = order.size(); i > 1; i-- ) {
+			seed ^= seed << 13;
+			seed ^= seed >> 17;
+			seed ^= seed << 5;
+			std::swap( order[ i - 1 ], order[ seed % i ] );
+		}
+	};
+
+	std::vector<uint32_t> vertex_order( num_vertices ); // new vertex index -> old vertex index
+	std::vector<uint32_t> vertex_remap( num_vertices ); // old vertex index -> new vertex index
+	std::vector<uint32_t> triangle_order( num_indices / 3 );
+
+	for ( uint32_t i = 0; i != vertex_order.size(); i++ ) {
+		vertex_order[ i ] = i;
+	}
+
+	for ( uint32_t i = 0; i != triangle_order.size(); i++ ) {
+		triangle_order[ i ] = i;
+	}
+
+	shuffle( vertex_order );
+	shuffle( triangle_order );
+
+	for ( uint32_t i = 0; i != vertex_order.size(); i++ ) {
+		vertex_remap[ vertex_order[ i ] ] = i;
+	}
+
+	FILE *file = fopen( path, "wb" );
+
+	if ( nullptr == file ) {
+		return false;
+	}
+
+	fprintf( file, "ply\nformat binary_little_endian 1.0\n" );
+	fprintf( file, "element vertex %zu\nproperty float x\nproperty float y\nproperty float z\n", num_vertices );
+
+	if ( has_normals ) {
+		fprintf( file, "property float nx\nproperty float ny\nproperty float nz\n" );
+	}
+
+	fprintf( file, "element face %zu\nproperty list uchar uint vertex_indices\nend_header\n", triangle_order.size() );
+
+	for ( uint32_t v : vertex_order ) {
+		fwrite( vertices + 3 * v, sizeof( float ), 3, file );
+		if ( has_normals ) {
+			fwrite( normals + 3 * v, sizeof( float ), 3, file );
+		}
+	}
+
+	for ( uint32_t t : triangle_order ) {
+		uint8_t  count         = 3;
+		uint32_t triangle[ 3 ] = { vertex_remap[ indices[ 3 * t + 0 ] ],
+		                           vertex_remap[ indices[ 3 * t + 1 ] ],
+		                           vertex_remap[ indices[ 3 * t + 2 ] ] };
+		fwrite( &count, sizeof( count ), 1, file );
+		fwrite( triangle, sizeof( uint32_t ), 3, file );
+	}
+
+	return 0 == fclose( file );
+}
+
+// ----------------------------------------------------------------------
+
+static void log_statistics( le_log_channel_o *channel, char const *label, le_mesh_o *mesh ) {
+	using namespace le_mesh;
+
+	auto logger = LeLog( channel );
+
+	le_mesh_api::interleaved_vertex_layout_t layout{};
+	size_t                                   num_vertices = 0;
+	size_t                                   num_indices  = 0;
+	le_mesh_i.get_interleaved_vertices( mesh, false, &layout, num_vertices, nullptr );
+	le_mesh_i.get_indices_u32( mesh, num_indices, nullptr );
+
+	le_mesh_api::mesh_statistics_t positions{};
+	le_mesh_api::mesh_statistics_t interleaved{};
+	le_mesh_i.get_statistics( mesh, VERTEX_CACHE_SIZE, 0, &positions );
+	le_mesh_i.get_statistics( mesh, VERTEX_CACHE_SIZE, layout.stride, &interleaved );
+
+	logger.info( "%-28s %7zu triangles, %7zu vertices: ACMR %.3f, ATVR %.3f, fetch ratio %.2f (positions), %.2f (interleaved, %d bytes)",
+	             label, num_indices / 3, num_vertices,
+	             positions.acmr, positions.atvr, positions.fetch_ratio,
+	             interleaved.fetch_ratio, layout.stride );
+}
+
+// ----------------------------------------------------------------------
+
+static void benchmark_optimise( app_o *self, char const *name, le_mesh_o *mesh ) {
+	using namespace le_mesh;
+
+	auto logger = LeLog( self->logger );
+
+	char label[ 64 ];
+
+	snprintf( label, sizeof( label ), "%s (before)", name );
+	log_statistics( self->logger, label, mesh );
+
+	auto t_start = std::chrono::high_resolution_clock::now();
+	le_mesh_i.optimise( mesh, VERTEX_CACHE_SIZE );
+	double ms_optimise = ms_since( t_start );
+
+	snprintf( label, sizeof( label ), "%s (optimised)", name );
+	log_statistics( self->logger, label, mesh );
+
+	logger.info( "%-28s optimise took %.2fms", name, ms_optimise );
+}
+
+// ----------------------------------------------------------------------
+// Sets up cull params for a camera at `camera`, looking at the origin, with a
+// square viewport. Frustum planes face inwards.
+static void set_camera( le_mesh_api::meshlet_cull_params_t &params, float const camera[ 3 ] ) {
+
+	auto normalize = []( float v[ 3 ] ) {
+		float len = sqrtf( v[ 0 ] * v[ 0 ] + v[ 1 ] * v[ 1 ] + v[ 2 ] * v[ 2 ] );
+		v[ 0 ] /= len;
+		v[ 1 ] /= len;
+		v[ 2 ] /= len;
+	};
+
+	auto set_plane = [ &params, camera ]( size_t p, float const n[ 3 ], float offset ) {
+		params.planes[ p ][ 0 ] = n[ 0 ];
+		params.planes[ p ][ 1 ] = n[ 1 ];
+		params.planes[ p ][ 2 ] = n[ 2 ];
+		params.planes[ p ][ 3 ] = -( n[ 0 ] * camera[ 0 ] + n[ 1 ] * camera[ 1 ] + n[ 2 ] * camera[ 2 ] ) - offset;
+	};
+
+	float forward[ 3 ] = { -camera[ 0 ], -camera[ 1 ], -camera[ 2 ] };
+	normalize( forward );
+
+	// right = forward x up, with up = y; up = right x forward
+	float right[ 3 ] = { -forward[ 2 ], 0, forward[ 0 ] };
+	normalize( right );
+
+	float up[ 3 ] = { right[ 1 ] * forward[ 2 ] - right[ 2 ] * forward[ 1 ],
+	                  right[ 2 ] * forward[ 0 ] - right[ 0 ] * forward[ 2 ],
+	                  right[ 0 ] * forward[ 1 ] - right[ 1 ] * forward[ 0 ] };
+
+	float const c = cosf( CAMERA_HALF_FOV );
+	float const s = sinf( CAMERA_HALF_FOV );
+
+	float n[ 3 ];
+
+	for ( int side = 0; side != 4; side++ ) {
+		float const *axis = side < 2 ? right : up;
+		float        sign = side % 2 ? -1.f : 1.f;
+		for ( int i = 0; i != 3; i++ ) {
+			n[ i ] = sign * c * axis[ i ] + s * forward[ i ];
+		}
+		set_plane( side, n, 0.f );
+	}
+
+	set_plane( 4, forward, 0.01f ); // near
+	for ( int i = 0; i != 3; i++ ) {
+		n[ i ] = -forward[ i ];
+	}
+	set_plane( 5, n, -100.f ); // far
+
+	params.camera_position[ 0 ] = camera[ 0 ];
+	params.camera_position[ 1 ] = camera[ 1 ];
+	params.camera_position[ 2 ] = camera[ 2 ];
+	params.radius_scale         = 1.f;
+}
+
+// ----------------------------------------------------------------------
+
+static void benchmark_meshlets( app_o *self, char const *name, le_mesh_o *mesh ) {
+	using namespace le_mesh;
+
+	auto logger = LeLog( self->logger );
+
+	LeMeshlets meshlets;
+
+	auto t_start = std::chrono::high_resolution_clock::now();
+	le_mesh_i.build_meshlets( mesh, meshlets, le_mesh_api::MESHLET_MAX_VERTICES, le_mesh_api::MESHLET_MAX_TRIANGLES );
+	double ms_build = ms_since( t_start );
+
+	size_t                        num_meshlets  = 0;
+	le_mesh_api::meshlet_t const *meshlet_data  = nullptr;
+	size_t                        num_triangles = 0;
+	size_t                        num_vertices  = 0;
+	meshlets.getMeshlets( num_meshlets, &meshlet_data );
+	meshlets.getTriangles( num_triangles );
+	meshlets.getVertexIndices( num_vertices );
+
+	logger.info( "%-28s %7zu meshlets, %.1f vertices (%.0f%%), %.1f triangles (%.0f%%) per meshlet, build took %.2fms",
+	             name, num_meshlets,
+	             double( num_vertices ) / num_meshlets, 100. * num_vertices / ( num_meshlets * le_mesh_api::MESHLET_MAX_VERTICES ),
+	             double( num_triangles ) / num_meshlets, 100. * num_triangles / ( num_meshlets * le_mesh_api::MESHLET_MAX_TRIANGLES ),
+	             ms_build );
+
+	std::vector<uint32_t> visible( num_meshlets );
+
+	for ( bool cull_backfacing : { false, true } ) {
+
+		le_mesh_api::meshlet_cull_params_t params{};
+		params.cull_backfacing = cull_backfacing;
+
+		size_t num_visible_triangles = 0;
+		double ms_cull               = 0;
+
+		for ( uint32_t i = 0; i != NUM_CAMERAS; i++ ) {
+			float const azimuth     = 2 * 3.14159265f * i / NUM_CAMERAS;
+			float const elevation   = i % 2 ? -0.7854f : 0.7854f; // alternate between 45 degrees above and below
+			float const camera[ 3 ] = { CAMERA_DISTANCE * cosf( elevation ) * cosf( azimuth ),
+			                            CAMERA_DISTANCE * sinf( elevation ),
+			                            CAMERA_DISTANCE * cosf( elevation ) * sinf( azimuth ) };
+			set_camera( params, camera );
+
+			t_start            = std::chrono::high_resolution_clock::now();
+			size_t num_visible = le_meshlets_i.cull( meshlet_data, num_meshlets, &params, visible.data() );
+			ms_cull += ms_since( t_start );
+
+			for ( size_t v = 0; v != num_visible; v++ ) {
+				num_visible_triangles += meshlet_data[ visible[ v ] ].triangle_count;
+			}
+		}
+
+		logger.info( "%-28s cull (%s): %5.1f%% of triangles visible, %.2fns per meshlet",
+		             name, cull_backfacing ? "frustum, back-facing" : "frustum             ",
+		             100. * num_visible_triangles / ( double( num_triangles ) * NUM_CAMERAS ),
+		             1e6 * ms_cull / ( double( num_meshlets ) * NUM_CAMERAS ) );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Returns the largest distance from the surface, sampled at points spread
+// evenly over each triangle.
+static float max_surface_distance( float const *vertices, uint32_t const *indices, size_t num_indices, float ( *surface_distance )( float const p[ 3 ] ) ) {
+
+	float max_distance = 0;
+
+	for ( size_t t = 0; t + 2 < num_indices; t += 3 ) {
+
+		float const *a = vertices + 3 * indices[ t + 0 ];
+		float const *b = vertices + 3 * indices[ t + 1 ];
+		float const *c = vertices + 3 * indices[ t + 2 ];
+
+		for ( uint32_t i = 0; i <= LOD_SAMPLES; i++ ) {
+			for ( uint32_t j = 0; i + j <= LOD_SAMPLES; j++ ) {
+				float const u      = float( i ) / LOD_SAMPLES;
+				float const v      = float( j ) / LOD_SAMPLES;
+				float const w      = 1.f - u - v;
+				float const p[ 3 ] = { u * a[ 0 ] + v * b[ 0 ] + w * c[ 0 ],
+				                       u * a[ 1 ] + v * b[ 1 ] + w * c[ 1 ],
+				                       u * a[ 2 ] + v * b[ 2 ] + w * c[ 2 ] };
+				max_distance       = std::max( max_distance, surface_distance( p ) );
+			}
+		}
+	}
+
+	return max_distance;
+}
+
+// ----------------------------------------------------------------------
+
+static float sphere_distance( float const p[ 3 ] ) {
+	return fabsf( sqrtf( p[ 0 ] * p[ 0 ] + p[ 1 ] * p[ 1 ] + p[ 2 ] * p[ 2 ] ) - 1.f );
+}
+
+// ----------------------------------------------------------------------
+
+static float plane_distance( float const p[ 3 ] ) {
+	return fabsf( p[ 1 ] );
+}
+
+// ----------------------------------------------------------------------
+
+static void benchmark_lod( app_o *self, char const *name, le_mesh_o *mesh, float ( *surface_distance )( float const p[ 3 ] ) ) {
+	using namespace le_mesh;
+
+	auto logger = LeLog( self->logger );
+
+	LeMeshLod lod;
+
+	auto t_start = std::chrono::high_resolution_clock::now();
+	le_mesh_i.build_lod_chain( mesh, lod, LOD_MAX_LEVELS, 0.5f );
+	double ms_build = ms_since( t_start );
+
+	size_t                          num_levels   = 0;
+	size_t                          num_indices  = 0;
+	size_t                          num_vertices = 0;
+	le_mesh_api::lod_level_t const *levels       = nullptr;
+	uint32_t const *                indices      = nullptr;
+	float const *                   vertices     = nullptr;
+
+	lod.getLevels( num_levels, &levels );
+	lod.getIndices( num_indices, &indices );
+	le_mesh_i.get_vertices( mesh, num_vertices, &vertices );
+
+	logger.info( "%-28s %zu levels, build took %.2fms", name, num_levels, ms_build );
+
+	// The original tessellation already strays from the surface; levels may only
+	// add their reported error to this.
+	float const base_distance = max_surface_distance( vertices, indices + levels[ 0 ].index_offset, levels[ 0 ].index_count, surface_distance );
+
+	for ( size_t i = 0; i != num_levels; i++ ) {
+		float const distance = max_surface_distance( vertices, indices + levels[ i ].index_offset, levels[ i ].index_count, surface_distance );
+		logger.info( "%-28s level %zu: %7d triangles, reported error %.5f, measured distance from surface %.5f (%s)",
+		             name, i, levels[ i ].index_count / 3, levels[ i ].error, distance,
+		             distance <= base_distance + levels[ i ].error + 1e-5f ? "within bound" : "EXCEEDS BOUND" );
+	}
+
+	// Which level would we draw, at 1080p, with a 60 degree vertical field of view?
+
+	for ( float distance : { 1.f, 4.f, 16.f, 64.f } ) {
+		le_mesh_api::lod_select_params_t params{};
+		params.distance         = distance;
+		params.object_scale     = 1.f;
+		params.projection_scale = PROJECTION_SCALE;
+		params.max_pixel_error  = 1.f;
+
+		uint32_t level = le_mesh_lod_i.select_level( levels, num_levels, &params );
+
+		logger.info( "%-28s at distance %4.0f, max 1px error: level %d (%d triangles)",
+		             name, distance, level, levels[ level ].index_count / 3 );
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static mesh_benchmark_app_o *mesh_benchmark_app_create() {
+	auto app = new ( mesh_benchmark_app_o );
+
+	app->logger = le_log_api_i->get_channel( "mesh_benchmark" );
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+
+static bool mesh_benchmark_app_update( mesh_benchmark_app_o *self ) {
+	using namespace le_mesh_generator;
+
+	auto logger = LeLog( self->logger );
+
+	LeMesh sphere;
+	LeMesh plane;
+
+	le_mesh_generator_i.generate_sphere( sphere, 1.f, 256, 128, 0.f, 2 * 3.14159265f, 0.f, 3.14159265f );
+
+	{
+		LeMesh ordered_plane;
+		le_mesh_generator_i.generate_plane( ordered_plane, 1.f, 1.f, GRID_SEGMENTS, GRID_SEGMENTS );
+
+		if ( !write_shuffled_ply( ordered_plane, SHUFFLED_PLY_PATH ) || !plane.loadFromPlyFile( SHUFFLED_PLY_PATH ) ) {
+			logger.error( "Could not write shuffled plane to '%s'", SHUFFLED_PLY_PATH );
+			return false;
+		}
+
+		remove( SHUFFLED_PLY_PATH );
+	}
+
+	benchmark_optimise( self, "sphere", sphere );
+	benchmark_optimise( self, "plane, shuffled", plane );
+
+	benchmark_meshlets( self, "sphere", sphere );
+	benchmark_meshlets( self, "plane, shuffled", plane );
+
+	benchmark_lod( self, "sphere", sphere, sphere_distance );
+	benchmark_lod( self, "plane, shuffled", plane, plane_distance );
+
+	return false; // we're done after one update
+}
+
+// ----------------------------------------------------------------------
+
+static void mesh_benchmark_app_destroy( mesh_benchmark_app_o *self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( mesh_benchmark_app, api ) {
+
+	auto  mesh_benchmark_app_api_i = static_cast<mesh_benchmark_app_api *>( api );
+	auto &mesh_benchmark_app_i     = mesh_benchmark_app_api_i->mesh_benchmark_app_i;
+
+	mesh_benchmark_app_i.initialize = app_initialize;
+	mesh_benchmark_app_i.terminate  = app_terminate;
+
+	mesh_benchmark_app_i.create  = mesh_benchmark_app_create;
+	mesh_benchmark_app_i.destroy = mesh_benchmark_app_destroy;
+	mesh_benchmark_app_i.update  = mesh_benchmark_app_update;
+}
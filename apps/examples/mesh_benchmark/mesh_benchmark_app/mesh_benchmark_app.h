@@ -0,0 +1,64 @@
+#ifndef GUARD_mesh_benchmark_app_H
+#define GUARD_mesh_benchmark_app_H
+
+#include "le_core.h"
+
+// Headless benchmark for le_mesh: measures vertex cache and vertex fetch
+// efficiency before and after mesh optimisation.
+
+struct mesh_benchmark_app_o;
+
+// clang-format off
+struct mesh_benchmark_app_api {
+
+	struct mesh_benchmark_app_interface_t {
+		mesh_benchmark_app_o * ( *create     )();
+		void                   ( *destroy    )( mesh_benchmark_app_o *self );
+		bool                   ( *update     )( mesh_benchmark_app_o *self );
+		void                   ( *initialize )(); // static methods
+		void                   ( *terminate  )(); // static methods
+	};
+
+	mesh_benchmark_app_interface_t mesh_benchmark_app_i;
+};
+// clang-format on
+
+LE_MODULE( mesh_benchmark_app );
+LE_MODULE_LOAD_DEFAULT( mesh_benchmark_app );
+
+#ifdef __cplusplus
+
+namespace mesh_benchmark_app {
+static const auto &api                  = mesh_benchmark_app_api_i;
+static const auto &mesh_benchmark_app_i = api -> mesh_benchmark_app_i;
+} // namespace mesh_benchmark_app
+
+class MeshBenchmarkApp : NoCopy, NoMove {
+
+	mesh_benchmark_app_o *self;
+
+  public:
+	MeshBenchmarkApp()
+	    : self( mesh_benchmark_app::mesh_benchmark_app_i.create() ) {
+	}
+
+	bool update() {
+		return mesh_benchmark_app::mesh_benchmark_app_i.update( self );
+	}
+
+	~MeshBenchmarkApp() {
+		mesh_benchmark_app::mesh_benchmark_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		mesh_benchmark_app::mesh_benchmark_app_i.initialize();
+	}
+
+	static void terminate() {
+		mesh_benchmark_app::mesh_benchmark_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif
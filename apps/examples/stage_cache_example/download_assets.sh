@@ -0,0 +1,6 @@
+#!/bin/bash
+
+mkdir -p resources/meshes
+pushd resources/meshes
+curl -L "https://raw.githubusercontent.com/KhronosGroup/glTF-Sample-Assets/main/Models/Fox/glTF-Binary/Fox.glb" -o Fox.glb
+popd
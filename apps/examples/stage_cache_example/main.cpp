@@ -0,0 +1,33 @@
+#include "stage_cache_example_app/stage_cache_example_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const *argv[] ) {
+
+	StageCacheExampleApp::initialize();
+
+	{
+		// We instantiate StageCacheExampleApp in its own scope - so that
+		// it will be destroyed before StageCacheExampleApp::terminate
+		// is called.
+
+		StageCacheExampleApp StageCacheExampleApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = StageCacheExampleApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last StageCacheExampleApp is destroyed
+	StageCacheExampleApp::terminate();
+
+	return 0;
+}
@@ -0,0 +1,237 @@
+#include "stage_cache_example_app.h"
+#include "le_log.h"
+#include "le_stage.h"
+#include "le_gltf.h"
+
+#ifndef LE_MT
+#	define LE_MT 0
+#endif
+
+#if ( LE_MT > 0 )
+#	include "le_jobs.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+/*
+ * Round-trips a stage through the binary stage cache, without rendering anything:
+ *
+ * 1. Import a glTF file into a stage, and save the stage to a cache.
+ * 2. Load the cache into a second stage, and save this stage to a second cache -
+ *    both caches must be identical, byte for byte.
+ * 3. Touch the glTF file - the cache must now be rejected as out of date.
+ * 4. Load a number of corrupted copies of the cache - each load may fail, but
+ *    must never crash.
+ *
+ * Run `download_assets.sh` first to fetch the glTF file.
+ *
+ */
+
+static constexpr char const *ASSET_PATH           = "./local_resources/meshes/Fox.glb";
+static constexpr char const *SOURCE_PATH          = "./stage_cache_example.glb"; // we touch this, so we work on a copy of the asset
+static constexpr char const *CACHE_PATH           = "./stage_cache_example.lestage";
+static constexpr char const *ROUND_TRIP_PATH      = "./stage_cache_example_round_trip.lestage";
+static constexpr char const *CORRUPT_CACHE_PATH   = "./stage_cache_example_corrupt.lestage";
+static constexpr uint32_t    NUM_CORRUPTED_CACHES = 64;
+
+struct stage_cache_example_app_o {
+	le_log_channel_o *logger;
+};
+
+typedef stage_cache_example_app_o app_o;
+
+// ----------------------------------------------------------------------
+
+static void app_initialize() {
+#if ( LE_MT > 0 )
+	le_jobs::initialize( LE_MT );
+#endif
+};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate() {
+#if ( LE_MT > 0 )
+	le_jobs::terminate();
+#endif
+};
+
+// ----------------------------------------------------------------------
+
+static std::vector<char> load_file( char const *path ) {
+	std::ifstream file( path, std::ios::binary );
+	return std::vector<char>( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+}
+
+// ----------------------------------------------------------------------
+
+static bool save_file( char const *path, std::vector<char> const &data ) {
+	std::ofstream file( path, std::ios::binary | std::ios::trunc );
+	file.write( data.data(), std::streamsize( data.size() ) );
+	return bool( file );
+}
+
+// ----------------------------------------------------------------------
+
+static double ms_since( std::chrono::high_resolution_clock::time_point t_start ) {
+	return std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - t_start ).count();
+}
+
+// ----------------------------------------------------------------------
+
+static stage_cache_example_app_o *stage_cache_example_app_create() {
+	auto app = new ( stage_cache_example_app_o );
+
+	app->logger = le_log_api_i->get_channel( "stage_cache_example" );
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+
+static bool stage_cache_example_app_update( stage_cache_example_app_o *self ) {
+
+	using namespace le_stage;
+
+	auto logger = LeLog( self->logger );
+
+	std::error_code ec;
+	std::filesystem::copy_file( ASSET_PATH, SOURCE_PATH, std::filesystem::copy_options::overwrite_existing, ec );
+
+	if ( ec ) {
+		logger.error( "Could not find '%s' - run download_assets.sh first.", ASSET_PATH );
+		return false;
+	}
+
+	// 1. Import, and save cache.
+
+	double ms_import = 0;
+
+	{
+		LeStage stage( nullptr ); // we don't render, which means we don't need a renderer.
+
+		auto t_start = std::chrono::high_resolution_clock::now();
+		{
+			LeGltf gltf( SOURCE_PATH );
+			gltf.import( stage );
+		}
+		ms_import = ms_since( t_start );
+
+		if ( !le_stage_i.save_cache( stage, CACHE_PATH, SOURCE_PATH ) ) {
+			logger.error( "FAILED: could not save stage cache." );
+			return false;
+		}
+	}
+
+	// 2. Load cache, save it again, and compare.
+
+	double ms_load = 0;
+
+	{
+		LeStage stage( nullptr );
+
+		auto t_start = std::chrono::high_resolution_clock::now();
+
+		if ( !le_stage_i.load_cache( stage, CACHE_PATH, SOURCE_PATH ) ) {
+			logger.error( "FAILED: could not load stage cache which we just saved." );
+			return false;
+		}
+
+		ms_load = ms_since( t_start );
+
+		if ( !le_stage_i.save_cache( stage, ROUND_TRIP_PATH, SOURCE_PATH ) ) {
+			logger.error( "FAILED: could not save stage loaded from cache." );
+			return false;
+		}
+	}
+
+	std::vector<char> const cache      = load_file( CACHE_PATH );
+	std::vector<char> const round_trip = load_file( ROUND_TRIP_PATH );
+
+	if ( cache != round_trip ) {
+		auto mismatch = std::mismatch( cache.begin(), cache.end(), round_trip.begin(), round_trip.end() );
+		logger.error( "FAILED: round trip changed the cache (%zu vs. %zu bytes, first difference at byte %zu).",
+		              cache.size(), round_trip.size(), size_t( mismatch.first - cache.begin() ) );
+		return false;
+	}
+
+	logger.info( "round trip ok: %zu bytes - import: %.2fms, load from cache: %.2fms", cache.size(), ms_import, ms_load );
+
+	// 3. Once the source changes, the cache must be out of date.
+
+	std::filesystem::last_write_time( SOURCE_PATH, std::filesystem::last_write_time( SOURCE_PATH ) + std::chrono::seconds( 1 ) );
+
+	{
+		LeStage stage( nullptr );
+
+		if ( le_stage_i.load_cache( stage, CACHE_PATH, SOURCE_PATH ) ) {
+			logger.error( "FAILED: cache was accepted, even though its source has changed." );
+			return false;
+		}
+	}
+
+	logger.info( "out of date cache was rejected" );
+
+	// 4. Corrupted caches must never crash. We don't pass a source path, so that
+	// loading does not stop at the fingerprint check.
+
+	uint32_t num_accepted = 0;
+	uint32_t seed         = 0x9e3779b9;
+
+	for ( uint32_t i = 0; i != NUM_CORRUPTED_CACHES; i++ ) {
+
+		std::vector<char> corrupt = cache;
+
+		// Flip a few bytes at random, and every other time truncate the cache, too.
+
+		for ( int j = 0; j != 4; j++ ) {
+			seed ^= seed << 13;
+			seed ^= seed >> 17;
+			seed ^= seed << 5;
+			corrupt[ seed % corrupt.size() ] ^= char( 1 + ( seed >> 24 ) % 255 );
+		}
+
+		if ( i % 2 ) {
+			corrupt.resize( seed % corrupt.size() );
+		}
+
+		save_file( CORRUPT_CACHE_PATH, corrupt );
+
+		LeStage stage( nullptr );
+		num_accepted += le_stage_i.load_cache( stage, CORRUPT_CACHE_PATH, nullptr );
+	}
+
+	logger.info( "loaded %d corrupted caches without crashing: %d accepted, %d rejected",
+	             NUM_CORRUPTED_CACHES, num_accepted, NUM_CORRUPTED_CACHES - num_accepted );
+
+	std::filesystem::remove( CORRUPT_CACHE_PATH, ec );
+	std::filesystem::remove( ROUND_TRIP_PATH, ec );
+
+	return false; // we're done after one update
+}
+
+// ----------------------------------------------------------------------
+
+static void stage_cache_example_app_destroy( stage_cache_example_app_o *self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( stage_cache_example_app, api ) {
+
+	auto  stage_cache_example_app_api_i = static_cast<stage_cache_example_app_api *>( api );
+	auto &stage_cache_example_app_i     = stage_cache_example_app_api_i->stage_cache_example_app_i;
+
+	stage_cache_example_app_i.initialize = app_initialize;
+	stage_cache_example_app_i.terminate  = app_terminate;
+
+	stage_cache_example_app_i.create  = stage_cache_example_app_create;
+	stage_cache_example_app_i.destroy = stage_cache_example_app_destroy;
+	stage_cache_example_app_i.update  = stage_cache_example_app_update;
+}
@@ -0,0 +1,64 @@
+#ifndef GUARD_stage_cache_example_app_H
+#define GUARD_stage_cache_example_app_H
+
+#include "le_core.h"
+
+// Headless example for the le_stage binary cache: imports a glTF file, saves the
+// stage to a cache, loads it back, and checks that the round trip is lossless.
+
+struct stage_cache_example_app_o;
+
+// clang-format off
+struct stage_cache_example_app_api {
+
+	struct stage_cache_example_app_interface_t {
+		stage_cache_example_app_o * ( *create     )();
+		void                        ( *destroy    )( stage_cache_example_app_o *self );
+		bool                        ( *update     )( stage_cache_example_app_o *self );
+		void                        ( *initialize )(); // static methods
+		void                        ( *terminate  )(); // static methods
+	};
+
+	stage_cache_example_app_interface_t stage_cache_example_app_i;
+};
+// clang-format on
+
+LE_MODULE( stage_cache_example_app );
+LE_MODULE_LOAD_DEFAULT( stage_cache_example_app );
+
+#ifdef __cplusplus
+
+namespace stage_cache_example_app {
+static const auto &api                       = stage_cache_example_app_api_i;
+static const auto &stage_cache_example_app_i = api -> stage_cache_example_app_i;
+} // namespace stage_cache_example_app
+
+class StageCacheExampleApp : NoCopy, NoMove {
+
+	stage_cache_example_app_o *self;
+
+  public:
+	StageCacheExampleApp()
+	    : self( stage_cache_example_app::stage_cache_example_app_i.create() ) {
+	}
+
+	bool update() {
+		return stage_cache_example_app::stage_cache_example_app_i.update( self );
+	}
+
+	~StageCacheExampleApp() {
+		stage_cache_example_app::stage_cache_example_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		stage_cache_example_app::stage_cache_example_app_i.initialize();
+	}
+
+	static void terminate() {
+		stage_cache_example_app::stage_cache_example_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif
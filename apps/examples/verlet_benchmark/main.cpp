@@ -0,0 +1,33 @@
+#include "verlet_benchmark_app/verlet_benchmark_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const *argv[] ) {
+
+	VerletBenchmarkApp::initialize();
+
+	{
+		// We instantiate VerletBenchmarkApp in its own scope - so that
+		// it will be destroyed before VerletBenchmarkApp::terminate
+		// is called.
+
+		VerletBenchmarkApp VerletBenchmarkApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = VerletBenchmarkApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last VerletBenchmarkApp is destroyed
+	VerletBenchmarkApp::terminate();
+
+	return 0;
+}
@@ -0,0 +1,181 @@
+#include "verlet_benchmark_app.h"
+#include "le_log.h"
+#include "le_verlet.h"
+
+#ifndef LE_MT
+#	define LE_MT 0
+#endif
+
+#if ( LE_MT > 0 )
+#	include "le_jobs.h"
+#endif
+
+#include "glm/glm.hpp"
+
+#include <chrono>
+#include <vector>
+
+/*
+ * Benchmarks le_verlet with a grid of 1000x1000 particles, connected by
+ * horizontal and vertical springs (~2M springs).
+ *
+ * Each round runs the same number of frames with the sequential, and with
+ * the parallel solver, and logs the average time per frame for each.
+ *
+ */
+
+static constexpr uint32_t GRID_SIZE        = 1000; // particles per row, and per column
+static constexpr uint32_t FRAMES_PER_ROUND = 10;
+static constexpr uint32_t NUM_ROUNDS       = 3;
+static constexpr size_t   NUM_STEPS        = 4; // constraint iterations per frame
+
+struct verlet_benchmark_app_o {
+	uint32_t          round = 0;
+	le_log_channel_o *logger;
+};
+
+typedef verlet_benchmark_app_o app_o;
+
+// ----------------------------------------------------------------------
+
+static void app_initialize() {
+#if ( LE_MT > 0 )
+	le_jobs::initialize( LE_MT );
+#endif
+};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate() {
+#if ( LE_MT > 0 )
+	le_jobs::terminate();
+#endif
+};
+
+// ----------------------------------------------------------------------
+// Creates a grid of particles, where each particle is connected to its
+// right, and its lower neighbour by a spring. Particles are jittered after
+// springs have been set up so that the solver has some work to do.
+static le_verlet_particle_system_o *create_grid( le_verlet_api::SolverMode mode ) {
+	using namespace le_verlet;
+
+	auto system = le_verlet_i.create();
+	le_verlet_i.set_solver_mode( system, mode );
+
+	std::vector<glm::vec2> particles;
+	particles.reserve( GRID_SIZE * GRID_SIZE );
+
+	for ( uint32_t y = 0; y != GRID_SIZE; y++ ) {
+		for ( uint32_t x = 0; x != GRID_SIZE; x++ ) {
+			particles.emplace_back( float( x ), float( y ) );
+		}
+	}
+
+	le_verlet_i.add_particles( system, particles.data(), particles.size() );
+
+	for ( uint32_t y = 0; y != GRID_SIZE; y++ ) {
+		for ( uint32_t x = 0; x != GRID_SIZE; x++ ) {
+			uint32_t i = y * GRID_SIZE + x;
+			if ( x + 1 != GRID_SIZE ) {
+				le_verlet_i.add_constraint( system, le_verlet_api::SpringConstraint( i, i + 1 ) );
+			}
+			if ( y + 1 != GRID_SIZE ) {
+				le_verlet_i.add_constraint( system, le_verlet_api::SpringConstraint( i, i + GRID_SIZE ) );
+			}
+		}
+	}
+
+	// Jitter particles using a simple deterministic hash, so that both
+	// solvers start from the same state.
+	uint32_t seed = 0x9e3779b9;
+	for ( size_t i = 0; i != particles.size(); i++ ) {
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		glm::vec2 offset{ float( seed & 0xffff ) / 65535.f - 0.5f, float( seed >> 16 ) / 65535.f - 0.5f };
+		le_verlet_i.set_particle( system, i, particles[ i ] + offset * 0.25f );
+	}
+
+	return system;
+}
+
+// ----------------------------------------------------------------------
+// Returns average time per frame in milliseconds.
+static double run_frames( le_verlet_particle_system_o *system ) {
+	using namespace le_verlet;
+
+	// The first update for the parallel solver includes building colour
+	// groups - we don't want to measure this, so we run one frame upfront.
+	le_verlet_i.update( system, NUM_STEPS );
+
+	auto t_start = std::chrono::high_resolution_clock::now();
+
+	for ( uint32_t i = 0; i != FRAMES_PER_ROUND; i++ ) {
+		le_verlet_i.update( system, NUM_STEPS );
+	}
+
+	auto t_end = std::chrono::high_resolution_clock::now();
+
+	return std::chrono::duration<double, std::milli>( t_end - t_start ).count() / FRAMES_PER_ROUND;
+}
+
+// ----------------------------------------------------------------------
+
+static verlet_benchmark_app_o *verlet_benchmark_app_create() {
+	auto app = new ( verlet_benchmark_app_o );
+
+	app->logger = le_log_api_i->get_channel( "verlet_benchmark" );
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+
+static bool verlet_benchmark_app_update( verlet_benchmark_app_o *self ) {
+
+	auto logger = LeLog( self->logger );
+
+	double ms_per_frame[ 2 ];
+
+	le_verlet_api::SolverMode const modes[ 2 ] = { le_verlet_api::eSolverSequential, le_verlet_api::eSolverParallel };
+
+	for ( int i = 0; i != 2; i++ ) {
+		auto system       = create_grid( modes[ i ] );
+		ms_per_frame[ i ] = run_frames( system );
+		le_verlet::le_verlet_i.destroy( system );
+	}
+
+	logger.info( "round %d: %d particles, %d springs, %d steps: sequential %.2fms/frame, parallel %.2fms/frame (LE_MT=%d)",
+	             self->round,
+	             GRID_SIZE * GRID_SIZE,
+	             2 * GRID_SIZE * ( GRID_SIZE - 1 ),
+	             int( NUM_STEPS ),
+	             ms_per_frame[ 0 ],
+	             ms_per_frame[ 1 ],
+	             LE_MT );
+
+	self->round++;
+
+	return self->round < NUM_ROUNDS; // keep app alive until all rounds are done
+}
+
+// ----------------------------------------------------------------------
+
+static void verlet_benchmark_app_destroy( verlet_benchmark_app_o *self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( verlet_benchmark_app, api ) {
+
+	auto  verlet_benchmark_app_api_i = static_cast<verlet_benchmark_app_api *>( api );
+	auto &verlet_benchmark_app_i     = verlet_benchmark_app_api_i->verlet_benchmark_app_i;
+
+	verlet_benchmark_app_i.initialize = app_initialize;
+	verlet_benchmark_app_i.terminate  = app_terminate;
+
+	verlet_benchmark_app_i.create  = verlet_benchmark_app_create;
+	verlet_benchmark_app_i.destroy = verlet_benchmark_app_destroy;
+	verlet_benchmark_app_i.update  = verlet_benchmark_app_update;
+}
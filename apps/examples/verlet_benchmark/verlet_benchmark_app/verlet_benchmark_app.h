@@ -0,0 +1,63 @@
+#ifndef GUARD_verlet_benchmark_app_H
+#define GUARD_verlet_benchmark_app_H
+
+#include "le_core.h"
+
+// Headless benchmark for le_verlet: compares sequential and parallel solvers.
+
+struct verlet_benchmark_app_o;
+
+// clang-format off
+struct verlet_benchmark_app_api {
+
+	struct verlet_benchmark_app_interface_t {
+		verlet_benchmark_app_o * ( *create     )();
+		void                     ( *destroy    )( verlet_benchmark_app_o *self );
+		bool                     ( *update     )( verlet_benchmark_app_o *self );
+		void                     ( *initialize )(); // static methods
+		void                     ( *terminate  )(); // static methods
+	};
+
+	verlet_benchmark_app_interface_t verlet_benchmark_app_i;
+};
+// clang-format on
+
+LE_MODULE( verlet_benchmark_app );
+LE_MODULE_LOAD_DEFAULT( verlet_benchmark_app );
+
+#ifdef __cplusplus
+
+namespace verlet_benchmark_app {
+static const auto &api                    = verlet_benchmark_app_api_i;
+static const auto &verlet_benchmark_app_i = api -> verlet_benchmark_app_i;
+} // namespace verlet_benchmark_app
+
+class VerletBenchmarkApp : NoCopy, NoMove {
+
+	verlet_benchmark_app_o *self;
+
+  public:
+	VerletBenchmarkApp()
+	    : self( verlet_benchmark_app::verlet_benchmark_app_i.create() ) {
+	}
+
+	bool update() {
+		return verlet_benchmark_app::verlet_benchmark_app_i.update( self );
+	}
+
+	~VerletBenchmarkApp() {
+		verlet_benchmark_app::verlet_benchmark_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		verlet_benchmark_app::verlet_benchmark_app_i.initialize();
+	}
+
+	static void terminate() {
+		verlet_benchmark_app::verlet_benchmark_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif
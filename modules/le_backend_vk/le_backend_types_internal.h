@@ -216,6 +216,8 @@ struct LeRenderPass {
 	uint16_t       numDepthStencilAttachments;              // 0..1
 
 	LeRenderPassType type;
+	uint32_t         isAsyncCompute;       // pass is recorded and submitted on the async compute queue
+	uint32_t         waitsForAsyncCompute; // pass must wait for async compute work of this frame to complete
 
 	vk::Framebuffer         framebuffer;
 	vk::RenderPass          renderPass;
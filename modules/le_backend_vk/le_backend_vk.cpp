@@ -33,6 +33,10 @@ static constexpr auto LOGGER_LABEL = "le_backend";
 #	define PRINT_DEBUG_MESSAGES false
 #endif
 
+#if defined( LE_FEATURE_ASYNC_COMPUTE ) && !defined( LE_FEATURE_TIMELINE_SEMAPHORES )
+#	error "LE_FEATURE_ASYNC_COMPUTE requires LE_FEATURE_TIMELINE_SEMAPHORES"
+#endif
+
 #ifndef DEBUG_TAG_RESOURCES
 // Whether to tag resources - requires the debugUtils extension to be present.
 #	define DEBUG_TAG_RESOURCES true
@@ -338,7 +342,7 @@ ResourceCreateInfo ResourceCreateInfo::from_le_resource_info( const le_resource_
 		                     .setFlags( {} )
 		                     .setSize( info.buffer.size )
 		                     .setUsage( vk::BufferUsageFlags{ info.buffer.usage } ) // FIXME: we need to call an explicit le -> vk conversion
-		                     .setSharingMode( vk::SharingMode::eExclusive )
+		                     .setSharingMode( queueFamilyIndexCount > 1 ? vk::SharingMode::eConcurrent : vk::SharingMode::eExclusive ) // concurrent if buffer may be shared between graphics and async compute queue
 		                     .setQueueFamilyIndexCount( queueFamilyIndexCount )
 		                     .setPQueueFamilyIndices( pQueueFamilyIndices );
 
@@ -415,6 +419,15 @@ struct AllocatedResourceVk {
 	uint32_t           padding__;
 };
 
+// Device memory which was bound to an image or buffer that is no longer referenced
+// by any frame. The memory is kept alive so that a new image or buffer with compatible
+// memory requirements may be bound to it.
+struct PooledAllocationVk {
+	VmaAllocation     allocation;
+	VmaAllocationInfo allocationInfo; // memory type, offset and size of allocation
+	uint64_t          pooled_at;      // value of resource pool clock when allocation entered the pool
+};
+
 struct le_staging_allocator_o {
 	VmaAllocator                   allocator;      // non-owning, refers to backend allocator object
 	VkDevice                       device;         // non-owning, refers to vulkan device object
@@ -447,9 +460,29 @@ struct BackendFrameData {
 	vk::Fence       frameFence  = nullptr; // protects the frame - cpu waits on gpu to pass fence before deleting/recycling frame
 	vk::CommandPool commandPool = nullptr;
 
+	// Only used with LE_FEATURE_TIMELINE_SEMAPHORES: value which the backend's frame timeline semaphore
+	// will reach once the gpu has finished processing this frame. Frame fence is not used in that case.
+	uint64_t frameTimelineValue = 0;
+
 	std::vector<swapchain_state_t> swapchain_state;
 	std::vector<vk::CommandBuffer> commandBuffers;
 
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+	vk::CommandPool                commandPoolCompute = nullptr;       // command buffers for async compute passes are allocated from this pool
+	std::vector<vk::CommandBuffer> commandBuffersCompute;              // command buffers for passes which are submitted to the async compute queue
+	size_t                         commandBuffersComputeWaitIndex = 0; // index of first element in commandBuffers which must wait for async compute work
+	uint64_t                       computeTimelineValue           = 0; // value which compute timeline semaphore reaches once async compute work for this frame completes
+#endif
+
+	// Gpu profiler - only used if enabled via backend settings. Each pass gets two timestamp
+	// queries, and optionally one pipeline statistics query. Query results are read back
+	// when the frame is cleared.
+	vk::QueryPool                       timestampQueryPool    = nullptr; // owning
+	vk::QueryPool                       statisticsQueryPool   = nullptr; // owning, only if pipeline statistics are enabled
+	uint32_t                            queryPoolPassCapacity = 0;       // number of passes for which query pools have space
+	std::vector<le_renderpass_timing_t> passTimings;                     // one entry per pass, results filled in when frame is cleared
+	std::vector<std::string>            passTimingNames;                 // storage for debug names referenced by passTimings
+
 	struct Texture {
 		vk::Sampler   sampler;
 		vk::ImageView imageView;
@@ -553,11 +586,34 @@ struct le_backend_o {
 	uint32_t queueFamilyIndexGraphics = 0; // inferred during setup
 	uint32_t queueFamilyIndexCompute  = 0; // inferred during setup
 
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES
+	vk::Semaphore frameTimelineSemaphore = nullptr; // owning; signalled with monotonically increasing value once a frame has been processed by the gpu
+	uint64_t      frameTimelineValue     = 0;       // last value which was submitted to be signalled via frameTimelineSemaphore
+#endif
+
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+	bool          hasAsyncComputeQueue          = false;   // true if default compute queue is distinct from default graphics queue
+	uint32_t      queueFamilyIndicesShared[ 2 ] = {};      // graphics and compute queue family index, for buffers which may be accessed by both queues
+	uint32_t      queueFamilyIndicesSharedCount = 0;       // 2 if queue families differ (buffers use concurrent sharing), 0 otherwise
+	vk::Semaphore computeTimelineSemaphore      = nullptr; // owning; signalled with monotonically increasing value once async compute work for a frame has completed
+	uint64_t      computeTimelineValue          = 0;       // last value which was submitted to be signalled via computeTimelineSemaphore
+#endif
+
+	struct {
+		bool     timestamps_enabled          = false;
+		bool     pipeline_statistics_enabled = false;
+		float    timestamp_period            = 1.f; // nanoseconds per timestamp tick
+		uint64_t timestamp_mask_graphics     = 0;   // valid timestamp bits for graphics queue, 0 if queue does not support timestamps
+		uint64_t timestamp_mask_compute      = 0;   // valid timestamp bits for compute queue, 0 if queue does not support timestamps
+	} gpuProfiler;
+
 	KillList<le_rtx_blas_info_o> rtx_blas_info_kill_list; // used to keep track rtx_blas_infos.
 	KillList<le_rtx_tlas_info_o> rtx_tlas_info_kill_list; // used to keep track rtx_blas_infos.
 
 	struct {
 		std::unordered_map<le_resource_handle, AllocatedResourceVk> allocatedResources; // Allocated resources, indexed by resource name hash
+		std::vector<PooledAllocationVk>                             resourcePool;       // Memory of retired images and buffers, which may be bound to any image or buffer with compatible memory requirements
+		uint64_t                                                    resourcePoolClock = 0; // Incremented once per call to backend_allocate_resources
 	} only_backend_allocate_resources_may_access;                                       // Only acquire_physical_resources may read/write
 };
 
@@ -694,7 +750,9 @@ static void backend_destroy( le_backend_o *self ) {
 
 		// -- destroy per-frame data
 
+#ifndef LE_FEATURE_TIMELINE_SEMAPHORES
 		device.destroyFence( frameData.frameFence );
+#endif
 
 		for ( auto &swapchain_state : frameData.swapchain_state ) {
 			device.destroySemaphore( swapchain_state.presentComplete );
@@ -704,6 +762,19 @@ static void backend_destroy( le_backend_o *self ) {
 
 		device.destroyCommandPool( frameData.commandPool );
 
+		if ( frameData.timestampQueryPool ) {
+			device.destroyQueryPool( frameData.timestampQueryPool );
+		}
+		if ( frameData.statisticsQueryPool ) {
+			device.destroyQueryPool( frameData.statisticsQueryPool );
+		}
+
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+		if ( frameData.commandPoolCompute ) {
+			device.destroyCommandPool( frameData.commandPoolCompute );
+		}
+#endif
+
 		for ( auto &d : frameData.descriptorPools ) {
 			device.destroyDescriptorPool( d );
 		}
@@ -758,6 +829,18 @@ static void backend_destroy( le_backend_o *self ) {
 
 	self->mFrames.clear();
 
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES
+	device.destroySemaphore( self->frameTimelineSemaphore );
+	self->frameTimelineSemaphore = nullptr;
+#endif
+
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+	if ( self->computeTimelineSemaphore ) {
+		device.destroySemaphore( self->computeTimelineSemaphore );
+		self->computeTimelineSemaphore = nullptr;
+	}
+#endif
+
 	// Remove any resources still alive in the backend.
 	// At this point we're running single-threaded, so we can ignore the
 	// ownership claim on allocatedResources.
@@ -789,6 +872,12 @@ static void backend_destroy( le_backend_o *self ) {
 
 	self->only_backend_allocate_resources_may_access.allocatedResources.clear();
 
+	// Free any memory which was waiting in the resource pool to be recycled.
+	for ( auto &p : self->only_backend_allocate_resources_may_access.resourcePool ) {
+		vmaFreeMemory( self->mAllocator, p.allocation );
+	}
+	self->only_backend_allocate_resources_may_access.resourcePool.clear();
+
 	if ( self->mAllocator ) {
 		vmaDestroyAllocator( self->mAllocator );
 		self->mAllocator = nullptr;
@@ -1084,6 +1173,12 @@ static std::vector<char const *> collect_requested_device_extensions( le_backend
 	    settings->pSwapchain_settings, settings->num_swapchain_settings,
 	    le_swapchain_vk::swapchain_i.get_required_vk_device_extensions, requestedDeviceExtensions );
 
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES
+	// -- we need synchronization2 so that we can submit a frame via vkQueueSubmit2KHR
+
+	requestedDeviceExtensions.push_back( VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME );
+#endif
+
 	// -- insert any additionally requested extensions
 
 	requestedDeviceExtensions.insert(
@@ -1096,10 +1191,10 @@ static std::vector<char const *> collect_requested_device_extensions( le_backend
 
 // ----------------------------------------------------------------------
 
-static void backend_initialise( le_backend_o *self, std::vector<char const *> requested_instance_extensions, std::vector<char const *> requested_device_extensions ) {
+static void backend_initialise( le_backend_o *self, std::vector<char const *> requested_instance_extensions, std::vector<char const *> requested_device_extensions, bool request_pipeline_statistics_query ) {
 	using namespace le_backend_vk;
 	self->instance      = vk_instance_i.create( requested_instance_extensions.data(), uint32_t( requested_instance_extensions.size() ) );
-	self->device        = std::make_unique<le::Device>( self->instance, requested_device_extensions.data(), uint32_t( requested_device_extensions.size() ) );
+	self->device        = std::make_unique<le::Device>( self->instance, requested_device_extensions.data(), uint32_t( requested_device_extensions.size() ), request_pipeline_statistics_query );
 	self->pipelineCache = le_pipeline_manager_i.create( *self->device );
 }
 // ----------------------------------------------------------------------
@@ -1136,7 +1231,10 @@ static void backend_setup( le_backend_o *self, le_backend_vk_settings_t const *s
 
 	// -- initialise backend
 
-	backend_initialise( self, collect_requested_instance_extensions( settings ), collect_requested_device_extensions( settings ) );
+	// Pipeline statistics are only queried by the gpu profiler - we don't ask for the device feature otherwise.
+	bool const request_pipeline_statistics_query = settings->enable_gpu_timestamps && settings->enable_gpu_pipeline_statistics;
+
+	backend_initialise( self, collect_requested_instance_extensions( settings ), collect_requested_device_extensions( settings ), request_pipeline_statistics_query );
 
 	vk::Device         vkDevice         = self->device->getVkDevice();
 	vk::PhysicalDevice vkPhysicalDevice = self->device->getVkPhysicalDevice();
@@ -1163,11 +1261,80 @@ static void backend_setup( le_backend_o *self, le_backend_vk_settings_t const *s
 	self->queueFamilyIndexGraphics = self->device->getDefaultGraphicsQueueFamilyIndex();
 	self->queueFamilyIndexCompute  = self->device->getDefaultComputeQueueFamilyIndex();
 
+	if ( settings->enable_gpu_timestamps ) {
+
+		// -- Set up gpu profiler: find out how to interpret timestamp values for each queue.
+
+		auto const &queueFamilyProperties = vkPhysicalDevice.getQueueFamilyProperties();
+
+		auto get_timestamp_mask = []( uint32_t valid_bits ) -> uint64_t {
+			return valid_bits >= 64 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << valid_bits ) - 1;
+		};
+
+		self->gpuProfiler.timestamps_enabled          = true;
+		self->gpuProfiler.pipeline_statistics_enabled = self->device->isPipelineStatisticsQueryEnabled();
+		self->gpuProfiler.timestamp_period            = vkPhysicalDevice.getProperties().limits.timestampPeriod;
+		self->gpuProfiler.timestamp_mask_graphics     = get_timestamp_mask( queueFamilyProperties[ self->queueFamilyIndexGraphics ].timestampValidBits );
+		self->gpuProfiler.timestamp_mask_compute      = get_timestamp_mask( queueFamilyProperties[ self->queueFamilyIndexCompute ].timestampValidBits );
+	}
+
 	uint32_t memIndexScratchBufferGraphics = getMemoryIndexForGraphicsScratchBuffer( self->mAllocator, self->queueFamilyIndexGraphics ); // used for transient command buffer allocations
 	uint32_t memIndexStagingBufferGraphics = getMemoryIndexForGraphicsStagingBuffer( self->mAllocator, self->queueFamilyIndexGraphics ); // used to stage transfers to persistent memory
 
 	assert( vkDevice ); // device must come from somewhere! It must have been introduced to backend before, or backend must create device used by everyone else...
 
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES
+	{
+		// -- Create a single timeline semaphore which tracks all frames.
+		//
+		// Each frame, once dispatched, signals this semaphore with a new, monotonically
+		// increasing value. To find out whether a frame can be recycled, we only need to
+		// compare against the value stored with the frame - there are no fences to reset.
+
+		vk::SemaphoreTypeCreateInfo semaphoreTypeInfo;
+		semaphoreTypeInfo
+		    .setSemaphoreType( vk::SemaphoreType::eTimeline )
+		    .setInitialValue( 0 );
+
+		self->frameTimelineSemaphore = vkDevice.createSemaphore( vk::SemaphoreCreateInfo().setPNext( &semaphoreTypeInfo ) );
+		self->frameTimelineValue     = 0;
+	}
+#endif
+
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+	{
+		// -- Find out whether we can submit compute passes to a queue which is distinct from the
+		// graphics queue. If not, async compute passes are recorded into the graphics queue.
+		//
+		// If the compute queue belongs to a different queue family, buffers which may be
+		// accessed by async compute passes are created with concurrent sharing mode, so that
+		// we don't have to track queue family ownership for these buffers across frames.
+		//
+		// Note that only buffer-only passes are tagged async compute by the rendergraph,
+		// which means images may remain in exclusive sharing mode.
+
+		self->hasAsyncComputeQueue =
+		    self->device->getDefaultComputeQueue() != nullptr &&
+		    self->device->getDefaultComputeQueue() != self->device->getDefaultGraphicsQueue();
+
+		if ( self->hasAsyncComputeQueue && self->queueFamilyIndexCompute != self->queueFamilyIndexGraphics ) {
+			self->queueFamilyIndicesShared[ 0 ]  = self->queueFamilyIndexGraphics;
+			self->queueFamilyIndicesShared[ 1 ]  = self->queueFamilyIndexCompute;
+			self->queueFamilyIndicesSharedCount = 2;
+		}
+
+		if ( self->hasAsyncComputeQueue ) {
+			vk::SemaphoreTypeCreateInfo semaphoreTypeInfo;
+			semaphoreTypeInfo
+			    .setSemaphoreType( vk::SemaphoreType::eTimeline )
+			    .setInitialValue( 0 );
+
+			self->computeTimelineSemaphore = vkDevice.createSemaphore( vk::SemaphoreCreateInfo().setPNext( &semaphoreTypeInfo ) );
+			self->computeTimelineValue     = 0;
+		}
+	}
+#endif
+
 	{
 		self->swapchain_resources.reserve( self->swapchains.size() );
 		char swapchain_name[ 64 ];
@@ -1197,9 +1364,17 @@ static void backend_setup( le_backend_o *self, le_backend_vk_settings_t const *s
 			}
 		}
 
-		frameData.frameFence  = vkDevice.createFence( {} ); // fence starts out as "signalled"
+#ifndef LE_FEATURE_TIMELINE_SEMAPHORES
+		frameData.frameFence = vkDevice.createFence( {} ); // fence starts out as "signalled"
+#endif
 		frameData.commandPool = vkDevice.createCommandPool( { vk::CommandPoolCreateFlagBits::eTransient, self->device->getDefaultGraphicsQueueFamilyIndex() } );
 
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+		if ( self->hasAsyncComputeQueue ) {
+			frameData.commandPoolCompute = vkDevice.createCommandPool( { vk::CommandPoolCreateFlagBits::eTransient, self->queueFamilyIndexCompute } );
+		}
+#endif
+
 		{
 			// -- set up an allocation pool for each frame
 			// so that each frame can create sub-allocators
@@ -1557,6 +1732,9 @@ static void frame_track_resource_state( BackendFrameData &frame, le_renderpass_o
 		currentPass.type      = renderpass_i.get_type( *pass );
 		currentPass.debugName = renderpass_i.get_debug_name( *pass );
 
+		currentPass.isAsyncCompute       = renderpass_i.get_is_async_compute( *pass );
+		currentPass.waitsForAsyncCompute = renderpass_i.get_waits_for_async_compute( *pass );
+
 		currentPass.width       = renderpass_i.get_width( *pass );
 		currentPass.height      = renderpass_i.get_height( *pass );
 		currentPass.sampleCount = le_sample_count_flag_bits_to_vk( renderpass_i.get_sample_count( *pass ) );
@@ -1744,12 +1922,36 @@ static bool backend_poll_frame_fence( le_backend_o *self, size_t frameIndex ) {
 	auto &     frame  = self->mFrames[ frameIndex ];
 	vk::Device device = self->device->getVkDevice();
 
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES
+
+	// With timeline semaphores, the frame fence is implicit: the frame has been
+	// processed by the gpu once the timeline semaphore has reached the value which
+	// was assigned to the frame when it was dispatched.
+
+	// Non-blocking, polling
+	if ( device.getSemaphoreCounterValue( self->frameTimelineSemaphore ) >= frame.frameTimelineValue ) {
+		return true;
+	}
+
+	// NOTE: this may block.
+	vk::SemaphoreWaitInfo waitInfo;
+	waitInfo
+	    .setSemaphoreCount( 1 )
+	    .setPSemaphores( &self->frameTimelineSemaphore )
+	    .setPValues( &frame.frameTimelineValue );
+
+	auto result = device.waitSemaphores( waitInfo, 1000'000'000 );
+
+#else
+
 	// Non-blocking, polling
 	// auto result = device.getFenceStatus( {frame.frameFence} );
 
 	// NOTE: this may block.
 	auto result = device.waitForFences( { frame.frameFence }, true, 1000'000'000 );
 
+#endif
+
 	if ( result != vk::Result::eSuccess ) {
 		return false;
 	} else {
@@ -1757,6 +1959,159 @@ static bool backend_poll_frame_fence( le_backend_o *self, size_t frameIndex ) {
 	}
 }
 
+// ----------------------------------------------------------------------
+// Returns true if pass gets recorded into a command buffer for the async compute queue.
+static inline bool backend_pass_uses_compute_queue( le_backend_o const *self, LeRenderPass const &pass ) {
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+	return self->hasAsyncComputeQueue && pass.isAsyncCompute;
+#else
+	return false;
+#endif
+}
+
+// ----------------------------------------------------------------------
+
+// Pipeline statistics which the gpu profiler queries for each pass. Note that query results are
+// written in order of bit position - this order must match le_renderpass_timing_t::PipelineStatistic.
+static const vk::QueryPipelineStatisticFlags LE_GPU_PROFILER_PIPELINE_STATISTICS =
+    vk::QueryPipelineStatisticFlagBits::eInputAssemblyVertices |
+    vk::QueryPipelineStatisticFlagBits::eInputAssemblyPrimitives |
+    vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations |
+    vk::QueryPipelineStatisticFlagBits::eClippingInvocations |
+    vk::QueryPipelineStatisticFlagBits::eClippingPrimitives |
+    vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations |
+    vk::QueryPipelineStatisticFlagBits::eComputeShaderInvocations;
+
+// Makes sure that gpu profiler query pools have space for all passes of the current frame,
+// and prepares a timing entry for each pass. Must be called before passes are recorded.
+static void backend_frame_prepare_gpu_profiler( le_backend_o *self, BackendFrameData &frame, vk::Device const &device ) {
+
+	frame.passTimings.clear();
+	frame.passTimingNames.clear();
+
+	if ( !self->gpuProfiler.timestamps_enabled ) {
+		return;
+	}
+
+	// ---------| invariant: gpu profiler is enabled
+
+	uint32_t const numPasses = uint32_t( frame.passes.size() );
+
+	if ( numPasses > frame.queryPoolPassCapacity ) {
+
+		// Grow query pools - it is safe to destroy previous query pools, as the
+		// fence for this frame must have been crossed before we can process it.
+
+		if ( frame.timestampQueryPool ) {
+			device.destroyQueryPool( frame.timestampQueryPool );
+		}
+		if ( frame.statisticsQueryPool ) {
+			device.destroyQueryPool( frame.statisticsQueryPool );
+			frame.statisticsQueryPool = nullptr;
+		}
+
+		frame.queryPoolPassCapacity = std::max( numPasses, std::max( 2 * frame.queryPoolPassCapacity, 32u ) );
+
+		frame.timestampQueryPool = device.createQueryPool(
+		    vk::QueryPoolCreateInfo()
+		        .setQueryType( vk::QueryType::eTimestamp )
+		        .setQueryCount( 2 * frame.queryPoolPassCapacity ) ); // two timestamps per pass: begin, end
+
+		if ( self->gpuProfiler.pipeline_statistics_enabled ) {
+			frame.statisticsQueryPool = device.createQueryPool(
+			    vk::QueryPoolCreateInfo()
+			        .setQueryType( vk::QueryType::ePipelineStatistics )
+			        .setQueryCount( frame.queryPoolPassCapacity )
+			        .setPipelineStatistics( LE_GPU_PROFILER_PIPELINE_STATISTICS ) );
+		}
+	}
+
+	frame.passTimingNames.reserve( numPasses );
+	frame.passTimings.resize( numPasses, le_renderpass_timing_t{} );
+
+	for ( auto const &pass : frame.passes ) {
+		frame.passTimingNames.emplace_back( pass.debugName );
+	}
+
+	for ( size_t i = 0; i != numPasses; i++ ) {
+		auto &     timing       = frame.passTimings[ i ];
+		bool const uses_compute = backend_pass_uses_compute_queue( self, frame.passes[ i ] );
+
+		timing.debug_name              = frame.passTimingNames[ i ].c_str();
+		timing.is_async_compute        = uses_compute;
+		timing.has_timestamps          = 0 != ( uses_compute ? self->gpuProfiler.timestamp_mask_compute : self->gpuProfiler.timestamp_mask_graphics );
+		timing.has_pipeline_statistics = self->gpuProfiler.pipeline_statistics_enabled && !uses_compute; // graphics statistics may not be queried on a compute-only queue
+	}
+}
+
+// ----------------------------------------------------------------------
+// Reads back gpu profiler query results for all passes of a frame.
+// The frame fence must have been crossed, so that all results are available.
+static void backend_frame_fetch_gpu_profiler_results( le_backend_o *self, BackendFrameData &frame, vk::Device const &device ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	for ( size_t i = 0; i != frame.passTimings.size(); i++ ) {
+
+		auto &timing = frame.passTimings[ i ];
+
+		if ( timing.has_timestamps ) {
+
+			// Each query result is followed by its availability - queries will not be
+			// available if the frame was processed, but never submitted.
+			uint64_t data[ 4 ] = {}; // begin, begin available, end, end available
+
+			vk::Result result =
+			    device.getQueryPoolResults(
+			        frame.timestampQueryPool, uint32_t( 2 * i ), 2,
+			        sizeof( data ), data, 2 * sizeof( uint64_t ),
+			        vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability );
+
+			if ( ( result == vk::Result::eSuccess || result == vk::Result::eNotReady ) && data[ 1 ] && data[ 3 ] ) {
+				uint64_t const mask   = timing.is_async_compute ? self->gpuProfiler.timestamp_mask_compute : self->gpuProfiler.timestamp_mask_graphics;
+				timing.gpu_time_begin = uint64_t( double( data[ 0 ] & mask ) * self->gpuProfiler.timestamp_period );
+				timing.gpu_time_end   = uint64_t( double( data[ 2 ] & mask ) * self->gpuProfiler.timestamp_period );
+			} else {
+				timing.has_timestamps = false;
+			}
+		}
+
+		if ( timing.has_pipeline_statistics ) {
+
+			uint64_t data[ le_renderpass_timing_t::ePipelineStatisticCount + 1 ] = {}; // statistics, followed by availability
+
+			vk::Result result =
+			    device.getQueryPoolResults(
+			        frame.statisticsQueryPool, uint32_t( i ), 1,
+			        sizeof( data ), data, sizeof( data ),
+			        vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability );
+
+			if ( ( result == vk::Result::eSuccess || result == vk::Result::eNotReady ) && data[ le_renderpass_timing_t::ePipelineStatisticCount ] ) {
+				memcpy( timing.pipeline_statistics, data, sizeof( timing.pipeline_statistics ) );
+			} else {
+				timing.has_pipeline_statistics = false;
+			}
+		}
+	}
+
+	if ( PRINT_DEBUG_MESSAGES ) {
+		for ( auto const &timing : frame.passTimings ) {
+			if ( timing.has_timestamps ) {
+				logger.debug( "Pass '%s': %8.3fms (gpu)", timing.debug_name, double( timing.gpu_time_end - timing.gpu_time_begin ) / 1'000'000.0 );
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static bool backend_get_frame_pass_timings( le_backend_o *self, size_t frameIndex, le_renderpass_timing_t const **timings, uint32_t *timings_count ) {
+	auto const &frame = self->mFrames[ frameIndex ];
+	*timings          = frame.passTimings.data();
+	*timings_count    = uint32_t( frame.passTimings.size() );
+	return !frame.passTimings.empty();
+}
+
 // ----------------------------------------------------------------------
 /// \brief: Frees all frame local resources
 /// \preliminary: frame fence must have been crossed.
@@ -1778,7 +2133,12 @@ static bool backend_clear_frame( le_backend_o *self, size_t frameIndex ) {
 	// -------- Invariant: fence has been crossed, all resources protected by fence
 	//          can now be claimed back.
 
+	// Query results are available now that the frame fence has been crossed.
+	backend_frame_fetch_gpu_profiler_results( self, frame, device );
+
+#ifndef LE_FEATURE_TIMELINE_SEMAPHORES
 	device.resetFences( { frame.frameFence } );
+#endif
 
 	// -- reset all frame-local sub-allocators
 	for ( auto &alloc : frame.allocators ) {
@@ -1835,6 +2195,17 @@ static bool backend_clear_frame( le_backend_o *self, size_t frameIndex ) {
 	device.freeCommandBuffers( frame.commandPool, frame.commandBuffers );
 	frame.commandBuffers.clear();
 
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+	if ( frame.commandPoolCompute ) {
+		if ( !frame.commandBuffersCompute.empty() ) {
+			device.freeCommandBuffers( frame.commandPoolCompute, frame.commandBuffersCompute );
+		}
+		device.resetCommandPool( frame.commandPoolCompute, vk::CommandPoolResetFlagBits::eReleaseResources );
+	}
+	frame.commandBuffersCompute.clear();
+	frame.commandBuffersComputeWaitIndex = 0;
+#endif
+
 	frame.physicalResources.clear();
 	frame.syncChainTable.clear();
 
@@ -2420,25 +2791,12 @@ static inline AllocatedResourceVk allocate_resource_vk( const VmaAllocator &allo
 
 	VkResult result = VK_SUCCESS;
 
-	if ( resourceInfo.isBuffer() ) {
+	if ( resourceInfo.isBuffer() || resourceInfo.isImage() ) {
 
-		result = vmaCreateBuffer( alloc,
-		                          &resourceInfo.bufferInfo,
-		                          &allocationCreateInfo,
-		                          &res.as.buffer,
-		                          &res.allocation,
-		                          &res.allocationInfo );
-		assert( result == VK_SUCCESS );
+		// Images and buffers must be bound to memory which may be recycled once they
+		// are no longer used - see backend_allocate_or_recycle_resource().
+		assert( false && "images and buffers must be allocated via backend_allocate_or_recycle_resource()" );
 
-	} else if ( resourceInfo.isImage() ) {
-
-		result = vmaCreateImage( alloc,
-		                         &resourceInfo.imageInfo,
-		                         &allocationCreateInfo,
-		                         &res.as.image,
-		                         &res.allocation,
-		                         &res.allocationInfo );
-		assert( result == VK_SUCCESS );
 	} else if ( resourceInfo.isBlas() ) {
 
 #ifdef LE_FEATURE_RTX
@@ -2760,16 +3118,166 @@ static void staging_allocator_destroy( le_staging_allocator_o *self ) {
 
 // ----------------------------------------------------------------------
 
-// Frees any resources which are marked for being recycled in the current frame.
-inline void frame_release_binned_resources( BackendFrameData &frame, VmaAllocator &allocator ) {
+// Upper bounds for the resource pool - once any of these is exceeded, the
+// oldest pooled allocations are freed first.
+static constexpr uint64_t LE_RESOURCE_POOL_MAX_BYTES   = 256ull << 20; // 256 MiB
+static constexpr size_t   LE_RESOURCE_POOL_MAX_ENTRIES = 64;
+
+// ----------------------------------------------------------------------
+
+// Moves the memory of resources which were binned the last time this frame was
+// active into the backend-wide resource pool. Since this frame has been cleared,
+// the gpu is done with these resources, and any frame which is still in flight
+// only references newer versions of them, so that we may destroy the images and
+// buffers, and recycle their memory.
+//
+// Pooled allocations get freed if:
+//
+// - they have spent more calls to backend_allocate_resources in the pool than
+//   there are frames in flight - memory which has not been picked up again
+//   by then is unlikely to be picked up at all,
+// - the pool holds more than LE_RESOURCE_POOL_MAX_ENTRIES allocations, or more
+//   than LE_RESOURCE_POOL_MAX_BYTES of memory - oldest allocations go first.
+static void frame_release_binned_resources( le_backend_o *self, BackendFrameData &frame ) {
+
+	vk::Device device = self->device->getVkDevice();
+
+	auto &pool  = self->only_backend_allocate_resources_may_access.resourcePool;
+	auto  clock = ++self->only_backend_allocate_resources_may_access.resourcePoolClock;
+
+	uint64_t const max_age = self->mFrames.size();
+
 	for ( auto &a : frame.binnedResources ) {
-		if ( a.second.info.isBuffer() ) {
-			vmaDestroyBuffer( allocator, a.second.as.buffer, a.second.allocation );
+		if ( a.second.info.isBuffer() || a.second.info.isImage() ) {
+			if ( a.second.info.isBuffer() ) {
+				device.destroyBuffer( a.second.as.buffer );
+			} else {
+				device.destroyImage( a.second.as.image );
+			}
+			VmaAllocationInfo allocation_info{};
+			vmaGetAllocationInfo( self->mAllocator, a.second.allocation, &allocation_info );
+			pool.push_back( { a.second.allocation, allocation_info, clock } );
 		} else {
-			vmaDestroyImage( allocator, a.second.as.image, a.second.allocation );
+			vmaDestroyImage( self->mAllocator, a.second.as.image, a.second.allocation );
 		}
 	}
 	frame.binnedResources.clear();
+
+	// Evict any allocations which have outstayed their welcome.
+	pool.erase( std::remove_if( pool.begin(), pool.end(),
+	                            [ & ]( PooledAllocationVk &p ) -> bool {
+		                            if ( clock - p.pooled_at > max_age ) {
+			                            vmaFreeMemory( self->mAllocator, p.allocation );
+			                            return true;
+		                            }
+		                            return false;
+	                            } ),
+	            pool.end() );
+
+	// Allocations enter the pool in order, so that the oldest allocations are
+	// at the front of the pool - if the pool is over budget, we free from
+	// the front until it isn't anymore.
+
+	uint64_t pool_bytes = 0;
+	for ( auto const &p : pool ) {
+		pool_bytes += p.allocationInfo.size;
+	}
+
+	size_t num_evicted = 0;
+	while ( num_evicted != pool.size() &&
+	        ( pool.size() - num_evicted > LE_RESOURCE_POOL_MAX_ENTRIES || pool_bytes > LE_RESOURCE_POOL_MAX_BYTES ) ) {
+		pool_bytes -= pool[ num_evicted ].allocationInfo.size;
+		vmaFreeMemory( self->mAllocator, pool[ num_evicted ].allocation );
+		num_evicted++;
+	}
+	pool.erase( pool.begin(), pool.begin() + num_evicted );
+}
+
+// ----------------------------------------------------------------------
+// Returns a physical resource matching `createInfo`.
+//
+// Images and buffers are created first, so that we can query their memory
+// requirements. They are then bound to memory from the backend-wide resource
+// pool, if the pool holds an allocation which fits, otherwise to a newly
+// allocated block of memory.
+//
+// An allocation fits if its memory type is allowed, its offset is aligned,
+// and its size is large enough, but not more than twice as large as what
+// has been requested, so that small resources don't hog large allocations.
+// Of all allocations which fit, we pick the smallest.
+//
+// Memory is always allocated independently of the resource which it is first
+// bound to, so that VMA never hands out dedicated allocations, which could not
+// be bound to any other resource. Since all images and buffers are allocated
+// with the same allocation create info, the memory type of any pooled
+// allocation matches the memory properties which we ask for.
+static AllocatedResourceVk backend_allocate_or_recycle_resource( le_backend_o *self, ResourceCreateInfo const &createInfo ) {
+
+	if ( !createInfo.isBuffer() && !createInfo.isImage() ) {
+		return allocate_resource_vk( self->mAllocator, createInfo, self->device->getVkDevice() );
+	}
+
+	// ----------| invariant: resource is either an image or a buffer
+
+	vk::Device device = self->device->getVkDevice();
+
+	AllocatedResourceVk res{};
+	res.info = createInfo;
+
+	vk::MemoryRequirements memory_requirements;
+
+	if ( createInfo.isBuffer() ) {
+		res.as.buffer       = device.createBuffer( reinterpret_cast<vk::BufferCreateInfo const &>( createInfo.bufferInfo ) );
+		memory_requirements = device.getBufferMemoryRequirements( res.as.buffer );
+	} else {
+		res.as.image        = device.createImage( reinterpret_cast<vk::ImageCreateInfo const &>( createInfo.imageInfo ) );
+		memory_requirements = device.getImageMemoryRequirements( res.as.image );
+	}
+
+	auto &pool = self->only_backend_allocate_resources_may_access.resourcePool;
+
+	auto found = pool.end();
+
+	for ( auto it = pool.rbegin(); it != pool.rend(); it++ ) {
+		auto const &info = it->allocationInfo;
+		if ( ( memory_requirements.memoryTypeBits & ( 1u << info.memoryType ) ) &&
+		     info.offset % memory_requirements.alignment == 0 &&
+		     info.size >= memory_requirements.size &&
+		     info.size <= 2 * memory_requirements.size &&
+		     ( found == pool.end() || info.size < found->allocationInfo.size ) ) {
+			found = std::prev( it.base() );
+		}
+	}
+
+	VkResult result = VK_SUCCESS;
+
+	if ( found != pool.end() ) {
+		res.allocation = found->allocation;
+		pool.erase( found );
+	} else {
+		VmaAllocationCreateInfo allocationCreateInfo{};
+		allocationCreateInfo.flags          = {}; // default flags
+		allocationCreateInfo.usage          = VMA_MEMORY_USAGE_GPU_ONLY;
+		allocationCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+		result = vmaAllocateMemory( self->mAllocator,
+		                            &static_cast<VkMemoryRequirements const &>( memory_requirements ),
+		                            &allocationCreateInfo,
+		                            &res.allocation,
+		                            nullptr );
+		assert( result == VK_SUCCESS );
+	}
+
+	if ( createInfo.isBuffer() ) {
+		result = vmaBindBufferMemory( self->mAllocator, res.allocation, res.as.buffer );
+	} else {
+		result = vmaBindImageMemory( self->mAllocator, res.allocation, res.as.image );
+	}
+	assert( result == VK_SUCCESS );
+
+	vmaGetAllocationInfo( self->mAllocator, res.allocation, &res.allocationInfo );
+
+	return res;
 }
 
 // ----------------------------------------------------------------------
@@ -3266,7 +3774,7 @@ static void backend_allocate_resources( le_backend_o *self, BackendFrameData &fr
 	// It's possible that this was more than two frames ago,
 	// depending on how many swapchain images there are.
 	//
-	frame_release_binned_resources( frame, self->mAllocator );
+	frame_release_binned_resources( self, frame );
 
 	// Iterate over all resource declarations in all passes so that we can collect all resources,
 	// and their usage information. Later, we will consolidate their usages so that resources can
@@ -3323,7 +3831,11 @@ static void backend_allocate_resources( le_backend_o *self, BackendFrameData &fr
 		// first check if the resource is available to the frame,
 		// if that is not the chase, check if the resource is available to the frame.
 
-		auto       resourceCreateInfo = ResourceCreateInfo::from_le_resource_info( resourceInfo, &self->queueFamilyIndexGraphics, 0 );
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+		auto resourceCreateInfo = ResourceCreateInfo::from_le_resource_info( resourceInfo, self->queueFamilyIndicesShared, self->queueFamilyIndicesSharedCount );
+#else
+		auto resourceCreateInfo = ResourceCreateInfo::from_le_resource_info( resourceInfo, &self->queueFamilyIndexGraphics, 0 );
+#endif
 		auto       foundIt            = backendResources.find( resource );
 		const bool resourceIdNotFound = ( foundIt == backendResources.end() );
 
@@ -3341,7 +3853,7 @@ static void backend_allocate_resources( le_backend_o *self, BackendFrameData &fr
 				}
 			}
 
-			auto allocatedResource = allocate_resource_vk( self->mAllocator, resourceCreateInfo, self->device->getVkDevice() );
+			auto allocatedResource = backend_allocate_or_recycle_resource( self, resourceCreateInfo );
 
 			if ( PRINT_DEBUG_MESSAGES || true ) {
 				//				logger.info( "Allocated resource: " );
@@ -3388,7 +3900,7 @@ static void backend_allocate_resources( le_backend_o *self, BackendFrameData &fr
 					}
 				}
 
-				auto allocatedResource = allocate_resource_vk( self->mAllocator, resourceCreateInfo );
+				auto allocatedResource = backend_allocate_or_recycle_resource( self, resourceCreateInfo );
 
 				if ( PRINT_DEBUG_MESSAGES || true ) {
 					logger.info( "Re-allocated resource: " );
@@ -3447,9 +3959,13 @@ static void backend_allocate_resources( le_backend_o *self, BackendFrameData &fr
 			resourceInfo.buffer.size              = uint32_t( scratchbuffer_max_size );
 			resourceInfo.buffer.usage             = { LE_BUFFER_USAGE_STORAGE_BUFFER_BIT | LE_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT };
 			resourceInfo.type                     = LeResourceType::eBuffer;
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+			ResourceCreateInfo resourceCreateInfo = ResourceCreateInfo::from_le_resource_info( resourceInfo, self->queueFamilyIndicesShared, self->queueFamilyIndicesSharedCount );
+#else
 			ResourceCreateInfo resourceCreateInfo = ResourceCreateInfo::from_le_resource_info( resourceInfo, &self->queueFamilyIndexGraphics, 0 );
+#endif
 			auto               resource_id        = LE_RTX_SCRATCH_BUFFER_HANDLE;
-			auto               allocated_resource = allocate_resource_vk( self->mAllocator, resourceCreateInfo, self->device->getVkDevice() );
+			auto               allocated_resource = backend_allocate_or_recycle_resource( self, resourceCreateInfo );
 			frame.availableResources.insert_or_assign( resource_id, allocated_resource );
 
 			// We immediately bin the buffer resource, so that its lifetime is tied to the current frame.
@@ -3883,7 +4399,16 @@ static le_allocator_o **backend_create_transient_allocators( le_backend_o *self,
 			    .setUsage( LE_BUFFER_USAGE_FLAGS_SCRATCH )
 			    .setSharingMode( vk::SharingMode::eExclusive )
 			    .setQueueFamilyIndexCount( 1 )
-			    .setPQueueFamilyIndices( &self->queueFamilyIndexGraphics ); // TODO: use compute queue for compute passes, or transfer for transfer passes
+			    .setPQueueFamilyIndices( &self->queueFamilyIndexGraphics ); // TODO: use transfer queue for transfer passes
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+			if ( self->queueFamilyIndicesSharedCount > 1 ) {
+				// Scratch buffers may be used by passes on both graphics and async compute queue.
+				bufferInfoProxy
+				    .setSharingMode( vk::SharingMode::eConcurrent )
+				    .setQueueFamilyIndexCount( self->queueFamilyIndicesSharedCount )
+				    .setPQueueFamilyIndices( self->queueFamilyIndicesShared );
+			}
+#endif
 			bufferCreateInfo = bufferInfoProxy;
 		}
 
@@ -4217,11 +4742,47 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 
 	// TODO: (parallelize) when going wide, there needs to be a commandPool for each execution context so that
 	// command buffer generation may be free-threaded.
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+
+	// Passes which the rendergraph tagged as async compute get their command buffers
+	// from the compute command pool - all other passes use the graphics command pool.
+	// If there is no distinct compute queue, all passes go to the graphics queue.
+
+	uint32_t numCommandBuffersCompute = 0;
+	for ( auto const &pass : frame.passes ) {
+		numCommandBuffersCompute += backend_pass_uses_compute_queue( self, pass ) ? 1 : 0;
+	}
+	uint32_t numCommandBuffersGraphics = uint32_t( frame.passes.size() ) - numCommandBuffersCompute;
+
+	std::vector<vk::CommandBuffer> cmdBufsGraphics;
+	std::vector<vk::CommandBuffer> cmdBufsCompute;
+
+	if ( numCommandBuffersGraphics ) {
+		cmdBufsGraphics = device.allocateCommandBuffers( { frame.commandPool, vk::CommandBufferLevel::ePrimary, numCommandBuffersGraphics } );
+	}
+	if ( numCommandBuffersCompute ) {
+		cmdBufsCompute = device.allocateCommandBuffers( { frame.commandPoolCompute, vk::CommandBufferLevel::ePrimary, numCommandBuffersCompute } );
+	}
+
+	// Arrange command buffers so that there is exactly one per pass, in pass order.
+	std::vector<vk::CommandBuffer> cmdBufs;
+	cmdBufs.reserve( frame.passes.size() );
+	{
+		auto g = cmdBufsGraphics.begin();
+		auto c = cmdBufsCompute.begin();
+		for ( auto const &pass : frame.passes ) {
+			cmdBufs.push_back( backend_pass_uses_compute_queue( self, pass ) ? *c++ : *g++ );
+		}
+	}
+#else
 	auto numCommandBuffers = uint32_t( frame.passes.size() );
 	auto cmdBufs           = device.allocateCommandBuffers( { frame.commandPool, vk::CommandBufferLevel::ePrimary, numCommandBuffers } );
+#endif
 
 	std::array<vk::ClearValue, 16> clearValues{};
 
+	backend_frame_prepare_gpu_profiler( self, frame, device );
+
 	// TODO: (parallel for)
 	// note that access to any caches when creating pipelines and layouts and descriptorsets must be
 	// mutex-controlled when processing happens concurrently.
@@ -4261,6 +4822,21 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 			cmd.beginDebugUtilsLabelEXT( labelInfo );
 		}
 
+		// Gpu profiler: bracket pass with timestamp, and pipeline statistics queries.
+		// Queries are reset in the same command buffer, so that each pass is self-contained,
+		// independent of which queue it gets submitted to.
+		le_renderpass_timing_t const *passTiming = frame.passTimings.empty() ? nullptr : &frame.passTimings[ passIndex ];
+
+		if ( passTiming && passTiming->has_timestamps ) {
+			cmd.resetQueryPool( frame.timestampQueryPool, uint32_t( 2 * passIndex ), 2 );
+			cmd.writeTimestamp( vk::PipelineStageFlagBits::eTopOfPipe, frame.timestampQueryPool, uint32_t( 2 * passIndex ) );
+		}
+
+		if ( passTiming && passTiming->has_pipeline_statistics ) {
+			cmd.resetQueryPool( frame.statisticsQueryPool, uint32_t( passIndex ), 1 );
+			cmd.beginQuery( frame.statisticsQueryPool, uint32_t( passIndex ), {} );
+		}
+
 		{
 
 			if ( PRINT_DEBUG_MESSAGES ) {
@@ -4414,6 +4990,8 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 			void *                        dataIt = commandStream;
 			le_pipeline_and_layout_info_t currentPipeline{};
 
+			std::unordered_map<le_resource_handle, ResourceState> written_image_state; // state in which images written to in this pass were left, used to sync subsequent writes
+
 			while ( commandIndex != numCommands ) {
 
 				auto header = static_cast<le::CommandHeader *>( dataIt );
@@ -5181,7 +5759,6 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 
 				case le::CommandType::eWriteToImage: {
 
-					// TODO: Use sync chain to sync
 					// TODO: we can only write to linear images - we must find a way to make our image tiled
 
 					auto *le_cmd = static_cast<le::CommandWriteToImage *>( dataIt );
@@ -5189,6 +5766,74 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 					auto srcBuffer = frame_data_get_buffer_from_le_resource_id( frame, le_cmd->info.src_buffer_id );
 					auto dstImage  = frame_data_get_image_from_le_resource_id( frame, le_cmd->info.dst_image_id );
 
+					// Find the state in which the image was left before this write, so that we may
+					// transition from its actual layout, and wait for any prior accesses.
+					//
+					// Images which have been written to in this pass were left in shader read only
+					// optimal layout by the last write (see below). Otherwise, the image was brought
+					// into the state recorded in the sync chain by the explicit sync op which the
+					// TRANSFER_DST usage of this pass has added before the pass began.
+					//
+					// If an image has no recorded state, or held no contents before this pass, we
+					// transition from undefined, which allows the implementation to discard contents.
+					ResourceState state_before{}; // default: layout undefined, no prior access
+					bool          has_state_before = false;
+
+					if ( auto it = written_image_state.find( le_cmd->info.dst_image_id ); it != written_image_state.end() ) {
+						state_before     = it->second;
+						has_state_before = true;
+					} else {
+						for ( auto const &op : pass.explicit_sync_ops ) {
+							if ( op.resource != le_cmd->info.dst_image_id ) {
+								continue;
+							}
+							// ----------| invariant: sync op is for the image which we write to
+							auto const &syncChain = frame.syncChainTable.at( op.resource );
+							state_before          = syncChain[ op.sync_chain_offset_final ];
+							has_state_before      = true;
+							if ( syncChain[ op.sync_chain_offset_initial ].layout == vk::ImageLayout::eUndefined ) {
+								// Image held no contents before this pass - there is nothing to preserve.
+								state_before.layout = vk::ImageLayout::eUndefined;
+							}
+							break;
+						}
+					}
+
+					if ( !has_state_before ) {
+						// Image was not declared for use in this pass, so we don't know in which layout it is in.
+						// We transition all its subresources from undefined so that they are in a known layout.
+						vk::ImageSubresourceRange rangeFullImage;
+						rangeFullImage
+						    .setAspectMask( vk::ImageAspectFlagBits::eColor )
+						    .setBaseMipLevel( 0 )
+						    .setLevelCount( VK_REMAINING_MIP_LEVELS )
+						    .setBaseArrayLayer( 0 )
+						    .setLayerCount( VK_REMAINING_ARRAY_LAYERS );
+
+						vk::ImageMemoryBarrier imageLayoutFromUndefined;
+						imageLayoutFromUndefined
+						    .setSrcAccessMask( {} )                                  // no prior access
+						    .setDstAccessMask( {} )                                  // next barrier waits for transfer stage
+						    .setOldLayout( vk::ImageLayout::eUndefined )             // contents may be discarded
+						    .setNewLayout( vk::ImageLayout::eShaderReadOnlyOptimal ) // layout in which written images are left
+						    .setSrcQueueFamilyIndex( VK_QUEUE_FAMILY_IGNORED )
+						    .setDstQueueFamilyIndex( VK_QUEUE_FAMILY_IGNORED )
+						    .setImage( dstImage )
+						    .setSubresourceRange( rangeFullImage );
+
+						cmd.pipelineBarrier(
+						    vk::PipelineStageFlagBits::eTopOfPipe,
+						    vk::PipelineStageFlagBits::eTransfer,
+						    {},
+						    {},
+						    {},                          // buffers: nothing to do
+						    { imageLayoutFromUndefined } // images: bring into known layout
+						);
+
+						state_before.write_stage = vk::PipelineStageFlagBits::eTransfer;
+						state_before.layout      = vk::ImageLayout::eUndefined; // contents are undefined
+					}
+
 					// We define a range that covers all miplevels. this is useful as it allows us to transform
 					// Image layouts in bulk, covering the full mip chain.
 					vk::ImageSubresourceRange rangeAllRemainingMiplevels;
@@ -5197,7 +5842,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 					    .setBaseMipLevel( le_cmd->info.dst_miplevel )
 					    .setLevelCount( VK_REMAINING_MIP_LEVELS ) // we want all miplevels to be in transferDstOptimal.
 					    .setBaseArrayLayer( le_cmd->info.dst_array_layer )
-					    .setLayerCount( VK_REMAINING_ARRAY_LAYERS ); // we want the range to encompass all layers
+					    .setLayerCount( 1 ); // only the layer we write to - other layers may hold data from earlier writes
 
 					{
 						vk::BufferMemoryBarrier bufferTransferBarrier;
@@ -5212,9 +5857,9 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 
 						vk::ImageMemoryBarrier imageLayoutToTransferDstOptimal;
 						imageLayoutToTransferDstOptimal
-						    .setSrcAccessMask( {} )                                 // no prior access
+						    .setSrcAccessMask( state_before.visible_access )        // wait for any prior access
 						    .setDstAccessMask( vk::AccessFlagBits::eTransferWrite ) // ready image for transferwrite
-						    .setOldLayout( {} )                                     // from vk::ImageLayout::eUndefined
+						    .setOldLayout( state_before.layout )                    // keep existing contents, unless undefined
 						    .setNewLayout( vk::ImageLayout::eTransferDstOptimal )   // to transfer_dst_optimal
 						    .setSrcQueueFamilyIndex( VK_QUEUE_FAMILY_IGNORED )
 						    .setDstQueueFamilyIndex( VK_QUEUE_FAMILY_IGNORED )
@@ -5222,7 +5867,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 						    .setSubresourceRange( rangeAllRemainingMiplevels );
 
 						cmd.pipelineBarrier(
-						    vk::PipelineStageFlagBits::eHost,
+						    vk::PipelineStageFlagBits::eHost | state_before.write_stage,
 						    vk::PipelineStageFlagBits::eTransfer,
 						    {},
 						    {},
@@ -5272,6 +5917,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 						// layout we applied to the whole mip chain when
 
 						const uint32_t         base_miplevel = le_cmd->info.dst_miplevel;
+						const uint32_t         array_layer   = le_cmd->info.dst_array_layer;
 						vk::ImageMemoryBarrier prepareBlit;
 						prepareBlit
 						    .setSrcAccessMask( vk::AccessFlagBits::eTransferWrite ) // transfer write
@@ -5281,7 +5927,7 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 						    .setSrcQueueFamilyIndex( VK_QUEUE_FAMILY_IGNORED )
 						    .setDstQueueFamilyIndex( VK_QUEUE_FAMILY_IGNORED )
 						    .setImage( dstImage )
-						    .setSubresourceRange( { vk::ImageAspectFlagBits::eColor, base_miplevel, 1, 0, 1 } );
+						    .setSubresourceRange( { vk::ImageAspectFlagBits::eColor, base_miplevel, 1, array_layer, 1 } );
 
 						cmd.pipelineBarrier( vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, { prepareBlit } );
 
@@ -5300,8 +5946,8 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 							auto dstImgWidth  = srcImgWidth > 2 ? srcImgWidth >> 1 : 1;
 							auto dstImgHeight = srcImgHeight > 2 ? srcImgHeight >> 1 : 1;
 
-							vk::ImageSubresourceRange rangeSrcMipLevel( vk::ImageAspectFlagBits::eColor, srcMipLevel, 1, 0, 1 );
-							vk::ImageSubresourceRange rangeDstMipLevel( vk::ImageAspectFlagBits::eColor, dstMipLevel, 1, 0, 1 );
+							vk::ImageSubresourceRange rangeSrcMipLevel( vk::ImageAspectFlagBits::eColor, srcMipLevel, 1, array_layer, 1 );
+							vk::ImageSubresourceRange rangeDstMipLevel( vk::ImageAspectFlagBits::eColor, dstMipLevel, 1, array_layer, 1 );
 
 							vk::ImageBlit region;
 
@@ -5309,8 +5955,8 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 							vk::Offset3D offsetSrc  = { srcImgWidth, srcImgHeight, 1 };
 							vk::Offset3D offsetDst  = { dstImgWidth, dstImgHeight, 1 };
 							region
-							    .setSrcSubresource( { vk::ImageAspectFlagBits::eColor, srcMipLevel, 0, 1 } )
-							    .setDstSubresource( { vk::ImageAspectFlagBits::eColor, dstMipLevel, 0, 1 } )
+							    .setSrcSubresource( { vk::ImageAspectFlagBits::eColor, srcMipLevel, array_layer, 1 } )
+							    .setDstSubresource( { vk::ImageAspectFlagBits::eColor, dstMipLevel, array_layer, 1 } )
 							    .setSrcOffsets( { offsetZero, offsetSrc } )
 							    .setDstOffsets( { offsetZero, offsetDst } )
 							    //
@@ -5386,6 +6032,13 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 						);
 					}
 
+					// Any subsequent write to this image in this pass must wait for the barrier above.
+					written_image_state[ le_cmd->info.dst_image_id ] = {
+					    vk::AccessFlagBits::eShaderRead,
+					    vk::PipelineStageFlagBits::eFragmentShader,
+					    vk::ImageLayout::eShaderReadOnlyOptimal,
+					};
+
 					break;
 				}
 #ifdef LE_FEATURE_RTX
@@ -5601,6 +6254,14 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 			cmd.endRenderPass();
 		}
 
+		if ( passTiming && passTiming->has_pipeline_statistics ) {
+			cmd.endQuery( frame.statisticsQueryPool, uint32_t( passIndex ) );
+		}
+
+		if ( passTiming && passTiming->has_timestamps ) {
+			cmd.writeTimestamp( vk::PipelineStageFlagBits::eBottomOfPipe, frame.timestampQueryPool, uint32_t( 2 * passIndex + 1 ) );
+		}
+
 		if ( should_insert_debug_labels ) {
 			cmd.endDebugUtilsLabelEXT();
 		}
@@ -5609,9 +6270,31 @@ static void backend_process_frame( le_backend_o *self, size_t frameIndex ) {
 	}
 
 	// place command buffer in frame store so that it can be submitted.
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+	frame.commandBuffersComputeWaitIndex = ~size_t( 0 );
+
+	for ( size_t passIndex = 0; passIndex != frame.passes.size(); ++passIndex ) {
+		auto const &pass = frame.passes[ passIndex ];
+		if ( backend_pass_uses_compute_queue( self, pass ) ) {
+			frame.commandBuffersCompute.emplace_back( cmdBufs[ passIndex ] );
+		} else {
+			if ( pass.waitsForAsyncCompute && frame.commandBuffersComputeWaitIndex == ~size_t( 0 ) ) {
+				// First graphics pass which consumes async compute results: this, and all
+				// following command buffers must wait for async compute work to complete.
+				frame.commandBuffersComputeWaitIndex = frame.commandBuffers.size();
+			}
+			frame.commandBuffers.emplace_back( cmdBufs[ passIndex ] );
+		}
+	}
+
+	if ( frame.commandBuffersComputeWaitIndex == ~size_t( 0 ) ) {
+		frame.commandBuffersComputeWaitIndex = frame.commandBuffers.size();
+	}
+#else
 	for ( auto &&c : cmdBufs ) {
 		frame.commandBuffers.emplace_back( c );
 	}
+#endif
 }
 
 // ----------------------------------------------------------------------
@@ -5661,6 +6344,125 @@ static bool backend_dispatch_frame( le_backend_o *self, size_t frameIndex ) {
 
 	auto &frame = self->mFrames[ frameIndex ];
 
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES
+
+	// All passes of this frame are batched into a single submission. The submission
+	// waits on all swapchain images to be acquired, and signals both the binary
+	// semaphores needed for present, and the frame timeline semaphore, which tells
+	// us when this frame may be recycled.
+
+	std::vector<vk::SemaphoreSubmitInfoKHR> wait_semaphore_infos;
+	wait_semaphore_infos.reserve( frame.swapchain_state.size() );
+
+	std::vector<vk::SemaphoreSubmitInfoKHR> signal_semaphore_infos;
+	signal_semaphore_infos.reserve( frame.swapchain_state.size() + 1 );
+
+	std::vector<vk::Semaphore> render_complete_semaphores;
+	render_complete_semaphores.reserve( frame.swapchain_state.size() );
+
+	for ( auto const &swp : frame.swapchain_state ) {
+		wait_semaphore_infos.emplace_back( swp.presentComplete, 0, vk::PipelineStageFlagBits2KHR::eColorAttachmentOutput );
+		signal_semaphore_infos.emplace_back( swp.renderComplete, 0, vk::PipelineStageFlagBits2KHR::eAllCommands );
+		render_complete_semaphores.push_back( swp.renderComplete );
+	}
+
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+	if ( !frame.commandBuffersCompute.empty() ) {
+
+		// -- Submit async compute passes to the compute queue.
+		//
+		// Compute work waits for graphics work of the previously dispatched frame to complete,
+		// as resources used by async compute passes may have been accessed by that frame.
+		// Once complete, compute work signals the compute timeline semaphore, which graphics
+		// passes consuming async compute results wait upon.
+
+		vk::SemaphoreSubmitInfoKHR compute_wait_info( self->frameTimelineSemaphore, self->frameTimelineValue, vk::PipelineStageFlagBits2KHR::eComputeShader );
+
+		frame.computeTimelineValue = ++self->computeTimelineValue;
+
+		vk::SemaphoreSubmitInfoKHR compute_signal_info( self->computeTimelineSemaphore, frame.computeTimelineValue, vk::PipelineStageFlagBits2KHR::eAllCommands );
+
+		std::vector<vk::CommandBufferSubmitInfoKHR> compute_command_buffer_infos;
+		compute_command_buffer_infos.reserve( frame.commandBuffersCompute.size() );
+
+		for ( auto const &c : frame.commandBuffersCompute ) {
+			compute_command_buffer_infos.emplace_back( c );
+		}
+
+		vk::SubmitInfo2KHR computeSubmitInfo;
+		computeSubmitInfo
+		    .setWaitSemaphoreInfoCount( 1 )
+		    .setPWaitSemaphoreInfos( &compute_wait_info )
+		    .setCommandBufferInfoCount( uint32_t( compute_command_buffer_infos.size() ) )
+		    .setPCommandBufferInfos( compute_command_buffer_infos.data() )
+		    .setSignalSemaphoreInfoCount( 1 )
+		    .setPSignalSemaphoreInfos( &compute_signal_info );
+
+		auto computeQueue = vk::Queue{ self->device->getDefaultComputeQueue() };
+
+		computeQueue.submit2KHR( { computeSubmitInfo }, nullptr );
+	}
+#endif
+
+	frame.frameTimelineValue = ++self->frameTimelineValue;
+
+	signal_semaphore_infos.emplace_back( self->frameTimelineSemaphore, frame.frameTimelineValue, vk::PipelineStageFlagBits2KHR::eAllCommands );
+
+	std::vector<vk::CommandBufferSubmitInfoKHR> command_buffer_infos;
+	command_buffer_infos.reserve( frame.commandBuffers.size() );
+
+	for ( auto const &c : frame.commandBuffers ) {
+		command_buffer_infos.emplace_back( c );
+	}
+
+	auto queue = vk::Queue{ self->device->getDefaultGraphicsQueue() };
+
+#ifdef LE_FEATURE_ASYNC_COMPUTE
+	if ( !frame.commandBuffersCompute.empty() ) {
+
+		// -- Split graphics work into two batches: passes before the first pass which
+		// consumes async compute results may overlap with compute work, all other passes
+		// must wait for async compute work to complete. The second batch signals frame
+		// completion - since compute work has completed by then, the frame timeline
+		// semaphore covers async compute work, too.
+
+		vk::SemaphoreSubmitInfoKHR graphics_wait_compute_info( self->computeTimelineSemaphore, frame.computeTimelineValue, vk::PipelineStageFlagBits2KHR::eAllCommands );
+
+		auto const numCommandBuffersBeforeWait = uint32_t( frame.commandBuffersComputeWaitIndex );
+
+		std::array<vk::SubmitInfo2KHR, 2> submitInfos;
+		submitInfos[ 0 ]
+		    .setWaitSemaphoreInfoCount( uint32_t( wait_semaphore_infos.size() ) )
+		    .setPWaitSemaphoreInfos( wait_semaphore_infos.data() )
+		    .setCommandBufferInfoCount( numCommandBuffersBeforeWait )
+		    .setPCommandBufferInfos( command_buffer_infos.data() );
+		submitInfos[ 1 ]
+		    .setWaitSemaphoreInfoCount( 1 )
+		    .setPWaitSemaphoreInfos( &graphics_wait_compute_info )
+		    .setCommandBufferInfoCount( uint32_t( command_buffer_infos.size() ) - numCommandBuffersBeforeWait )
+		    .setPCommandBufferInfos( command_buffer_infos.data() + numCommandBuffersBeforeWait )
+		    .setSignalSemaphoreInfoCount( uint32_t( signal_semaphore_infos.size() ) )
+		    .setPSignalSemaphoreInfos( signal_semaphore_infos.data() );
+
+		queue.submit2KHR( submitInfos, nullptr );
+
+	} else
+#endif
+	{
+		vk::SubmitInfo2KHR submitInfo;
+		submitInfo
+		    .setWaitSemaphoreInfoCount( uint32_t( wait_semaphore_infos.size() ) )
+		    .setPWaitSemaphoreInfos( wait_semaphore_infos.data() )
+		    .setCommandBufferInfoCount( uint32_t( command_buffer_infos.size() ) )
+		    .setPCommandBufferInfos( command_buffer_infos.data() )
+		    .setSignalSemaphoreInfoCount( uint32_t( signal_semaphore_infos.size() ) )
+		    .setPSignalSemaphoreInfos( signal_semaphore_infos.data() );
+
+		queue.submit2KHR( { submitInfo }, nullptr );
+	}
+
+#else
+
 	std::vector<::vk::PipelineStageFlags> wait_dst_stage_mask(
 	    frame.swapchain_state.size(), { vk::PipelineStageFlagBits::eColorAttachmentOutput } );
 
@@ -5689,6 +6491,8 @@ static bool backend_dispatch_frame( le_backend_o *self, size_t frameIndex ) {
 
 	queue.submit( { submitInfo }, frame.frameFence );
 
+#endif
+
 	using namespace le_swapchain_vk;
 
 	bool overall_result = true;
@@ -5775,6 +6579,7 @@ LE_MODULE_REGISTER_IMPL( le_backend_vk, api_ ) {
 	vk_backend_i.acquire_physical_resources = backend_acquire_physical_resources;
 	vk_backend_i.process_frame              = backend_process_frame;
 	vk_backend_i.dispatch_frame             = backend_dispatch_frame;
+	vk_backend_i.get_frame_pass_timings     = backend_get_frame_pass_timings;
 
 	vk_backend_i.get_pipeline_cache    = backend_get_pipeline_cache;
 	vk_backend_i.update_shader_modules = backend_update_shader_modules;
@@ -71,6 +71,7 @@ struct LeShaderSourceLanguageEnum;
 struct VkFormatEnum; // wrapper around `vk::Format`. Defined in <le_backend_types_internal.h>
 
 struct le_resource_info_t;
+struct le_renderpass_timing_t;
 
 struct le_backend_vk_settings_t {
 	const char **            requestedInstanceExtensions    = nullptr;
@@ -80,6 +81,8 @@ struct le_backend_vk_settings_t {
 	uint32_t                 concurrency_count              = 1;       // number of potential worker threads
 	le_swapchain_settings_t *pSwapchain_settings            = nullptr; // non-owning, owned by caller of setup method.
 	uint32_t                 num_swapchain_settings         = 1;       // must be set by caller of setup method - tells us how many pSwapchain_settings to expect.
+	bool                     enable_gpu_timestamps          = false;   // write gpu timestamps before and after each renderpass
+	bool                     enable_gpu_pipeline_statistics = false;   // query pipeline statistics for each renderpass - only if enable_gpu_timestamps, and if supported by the device
 };
 
 struct le_pipeline_layout_info {
@@ -109,6 +112,9 @@ struct le_backend_vk_api {
 		bool                   ( *acquire_physical_resources ) ( le_backend_o *self, size_t frameIndex, le_renderpass_o **passes, size_t numRenderPasses, le_resource_handle const * declared_resources, le_resource_info_t const * declared_resources_infos, size_t const & declared_resources_count );
 		bool                   ( *dispatch_frame             ) ( le_backend_o *self, size_t frameIndex );
 
+		/// Returns gpu profiling results for all passes of frame at frameIndex - only valid between clear_frame and the next process_frame for this frameIndex.
+		bool                   ( *get_frame_pass_timings     ) ( le_backend_o *self, size_t frameIndex, le_renderpass_timing_t const ** timings, uint32_t* timings_count );
+
 		size_t                 ( *get_num_swapchain_images   ) ( le_backend_o *self );
 		void                   ( *reset_swapchain            ) ( le_backend_o *self, uint32_t index );
 		void                   ( *reset_failed_swapchains    ) ( le_backend_o *self );
@@ -171,7 +177,7 @@ struct le_backend_vk_api {
 	};
 
 	struct device_interface_t {
-		le_device_o *               ( *create                                  ) ( le_backend_vk_instance_o* instance_, const char **extension_names, uint32_t extension_names_count );
+		le_device_o *               ( *create                                  ) ( le_backend_vk_instance_o* instance_, const char **extension_names, uint32_t extension_names_count, bool request_pipeline_statistics_query );
 		void                        ( *destroy                                 ) ( le_device_o* self_ );
 
 		le_device_o *			    ( *decrease_reference_count                ) ( le_device_o* self_ );
@@ -186,6 +192,7 @@ struct le_backend_vk_api {
 		VkPhysicalDevice_T*         ( *get_vk_physical_device                  ) ( le_device_o* self_ );
 		VkDevice_T*                 ( *get_vk_device                           ) ( le_device_o* self_ );
 		bool                        ( *is_extension_available                  ) ( le_device_o* self, char const * extension_name);
+		bool                        ( *is_pipeline_statistics_query_enabled    ) ( le_device_o* self ); // false unless requested at create, and supported by the physical device
 
 		const VkPhysicalDeviceProperties&       ( *get_vk_physical_device_properties        ) ( le_device_o* self );
 		const VkPhysicalDeviceMemoryProperties& ( *get_vk_physical_device_memory_properties ) ( le_device_o* self );
@@ -322,8 +329,8 @@ class Device : NoCopy, NoMove {
 	le_device_o *self = nullptr;
 
   public:
-	Device( le_backend_vk_instance_o *instance_, const char **extension_names, uint32_t extension_names_count )
-	    : self( le_backend_vk::vk_device_i.create( instance_, extension_names, extension_names_count ) ) {
+	Device( le_backend_vk_instance_o *instance_, const char **extension_names, uint32_t extension_names_count, bool requestPipelineStatisticsQuery = false )
+	    : self( le_backend_vk::vk_device_i.create( instance_, extension_names, extension_names_count, requestPipelineStatisticsQuery ) ) {
 		le_backend_vk::vk_device_i.increase_reference_count( self );
 	}
 
@@ -376,6 +383,10 @@ class Device : NoCopy, NoMove {
 		return le_backend_vk::vk_device_i.is_extension_available( self, extensionName );
 	}
 
+	bool isPipelineStatisticsQueryEnabled() const {
+		return le_backend_vk::vk_device_i.is_pipeline_statistics_query_enabled( self );
+	}
+
 	operator auto() {
 		return self;
 	}
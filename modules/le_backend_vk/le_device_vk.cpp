@@ -40,6 +40,8 @@ struct le_device_o {
 
 	std::set<std::string> requestedDeviceExtensions;
 
+	bool pipelineStatisticsQueryEnabled = false; // only if requested, and supported by the physical device
+
 	DefaultQueueIndices defaultQueueIndices;
 	vk::Format          defaultDepthStencilFormat;
 
@@ -156,7 +158,7 @@ std::vector<std::tuple<uint32_t, uint32_t, size_t>> findBestMatchForRequestedQue
 
 // ----------------------------------------------------------------------
 
-le_device_o *device_create( le_backend_vk_instance_o *instance_, const char **extension_names, uint32_t extension_names_count ) {
+le_device_o *device_create( le_backend_vk_instance_o *instance_, const char **extension_names, uint32_t extension_names_count, bool request_pipeline_statistics_query ) {
 
 	static auto logger = LeLog( LOGGER_LABEL );
 
@@ -255,6 +257,16 @@ le_device_o *device_create( le_backend_vk_instance_o *instance_, const char **ex
 		}
 	}
 
+	// Optional features may only be enabled if the physical device supports them.
+
+	vk::PhysicalDeviceFeatures const availableFeatures = self->vkPhysicalDevice.getFeatures();
+
+	self->pipelineStatisticsQueryEnabled = request_pipeline_statistics_query && availableFeatures.pipelineStatisticsQuery;
+
+	if ( request_pipeline_statistics_query && !self->pipelineStatisticsQueryEnabled ) {
+		logger.warn( "Pipeline statistics queries were requested, but are not supported by this device." );
+	}
+
 	// Vulkan >= 1.2  has per-version structs
 
 	vk::StructureChain<
@@ -269,6 +281,10 @@ le_device_o *device_create( le_backend_vk_instance_o *instance_, const char **ex
 #ifdef LE_FEATURE_RTX
 	    ,
 	    vk::PhysicalDeviceMeshShaderFeaturesNV // Optional, based on #define
+#endif
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES
+	    ,
+	    vk::PhysicalDeviceSynchronization2FeaturesKHR // Optional, based on #define
 #endif
 	    >
 	    featuresChain{};
@@ -284,6 +300,8 @@ le_device_o *device_create( le_backend_vk_instance_o *instance_, const char **ex
 	                      .setGeometryShader( true )    // we want geometry shaders
 	                      .setShaderInt16( true )       //
 	                      .setShaderFloat64( true )     //
+	                      // allow per-renderpass pipeline statistics queries (gpu profiler)
+	                      .setPipelineStatisticsQuery( self->pipelineStatisticsQueryEnabled )
 	    );
 
 #ifdef LE_FEATURE_RTX
@@ -316,6 +334,18 @@ le_device_o *device_create( le_backend_vk_instance_o *instance_, const char **ex
 	    ;
 #endif
 
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES
+
+	// Frames are tracked via a single timeline semaphore, and all passes
+	// of a frame are submitted with a single call to vkQueueSubmit2KHR.
+
+	featuresChain.get<vk::PhysicalDeviceVulkan12Features>()
+	    .setTimelineSemaphore( true );
+
+	featuresChain.get<vk::PhysicalDeviceSynchronization2FeaturesKHR>()
+	    .setSynchronization2( true );
+#endif
+
 	//ms I had to disable this on my nvidia 1070 as it was failing
 	featuresChain.get<vk::PhysicalDeviceVulkan12Features>()
 	    //    .setShaderInt8( true )
@@ -526,6 +556,12 @@ static bool device_is_extension_available( le_device_o *self, char const *extens
 
 // ----------------------------------------------------------------------
 
+static bool device_is_pipeline_statistics_query_enabled( le_device_o *self ) {
+	return self->pipelineStatisticsQueryEnabled;
+}
+
+// ----------------------------------------------------------------------
+
 // ----------------------------------------------------------------------
 
 void register_le_device_vk_api( void *api_ ) {
@@ -549,4 +585,5 @@ void register_le_device_vk_api( void *api_ ) {
 	device_i.get_vk_physical_device_ray_tracing_properties = device_get_physical_device_ray_tracing_properties;
 	device_i.get_memory_allocation_info                    = device_get_memory_allocation_info;
 	device_i.is_extension_available                        = device_is_extension_available;
+	device_i.is_pipeline_statistics_query_enabled          = device_is_pipeline_statistics_query_enabled;
 }
@@ -101,6 +101,11 @@ DECLARE_EXT_PFN( vkCmdDrawMeshTasksIndirectNV );
 DECLARE_EXT_PFN( vkCmdDrawMeshTasksIndirectCountNV );
 #endif
 
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES
+// device extensions for single-submit frame dispatch
+DECLARE_EXT_PFN( vkQueueSubmit2KHR );
+#endif
+
 #undef DECLARE_EXT_PFN
 
 // ----------------------------------------------------------------------
@@ -162,6 +167,11 @@ static void patchExtProcAddrs( le_backend_vk_instance_o *obj ) {
 	GET_EXT_PROC_ADDR( vkCmdDrawMeshTasksIndirectCountNV );
 #endif
 
+	// device extensions for synchronization2
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES
+	GET_EXT_PROC_ADDR( vkQueueSubmit2KHR );
+#endif
+
 #undef GET_EXT_PROC_ADDR
 
 	static auto logger = LeLog( LOGGER_LABEL );
@@ -335,6 +345,17 @@ VKAPI_ATTR void VKAPI_CALL vkCmdDrawMeshTasksIndirectCountNV(
 	pfn_vkCmdDrawMeshTasksIndirectCountNV( commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride );
 }
 #endif
+
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES // synchronization2 method prototypes
+
+VKAPI_ATTR VkResult VKAPI_CALL vkQueueSubmit2KHR(
+    VkQueue                 queue,
+    uint32_t                submitCount,
+    const VkSubmitInfo2KHR *pSubmits,
+    VkFence                 fence ) {
+	return pfn_vkQueueSubmit2KHR( queue, submitCount, pSubmits, fence );
+}
+#endif
 // ----------------------------------------------------------------------
 
 //static void create_debug_messenger_callback( le_backend_vk_instance_o *obj );  // ffdecl.
@@ -438,6 +459,9 @@ static void destroy_debug_messenger_callback( le_backend_vk_instance_o *obj ) {
 le_backend_vk_instance_o *instance_create( const char **extensionNamesArray_, uint32_t numExtensionNames_ ) {
 
 	static_assert( VK_HEADER_VERSION >= 162, "Wrong VK_HEADER_VERSION!" );
+#ifdef LE_FEATURE_TIMELINE_SEMAPHORES
+	static_assert( VK_HEADER_VERSION >= 170, "LE_FEATURE_TIMELINE_SEMAPHORES requires VK_KHR_synchronization2, VK_HEADER_VERSION must be >= 170" );
+#endif
 
 	auto        self   = new le_backend_vk_instance_o();
 	static auto logger = LeLog( LOGGER_LABEL );
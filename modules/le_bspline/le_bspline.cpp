@@ -4,26 +4,56 @@
 /* B-Spline methods
  *
  * Implementation based on <https://github.com/thibauts/b-spline/>
+ *
+ * Only degree+1 control points influence any point on the curve: those of
+ * the knot span which contains the point's parameter t. We therefore trace
+ * the curve span by span: all samples of a span share the same local
+ * control points, which we evaluate in batches, lane by lane, so that the
+ * compiler may vectorise de Boor's algorithm over a batch.
+ *
+ * Tracing keeps track of which polyline vertices belong to which knot span,
+ * so that if only some control points change (see update_points), we only
+ * need to trace again the spans these control points influence.
+ *
  */
 
 #include <vector>
+#include <algorithm>
+#include <math.h>
 #include "glm/glm.hpp"
 #include <iostream>
 #include <iomanip>
 
 using Vertex = glm::vec2;
 
+static constexpr uint32_t LE_BSPLINE_MAX_DEGREE        = 15;    // local control points for one sample must fit on the stack
+static constexpr size_t   LE_BSPLINE_BATCH_SIZE        = 8;     // number of samples which we evaluate together
+static constexpr size_t   LE_BSPLINE_MAX_SPAN_SEGMENTS = 256;   // upper limit for segments per knot span for adaptive tracing
+static constexpr float    LE_BSPLINE_MIN_TOLERANCE     = 1e-6f; // lower limit for tolerance for adaptive tracing
+
 struct le_bspline_o {
 	uint32_t degree = 1; // must be at least 1
 
-	uint16_t dirty  = 1;
+	uint16_t dirty  = 1; // whether the polyline must be traced again in full
 	uint16_t closed = 0;
 
 	std::vector<float>  knots;
 	std::vector<Vertex> points;
 	std::vector<float>  weight;
 
-	std::vector<Vertex> polyline;
+	bool knots_are_default = false; // whether knots were generated by trace, and must be generated again if the number of points changes
+
+	std::vector<glm::vec3> homogeneous; // control points as homogeneous coordinates (x*w, y*w, w), wrapped around if closed
+
+	size_t dirty_spans_begin = 0; // range of knot spans which must be traced again, because some control points changed
+	size_t dirty_spans_end   = 0; // empty range means no knot spans need tracing
+
+	size_t trace_resolution = 0;  // resolution of most recent trace, 0 if most recent trace was adaptive, or none
+	float  trace_tolerance  = 0;  // tolerance of most recent adaptive trace
+
+	std::vector<Vertex>   polyline;
+	std::vector<uint32_t> span_first_vertex; // index of first polyline vertex for each knot span in the domain, followed by polyline size
+	std::vector<Vertex>   scratch;           // used to splice polyline when knot spans are traced again adaptively
 };
 
 // ----------------------------------------------------------------------
@@ -42,31 +72,58 @@ static void le_bspline_destroy( le_bspline_o *self ) {
 
 static void le_bspline_set_degree( le_bspline_o *self, uint32_t degree ) {
 	self->degree = degree;
+	self->dirty  = 1;
 }
 
 // ----------------------------------------------------------------------
 static void le_bspline_set_closed( le_bspline_o *self, bool closed ) {
 	self->closed = closed;
+	self->dirty  = 1;
 }
 // ----------------------------------------------------------------------
 static void le_bspline_set_points( le_bspline_o *self, Vertex const *points, size_t const num_points ) {
 	self->points = { points, points + num_points };
+	self->dirty  = 1;
 }
 
 // ----------------------------------------------------------------------
 static void le_bspline_set_knots( le_bspline_o *self, float const *knots, size_t const num_knots ) {
-	self->knots = { knots, knots + num_knots };
+	self->knots             = { knots, knots + num_knots };
+	self->knots_are_default = false;
+	self->dirty             = 1;
 }
 
 // ----------------------------------------------------------------------
 static void le_bspline_set_weights( le_bspline_o *self, float const *weights, size_t const num_weights ) {
 	self->weight = { weights, weights + num_weights };
+	self->dirty  = 1;
 }
 
 // ----------------------------------------------------------------------
-static bool le_bspline_trace( le_bspline_o *self, size_t resolution ) {
+// Returns the range of knot spans [begin, end) over which the curve is defined.
+static void bspline_get_domain( le_bspline_o const *self, size_t *begin, size_t *end ) {
+	*begin = self->degree;
+	*end   = self->knots.size() - ( self->degree + 1 );
+}
 
-	assert( resolution > 1 ); // resolution must be at least 2, otherwise we cannot cover at least start and endpoint.
+// ----------------------------------------------------------------------
+// Updates homogeneous coordinates for control point i. If the curve is
+// closed, the first degree+1 control points appear twice.
+static void bspline_update_homogeneous( le_bspline_o *self, size_t i ) {
+	float const   w = self->weight.empty() ? 1.f : self->weight[ i ];
+	Vertex const &p = self->points[ i ];
+
+	self->homogeneous[ i ] = { p.x * w, p.y * w, w };
+
+	if ( self->closed && i <= self->degree ) {
+		self->homogeneous[ i + self->points.size() ] = self->homogeneous[ i ];
+	}
+}
+
+// ----------------------------------------------------------------------
+// Validates parameters, generates default knots if needed, and calculates
+// homogeneous coordinates for all control points.
+static bool bspline_prepare( le_bspline_o *self ) {
 
 	size_t n = self->points.size();
 
@@ -75,21 +132,21 @@ static bool le_bspline_trace( le_bspline_o *self, size_t resolution ) {
 		return false;
 	}
 
-	if ( self->degree > ( n - 1 ) ) {
+	if ( self->degree > LE_BSPLINE_MAX_DEGREE ) {
+		assert( false ); // degree must not be larger than LE_BSPLINE_MAX_DEGREE
+		return false;
+	}
+
+	if ( n == 0 || self->degree > ( n - 1 ) ) {
 		assert( false ); // degree must be less or equal to point count -1
 		return false;
 	}
 
-	// Initialise weights to 1 if no weights given.
-	// must have one weight per point
-	if ( self->weight.empty() ) {
-		self->weight = std::vector<float>( n, 1.f );
-	} else {
-		// Ensure that a weight is given for each point
-		if ( self->weight.size() != self->points.size() ) {
-			assert( false );
-			return false;
-		}
+	// If no weights are given, all weights are 1.
+	// Otherwise, there must be one weight per point.
+	if ( !self->weight.empty() && self->weight.size() != n ) {
+		assert( false );
+		return false;
 	}
 
 	// Initisalise knots if not given, check number
@@ -98,11 +155,13 @@ static bool le_bspline_trace( le_bspline_o *self, size_t resolution ) {
 		// If closed, add a second helping of (degree+1) to number of knots
 		size_t numKnots = n + ( self->degree + 1 ) * ( self->closed ? 2 : 1 );
 
-		if ( self->knots.empty() ) {
+		if ( self->knots.empty() || self->knots_are_default ) {
+			self->knots.clear();
 			self->knots.reserve( numKnots );
 			for ( size_t i = 0; i != numKnots; i++ ) {
 				self->knots.push_back( i );
 			}
+			self->knots_are_default = true;
 		} else {
 			// must ensure that number of knots is correct
 			if ( self->knots.size() != numKnots ) {
@@ -113,64 +172,404 @@ static bool le_bspline_trace( le_bspline_o *self, size_t resolution ) {
 	}
 	// ---------| invariant: number of knots is number of points + degree + 1
 
-	size_t domain[ 2 ] = { self->degree, self->knots.size() - ( self->degree + 1 ) };
-	float  low         = self->knots[ domain[ 0 ] ];
-	float  high        = self->knots[ domain[ 1 ] - 1 ];
+	self->homogeneous.resize( n + ( self->closed ? self->degree + 1 : 0 ) );
 
-	self->polyline.clear();
+	for ( size_t i = 0; i != n; i++ ) {
+		bspline_update_homogeneous( self, i );
+	}
 
-	size_t s = domain[ 0 ]; // current segment
-	for ( size_t r = 0; r < resolution; r++ ) {
+	return true;
+}
 
-		// homogenous coordinates for points
-		std::vector<glm::vec3> v;
+// ----------------------------------------------------------------------
+// Evaluates the curve for up to LE_BSPLINE_BATCH_SIZE parameters ts, which
+// must all lie within knot span s, using de Boor's algorithm.
+//
+// We only ever look at the degree+1 control points which influence span s,
+// and keep the pyramid for all samples of a batch on the stack, one lane per
+// sample, so that each step may operate on all lanes at once.
+static void bspline_evaluate_batch( le_bspline_o const *self, size_t s, float const *ts, size_t count, Vertex *result ) {
+
+	constexpr size_t N = LE_BSPLINE_BATCH_SIZE;
+
+	size_t const degree = self->degree;
+	float const *knots  = self->knots.data();
+
+	float t[ N ];
+	float x[ LE_BSPLINE_MAX_DEGREE + 1 ][ N ];
+	float y[ LE_BSPLINE_MAX_DEGREE + 1 ][ N ];
+	float w[ LE_BSPLINE_MAX_DEGREE + 1 ][ N ];
+
+	// Unused lanes repeat the last sample, so that all lanes hold valid numbers.
+	for ( size_t lane = 0; lane != N; lane++ ) {
+		t[ lane ] = ts[ std::min( lane, count - 1 ) ];
+	}
 
-		// Create homogenous coordinates for each point
-		{
+	glm::vec3 const *local = self->homogeneous.data() + ( s - degree );
 
-			const size_t numPoints     = self->points.size();
-			size_t       numIterations = numPoints;
-			if ( self->closed ) {
-				numIterations += self->degree + 1;
-			}
+	for ( size_t j = 0; j <= degree; j++ ) {
+		for ( size_t lane = 0; lane != N; lane++ ) {
+			x[ j ][ lane ] = local[ j ].x;
+			y[ j ][ lane ] = local[ j ].y;
+			w[ j ][ lane ] = local[ j ].z;
+		}
+	}
 
-			v.reserve( numIterations );
-			for ( size_t i = 0; i != numIterations; ++i ) {
-				auto &p = self->points[ i % numPoints ];
-				auto &w = self->weight[ i % numPoints ];
-				v.emplace_back( p.x * w, p.y * w, w );
+	// l (level) goes from 1 to the curve degree - local point j corresponds to
+	// control point i = s - degree + j.
+	for ( size_t l = 1; l <= degree; ++l ) {
+		// build level l of the pyramid
+		for ( size_t j = degree; j >= l; j-- ) {
+			size_t const i = s - degree + j;
+
+			float const knot  = knots[ i ];
+			float const range = knots[ i + degree + 1 - l ] - knot;
+			float const scale = range != 0.f ? 1.f / range : 0.f; // repeated knots must not produce NaNs
+
+			for ( size_t lane = 0; lane != N; lane++ ) {
+				float const alpha = ( t[ lane ] - knot ) * scale;
+				x[ j ][ lane ]    = ( 1.f - alpha ) * x[ j - 1 ][ lane ] + alpha * x[ j ][ lane ];
+				y[ j ][ lane ]    = ( 1.f - alpha ) * y[ j - 1 ][ lane ] + alpha * y[ j ][ lane ];
+				w[ j ][ lane ]    = ( 1.f - alpha ) * w[ j - 1 ][ lane ] + alpha * w[ j ][ lane ];
 			}
 		}
+	}
+
+	// Convert back (unproject homogenous coordinates) and store in output.
+
+	for ( size_t lane = 0; lane != count; lane++ ) {
+		result[ lane ] = { x[ degree ][ lane ] / w[ degree ][ lane ],
+		                   y[ degree ][ lane ] / w[ degree ][ lane ] };
+	}
+}
+
+// ----------------------------------------------------------------------
+// Evaluates the curve at evenly spaced parameters t = lerp(t0, t1, i / num_segments)
+// for i in [first, last[ - all parameters must lie within knot span s.
+static void bspline_evaluate_span( le_bspline_o const *self, size_t s, float t0, float t1, size_t num_segments, size_t first, size_t last, Vertex *result ) {
+	float ts[ LE_BSPLINE_BATCH_SIZE ];
+
+	for ( size_t i = first; i < last; i += LE_BSPLINE_BATCH_SIZE ) {
+		size_t const count = std::min( LE_BSPLINE_BATCH_SIZE, last - i );
+		for ( size_t k = 0; k != count; k++ ) {
+			float const u = float( i + k ) / float( num_segments );
+			ts[ k ]       = u * ( t1 - t0 ) + t0;
+		}
+		bspline_evaluate_batch( self, s, ts, count, result + ( i - first ) );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Evaluates polyline vertices [first, last[ for a trace with uniform resolution -
+// all vertices must lie within knot span s.
+static void bspline_evaluate_uniform( le_bspline_o *self, size_t s, size_t first, size_t last, float low, float high ) {
+	size_t const resolution = self->polyline.size();
+
+	float ts[ LE_BSPLINE_BATCH_SIZE ];
+
+	for ( size_t r = first; r < last; r += LE_BSPLINE_BATCH_SIZE ) {
+		size_t const count = std::min( LE_BSPLINE_BATCH_SIZE, last - r );
+		for ( size_t k = 0; k != count; k++ ) {
+			float t = float( r + k ) / float( resolution - 1 );
+			ts[ k ] = t * ( high - low ) + low; // map t to domain
+		}
+		bspline_evaluate_batch( self, s, ts, count, self->polyline.data() + r );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Returns the parameter range [t0, t1] of knot span s which lies within [low, high].
+// Returns false if this range is empty.
+static bool bspline_get_span_range( le_bspline_o const *self, size_t s, float low, float high, float *t0, float *t1 ) {
+	*t0 = std::max( self->knots[ s ], low );
+	*t1 = std::min( self->knots[ s + 1 ], high );
+	return *t0 < *t1;
+}
+
+// ----------------------------------------------------------------------
+// Returns the number of segments needed so that the chords for knot span s
+// deviate from the curve by no more than tolerance.
+//
+// A chord over a parameter interval of length h deviates from the curve by at
+// most h^2 * max|C''| / 8. The second derivative of a B-spline is itself a
+// B-spline with control points given by second differences of the control
+// points, which bound |C''|. For rational curves, we estimate using projected
+// control points, and scale the estimate by the ratio of largest to smallest
+// weight, as uneven weights bunch up the curve.
+static size_t bspline_get_span_segment_count( le_bspline_o const *self, size_t s, float t0, float t1, float tolerance ) {
+
+	size_t const degree = self->degree;
+
+	if ( degree < 2 ) {
+		return 1; // a span of a degree 1 curve is a straight line
+	}
+
+	float const *knots = self->knots.data();
+
+	// First derivative control points
+	Vertex d[ LE_BSPLINE_MAX_DEGREE ];
+
+	float min_weight = self->homogeneous[ s - degree ].z;
+	float max_weight = min_weight;
+
+	for ( size_t i = s - degree + 1; i <= s; i++ ) {
+		min_weight = std::min( min_weight, self->homogeneous[ i ].z );
+		max_weight = std::max( max_weight, self->homogeneous[ i ].z );
+	}
+
+	for ( size_t j = 0; j != degree; j++ ) {
+		size_t const     i     = s - degree + j;
+		glm::vec3 const &p0    = self->homogeneous[ i ];
+		glm::vec3 const &p1    = self->homogeneous[ i + 1 ];
+		float const      range = knots[ i + degree + 1 ] - knots[ i + 1 ];
+		Vertex const     delta = Vertex( p1.x / p1.z, p1.y / p1.z ) - Vertex( p0.x / p0.z, p0.y / p0.z );
+		d[ j ]                 = range != 0.f ? delta * ( float( degree ) / range ) : Vertex( 0 );
+	}
+
+	// Second derivative control points bound the second derivative over this span.
+	float max_second_derivative = 0.f;
+
+	for ( size_t j = 0; j + 1 != degree; j++ ) {
+		size_t const i     = s - degree + j;
+		float const  range = knots[ i + degree + 1 ] - knots[ i + 2 ];
+		if ( range != 0.f ) {
+			max_second_derivative = std::max( max_second_derivative, glm::length( d[ j + 1 ] - d[ j ] ) * float( degree - 1 ) / range );
+		}
+	}
+
+	if ( min_weight > 0.f ) {
+		max_second_derivative *= max_weight / min_weight;
+	}
+
+	float const segments = ( t1 - t0 ) * sqrtf( max_second_derivative / ( 8.f * tolerance ) );
+
+	return std::min( std::max( size_t( ceilf( segments ) ), size_t( 1 ) ), LE_BSPLINE_MAX_SPAN_SEGMENTS );
+}
+
+// ----------------------------------------------------------------------
+// Appends vertices for knot span s to `polyline`, for an adaptive trace. Each span
+// contributes its start vertex, and interior vertices - the span which ends the
+// curve also contributes the end vertex of the curve.
+static void bspline_trace_span_adaptive( le_bspline_o const *self, size_t s, float low, float high, float tolerance, std::vector<Vertex> &polyline ) {
+	float t0, t1;
+
+	size_t num_segments;
+	size_t num_vertices;
+
+	if ( bspline_get_span_range( self, s, low, high, &t0, &t1 ) ) {
+		num_segments = bspline_get_span_segment_count( self, s, t0, t1, tolerance );
+		num_vertices = num_segments + ( t1 == high ? 1 : 0 );
+	} else if ( low == high && s == self->degree ) {
+		// Domain is a single point - just as trace does, we emit the curve at this point.
+		num_segments = 1;
+		num_vertices = 1;
+	} else {
+		return;
+	}
+
+	size_t const offset = polyline.size();
+	polyline.resize( offset + num_vertices );
+
+	bspline_evaluate_span( self, s, t0, t1, num_segments, 0, num_vertices, polyline.data() + offset );
+}
+
+// ----------------------------------------------------------------------
+// Traces the curve with `resolution` samples evenly spaced over its domain.
+static bool le_bspline_trace( le_bspline_o *self, size_t resolution ) {
+
+	assert( resolution > 1 ); // resolution must be at least 2, otherwise we cannot cover at least start and endpoint.
+
+	if ( self->dirty ) {
+		if ( !bspline_prepare( self ) ) {
+			return false;
+		}
+	}
+
+	size_t domain[ 2 ];
+	bspline_get_domain( self, &domain[ 0 ], &domain[ 1 ] );
+
+	float low  = self->knots[ domain[ 0 ] ];
+	float high = self->knots[ domain[ 1 ] - 1 ];
+
+	if ( !self->dirty && self->trace_resolution == resolution ) {
+
+		// Polyline is still valid, apart from knot spans influenced by control
+		// points which changed - these keep their vertices, we only need to
+		// evaluate them again.
+
+		for ( size_t s = self->dirty_spans_begin; s < self->dirty_spans_end; s++ ) {
+			size_t const span = s - domain[ 0 ];
+			bspline_evaluate_uniform( self, s, self->span_first_vertex[ span ], self->span_first_vertex[ span + 1 ], low, high );
+		}
+
+		self->dirty_spans_begin = self->dirty_spans_end = 0;
+		return true;
+	}
+
+	// --------| invariant: we must trace the full curve
+
+	self->polyline.resize( resolution );
+	self->span_first_vertex.resize( domain[ 1 ] - domain[ 0 ] + 1 );
+
+	size_t r = 0; // current sample
 
-		float t = float( r ) / float( resolution - 1 );
-		t       = t * ( high - low ) + low; // map t to domain
+	for ( size_t s = domain[ 0 ]; s != domain[ 1 ]; s++ ) {
 
-		for ( ; s < domain[ 1 ]; ) {
-			if ( t >= self->knots[ s ] && t <= self->knots[ s + 1 ] ) {
+		// Find all samples which lie within this knot span - samples on the border
+		// between two spans belong to the first span.
+		size_t r_end = r;
+
+		while ( r_end != resolution ) {
+			float t = float( r_end ) / float( resolution - 1 );
+			t       = t * ( high - low ) + low; // map t to domain
+			if ( t > self->knots[ s + 1 ] && s + 1 != domain[ 1 ] ) {
 				break;
 			}
-			s++;
+			r_end++;
 		}
 
-		// l (level) goes from 1 to the curve degree + 1
-		for ( size_t l = 1; l <= self->degree + 1; ++l ) {
-			// build level l of the pyramid
-			for ( size_t i = s; i > ( s - self->degree - 1 + l ); i-- ) {
-				float alpha = ( t - self->knots[ i ] ) /
-				              ( self->knots[ i + self->degree + 1 - l ] - self->knots[ i ] );
-				v[ i ] = ( 1.f - alpha ) * v[ i - 1 ] + alpha * v[ i ];
-			}
+		self->span_first_vertex[ s - domain[ 0 ] ] = uint32_t( r );
+
+		bspline_evaluate_uniform( self, s, r, r_end, low, high );
+
+		r = r_end;
+	}
+
+	self->span_first_vertex.back() = uint32_t( resolution );
+
+	self->dirty             = 0;
+	self->dirty_spans_begin = self->dirty_spans_end = 0;
+	self->trace_resolution  = resolution;
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Traces the curve so that the polyline deviates from the curve by no more
+// than tolerance: spans which curve strongly receive more vertices.
+static bool le_bspline_trace_adaptive( le_bspline_o *self, float tolerance ) {
+
+	tolerance = std::max( tolerance, LE_BSPLINE_MIN_TOLERANCE );
+
+	if ( self->dirty ) {
+		if ( !bspline_prepare( self ) ) {
+			return false;
+		}
+	}
+
+	size_t domain[ 2 ];
+	bspline_get_domain( self, &domain[ 0 ], &domain[ 1 ] );
+
+	float low  = self->knots[ domain[ 0 ] ];
+	float high = self->knots[ domain[ 1 ] - 1 ];
+
+	if ( !self->dirty && self->trace_resolution == 0 && self->trace_tolerance == tolerance ) {
+
+		if ( self->dirty_spans_begin == self->dirty_spans_end ) {
+			return true; // polyline is up to date
+		}
+
+		// Knot spans influenced by changed control points may need a different number
+		// of vertices - we splice vertices for these spans in between the unchanged
+		// vertices before and after them.
+
+		size_t const first_span = self->dirty_spans_begin - domain[ 0 ];
+		size_t const last_span  = self->dirty_spans_end - domain[ 0 ];
+
+		auto &polyline = self->scratch;
+		polyline.clear();
+		polyline.insert( polyline.end(), self->polyline.begin(), self->polyline.begin() + self->span_first_vertex[ first_span ] );
+
+		for ( size_t s = self->dirty_spans_begin; s != self->dirty_spans_end; s++ ) {
+			self->span_first_vertex[ s - domain[ 0 ] ] = uint32_t( polyline.size() );
+			bspline_trace_span_adaptive( self, s, low, high, tolerance, polyline );
+		}
+
+		size_t const old_end = self->span_first_vertex[ last_span ];
+		size_t const new_end = polyline.size();
+
+		polyline.insert( polyline.end(), self->polyline.begin() + old_end, self->polyline.end() );
+
+		for ( size_t span = last_span; span != self->span_first_vertex.size(); span++ ) {
+			self->span_first_vertex[ span ] = uint32_t( self->span_first_vertex[ span ] - old_end + new_end );
 		}
 
-		// Convert back (unproject homogenous coordinates) and store in output vector.
+		std::swap( self->polyline, self->scratch );
+
+		self->dirty_spans_begin = self->dirty_spans_end = 0;
+		return true;
+	}
+
+	// --------| invariant: we must trace the full curve
+
+	self->polyline.clear();
+	self->span_first_vertex.resize( domain[ 1 ] - domain[ 0 ] + 1 );
 
-		self->polyline.emplace_back( v[ s ].x / v[ s ].z,
-		                             v[ s ].y / v[ s ].z );
+	for ( size_t s = domain[ 0 ]; s != domain[ 1 ]; s++ ) {
+		self->span_first_vertex[ s - domain[ 0 ] ] = uint32_t( self->polyline.size() );
+		bspline_trace_span_adaptive( self, s, low, high, tolerance, self->polyline );
 	}
 
+	self->span_first_vertex.back() = uint32_t( self->polyline.size() );
+
+	self->dirty             = 0;
+	self->dirty_spans_begin = self->dirty_spans_end = 0;
+	self->trace_resolution  = 0;
+	self->trace_tolerance   = tolerance;
+
 	return true;
 }
 
+// ----------------------------------------------------------------------
+// Replaces control points [first_point, first_point + num_points[. The next trace
+// only evaluates again knot spans which are influenced by these points.
+static void le_bspline_update_points( le_bspline_o *self, size_t first_point, Vertex const *points, size_t num_points ) {
+
+	if ( first_point + num_points > self->points.size() ) {
+		assert( false ); // points to update must already exist
+		return;
+	}
+
+	std::copy( points, points + num_points, self->points.begin() + first_point );
+
+	if ( self->dirty || num_points == 0 ) {
+		return; // curve will be prepared and traced in full anyway
+	}
+
+	// --------| invariant: homogeneous coordinates, and knots are valid
+
+	size_t domain[ 2 ];
+	bspline_get_domain( self, &domain[ 0 ], &domain[ 1 ] );
+
+	size_t const degree = self->degree;
+	size_t const n      = self->points.size();
+
+	// Control point i influences knot spans [i, i + degree]. If the curve is closed,
+	// control points i <= degree appear a second time, as point i + n.
+
+	size_t spans_begin = first_point;
+	size_t spans_end   = first_point + num_points + degree;
+
+	if ( self->closed && first_point <= degree ) {
+		spans_end = std::max( spans_end, std::min( first_point + num_points, degree + 1 ) + n + degree );
+	}
+
+	for ( size_t i = first_point; i != first_point + num_points; i++ ) {
+		bspline_update_homogeneous( self, i );
+	}
+
+	spans_begin = std::max( spans_begin, domain[ 0 ] );
+	spans_end   = std::min( spans_end, domain[ 1 ] );
+
+	if ( self->dirty_spans_begin != self->dirty_spans_end ) {
+		spans_begin = std::min( spans_begin, self->dirty_spans_begin );
+		spans_end   = std::max( spans_end, self->dirty_spans_end );
+	}
+
+	self->dirty_spans_begin = spans_begin;
+	self->dirty_spans_end   = std::max( spans_begin, spans_end );
+}
+
 // ----------------------------------------------------------------------
 
 static void le_bspline_get_vertices_for_polyline( le_bspline_o *self, Vertex const **vertices, size_t *num_vertices ) {
@@ -190,6 +589,8 @@ LE_MODULE_REGISTER_IMPL( le_bspline, api ) {
 	le_bspline_i.set_points                = le_bspline_set_points;
 	le_bspline_i.set_knots                 = le_bspline_set_knots;
 	le_bspline_i.set_weights               = le_bspline_set_weights;
+	le_bspline_i.update_points             = le_bspline_update_points;
 	le_bspline_i.trace                     = le_bspline_trace;
+	le_bspline_i.trace_adaptive            = le_bspline_trace_adaptive;
 	le_bspline_i.get_vertices_for_polyline = le_bspline_get_vertices_for_polyline;
 }
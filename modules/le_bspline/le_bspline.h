@@ -46,7 +46,17 @@ struct le_bspline_api {
 		void                 (* set_points                ) ( le_bspline_o* self, Vertex const * points, size_t const num_points );
 		void                 (* set_knots                 ) ( le_bspline_o* self, float const * knots, size_t const num_knots );
 		void                 (* set_weights               ) ( le_bspline_o* self, float const* weights, size_t const num_weights );
+
+		// Replaces existing control points [first_point, first_point + num_points). The next trace only
+		// evaluates again the parts of the curve which these points influence.
+		void                 (* update_points             ) ( le_bspline_o* self, size_t first_point, Vertex const * points, size_t const num_points );
+
+		// Samples the curve with `resolution` vertices, evenly spaced over its parameter domain.
 		bool                 (* trace                     ) ( le_bspline_o* self, size_t resolution );
+
+		// Samples the curve so that the polyline deviates from the curve by no more than `tolerance` -
+		// parts of the curve which curve strongly receive more vertices.
+		bool                 (* trace_adaptive            ) ( le_bspline_o* self, float tolerance );
 		void                 (* get_vertices_for_polyline ) ( le_bspline_o* self, Vertex const ** vertices, size_t * num_vertices );
 	};
 
@@ -99,10 +109,19 @@ class LeBspline : NoCopy, NoMove {
 		return *this;
 	}
 
+	LeBspline &updatePoints( size_t firstPoint, le_bspline_api::Vertex const *points, size_t numPoints ) {
+		le_bspline::le_bspline_i.update_points( self, firstPoint, points, numPoints );
+		return *this;
+	}
+
 	bool trace( size_t resolution ) {
 		return le_bspline::le_bspline_i.trace( self, resolution );
 	}
 
+	bool traceAdaptive( float tolerance ) {
+		return le_bspline::le_bspline_i.trace_adaptive( self, tolerance );
+	}
+
 	LeBspline &getVerticesForPolyline( le_bspline_api::Vertex const **pVertices, size_t *numVertices ) {
 		le_bspline::le_bspline_i.get_vertices_for_polyline( self, pVertices, numVertices );
 		return *this;
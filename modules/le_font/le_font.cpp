@@ -1,13 +1,23 @@
 #include "le_font.h"
 
 #include "3rdparty/stb_truetype.h"
-#include "3rdparty/stb_rect_pack.h"
+
+#ifndef LE_MT
+#	define LE_MT 0
+#endif
+
+#if ( LE_MT > 0 )
+#	include "le_jobs.h"
+#endif
 
 #include <vector>
-#include <array>
+#include <unordered_map>
+#include <mutex>
+#include <algorithm>
 #include <fstream>
 #include <filesystem> // for parsing source filepaths
 #include <iostream>
+#include <string.h> // for memset
 #include <assert.h>
 
 #include <glm/vec2.hpp>
@@ -15,23 +25,75 @@
 
 #include "le_path.h" // for get_path_for_glyph
 
-struct UnicodeRange {
-	uint32_t                      start_range;
-	uint32_t                      end_range;
-	std::vector<stbtt_packedchar> data;
+// Glyphs are rasterised on demand, the first time they are drawn, and cached in
+// a texture atlas. The atlas consists of up to MAX_ATLAS_PAGES pages; once all
+// pages are full, the least recently used page is evicted, and its glyphs will
+// be rasterised again when they are next used.
+
+struct GlyphEntry {
+	enum class State : uint8_t {
+		eRequested, // glyph was used, but has not yet been rasterised
+		eCached,    // glyph has been rasterised into an atlas page
+		eEmpty,     // glyph has no visible pixels (e.g. whitespace), only metrics
+	};
+	State    state;
+	uint32_t page;          // atlas page index
+	uint32_t upload_count;  // glyph is ready to draw once page upload_count is at least this value
+	uint16_t x0, y0;        // top-left of glyph rectangle in atlas page (in pixels)
+	uint16_t x1, y1;        // bottom-right of glyph rectangle in atlas page (in pixels)
+	float    xoff, yoff;    // offset from cursor to top-left of glyph quad
+	float    xoff2, yoff2;  // offset from cursor to bottom-right of glyph quad
+	float    xadvance;      // cursor advance after this glyph
+	uint64_t last_used = 0; // glyph cache generation in which this glyph was last drawn
+};
+
+struct AtlasShelf {
+	uint16_t y;      // top of shelf
+	uint16_t height; // height of shelf
+	uint16_t next_x; // next free pixel on shelf
+};
+
+struct AtlasPage {
+	std::vector<uint8_t>    pixels;           // PIXELS_WIDTH * PIXELS_HEIGHT * PIXELS_BPP
+	std::vector<AtlasShelf> shelves;          // glyphs are packed into horizontal shelves
+	uint16_t                next_shelf_y = 0; // top of next shelf to be opened
+	uint16_t                dirty_x0     = 0; // dirty rectangle, empty if x0 >= x1
+	uint16_t                dirty_y0     = 0;
+	uint16_t                dirty_x1     = 0;
+	uint16_t                dirty_y1     = 0;
+	uint32_t                upload_count = 0; // number of times this page was uploaded
+	uint64_t                last_used    = 0; // glyph cache generation in which this page was last used
+};
+
+// Pixels for a rasterised glyph, before it is packed into an atlas page
+struct GlyphBitmap {
+	uint32_t             codepoint;
+	std::vector<uint8_t> pixels; // tightly packed, width * height
+	uint16_t             width;
+	uint16_t             height;
+	float                xoff, yoff;
+	float                xoff2, yoff2;
 };
 
 struct le_font_o {
 	// members
-	static constexpr uint16_t                                      PIXELS_WIDTH  = 512 * 2;
-	static constexpr uint16_t                                      PIXELS_HEIGHT = 256 * 2;
-	static constexpr uint16_t                                      PIXELS_BPP    = 1; // bytes per pixels
-	stbtt_fontinfo                                                 info;
-	std::vector<uint8_t>                                           data;                     // ttf file data
-	std::array<uint8_t, PIXELS_WIDTH * PIXELS_HEIGHT * PIXELS_BPP> pixels;                   // pixels for texture_atlas
-	float                                                          font_size         = 24.f; // font size in pixels. TODO: check units for font size.
-	bool                                                           has_texture_atlas = false;
-	std::vector<UnicodeRange>                                      unicode_ranges; // available unicode ranges, assumed to be sorted.
+	static constexpr uint16_t PIXELS_WIDTH    = 512 * 2; // atlas page width
+	static constexpr uint16_t PIXELS_HEIGHT   = 256 * 2; // atlas page height
+	static constexpr uint16_t PIXELS_BPP      = 1;       // bytes per pixels
+	static constexpr uint32_t MAX_ATLAS_PAGES = 4;
+	static constexpr int      OVERSAMPLE_X    = 2;       // horizontal oversampling for rasterised glyphs
+	static constexpr int      OVERSAMPLE_Y    = 1;       // vertical oversampling for rasterised glyphs
+
+	stbtt_fontinfo                           info;
+	std::vector<uint8_t>                     data;                         // ttf file data
+	float                                    font_size            = 24.f;  // font size in pixels. TODO: check units for font size.
+	float                                    scale                = 1.f;   // scale to apply to font units to get pixels, for font_size
+	bool                                     has_texture_atlas    = false;
+	std::mutex                               glyph_cache_mtx;              // protects all members below, as strings may be drawn from multiple threads
+	std::unordered_map<uint32_t, GlyphEntry> glyphs;                       // glyph cache, indexed by codepoint
+	std::vector<uint32_t>                    requested_codepoints;         // codepoints used since last cache update, which need rasterising
+	std::vector<AtlasPage>                   atlas_pages;
+	uint64_t                                 generation           = 0;     // incremented with each glyph cache update
 };
 
 // ----------------------------------------------------------------------
@@ -151,51 +213,388 @@ static le_font_o *le_font_create( char const *font_filename, float font_size ) {
 	auto data  = load_file( font_filename, &loadOk );
 	self->data = { data.data(), data.data() + data.size() };
 
+	self->font_size = font_size;
+
 	if ( loadOk ) {
 		stbtt_InitFont( &self->info, self->data.data(), 0 );
+		self->scale = stbtt_ScaleForPixelHeight( &self->info, font_size );
 	} else {
 		std::cerr << "Could not load font file: '" << font_filename << "'" << std::endl
 		          << std::flush;
 	}
 
-	self->font_size = font_size;
-
 	return self;
 }
 
 // ----------------------------------------------------------------------
+// Returns cache entry for codepoint - if there is no entry yet, creates
+// one and requests the glyph to be rasterised with the next cache update.
+// Glyph cache mutex must be held by caller.
+static GlyphEntry &font_get_or_request_glyph( le_font_o *self, uint32_t codepoint ) {
 
-// Creates - (or re-creates) texture atlas for a given font
-static bool le_font_create_atlas( le_font_o *self ) {
-	if ( false == self->has_texture_atlas ) {
+	auto it = self->glyphs.find( codepoint );
+
+	if ( it != self->glyphs.end() ) {
+		return it->second;
+	}
+
+	// --------| invariant: glyph is not yet in cache
+
+	// We can calculate metrics right away, so that text layout does
+	// not depend on whether a glyph has been rasterised.
+
+	int advance_width, left_side_bearing;
+	stbtt_GetCodepointHMetrics( &self->info, int( codepoint ), &advance_width, &left_side_bearing );
+
+	GlyphEntry entry{};
+	entry.state    = GlyphEntry::State::eRequested;
+	entry.xadvance = self->scale * advance_width;
+
+	self->requested_codepoints.push_back( codepoint );
+
+	return self->glyphs.emplace( codepoint, entry ).first->second;
+}
+
+// ----------------------------------------------------------------------
+// Rasterises a single glyph - this only reads from font info, and may
+// therefore be called concurrently for different glyphs.
+static void font_rasterise_glyph( le_font_o const *self, GlyphBitmap *bitmap ) {
+
+	int glyph = stbtt_FindGlyphIndex( &self->info, int( bitmap->codepoint ) );
+
+	// This follows what stbtt_PackFontRange does for each glyph, so that
+	// glyphs look the same as they did with a pre-baked atlas.
+
+	int x0, y0, x1, y1;
+	stbtt_GetGlyphBitmapBoxSubpixel( &self->info, glyph, self->scale * self->OVERSAMPLE_X, self->scale * self->OVERSAMPLE_Y, 0, 0, &x0, &y0, &x1, &y1 );
+
+	if ( x1 <= x0 || y1 <= y0 ) {
+		// Glyph has no visible pixels
+		bitmap->width  = 0;
+		bitmap->height = 0;
+		return;
+	}
+
+	int w = x1 - x0 + self->OVERSAMPLE_X - 1;
+	int h = y1 - y0 + self->OVERSAMPLE_Y - 1;
+
+	bitmap->width  = uint16_t( w );
+	bitmap->height = uint16_t( h );
+	bitmap->pixels.resize( size_t( w ) * size_t( h ), 0 );
+
+	float sub_x, sub_y;
+	stbtt_MakeGlyphBitmapSubpixelPrefilter( &self->info, bitmap->pixels.data(), w, h, w,
+	                                        self->scale * self->OVERSAMPLE_X, self->scale * self->OVERSAMPLE_Y,
+	                                        0, 0, self->OVERSAMPLE_X, self->OVERSAMPLE_Y, &sub_x, &sub_y, glyph );
+
+	float const recip_h = 1.f / self->OVERSAMPLE_X;
+	float const recip_v = 1.f / self->OVERSAMPLE_Y;
+
+	bitmap->xoff  = float( x0 ) * recip_h + sub_x;
+	bitmap->yoff  = float( y0 ) * recip_v + sub_y;
+	bitmap->xoff2 = float( x0 + w ) * recip_h + sub_x;
+	bitmap->yoff2 = float( y0 + h ) * recip_v + sub_y;
+}
+
+// ----------------------------------------------------------------------
+// Rasterises all given glyphs - on worker threads if the job system is available.
+static void font_rasterise_glyphs( le_font_o const *self, GlyphBitmap *bitmaps, size_t num_bitmaps ) {
+
+#if ( LE_MT > 0 )
+	static constexpr size_t GLYPHS_PER_JOB = 16;
+
+	struct rasterise_job_param_t {
+		le_font_o const *font;
+		GlyphBitmap *    bitmaps;
+		size_t           num_bitmaps;
+	};
+
+	size_t const num_jobs = ( num_bitmaps + GLYPHS_PER_JOB - 1 ) / GLYPHS_PER_JOB;
+
+	if ( num_jobs > 1 ) {
+
+		std::vector<rasterise_job_param_t> params;
+		std::vector<le_jobs::job_t>        jobs;
+		params.reserve( num_jobs );
+		jobs.reserve( num_jobs );
+
+		for ( size_t i = 0; i < num_bitmaps; i += GLYPHS_PER_JOB ) {
+			params.push_back( { self, bitmaps + i, std::min( GLYPHS_PER_JOB, num_bitmaps - i ) } );
+		}
+
+		for ( auto &p : params ) {
+			jobs.push_back( { []( void *param ) {
+				                 auto p = static_cast<rasterise_job_param_t *>( param );
+				                 for ( size_t i = 0; i != p->num_bitmaps; i++ ) {
+					                 font_rasterise_glyph( p->font, p->bitmaps + i );
+				                 }
+			                 },
+			                  &p } );
+		}
+
+		le_jobs::counter_t *counter;
+		le_jobs::run_jobs( jobs.data(), uint32_t( jobs.size() ), &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
+
+		return;
+	}
+#endif
+
+	for ( size_t i = 0; i != num_bitmaps; i++ ) {
+		font_rasterise_glyph( self, bitmaps + i );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Finds space for a rectangle of given size in an atlas page, using shelf packing.
+// Returns false if the rectangle does not fit.
+static bool atlas_page_allocate( AtlasPage *page, uint16_t width, uint16_t height, uint16_t *x, uint16_t *y ) {
+
+	// Find the shelf which fits best - which is the lowest shelf that is high enough,
+	// but does not waste too much space.
+
+	AtlasShelf *best_shelf = nullptr;
+
+	for ( auto &shelf : page->shelves ) {
+		if ( shelf.height < height ||
+		     shelf.height > height + height / 2 + 2 ||
+		     shelf.next_x + width > le_font_o::PIXELS_WIDTH ) {
+			continue;
+		}
+		if ( nullptr == best_shelf || shelf.height < best_shelf->height ) {
+			best_shelf = &shelf;
+		}
+	}
+
+	if ( nullptr == best_shelf ) {
+
+		// Open a new shelf, if there is space left.
+
+		if ( page->next_shelf_y + height > le_font_o::PIXELS_HEIGHT ||
+		     width > le_font_o::PIXELS_WIDTH ) {
+			return false;
+		}
+
+		page->shelves.push_back( { page->next_shelf_y, height, 0 } );
+		page->next_shelf_y = uint16_t( page->next_shelf_y + height );
+		best_shelf         = &page->shelves.back();
+	}
+
+	*x = best_shelf->next_x;
+	*y = best_shelf->y;
+
+	best_shelf->next_x = uint16_t( best_shelf->next_x + width );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static void atlas_page_mark_dirty( AtlasPage *page, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1 ) {
+	if ( page->dirty_x0 >= page->dirty_x1 ) {
+		page->dirty_x0 = x0;
+		page->dirty_y0 = y0;
+		page->dirty_x1 = x1;
+		page->dirty_y1 = y1;
+	} else {
+		page->dirty_x0 = std::min( page->dirty_x0, x0 );
+		page->dirty_y0 = std::min( page->dirty_y0, y0 );
+		page->dirty_x1 = std::max( page->dirty_x1, x1 );
+		page->dirty_y1 = std::max( page->dirty_y1, y1 );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Evict all glyphs from a page, and reset the page so that it may be packed anew.
+// Glyph cache mutex must be held by caller.
+static void font_evict_atlas_page( le_font_o *self, uint32_t page_idx ) {
+
+	for ( auto it = self->glyphs.begin(); it != self->glyphs.end(); ) {
+		if ( it->second.state == GlyphEntry::State::eCached && it->second.page == page_idx ) {
+			it = self->glyphs.erase( it );
+		} else {
+			it++;
+		}
+	}
+
+	auto &page = self->atlas_pages[ page_idx ];
+
+	memset( page.pixels.data(), 0, page.pixels.size() );
+	page.shelves.clear();
+	page.next_shelf_y = 0;
+
+	atlas_page_mark_dirty( &page, 0, 0, le_font_o::PIXELS_WIDTH, le_font_o::PIXELS_HEIGHT );
+}
+
+// ----------------------------------------------------------------------
+// Adds an empty atlas page - a new page is dirty in full so that its
+// first upload initialises the complete image.
+// Glyph cache mutex must be held by caller.
+static void font_add_atlas_page( le_font_o *self ) {
+	AtlasPage page{};
+	page.pixels.resize( size_t( le_font_o::PIXELS_WIDTH ) * le_font_o::PIXELS_HEIGHT * le_font_o::PIXELS_BPP, 0 );
+	atlas_page_mark_dirty( &page, 0, 0, le_font_o::PIXELS_WIDTH, le_font_o::PIXELS_HEIGHT );
+	self->atlas_pages.emplace_back( std::move( page ) );
+	self->has_texture_atlas = true;
+}
+
+// ----------------------------------------------------------------------
+// Finds space for a glyph of given size - adds new atlas pages as needed, and
+// evicts the least recently used page once the maximum number of pages has been
+// reached. Pages which were used in the current, or the previous generation are
+// never evicted: the cache is updated at the start of a frame, before any strings
+// for that frame have been drawn, so pages drawn from in the previous frame are
+// likely to be drawn from again.
+// Returns false if no space could be found.
+static bool font_allocate_glyph_rect( le_font_o *self, uint16_t width, uint16_t height, uint32_t *page_idx, uint16_t *x, uint16_t *y ) {
+
+	for ( uint32_t i = 0; i != self->atlas_pages.size(); i++ ) {
+		if ( atlas_page_allocate( &self->atlas_pages[ i ], width, height, x, y ) ) {
+			*page_idx = i;
+			return true;
+		}
+	}
 
-		stbtt_pack_context pack_context{};
-		stbtt_PackBegin( &pack_context, self->pixels.data(), self->PIXELS_WIDTH, self->PIXELS_HEIGHT, 0, 1, nullptr ); // stride 0 means tightly packed, leave 1 pixel padding around pixels
+	// --------| invariant: glyph did not fit into any existing page
 
-		stbtt_PackSetOversampling( &pack_context, 2, 1 );
+	if ( self->atlas_pages.size() < le_font_o::MAX_ATLAS_PAGES ) {
+		font_add_atlas_page( self );
+	} else {
+		uint32_t lru_page = ~uint32_t( 0 );
+
+		for ( uint32_t i = 0; i != self->atlas_pages.size(); i++ ) {
+			if ( self->atlas_pages[ i ].last_used + 1 < self->generation &&
+			     ( lru_page == ~uint32_t( 0 ) || self->atlas_pages[ i ].last_used < self->atlas_pages[ lru_page ].last_used ) ) {
+				lru_page = i;
+			}
+		}
+
+		if ( lru_page == ~uint32_t( 0 ) ) {
+			// All pages are in use in the current, or the previous generation.
+			return false;
+		}
+
+		font_evict_atlas_page( self, lru_page );
+
+		*page_idx = lru_page;
+		return atlas_page_allocate( &self->atlas_pages[ lru_page ], width, height, x, y );
+	}
+
+	*page_idx = uint32_t( self->atlas_pages.size() - 1 );
+	return atlas_page_allocate( &self->atlas_pages.back(), width, height, x, y );
+}
+
+// ----------------------------------------------------------------------
+// Rasterises all glyphs which have been requested since the last update, and
+// packs them into the atlas. Call this once per frame, before uploading atlas pages.
+static void le_font_update_glyph_cache( le_font_o *self ) {
+
+	auto lock = std::scoped_lock( self->glyph_cache_mtx );
+
+	self->generation++;
+
+	if ( self->requested_codepoints.empty() ) {
+		return;
+	}
+
+	// --------| invariant: there are glyphs to rasterise
+
+	std::vector<GlyphBitmap> bitmaps( self->requested_codepoints.size() );
+
+	for ( size_t i = 0; i != bitmaps.size(); i++ ) {
+		bitmaps[ i ].codepoint = self->requested_codepoints[ i ];
+	}
+
+	self->requested_codepoints.clear();
+
+	font_rasterise_glyphs( self, bitmaps.data(), bitmaps.size() );
+
+	// Pack tallest glyphs first, this makes for tighter shelves.
+	std::sort( bitmaps.begin(), bitmaps.end(), []( GlyphBitmap const &lhs, GlyphBitmap const &rhs ) -> bool {
+		return lhs.height > rhs.height;
+	} );
 
-		auto pack_uniform_range = []( stbtt_pack_context *ctx, unsigned char const *font_data, float font_size, uint32_t start_range, uint32_t end_range ) -> UnicodeRange {
-			UnicodeRange r;
-			r.start_range = start_range;
-			r.end_range   = end_range;
-			r.data.resize( r.end_range - r.start_range );
+	for ( auto &bitmap : bitmaps ) {
 
-			stbtt_PackFontRange( ctx, font_data, 0, font_size,
-			                     int( r.start_range ),
-			                     int( r.end_range - r.start_range ),
-			                     r.data.data() );
+		auto it = self->glyphs.find( bitmap.codepoint );
 
-			return r;
-		};
+		if ( it == self->glyphs.end() ) {
+			continue;
+		}
+
+		auto &entry = it->second;
+
+		if ( bitmap.width == 0 || bitmap.height == 0 ||
+		     bitmap.width >= le_font_o::PIXELS_WIDTH || bitmap.height >= le_font_o::PIXELS_HEIGHT ) {
+			// Glyph has no pixels, or could never fit into an atlas page: we only keep its metrics.
+			entry.state = GlyphEntry::State::eEmpty;
+			continue;
+		}
 
-		self->unicode_ranges.emplace_back( pack_uniform_range( &pack_context, self->data.data(), self->font_size, 0x00, 0x7F ) );     // ascii
-		self->unicode_ranges.emplace_back( pack_uniform_range( &pack_context, self->data.data(), self->font_size, 0x80, 0xff ) );     // latin-extended
-		self->unicode_ranges.emplace_back( pack_uniform_range( &pack_context, self->data.data(), self->font_size, 0x20A0, 0x20CF ) ); // currency symbols
-		self->unicode_ranges.emplace_back( pack_uniform_range( &pack_context, self->data.data(), self->font_size, 0x2190, 0x21FF ) ); // arrows
+		// We leave one pixel of padding to the right and bottom of each glyph,
+		// so that neighbouring glyphs don't bleed into each other when sampled.
+
+		uint32_t page_idx;
+		uint16_t x, y;
+
+		if ( false == font_allocate_glyph_rect( self, uint16_t( bitmap.width + 1 ), uint16_t( bitmap.height + 1 ), &page_idx, &x, &y ) ) {
+			// Glyph could not be placed - remove it from the cache, so that it gets requested again.
+			self->glyphs.erase( it );
+			continue;
+		}
 
-		stbtt_PackEnd( &pack_context );
+		// --------| invariant: we have found space for the glyph in atlas page
+
+		auto &page = self->atlas_pages[ page_idx ];
+
+		for ( uint16_t row = 0; row != bitmap.height; row++ ) {
+			memcpy( page.pixels.data() + ( size_t( y + row ) * le_font_o::PIXELS_WIDTH + x ) * le_font_o::PIXELS_BPP,
+			        bitmap.pixels.data() + size_t( row ) * bitmap.width,
+			        bitmap.width );
+		}
+
+		atlas_page_mark_dirty( &page, x, y, uint16_t( x + bitmap.width ), uint16_t( y + bitmap.height ) );
+
+		page.last_used = self->generation;
+
+		entry.state        = GlyphEntry::State::eCached;
+		entry.page         = page_idx;
+		entry.upload_count = page.upload_count + 1; // glyph becomes visible once page has been uploaded
+		entry.x0           = x;
+		entry.y0           = y;
+		entry.x1           = uint16_t( x + bitmap.width );
+		entry.y1           = uint16_t( y + bitmap.height );
+		entry.xoff         = bitmap.xoff;
+		entry.yoff         = bitmap.yoff;
+		entry.xoff2        = bitmap.xoff2;
+		entry.yoff2        = bitmap.yoff2;
+	}
+}
 
-		self->has_texture_atlas = true;
+// ----------------------------------------------------------------------
+
+// Creates - (or re-creates) texture atlas for a given font
+//
+// Glyphs are rasterised on demand, this pre-populates the glyph cache
+// with glyphs for the ascii and latin-1 ranges, so that these are
+// available with the first frame.
+static bool le_font_create_atlas( le_font_o *self ) {
+	if ( false == self->has_texture_atlas ) {
+		{
+			auto lock = std::scoped_lock( self->glyph_cache_mtx );
+
+			if ( self->atlas_pages.empty() ) {
+				font_add_atlas_page( self );
+			}
+
+			for ( uint32_t cp = 0x20; cp != 0x7F; cp++ ) {
+				font_get_or_request_glyph( self, cp ); // ascii
+			}
+			for ( uint32_t cp = 0xA0; cp != 0x100; cp++ ) {
+				font_get_or_request_glyph( self, cp ); // latin-1 supplement
+			}
+		}
+		le_font_update_glyph_cache( self );
 	}
 	return true;
 }
@@ -287,18 +686,27 @@ static bool le_utf8_iterator( char const *str, void *user_data, le_font_api::le_
 
 // Places geometry into vertices to draw an utf-8 string using given font.
 //
-// Returns count of used vertices - calculated as 6 * codepoint count.
+// Returns count of used vertices - at most 6 * codepoint count.
 // Note that we count utf-8 code points, not ascii characters.
 //
-// Place nullptr in `vertices` to calculate vertex count and return early.
+// Place nullptr in `vertices` to calculate an upper bound for the vertex count
+// and return early.
 //
 // `max_vertices` marks the maximum number of vertices we may write into.
 //
 // `vertex_offset` tells us at which position in `vertices` to begin writing vertex data
 //
+// `quad_atlas_pages` is optional - if set, the atlas page index for each quad
+// (every 6 vertices) is written to `quad_atlas_pages[(vertex_offset + vertex index) / 6]`.
+//
+// Glyphs which are not yet in the glyph cache are requested, and will be
+// rasterised with the next call to `update_glyph_cache`. Until then, no
+// vertices are generated for them, but the cursor is advanced as if they
+// were drawn.
+//
 // If vertex data was written, x_pos and y_pos will be updated to the current
 // advance of the virtual text cursor.
-static size_t le_font_draw_utf8_string( le_font_o *self, const char *str, float *x_pos, float *y_pos, glm::vec4 *vertices, size_t max_vertices, size_t vertex_offset ) {
+static size_t le_font_draw_utf8_string( le_font_o *self, const char *str, float *x_pos, float *y_pos, glm::vec4 *vertices, size_t max_vertices, size_t vertex_offset, uint32_t *quad_atlas_pages ) {
 
 	size_t glyph_count = 0;
 
@@ -321,66 +729,83 @@ static size_t le_font_draw_utf8_string( le_font_o *self, const char *str, float
 
 	const float x_anchor     = x_pos ? *x_pos : 0; // In case nullptr, set to zero.
 	const float y_anchor     = y_pos ? *y_pos : 0; // In case nullptr, set to zero.
+	float       x            = x_anchor;
+	float       y            = y_anchor;
 	size_t      num_newlines = 0;
 
 	size_t num_vertices = 0;
 
-	{
-		stbtt_aligned_quad quad{};
+	constexpr float ipw = 1.f / le_font_o::PIXELS_WIDTH;
+	constexpr float iph = 1.f / le_font_o::PIXELS_HEIGHT;
 
-		for ( auto const &cp : codepoints ) {
+	auto lock = std::scoped_lock( self->glyph_cache_mtx );
 
-			if ( cp == '\n' ) {
-				*y_pos = y_anchor + int( ( ++num_newlines ) * self->font_size * 1.2f ); // We increase y position - assumed line height 1.2, aligned to pixels,
-				*x_pos = x_anchor;                                                      // and reset x position
-				continue;
-			}
+	for ( auto const &cp : codepoints ) {
 
-			// we must check that our codepoint is contained within a range of
-			// available codepoints from the current font.
+		if ( cp == '\n' ) {
+			y = y_anchor + int( ( ++num_newlines ) * self->font_size * 1.2f ); // We increase y position - assumed line height 1.2, aligned to pixels,
+			x = x_anchor;                                                      // and reset x position
+			continue;
+		}
 
-			UnicodeRange *            range      = self->unicode_ranges.data();
-			UnicodeRange const *const end_ranges = range + self->unicode_ranges.size();
+		GlyphEntry &glyph = font_get_or_request_glyph( self, cp );
 
-			while ( range != end_ranges && cp > range->end_range ) {
-				range++;
-			}
+		if ( glyph.state != GlyphEntry::State::eCached ||
+		     self->atlas_pages[ glyph.page ].upload_count < glyph.upload_count ) {
+			// Glyph has no pixels, or is not yet available in atlas - we only advance the cursor.
+			x += glyph.xadvance;
+			continue;
+		}
 
-			if ( range == end_ranges || cp < range->start_range ) {
-				// could not find codepoint in known ranges.
-				assert( false && "could not find codepoint" );
+		// -------| invariant: glyph is available in atlas
 
-				continue;
-			}
-
-			// -------| invariant: cp is < range->end_range
+		if ( num_vertices + 6 > max_vertices ) {
+			// we don't have enough vertex memory left, we must return early.
+			break;
+		}
 
-			stbtt_GetPackedQuad( range->data.data(), self->PIXELS_WIDTH, self->PIXELS_HEIGHT, int( cp - range->start_range ), x_pos, y_pos, &quad, 0 );
+		glyph.last_used                           = self->generation;
+		self->atlas_pages[ glyph.page ].last_used = self->generation;
 
-			if ( num_vertices + 6 > max_vertices ) {
-				// we don't have enough vertex memory left, we must return early.
-				return num_vertices / 6;
-			}
+		float const x0 = x + glyph.xoff;
+		float const y0 = y + glyph.yoff;
+		float const x1 = x + glyph.xoff2;
+		float const y1 = y + glyph.yoff2;
+		float const s0 = glyph.x0 * ipw;
+		float const t0 = glyph.y0 * iph;
+		float const s1 = glyph.x1 * ipw;
+		float const t1 = glyph.y1 * iph;
 
-			// Update vertices - stb_tt_packed_quad returns top-left,
-			// and bottom-right vertex, and we must expand this to two
-			// triangles.
+		// Update vertices - we must expand top-left, and bottom-right
+		// vertex to two triangles.
 
-			// Our return vertices will be x/y s/t per-vertex
-			// (we store texture coordinates per vertex in .zw coordinates to save bandwidth)
+		// Our return vertices will be x/y s/t per-vertex
+		// (we store texture coordinates per vertex in .zw coordinates to save bandwidth)
 
-			glm::vec4 *vtx = vertices + vertex_offset + num_vertices;
+		glm::vec4 *vtx = vertices + vertex_offset + num_vertices;
 
-			vtx[ 0 ] = { quad.x0, quad.y0, quad.s0, quad.t0 }; // top-left
-			vtx[ 1 ] = { quad.x0, quad.y1, quad.s0, quad.t1 }; // bottom-left
-			vtx[ 2 ] = { quad.x1, quad.y1, quad.s1, quad.t1 }; // bottom-right
+		vtx[ 0 ] = { x0, y0, s0, t0 }; // top-left
+		vtx[ 1 ] = { x0, y1, s0, t1 }; // bottom-left
+		vtx[ 2 ] = { x1, y1, s1, t1 }; // bottom-right
 
-			vtx[ 3 ] = { quad.x1, quad.y0, quad.s1, quad.t0 }; // top-right
-			vtx[ 4 ] = { quad.x0, quad.y0, quad.s0, quad.t0 }; // top-left
-			vtx[ 5 ] = { quad.x1, quad.y1, quad.s1, quad.t1 }; // bottom-right
+		vtx[ 3 ] = { x1, y0, s1, t0 }; // top-right
+		vtx[ 4 ] = { x0, y0, s0, t0 }; // top-left
+		vtx[ 5 ] = { x1, y1, s1, t1 }; // bottom-right
 
-			num_vertices += 6;
+		if ( quad_atlas_pages ) {
+			quad_atlas_pages[ ( vertex_offset + num_vertices ) / 6 ] = glyph.page;
 		}
+
+		num_vertices += 6;
+
+		x += glyph.xadvance;
+	}
+
+	if ( x_pos ) {
+		*x_pos = x;
+	}
+	if ( y_pos ) {
+		*y_pos = y;
 	}
 
 	return num_vertices;
@@ -394,13 +819,15 @@ static float le_font_get_scale_for_pixels_height( le_font_o const *self, float h
 
 // ----------------------------------------------------------------------
 
-static bool le_font_get_atlas( le_font_o *self, uint8_t const **pixels, uint32_t *width, uint32_t *height, uint32_t *pix_stride_in_bytes ) {
+static bool le_font_get_atlas_page( le_font_o *self, uint32_t page_idx, uint8_t const **pixels, uint32_t *width, uint32_t *height, uint32_t *pix_stride_in_bytes ) {
 
-	if ( false == self->has_texture_atlas ) {
+	auto lock = std::scoped_lock( self->glyph_cache_mtx );
+
+	if ( page_idx >= self->atlas_pages.size() ) {
 		return false;
 	}
 
-	*pixels              = self->pixels.data();
+	*pixels              = self->atlas_pages[ page_idx ].pixels.data();
 	*pix_stride_in_bytes = self->PIXELS_BPP;
 	*width               = self->PIXELS_WIDTH;
 	*height              = self->PIXELS_HEIGHT;
@@ -408,6 +835,61 @@ static bool le_font_get_atlas( le_font_o *self, uint8_t const **pixels, uint32_t
 	return true;
 }
 
+// ----------------------------------------------------------------------
+// Returns first atlas page - kept for compatibility with single-page atlasses.
+static bool le_font_get_atlas( le_font_o *self, uint8_t const **pixels, uint32_t *width, uint32_t *height, uint32_t *pix_stride_in_bytes ) {
+	return le_font_get_atlas_page( self, 0, pixels, width, height, pix_stride_in_bytes );
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t le_font_get_atlas_page_count( le_font_o *self ) {
+	auto lock = std::scoped_lock( self->glyph_cache_mtx );
+	return uint32_t( self->atlas_pages.size() );
+}
+
+// ----------------------------------------------------------------------
+// Returns false if the atlas page has no pixels which need uploading.
+static bool le_font_get_atlas_page_dirty_rect( le_font_o *self, uint32_t page_idx, uint32_t *x, uint32_t *y, uint32_t *width, uint32_t *height ) {
+
+	auto lock = std::scoped_lock( self->glyph_cache_mtx );
+
+	if ( page_idx >= self->atlas_pages.size() ) {
+		return false;
+	}
+
+	auto const &page = self->atlas_pages[ page_idx ];
+
+	if ( page.dirty_x0 >= page.dirty_x1 ) {
+		return false;
+	}
+
+	*x      = page.dirty_x0;
+	*y      = page.dirty_y0;
+	*width  = uint32_t( page.dirty_x1 - page.dirty_x0 );
+	*height = uint32_t( page.dirty_y1 - page.dirty_y0 );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Call this once the dirty region of an atlas page has been uploaded - glyphs
+// in this region become available for drawing.
+static void le_font_mark_atlas_page_uploaded( le_font_o *self, uint32_t page_idx ) {
+
+	auto lock = std::scoped_lock( self->glyph_cache_mtx );
+
+	if ( page_idx >= self->atlas_pages.size() ) {
+		return;
+	}
+
+	auto &page = self->atlas_pages[ page_idx ];
+
+	page.dirty_x0 = page.dirty_x1 = 0;
+	page.dirty_y0 = page.dirty_y1 = 0;
+	page.upload_count++;
+}
+
 // ----------------------------------------------------------------------
 
 static uint8_t *le_font_create_codepoint_sdf_bitmap( le_font_o *self, float scale, int codepoint, int padding, unsigned char onedge_value, float pixel_dist_scale, int *width, int *height, int *xoff, int *yoff ) {
@@ -435,6 +917,11 @@ LE_MODULE_REGISTER_IMPL( le_font, api ) {
 	le_font_i.destroy                      = le_font_destroy;
 	le_font_i.create_atlas                 = le_font_create_atlas;
 	le_font_i.get_atlas                    = le_font_get_atlas;
+	le_font_i.update_glyph_cache           = le_font_update_glyph_cache;
+	le_font_i.get_atlas_page_count         = le_font_get_atlas_page_count;
+	le_font_i.get_atlas_page               = le_font_get_atlas_page;
+	le_font_i.get_atlas_page_dirty_rect    = le_font_get_atlas_page_dirty_rect;
+	le_font_i.mark_atlas_page_uploaded     = le_font_mark_atlas_page_uploaded;
 	le_font_i.add_paths_for_glyph          = le_font_add_paths_for_glyph;
 	le_font_i.get_scale_for_pixel_height   = le_font_get_scale_for_pixels_height;
 	le_font_i.create_codepoint_sdf_bitmap  = le_font_create_codepoint_sdf_bitmap;
@@ -39,12 +39,22 @@ struct le_font_api {
 		void                 ( * destroy                    ) ( le_font_o* self );
 		bool                 ( * create_atlas               ) ( le_font_o* self );
 		bool                 ( * get_atlas                  ) ( le_font_o* self, uint8_t const ** pixels, uint32_t * width, uint32_t * height, uint32_t *pix_stride_in_bytes );
-		size_t				 ( * draw_utf8_string           ) ( le_font_o *self, const char *str, float* x_pos, float* y_pos, glm::vec4 *vertices, size_t max_vertices, size_t vertex_offset );
+		size_t				 ( * draw_utf8_string           ) ( le_font_o *self, const char *str, float* x_pos, float* y_pos, glm::vec4 *vertices, size_t max_vertices, size_t vertex_offset, uint32_t *quad_atlas_pages );
 		float                ( * get_scale_for_pixel_height ) ( le_font_o const * self, float height_in_pixels);
 
 		uint8_t*             ( * create_codepoint_sdf_bitmap  ) ( le_font_o* self, float scale, int codepoint, int padding, unsigned char onedge_value, float pixel_dist_scale, int *width, int *height, int *xoff, int *yoff);
 		void                 ( * destroy_codepoint_sdf_bitmap ) ( le_font_o* self, uint8_t * bitmap);
 
+		// Glyph cache: glyphs are rasterised the first time they are drawn, and packed into a
+		// texture atlas of one or more pages. Call `update_glyph_cache` once per frame to rasterise
+		// glyphs which were requested since the last update - then upload the dirty rectangle of
+		// each atlas page, and mark it as uploaded. Glyphs only get drawn once they have been uploaded.
+		void                 ( * update_glyph_cache         ) ( le_font_o* self );
+		uint32_t             ( * get_atlas_page_count       ) ( le_font_o* self );
+		bool                 ( * get_atlas_page             ) ( le_font_o* self, uint32_t page, uint8_t const ** pixels, uint32_t * width, uint32_t * height, uint32_t *pix_stride_in_bytes );
+		bool                 ( * get_atlas_page_dirty_rect  ) ( le_font_o* self, uint32_t page, uint32_t * x, uint32_t * y, uint32_t * width, uint32_t * height );
+		void                 ( * mark_atlas_page_uploaded   ) ( le_font_o* self, uint32_t page );
+
 		// NOTE: `codepoint_prev` is optional, if 0, no kerning is applied, any other value will apply kerning for kerning pair (`codepoint_prev`,`codepoint`).
 		void                 ( * add_paths_for_glyph      ) ( le_font_o const * self, le_path_o* path, int32_t const codepoint, float const scale, Vertex *offset, int32_t const codepoint_prev);
 
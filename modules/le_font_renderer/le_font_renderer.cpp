@@ -6,6 +6,8 @@
 #include "le_pipeline_builder.h"
 
 #include <forward_list>
+#include <vector>
+#include <string.h> // for memcpy
 #include <cstdio>
 #include <atomic>
 #include <algorithm>
@@ -14,13 +16,17 @@
 #define GLM_FORCE_RIGHT_HANDED      // glTF uses right handed coordinate system, and we're following its lead.
 #include "glm/vec4.hpp"
 
+struct font_atlas_page_t {
+	le_img_resource_handle image;
+	le_texture_handle      image_sampler;
+	bool                   was_uploaded; // whether page was uploaded in full at least once
+};
+
 struct font_info_t {
-	le_font_o *            font; // non-owning
-	le_img_resource_handle font_image;
-	le_resource_info_t     font_atlas_info;
-	le_texture_handle      font_image_sampler;
-	bool                   atlas_uploaded;
-	bool                   sampler_created;
+	le_font_o *                    font; // non-owning
+	size_t                         number;
+	le_resource_info_t             font_atlas_info;
+	std::vector<font_atlas_page_t> atlas_pages; // one image per font atlas page
 };
 
 struct le_font_renderer_o {
@@ -53,15 +59,30 @@ void le_font_renderer_destroy( le_font_renderer_o *self ) {
 }
 
 // ----------------------------------------------------------------------
-void le_font_renderer_add_font( le_font_renderer_o *self, le_font_o *font ) {
+// Makes sure that there is an image and sampler for each atlas page of the given font.
+static void font_info_update_atlas_pages( font_info_t &info ) {
 
-	char img_sampler_name[ 32 ] = "";
-	char img_atlas_name[ 32 ]   = "";
+	uint32_t num_pages = le_font::le_font_i.get_atlas_page_count( info.font );
 
-	size_t number = self->counter++;
+	for ( uint32_t i = uint32_t( info.atlas_pages.size() ); i < num_pages; i++ ) {
+
+		char img_sampler_name[ 32 ] = "";
+		char img_atlas_name[ 32 ]   = "";
+
+		snprintf( img_atlas_name, sizeof( img_atlas_name ), "fr_a_%08zu_%u", info.number, i );
+		snprintf( img_sampler_name, sizeof( img_sampler_name ), "fr_s_%08zu_%u", info.number, i );
+
+		info.atlas_pages.push_back(
+		    { LE_IMG_RESOURCE( img_atlas_name ),
+		      le::Renderer::produceTextureHandle( img_sampler_name ),
+		      false } );
+	}
+}
+
+// ----------------------------------------------------------------------
+void le_font_renderer_add_font( le_font_renderer_o *self, le_font_o *font ) {
 
-	snprintf( img_atlas_name, sizeof( img_atlas_name ), "fr_a_%08zu", number );
-	snprintf( img_sampler_name, sizeof( img_sampler_name ), "fr_s_%08zu", number );
+	size_t number = self->counter++;
 
 	using namespace le_font;
 	uint8_t const *pixels_data;
@@ -77,24 +98,22 @@ void le_font_renderer_add_font( le_font_renderer_o *self, le_font_o *font ) {
 	        .setFormat( le::Format::eR8Unorm )
 	        .build();
 
-	auto info =
-	    font_info_t(
-	        { font,
-	          LE_IMG_RESOURCE( img_atlas_name ),
-	          font_atlas_info,
-	          le::Renderer::produceTextureHandle( img_sampler_name ),
-	          false,
-	          false } );
+	font_info_t info{};
+	info.font            = font;
+	info.number          = number;
+	info.font_atlas_info = font_atlas_info;
+
+	font_info_update_atlas_pages( info );
 
-	self->fonts_info.push_front( info );
+	self->fonts_info.emplace_front( std::move( info ) );
 }
 
 // ----------------------------------------------------------------------
 le_texture_handle le_font_renderer_get_font_image_sampler( le_font_renderer_o *self, le_font_o *font ) {
 
 	for ( auto &f : self->fonts_info ) {
-		if ( f.font == font ) {
-			return f.font_image_sampler;
+		if ( f.font == font && !f.atlas_pages.empty() ) {
+			return f.atlas_pages[ 0 ].image_sampler;
 		}
 	}
 
@@ -107,8 +126,8 @@ le_texture_handle le_font_renderer_get_font_image_sampler( le_font_renderer_o *s
 le_img_resource_handle le_font_renderer_get_font_image( le_font_renderer_o *self, le_font_o *font ) {
 
 	for ( auto &f : self->fonts_info ) {
-		if ( f.font == font ) {
-			return f.font_image;
+		if ( f.font == font && !f.atlas_pages.empty() ) {
+			return f.atlas_pages[ 0 ].image;
 		}
 	}
 
@@ -121,17 +140,28 @@ le_img_resource_handle le_font_renderer_get_font_image( le_font_renderer_o *self
 
 bool le_font_renderer_setup_resources( le_font_renderer_o *self, le_render_module_o *module ) {
 
+	// -- Rasterise any glyphs which were requested since the last frame, so that
+	//    they can be uploaded with this frame.
+	for ( auto &fnt : self->fonts_info ) {
+		le_font::le_font_i.update_glyph_cache( fnt.font );
+		font_info_update_atlas_pages( fnt );
+	}
+
 	auto resource_upload_pass =
 	    le::RenderPass( "uploadImage", LE_RENDER_PASS_TYPE_TRANSFER )
 	        .setSetupCallback( self, []( le_renderpass_o *rp_, void *user_data ) -> bool {
 		        le::RenderPass rp{ rp_ };
 
 		        auto self         = static_cast<le_font_renderer_o *>( user_data );
-		        bool needs_upload = false; // If any atlasses need upload this must flip to true.
+		        bool needs_upload = false; // If any atlas pages need upload this must flip to true.
+
+		        uint32_t x, y, w, h;
 
 		        for ( auto &fnt : self->fonts_info ) {
-			        rp.useImageResource( fnt.font_image, { LE_IMAGE_USAGE_TRANSFER_DST_BIT } );
-			        needs_upload |= !fnt.atlas_uploaded;
+			        for ( uint32_t i = 0; i != fnt.atlas_pages.size(); i++ ) {
+				        rp.useImageResource( fnt.atlas_pages[ i ].image, { LE_IMAGE_USAGE_TRANSFER_DST_BIT } );
+				        needs_upload |= le_font::le_font_i.get_atlas_page_dirty_rect( fnt.font, i, &x, &y, &w, &h );
+			        }
 		        }
 
 		        return needs_upload;
@@ -141,23 +171,61 @@ bool le_font_renderer_setup_resources( le_font_renderer_o *self, le_render_modul
 
 		        le::Encoder encoder{ encoder_ };
 
-		        for ( auto &fnt : self->fonts_info ) {
-
-			        if ( fnt.atlas_uploaded ) {
-				        continue;
-			        }
+		        using namespace le_font;
 
-			        auto write_settings = le::WriteToImageSettingsBuilder().build();
+		        std::vector<uint8_t> region_pixels; // scratch memory for pixels of dirty regions
 
-			        using namespace le_font;
-
-			        uint8_t const *pixels_data;
-			        uint32_t       pix_stride;
-			        le_font_i.get_atlas( fnt.font, &pixels_data, &write_settings.image_w, &write_settings.image_h, &pix_stride );
-
-			        encoder.writeToImage( fnt.font_image, write_settings, pixels_data, pix_stride * write_settings.image_w * write_settings.image_h );
-
-			        fnt.atlas_uploaded = true;
+		        for ( auto &fnt : self->fonts_info ) {
+			        for ( uint32_t i = 0; i != fnt.atlas_pages.size(); i++ ) {
+
+				        auto &page = fnt.atlas_pages[ i ];
+
+				        uint32_t x, y, w, h;
+
+				        if ( false == le_font_i.get_atlas_page_dirty_rect( fnt.font, i, &x, &y, &w, &h ) ) {
+					        continue;
+				        }
+
+				        // --------| invariant: page has a dirty region
+
+				        uint8_t const *pixels_data;
+				        uint32_t       atlas_width, atlas_height, pix_stride;
+				        le_font_i.get_atlas_page( fnt.font, i, &pixels_data, &atlas_width, &atlas_height, &pix_stride );
+
+				        if ( false == page.was_uploaded ) {
+					        // The first upload must cover the full page, as partial writes
+					        // depend on the rest of the image holding valid contents.
+					        x = 0;
+					        y = 0;
+					        w = atlas_width;
+					        h = atlas_height;
+				        }
+
+				        auto write_settings =
+				            le::WriteToImageSettingsBuilder()
+				                .setOffsetX( int32_t( x ) )
+				                .setOffsetY( int32_t( y ) )
+				                .setImageW( w )
+				                .setImageH( h )
+				                .build();
+
+				        if ( w == atlas_width ) {
+					        // Rows are contiguous in atlas memory, we can upload directly.
+					        encoder.writeToImage( page.image, write_settings, pixels_data + size_t( y ) * atlas_width * pix_stride, pix_stride * w * h );
+				        } else {
+					        // Gather rows of dirty region into tightly packed scratch memory.
+					        region_pixels.resize( size_t( w ) * h * pix_stride );
+					        for ( uint32_t row = 0; row != h; row++ ) {
+						        memcpy( region_pixels.data() + size_t( row ) * w * pix_stride,
+						                pixels_data + ( size_t( y + row ) * atlas_width + x ) * pix_stride,
+						                size_t( w ) * pix_stride );
+					        }
+					        encoder.writeToImage( page.image, write_settings, region_pixels.data(), uint32_t( region_pixels.size() ) );
+				        }
+
+				        le_font_i.mark_atlas_page_uploaded( fnt.font, i );
+				        page.was_uploaded = true;
+			        }
 		        }
 	        } );
 
@@ -168,7 +236,9 @@ bool le_font_renderer_setup_resources( le_font_renderer_o *self, le_render_modul
 
 	// -- make resource names visible to rendergraph
 	for ( auto &fnt : self->fonts_info ) {
-		render_module_i.declare_resource( module, fnt.font_image, fnt.font_atlas_info );
+		for ( auto &page : fnt.atlas_pages ) {
+			render_module_i.declare_resource( module, page.image, fnt.font_atlas_info );
+		}
 	}
 
 	return true;
@@ -198,16 +268,19 @@ bool le_font_renderer_use_fonts( le_font_renderer_o *self, le_font_o **fonts, si
 			continue;
 		}
 
-		le_image_sampler_info_t font_sampler_info =
-		    le::ImageSamplerInfoBuilder()
-		        .withImageViewInfo()
-		        .setImage( found_info->font_image )
-		        .end()
-		        .build();
-
 		using namespace le_renderer;
 
-		renderpass_i.sample_texture( pass, found_info->font_image_sampler, &font_sampler_info );
+		for ( auto const &page : found_info->atlas_pages ) {
+
+			le_image_sampler_info_t font_sampler_info =
+			    le::ImageSamplerInfoBuilder()
+			        .withImageViewInfo()
+			        .setImage( page.image )
+			        .end()
+			        .build();
+
+			renderpass_i.sample_texture( pass, page.image_sampler, &font_sampler_info );
+		}
 	}
 
 	return true;
@@ -229,11 +302,37 @@ bool le_font_renderer_draw_string( le_font_renderer_o *self, le_font_o *font, le
 
 	using namespace le_font;
 
-	size_t                 num_vertices = le_font_i.draw_utf8_string( font, info.str, nullptr, nullptr, nullptr, 0, 0 );
+	font_info_t const *found_info = nullptr;
+
+	for ( auto const &f : self->fonts_info ) {
+		if ( f.font == font ) {
+			found_info = &f;
+			break;
+		}
+	}
+
+	if ( nullptr == found_info || found_info->atlas_pages.empty() ) {
+		assert( false && "font was not found in font_renderer" );
+		return false;
+	}
+
+	// --------| invariant: font has at least one atlas page
+
+	size_t                 num_vertices = le_font_i.draw_utf8_string( font, info.str, nullptr, nullptr, nullptr, 0, 0, nullptr );
 	std::vector<glm::vec4> vertices;
+	std::vector<uint32_t>  quad_pages;
 
 	vertices.resize( num_vertices );
-	le_font_i.draw_utf8_string( font, info.str, &info.x, &info.y, vertices.data(), num_vertices, 0 );
+	quad_pages.resize( num_vertices / 6 );
+	num_vertices = le_font_i.draw_utf8_string( font, info.str, &info.x, &info.y, vertices.data(), num_vertices, 0, quad_pages.data() );
+	vertices.resize( num_vertices );
+	quad_pages.resize( num_vertices / 6 );
+
+	if ( vertices.empty() ) {
+		return true;
+	}
+
+	// --------| invariant: there are glyphs to draw
 
 	struct NoMvpUbo {
 		glm::vec4 screen_extents;
@@ -244,11 +343,44 @@ bool le_font_renderer_draw_string( le_font_renderer_o *self, le_font_o *font, le
 	encoder
 	    .bindGraphicsPipeline( pipeline )
 	    .setArgumentData( LE_ARGUMENT_NAME( "Extents" ), &no_mvp_ubo, sizeof( NoMvpUbo ) ) //
-	    .setVertexData( vertices.data(), sizeof( glm::vec4 ) * vertices.size(), 0 )
-	    .setArgumentTexture( LE_ARGUMENT_NAME( "tex_unit_0" ), le_font_renderer_get_font_image_sampler( self, font ) )
-	    .setArgumentData( LE_ARGUMENT_NAME( "VertexColor" ), &info.color, sizeof( info.color ) )
-	    .draw( uint32_t( vertices.size() ) ) //
-	    ;
+	    .setArgumentData( LE_ARGUMENT_NAME( "VertexColor" ), &info.color, sizeof( info.color ) );
+
+	bool const single_page = std::all_of( quad_pages.begin(), quad_pages.end(), [ & ]( uint32_t p ) { return p == quad_pages[ 0 ]; } );
+
+	if ( single_page ) {
+		encoder
+		    .setVertexData( vertices.data(), sizeof( glm::vec4 ) * vertices.size(), 0 )
+		    .setArgumentTexture( LE_ARGUMENT_NAME( "tex_unit_0" ), found_info->atlas_pages[ quad_pages[ 0 ] ].image_sampler )
+		    .draw( uint32_t( vertices.size() ) ) //
+		    ;
+		return true;
+	}
+
+	// --------| invariant: glyphs are spread over more than one atlas page - we issue one draw per page.
+
+	std::vector<glm::vec4> page_vertices;
+	page_vertices.reserve( vertices.size() );
+
+	for ( uint32_t p = 0; p != found_info->atlas_pages.size(); p++ ) {
+
+		page_vertices.clear();
+
+		for ( size_t q = 0; q != quad_pages.size(); q++ ) {
+			if ( quad_pages[ q ] == p ) {
+				page_vertices.insert( page_vertices.end(), vertices.begin() + q * 6, vertices.begin() + q * 6 + 6 );
+			}
+		}
+
+		if ( page_vertices.empty() ) {
+			continue;
+		}
+
+		encoder
+		    .setVertexData( page_vertices.data(), sizeof( glm::vec4 ) * page_vertices.size(), 0 )
+		    .setArgumentTexture( LE_ARGUMENT_NAME( "tex_unit_0" ), found_info->atlas_pages[ p ].image_sampler )
+		    .draw( uint32_t( page_vertices.size() ) ) //
+		    ;
+	}
 
 	return true;
 }
@@ -12,6 +12,19 @@
 #include <filesystem>
 #include <iostream>
 #include <iomanip>
+#include <atomic>
+
+#ifndef _WIN32
+// On posix systems, we memory-map glTF files, and external buffer files,
+// so that buffer data does not need to be copied into heap memory.
+#	define LE_GLTF_USE_MMAP 1
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#else
+#	define LE_GLTF_USE_MMAP 0
+#endif
 
 #define GLM_FORCE_RIGHT_HANDED // glTF uses right handed coordinate system, and we're following its lead.
 #define GLM_ENABLE_EXPERIMENTAL
@@ -20,6 +33,10 @@
 #include "glm/gtx/quaternion.hpp"
 #include <glm/gtx/matrix_decompose.hpp>
 
+// Max number of bytes of pixels decoded in parallel in any one round when importing images - 0 means unlimited.
+// This limits concurrency, not memory: decoded pixels stay resident until the stage uploads them.
+static constexpr uint64_t LE_GLTF_IMAGE_DECODE_MAX_ROUND_BYTES = 1024ull * 1024ull * 1024ull;
+
 // Wrappers so that we can pass data via opaque pointers across header boundaries
 struct glm_vec3_t {
 	glm::vec3 data;
@@ -46,13 +63,134 @@ How to use this library:
 // when you create a mesh, you do it through the stage - which manages/stores the data for that mesh
 // the stage may also optimise data
 
+// A memory-mapped file. Mapped files are shared between cgltf and the stage:
+// the mapping is released once both have released it.
+struct le_gltf_mapped_file_o {
+	void *                addr;      // start of mapping
+	size_t                size;      // number of bytes mapped
+	std::atomic<uint32_t> ref_count; // mapping gets unmapped once this drops to zero
+};
+
 struct le_gltf_o {
-	cgltf_options         options = {};
-	cgltf_data *          data    = nullptr;
-	cgltf_result          result  = {};
-	std::filesystem::path gltf_file_path; // owning
+	cgltf_options                                             options = {};
+	cgltf_data *                                              data    = nullptr;
+	cgltf_result                                              result  = {};
+	std::filesystem::path                                     gltf_file_path; // owning
+	std::unordered_map<void const *, le_gltf_mapped_file_o *> mapped_files;   // non-owning: files currently mapped by cgltf, indexed by start of mapping
 };
 
+// ----------------------------------------------------------------------
+// Decrements reference count for mapped file, and unmaps file once nobody uses it anymore.
+// This may be called from any thread.
+static void le_gltf_mapped_file_release( void *mapped_file_ ) {
+#if ( LE_GLTF_USE_MMAP )
+	auto mapped_file = static_cast<le_gltf_mapped_file_o *>( mapped_file_ );
+
+	if ( 1 == mapped_file->ref_count.fetch_sub( 1 ) ) {
+		munmap( mapped_file->addr, mapped_file->size );
+		delete mapped_file;
+	}
+#endif
+}
+
+#if ( LE_GLTF_USE_MMAP )
+
+// ----------------------------------------------------------------------
+// File read callback for cgltf: instead of reading file contents into heap memory,
+// we map the file into memory. Mapping is private so that any modifications made
+// to buffer data in memory will never be written back to the file.
+static cgltf_result le_gltf_file_read_mmap( const cgltf_memory_options *memory_options, const cgltf_file_options *file_options, const char *path, cgltf_size *size, void **data ) {
+
+	auto self = static_cast<le_gltf_o *>( file_options->user_data );
+
+	int fd = open( path, O_RDONLY );
+
+	if ( fd < 0 ) {
+		return cgltf_result_file_not_found;
+	}
+
+	struct stat file_stat {};
+
+	if ( fstat( fd, &file_stat ) != 0 || file_stat.st_size <= 0 ) {
+		close( fd );
+		return cgltf_result_io_error;
+	}
+
+	size_t file_size = size_t( file_stat.st_size );
+
+	if ( *size > file_size ) {
+		// File is smaller than what was requested.
+		close( fd );
+		return cgltf_result_data_too_short;
+	}
+
+	void *addr = mmap( nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+
+	close( fd ); // mapping stays valid after file descriptor has been closed.
+
+	if ( addr == MAP_FAILED ) {
+		return cgltf_result_io_error;
+	}
+
+	auto mapped_file       = new le_gltf_mapped_file_o{};
+	mapped_file->addr      = addr;
+	mapped_file->size      = file_size;
+	mapped_file->ref_count = 1; // reference held by cgltf
+
+	self->mapped_files[ addr ] = mapped_file;
+
+	if ( *size == 0 ) {
+		*size = file_size;
+	}
+
+	*data = addr;
+
+	return cgltf_result_success;
+}
+
+// ----------------------------------------------------------------------
+// File release callback for cgltf: releases cgltf's reference to a mapped file.
+static void le_gltf_file_release_mmap( const cgltf_memory_options *memory_options, const cgltf_file_options *file_options, void *data ) {
+
+	auto self = static_cast<le_gltf_o *>( file_options->user_data );
+
+	auto it = self->mapped_files.find( data );
+
+	if ( it == self->mapped_files.end() ) {
+		assert( false && "data must have been mapped by le_gltf_file_read_mmap" );
+		return;
+	}
+
+	le_gltf_mapped_file_o *mapped_file = it->second;
+	self->mapped_files.erase( it );
+
+	le_gltf_mapped_file_release( mapped_file );
+}
+
+// ----------------------------------------------------------------------
+// cgltf 1.14 added the size of the file to its file release callback, and cgltf does
+// not define a version macro to test for. We provide both signatures, and let overload
+// resolution pick the one which matches `cgltf_file_options::release`.
+[[maybe_unused]] static void le_gltf_file_release_mmap( const cgltf_memory_options *memory_options, const cgltf_file_options *file_options, void *data, cgltf_size ) {
+	le_gltf_file_release_mmap( memory_options, file_options, data );
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+// Returns mapped file which contains given memory range, or nullptr if
+// memory range is not part of any mapped file.
+static le_gltf_mapped_file_o *le_gltf_find_mapped_file( le_gltf_o const *self, void const *mem, size_t sz ) {
+	for ( auto const &f : self->mapped_files ) {
+		char const *begin = static_cast<char const *>( f.second->addr );
+		char const *m     = static_cast<char const *>( mem );
+		if ( m >= begin && m + sz <= begin + f.second->size ) {
+			return f.second;
+		}
+	}
+	return nullptr;
+}
+
 // ----------------------------------------------------------------------
 
 static void le_gltf_destroy( le_gltf_o *self ) {
@@ -70,13 +208,22 @@ static le_gltf_o *le_gltf_create( char const *path ) {
 
 	assert( path && "valid path must be set" );
 
-	auto self    = new le_gltf_o{};
+	auto self = new le_gltf_o{};
+
+#if ( LE_GLTF_USE_MMAP )
+	self->options.file.read      = le_gltf_file_read_mmap;
+	self->options.file.release   = le_gltf_file_release_mmap;
+	self->options.file.user_data = self;
+#endif
+
 	self->result = cgltf_parse_file( &self->options, path, &self->data );
 
 	if ( self->result == cgltf_result_success ) {
 
 		// This will load buffers from file, or data URIs,
 		// and will allocate memory inside the cgltf module.
+		// Buffers from files (and the binary chunk of .glb files) will be memory-mapped
+		// if LE_GLTF_USE_MMAP is set.
 		//
 		// Memory will be freed when calling `cgltf_free(self->data)`
 		cgltf_result buffer_load_result = cgltf_load_buffers( &self->options, self->data, path );
@@ -275,6 +422,10 @@ static bool le_gltf_import( le_gltf_o *self, le_stage_o *stage ) {
 		// We must copy because we cannot otherwise guarantee that the image data will still be available when stage
 		// uploads it to the gpu, as the upload step happens in another method than the import step.
 
+		// Images are created deferred: stage only reads image headers here, and decodes all images
+		// in parallel while we continue importing the rest of the file. We wait for decoding to
+		// complete at the very end of the import - image data from buffers stays valid until then.
+
 		cgltf_image const *images_begin = self->data->images;
 		auto               images_end   = images_begin + self->data->images_count;
 
@@ -294,14 +445,14 @@ static bool le_gltf_import( le_gltf_o *self, le_stage_o *stage ) {
 					img_path = self->gltf_file_path.parent_path() / img_path;
 				}
 
-				stage_idx = le_stage_i.create_image_from_file_path( stage, img_path.c_str(), img->name ? img->name : img->uri, 0 );
+				stage_idx = le_stage_i.create_image_from_file_path_deferred( stage, img_path.c_str(), img->name ? img->name : img->uri, 0 );
 
 			} else if ( img->buffer_view && img->buffer_view->buffer && img->buffer_view->buffer->data ) {
 
 				unsigned char const *data = static_cast<unsigned char const *>( img->buffer_view->buffer->data );
 				data += img->buffer_view->offset;
 				size_t data_sz = img->buffer_view->size;
-				stage_idx      = le_stage_i.create_image_from_memory( stage, data, uint32_t( data_sz ), img->name ? img->name : img->uri, 0 );
+				stage_idx      = le_stage_i.create_image_from_memory_deferred( stage, data, uint32_t( data_sz ), img->name ? img->name : img->uri, 0 );
 
 			} else {
 				assert( false && "image must either have inline data or provide an uri" );
@@ -309,6 +460,8 @@ static bool le_gltf_import( le_gltf_o *self, le_stage_o *stage ) {
 
 			images_map.insert( { img, stage_idx } );
 		}
+
+		le_stage_i.decode_deferred_images( stage, LE_GLTF_IMAGE_DECODE_MAX_ROUND_BYTES );
 	}
 
 	{
@@ -380,7 +533,19 @@ static bool le_gltf_import( le_gltf_o *self, le_stage_o *stage ) {
 		int i = 0;
 		for ( auto b = buffers_begin; b != buffers_end; b++, ++i ) {
 			snprintf( debug_name, 32, "glTF_buffer_%d", i );
-			uint32_t stage_idx = le_stage_i.create_buffer( stage, b->data, uint32_t( b->size ), debug_name );
+
+			uint32_t stage_idx;
+
+			if ( le_gltf_mapped_file_o *mapped_file = le_gltf_find_mapped_file( self, b->data, b->size ) ) {
+				// Buffer data lives inside a mapped file: stage may refer to the mapping directly,
+				// and keeps the mapping alive until it has uploaded the buffer to the gpu.
+				mapped_file->ref_count++;
+				stage_idx = le_stage_i.create_buffer_from_external_memory( stage, b->data, uint32_t( b->size ), debug_name, le_gltf_mapped_file_release, mapped_file );
+			} else {
+				// Buffer data was allocated by cgltf (from a data uri) - stage must copy.
+				stage_idx = le_stage_i.create_buffer( stage, b->data, uint32_t( b->size ), debug_name );
+			}
+
 			buffer_map.insert( { b, stage_idx } );
 		}
 	}
@@ -1050,6 +1215,9 @@ static bool le_gltf_import( le_gltf_o *self, le_stage_o *stage ) {
 		}
 	}
 
+	// Wait for images which we started decoding at the beginning of the import.
+	le_stage_i.wait_for_deferred_images( stage );
+
 	return true;
 }
 
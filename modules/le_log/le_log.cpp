@@ -4,8 +4,28 @@
 
 #include <atomic>
 #include <mutex>
+#include <thread>
+#include <chrono>
 #include <unordered_map>
 #include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+/*
+ * In synchronous mode (default), messages are written on the calling thread.
+ *
+ * In asynchronous mode, messages are formatted on the calling thread into a slot
+ * of a bounded ring buffer, and written by a background writer thread. Claiming
+ * a slot is lock-free, which means that threads which log don't wait for each
+ * other, nor for output. If the ring buffer is full, messages are dropped and
+ * counted; the writer reports how many messages were dropped.
+ *
+ */
+
+static constexpr size_t LE_LOG_ASYNC_NUM_SLOTS    = 4096; // must be a power of two
+static constexpr size_t LE_LOG_ASYNC_MESSAGE_SIZE = 496;  // messages which are longer get truncated
+
+static_assert( ( LE_LOG_ASYNC_NUM_SLOTS & ( LE_LOG_ASYNC_NUM_SLOTS - 1 ) ) == 0, "number of slots must be a power of two" );
 
 struct le_log_channel_o {
 	std::string name = "DEFAULT";
@@ -16,10 +36,33 @@ struct le_log_channel_o {
 #endif
 };
 
+struct le_log_slot_t {
+	std::atomic<size_t>     sequence; // slot may be written if sequence == enqueue position, read if sequence == dequeue position + 1
+	le_log_channel_o const *channel;
+	LeLog::Level            level;
+	char                    text[ LE_LOG_ASYNC_MESSAGE_SIZE ];
+};
+
 struct le_log_context_o {
 	le_log_channel_o                                    channel_default;
 	std::unordered_map<std::string, le_log_channel_o *> channels;
 	std::mutex                                          mtx;
+
+	std::mutex output_mtx;            // protects output_file, and writing to output
+	FILE *     output_file = nullptr; // nullptr means stdout, or stderr for errors
+
+	// Asynchronous mode
+
+	std::atomic_bool    is_async{ false };          // true while messages go to the ring buffer - only if there is a writer thread
+	std::atomic_bool    writer_should_run{ false }; // true while asynchronous mode is switched on, even if the writer thread is suspended
+	le_log_slot_t *     slots = nullptr;            // ring buffer, allocated when asynchronous mode is first switched on
+	std::atomic<size_t> enqueue_pos{ 0 };           // next slot to claim
+	std::atomic<size_t> num_written{ 0 };           // number of slots which have been written to output
+	std::atomic<size_t> num_dropped{ 0 };           // number of messages dropped because ring buffer was full
+	size_t              dequeue_pos         = 0;    // only accessed by whoever drains
+	size_t              num_dropped_written = 0;    // number of dropped messages which we have reported
+	std::thread         writer;
+	std::atomic_bool    writer_should_stop{ false };
 };
 
 static le_log_context_o *ctx;
@@ -64,6 +107,171 @@ static const char *le_log_level_name( LeLog::Level level ) {
 	return "";
 }
 
+// ----------------------------------------------------------------------
+// Writes one message to output. Caller must hold ctx->output_mtx.
+static void le_log_write( const le_log_channel_o *channel, LeLog::Level level, const char *text ) {
+
+	auto file = ctx->output_file;
+
+	if ( file == nullptr ) {
+		file = ( level == LeLog::Level::eError ) ? stderr : stdout;
+	}
+
+	fprintf( file, "[ %-25s | %-7s ] %s\n", channel->name.c_str(), le_log_level_name( level ), text );
+}
+
+// ----------------------------------------------------------------------
+
+static void le_log_flush_output() {
+	if ( ctx->output_file ) {
+		fflush( ctx->output_file );
+	} else {
+		fflush( stdout );
+		fflush( stderr );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Writes all messages which have been published to the ring buffer so far.
+// Must only be called by one thread at a time: the writer thread, or, if
+// there is no writer thread, whoever stopped it.
+static size_t le_log_drain() {
+
+	size_t const mask        = LE_LOG_ASYNC_NUM_SLOTS - 1;
+	size_t       num_drained = 0;
+
+	std::scoped_lock lock( ctx->output_mtx );
+
+	for ( ;; ) {
+		le_log_slot_t &slot = ctx->slots[ ctx->dequeue_pos & mask ];
+
+		if ( slot.sequence.load( std::memory_order_acquire ) != ctx->dequeue_pos + 1 ) {
+			break; // slot has not been published yet
+		}
+
+		le_log_write( slot.channel, slot.level, slot.text );
+
+		// Hand slot back to producers, one round further on.
+		slot.sequence.store( ctx->dequeue_pos + LE_LOG_ASYNC_NUM_SLOTS, std::memory_order_release );
+		ctx->dequeue_pos++;
+		num_drained++;
+	}
+
+	size_t const num_dropped = ctx->num_dropped.load( std::memory_order_relaxed );
+
+	if ( num_dropped != ctx->num_dropped_written ) {
+		char text[ 64 ];
+		snprintf( text, sizeof( text ), "Log buffer full: dropped %zu messages", num_dropped - ctx->num_dropped_written );
+		le_log_write( le_log_channel_default(), LeLog::Level::eWarn, text );
+		ctx->num_dropped_written = num_dropped;
+	}
+
+	if ( num_drained ) {
+		le_log_flush_output();
+	}
+
+	ctx->num_written.store( ctx->dequeue_pos, std::memory_order_release );
+
+	return num_drained;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_log_writer_run() {
+	uint32_t num_idle = 0; // number of consecutive rounds in which there was nothing to write
+
+	while ( !ctx->writer_should_stop.load( std::memory_order_relaxed ) ) {
+		if ( le_log_drain() ) {
+			num_idle = 0;
+		} else if ( ++num_idle < 64 ) {
+			std::this_thread::yield(); // more messages are likely to follow soon
+		} else {
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		}
+	}
+	le_log_drain();
+}
+
+// ----------------------------------------------------------------------
+
+static void le_log_writer_start() {
+	if ( ctx->writer.joinable() ) {
+		return;
+	}
+	ctx->writer_should_stop = false;
+	ctx->writer             = std::thread( le_log_writer_run );
+}
+
+// ----------------------------------------------------------------------
+// Stops writer thread once it has written all pending messages.
+static void le_log_writer_stop() {
+	if ( !ctx->writer.joinable() ) {
+		return;
+	}
+	ctx->writer_should_stop = true;
+	ctx->writer.join();
+}
+
+// ----------------------------------------------------------------------
+// Routes messages to output synchronously, stops the writer thread, and writes
+// whatever was left in the ring buffer. Caller must hold ctx->mtx.
+static void le_log_writer_suspend() {
+	ctx->is_async = false;
+	le_log_writer_stop();
+	if ( ctx->slots ) {
+		le_log_drain(); // write anything which was enqueued while we were stopping
+	}
+}
+
+// ----------------------------------------------------------------------
+// Claims a slot in the ring buffer, formats message into it, and publishes it.
+// Returns false if the ring buffer was full.
+static bool le_log_enqueue( const le_log_channel_o *channel, LeLog::Level level, const char *msg, va_list args ) {
+
+	size_t const   mask = LE_LOG_ASYNC_NUM_SLOTS - 1;
+	le_log_slot_t *slot;
+	size_t         pos = ctx->enqueue_pos.load( std::memory_order_relaxed );
+
+	for ( ;; ) {
+		slot             = &ctx->slots[ pos & mask ];
+		size_t  sequence = slot->sequence.load( std::memory_order_acquire );
+		int64_t diff     = int64_t( sequence ) - int64_t( pos );
+
+		if ( diff == 0 ) {
+			// Slot is free - try to claim it.
+			if ( ctx->enqueue_pos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+				break;
+			}
+		} else if ( diff < 0 ) {
+			// Slot still holds a message from the previous round: ring buffer is full.
+			ctx->num_dropped.fetch_add( 1, std::memory_order_relaxed );
+			return false;
+		} else {
+			// Another thread claimed this slot before us.
+			pos = ctx->enqueue_pos.load( std::memory_order_relaxed );
+		}
+	}
+
+	// --------| invariant: slot is ours until we publish it
+
+	slot->channel = channel;
+	slot->level   = level;
+
+	int length = vsnprintf( slot->text, sizeof( slot->text ), msg, args );
+
+	if ( length >= int( sizeof( slot->text ) ) ) {
+		memcpy( slot->text + sizeof( slot->text ) - 4, "...", 4 ); // mark message as truncated
+	}
+
+	slot->sequence.store( pos + 1, std::memory_order_release );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_log_flush();
+
 static void le_log_printf( const le_log_channel_o *channel, LeLog::Level level, const char *msg, va_list args ) {
 
 	if ( !channel ) {
@@ -74,18 +282,37 @@ static void le_log_printf( const le_log_channel_o *channel, LeLog::Level level,
 		return;
 	}
 
-	auto file = stdout;
-
-	if ( level == LeLog::Level::eError ) {
-		file = stderr;
+	if ( ctx->is_async.load( std::memory_order_relaxed ) ) {
+		le_log_enqueue( channel, level, msg, args );
+		if ( level == LeLog::Level::eError ) {
+			le_log_flush(); // make sure errors are visible, even if we are about to crash
+		}
+		return;
 	}
 
-	fprintf( file, "[ %-25s | %-7s ] ", channel->name.c_str(), le_log_level_name( level ) );
+	char  text_local[ 512 ];
+	char *text = text_local;
 
-	vfprintf( file, msg, args );
-	fprintf( file, "\n" );
+	va_list args_copy;
+	va_copy( args_copy, args );
+	int length = vsnprintf( text_local, sizeof( text_local ), msg, args_copy );
+	va_end( args_copy );
 
-	fflush( file );
+	if ( length >= int( sizeof( text_local ) ) ) {
+		// Message does not fit on the stack.
+		text = new char[ length + 1 ];
+		vsnprintf( text, size_t( length ) + 1, msg, args );
+	}
+
+	{
+		std::scoped_lock lock( ctx->output_mtx );
+		le_log_write( channel, level, text );
+		le_log_flush_output();
+	}
+
+	if ( text != text_local ) {
+		delete[] text;
+	}
 }
 
 template <LeLog::Level level>
@@ -98,10 +325,109 @@ static void le_log_implementation( const le_log_channel_o *channel, const char *
 
 // ----------------------------------------------------------------------
 
+static void le_log_set_async( bool is_async ) {
+	std::scoped_lock g( ctx->mtx );
+
+	if ( is_async ) {
+		if ( ctx->slots == nullptr ) {
+			ctx->slots = new le_log_slot_t[ LE_LOG_ASYNC_NUM_SLOTS ];
+			for ( size_t i = 0; i != LE_LOG_ASYNC_NUM_SLOTS; i++ ) {
+				ctx->slots[ i ].sequence.store( i, std::memory_order_relaxed );
+			}
+		}
+		ctx->writer_should_run = true;
+		le_log_writer_start();
+		ctx->is_async = true;
+	} else {
+		ctx->writer_should_run = false;
+		le_log_writer_suspend();
+	}
+}
+
+// ----------------------------------------------------------------------
+// Blocks until all messages which were logged before this call have been written.
+static void le_log_flush() {
+
+	if ( ctx->slots == nullptr ) {
+		std::scoped_lock lock( ctx->output_mtx );
+		le_log_flush_output();
+		return;
+	}
+
+	size_t const target = ctx->enqueue_pos.load( std::memory_order_acquire );
+
+	while ( ctx->num_written.load( std::memory_order_acquire ) < target ) {
+		{
+			std::scoped_lock g( ctx->mtx );
+			if ( !ctx->writer.joinable() ) {
+				// No writer thread - messages which were enqueued while the
+				// writer was stopping must be written by us.
+				le_log_drain();
+			}
+		}
+		std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Redirects all output to file at path; nullptr redirects output back to stdout/stderr.
+static bool le_log_set_output_file( char const *path ) {
+
+	FILE *file = nullptr;
+
+	if ( path ) {
+		file = fopen( path, "w" );
+		if ( !file ) {
+			return false;
+		}
+	}
+
+	le_log_flush();
+
+	std::scoped_lock lock( ctx->output_mtx );
+
+	if ( ctx->output_file ) {
+		fclose( ctx->output_file );
+	}
+
+	ctx->output_file = file;
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static uint64_t le_log_get_num_dropped_messages() {
+	return ctx->num_dropped.load( std::memory_order_relaxed );
+}
+
+// ----------------------------------------------------------------------
+// The writer thread runs code from this module: it must not outlive the
+// module, which may be unloaded on reload, or on exit. We suspend it when
+// static objects are destroyed - messages logged after that are written
+// synchronously - and restart it once the module is registered again.
+struct le_log_writer_guard_t {
+	~le_log_writer_guard_t() {
+		if ( ctx ) {
+			std::scoped_lock g( ctx->mtx );
+			le_log_writer_suspend();
+		}
+	}
+};
+
+static le_log_writer_guard_t writer_guard;
+
+// ----------------------------------------------------------------------
+
 LE_MODULE_REGISTER_IMPL( le_log, api ) {
 	auto le_api         = static_cast<le_log_api *>( api );
 	le_api->get_channel = le_log_get_module;
 
+	le_api->set_async                = le_log_set_async;
+	le_api->set_output_file          = le_log_set_output_file;
+	le_api->flush                    = le_log_flush;
+	le_api->get_num_dropped_messages = le_log_get_num_dropped_messages;
+
 	auto &le_api_channel_i     = le_api->le_log_channel_i;
 	le_api_channel_i.debug     = le_log_implementation<LeLog::Level::eDebug>;
 	le_api_channel_i.info      = le_log_implementation<LeLog::Level::eInfo>;
@@ -116,4 +442,12 @@ LE_MODULE_REGISTER_IMPL( le_log, api ) {
 	}
 
 	ctx = static_cast<le_log_context_o *>( *fallback_context_addr );
+
+	if ( ctx->writer_should_run ) {
+		// Module was reloaded while in asynchronous mode - the writer thread
+		// was suspended when the previous version of this module was unloaded.
+		std::scoped_lock g( ctx->mtx );
+		le_log_writer_start();
+		ctx->is_async = true;
+	}
 }
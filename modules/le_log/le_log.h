@@ -31,6 +31,16 @@
 
 #endif
 
+// Calls to log functions for levels below `LE_LOG_COMPILE_LEVEL` compile to
+// nothing. Unless you set `LE_LOG_LEVEL` explicitly, this is only the case for
+// Release builds - in Debug builds, all calls are compiled in, and you may still
+// filter messages at runtime via `set_level`.
+#ifdef LE_LOG_LEVEL
+#	define LE_LOG_COMPILE_LEVEL LE_LOG_LEVEL
+#else
+#	define LE_LOG_COMPILE_LEVEL LE_LOG_LEVEL_DEBUG
+#endif
+
 struct le_log_channel_o;
 struct le_log_context_o;
 
@@ -46,6 +56,19 @@ struct le_log_api {
 
     le_log_channel_o *( * get_channel )(const char *name);
 
+    // In asynchronous mode, messages are formatted on the calling thread, and written
+    // to output by a background thread. If messages are logged faster than they can
+    // be written, messages are dropped - and the number of dropped messages is logged.
+    void     ( * set_async                )(bool is_async);
+
+    // Redirects output for all channels to a file, nullptr means stdout (stderr for errors).
+    bool     ( * set_output_file          )(const char *path);
+
+    // Blocks until all messages logged before this call have been written.
+    void     ( * flush                    )();
+
+    uint64_t ( * get_num_dropped_messages )();
+
     struct le_log_channel_interface_t {
 
         // Set the log level for a given channel - Messages below the given level will be ignored. 
@@ -96,28 +119,28 @@ class LeLog {
 
 	template <class... Args>
 	inline void debug( const char *msg, Args &&...args ) {
-#	if ( !defined NDEBUG ) || LE_LOG_LEVEL <= LE_LOG_LEVEL_DEBUG
+#	if LE_LOG_COMPILE_LEVEL <= LE_LOG_LEVEL_DEBUG
 		le_log::le_log_channel_i.debug( channel, msg, static_cast<Args &&>( args )... );
 #	endif
 	}
 
 	template <class... Args>
 	inline void info( const char *msg, Args &&...args ) {
-#	if ( !defined NDEBUG ) || LE_LOG_LEVEL <= LE_LOG_LEVEL_INFO
+#	if LE_LOG_COMPILE_LEVEL <= LE_LOG_LEVEL_INFO
 		le_log::le_log_channel_i.info( channel, msg, static_cast<Args &&>( args )... );
 #	endif
 	}
 
 	template <class... Args>
 	inline void warn( const char *msg, Args &&...args ) {
-#	if ( !defined NDEBUG ) || LE_LOG_LEVEL <= LE_LOG_LEVEL_WARN
+#	if LE_LOG_COMPILE_LEVEL <= LE_LOG_LEVEL_WARN
 		le_log::le_log_channel_i.warn( channel, msg, static_cast<Args &&>( args )... );
 #	endif
 	}
 
 	template <class... Args>
 	inline void error( const char *msg, Args &&...args ) {
-#	if ( !defined NDEBUG ) || LE_LOG_LEVEL <= LE_LOG_LEVEL_ERROR
+#	if LE_LOG_COMPILE_LEVEL <= LE_LOG_LEVEL_ERROR
 		le_log::le_log_channel_i.error( channel, msg, static_cast<Args &&>( args )... );
 #	endif
 	}
@@ -130,28 +153,28 @@ static inline void le_log_set_level( const LeLog::Level &level ) {
 
 template <typename... Args>
 static inline void le_log_debug( const char *msg, Args &&...args ) {
-#	if ( !defined NDEBUG ) || LE_LOG_LEVEL <= LE_LOG_LEVEL_DEBUG
+#	if LE_LOG_COMPILE_LEVEL <= LE_LOG_LEVEL_DEBUG
 	le_log::le_log_channel_i.debug( nullptr, msg, static_cast<Args &&>( args )... );
 #	endif
 }
 
 template <typename... Args>
 static inline void le_log_info( const char *msg, Args &&...args ) {
-#	if ( !defined NDEBUG ) || LE_LOG_LEVEL <= LE_LOG_LEVEL_INFO
+#	if LE_LOG_COMPILE_LEVEL <= LE_LOG_LEVEL_INFO
 	le_log::le_log_channel_i.info( nullptr, msg, static_cast<Args &&>( args )... );
 #	endif
 }
 
 template <typename... Args>
 static inline void le_log_warn( const char *msg, Args &&...args ) {
-#	if ( !defined NDEBUG ) || LE_LOG_LEVEL <= LE_LOG_LEVEL_WARN
+#	if LE_LOG_COMPILE_LEVEL <= LE_LOG_LEVEL_WARN
 	le_log::le_log_channel_i.warn( nullptr, msg, static_cast<Args &&>( args )... );
 #	endif
 }
 
 template <typename... Args>
 static inline void le_log_error( const char *msg, Args &&...args ) {
-#	if ( !defined NDEBUG ) || LE_LOG_LEVEL <= LE_LOG_LEVEL_ERROR
+#	if LE_LOG_COMPILE_LEVEL <= LE_LOG_LEVEL_ERROR
 	le_log::le_log_channel_i.error( nullptr, msg, static_cast<Args &&>( args )... );
 #	endif
 }
@@ -3,20 +3,42 @@
 
 #include <math.h>
 #include <vector>
+#include <algorithm>
 #include <filesystem> // for file loading
 #include <iostream>   // for file loading
 #include <fstream>    // for file loading
 #include <iomanip>    // for file loading
 
 #include <cstring>
+#include <string>
+#include <string_view>
 
 #include "le_mesh_types.h" //
 
 #ifdef _WIN32
 	# define __PRETTY_FUNCTION__ __FUNCSIG__
-	# define strtok_r strtok_s
 #endif// 
 
+#ifndef _WIN32
+// On posix systems, we memory-map PLY files, so that file contents
+// don't need to be copied into heap memory before parsing.
+#	define LE_MESH_USE_MMAP 1
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#else
+#	define LE_MESH_USE_MMAP 0
+#endif
+
+#ifndef LE_MT
+#	define LE_MT 0
+#endif
+
+#if ( LE_MT > 0 )
+#	include "le_jobs.h"
+#endif
+
 // ----------------------------------------------------------------------
 
 static le_mesh_o *le_mesh_create() {
@@ -39,6 +61,9 @@ static void le_mesh_clear( le_mesh_o *self ) {
 	self->tangents.clear();
 	self->colours.clear();
 	self->indices.clear();
+	self->indices_u16.clear();
+	self->indices_u16_dirty = true;
+	self->interleaved_vertices.clear();
 }
 
 // ----------------------------------------------------------------------
@@ -61,7 +86,45 @@ static void le_mesh_get_tangents( le_mesh_o *self, size_t &count, float const **
 
 // ----------------------------------------------------------------------
 
+// Updates 16 bit copy of indices if indices have changed since the last update -
+// returns false if indices don't fit into 16 bits.
+static bool mesh_update_indices_u16( le_mesh_o *self ) {
+
+	if ( !self->indices_u16_dirty ) {
+		return self->indices_u16_valid;
+	}
+
+	self->indices_u16_dirty = false;
+
+	if ( self->vertices.size() > 0x10000 ) {
+		// We only report this once per change of indices, as getters may be called every frame.
+		std::cerr << "ERROR: Mesh has " << self->vertices.size() << " vertices, which cannot be addressed using 16 bit indices. Use 32 bit indices instead." << std::endl
+		          << std::flush;
+		self->indices_u16.clear();
+		self->indices_u16_valid = false;
+		return false;
+	}
+
+	// --------| invariant: all indices fit into 16 bits
+
+	self->indices_u16.assign( self->indices.begin(), self->indices.end() );
+	self->indices_u16_valid = true;
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
 static void le_mesh_get_indices( le_mesh_o *self, size_t &count, uint16_t const **indices ) {
+	count = mesh_update_indices_u16( self ) ? self->indices_u16.size() : 0;
+	if ( indices ) {
+		*indices = self->indices_u16.data();
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void le_mesh_get_indices_u32( le_mesh_o *self, size_t &count, uint32_t const **indices ) {
 	count = self->indices.size();
 	if ( indices ) {
 		*indices = self->indices.data();
@@ -89,7 +152,7 @@ static void le_mesh_get_colours( le_mesh_o *self, size_t &count, float const **c
 // ----------------------------------------------------------------------
 
 static void le_mesh_get_uvs( le_mesh_o *self, size_t &count, float const **uvs ) {
-	count = self->normals.size();
+	count = self->uvs.size();
 	if ( uvs ) {
 		*uvs = static_cast<float *>( &self->uvs[ 0 ].x );
 	}
@@ -97,7 +160,7 @@ static void le_mesh_get_uvs( le_mesh_o *self, size_t &count, float const **uvs )
 
 // ----------------------------------------------------------------------
 
-static void le_mesh_get_data( le_mesh_o *self, size_t &numVertices, size_t &numIndices, float const **vertices, float const **normals, float const **uvs, float const **colours, uint16_t const **indices ) {
+static void le_mesh_get_data_u32( le_mesh_o *self, size_t &numVertices, size_t &numIndices, float const **vertices, float const **normals, float const **uvs, float const **colours, uint32_t const **indices ) {
 	numVertices = self->vertices.size();
 	numIndices  = self->indices.size();
 
@@ -123,496 +186,1498 @@ static void le_mesh_get_data( le_mesh_o *self, size_t &numVertices, size_t &numI
 }
 
 // ----------------------------------------------------------------------
-/// \brief   file loader utility method
-/// \details loads file given by filepath and returns a vector of chars if successful
-/// \note    returns an empty vector if not successful
-static std::vector<char> load_file( const std::filesystem::path &file_path, bool *success ) {
 
-	std::vector<char> contents;
+static void le_mesh_get_data( le_mesh_o *self, size_t &numVertices, size_t &numIndices, float const **vertices, float const **normals, float const **uvs, float const **colours, uint16_t const **indices ) {
+	le_mesh_get_data_u32( self, numVertices, numIndices, vertices, normals, uvs, colours, nullptr );
 
-	size_t        fileSize = 0;
-	std::ifstream file( file_path, std::ios::in | std::ios::binary | std::ios::ate );
+	if ( false == mesh_update_indices_u16( self ) ) {
+		numIndices = 0;
+	}
 
-	if ( !file.is_open() ) {
-		std::cerr << "Unable to open file: " << std::filesystem::canonical( file_path ) << std::endl
-		          << std::flush;
-		*success = false;
-		return contents;
+	if ( indices ) {
+		*indices = self->indices_u16.data();
 	}
+}
 
-	//	std::cout << "OK Opened file:" << std::filesystem::canonical( file_path ) << std::endl
-	//	          << std::flush;
+// ----------------------------------------------------------------------
 
-	// ----------| invariant: file is open
+static void le_mesh_get_interleaved_vertices( le_mesh_o *self, bool quantise, le_mesh_api::interleaved_vertex_layout_t *layout, size_t &numVertices, void const **data ) {
 
-	auto endOfFilePos = file.tellg();
+	numVertices = self->vertices.size();
 
-	if ( endOfFilePos > 0 ) {
-		fileSize = size_t( endOfFilePos );
-	} else {
-		*success = false;
-		return contents;
-	}
+	// An attribute is only present if there is one element per vertex.
+	bool const has_normals  = !self->normals.empty() && self->normals.size() == numVertices;
+	bool const has_uvs      = !self->uvs.empty() && self->uvs.size() == numVertices;
+	bool const has_colours  = !self->colours.empty() && self->colours.size() == numVertices;
+	bool const has_tangents = !self->tangents.empty() && self->tangents.size() == numVertices;
 
-	// ----------| invariant: file has some bytes to read
-	contents.resize( fileSize );
+	uint32_t offset = 0;
 
-	file.seekg( 0, std::ios::beg );
-	file.read( contents.data(), endOfFilePos );
-	file.close();
+	auto add_attribute = [ &offset ]( bool is_present, uint32_t num_bytes ) -> uint32_t {
+		if ( !is_present ) {
+			return le_mesh_api::ATTRIBUTE_NOT_PRESENT;
+		}
+		uint32_t attribute_offset = offset;
+		offset += num_bytes;
+		return attribute_offset;
+	};
 
-	*success = true;
-	return contents;
-}
+	// Quantised attributes all take 4 bytes, which keeps every attribute 4-byte aligned.
 
-// ----------------------------------------------------------------------
+	layout->offset_position = add_attribute( true, sizeof( glm::vec3 ) );
+	layout->offset_normal   = add_attribute( has_normals, quantise ? sizeof( uint32_t ) : sizeof( glm::vec3 ) );
+	layout->offset_uv       = add_attribute( has_uvs, quantise ? sizeof( uint32_t ) : sizeof( glm::vec2 ) );
+	layout->offset_colour   = add_attribute( has_colours, quantise ? sizeof( uint32_t ) : sizeof( glm::vec4 ) );
+	layout->offset_tangent  = add_attribute( has_tangents, quantise ? sizeof( uint32_t ) : sizeof( glm::vec3 ) );
+	layout->stride          = offset;
 
-inline int does_start_with( char const *haystack, char const *needle, size_t &needle_len ) {
-	needle_len = strlen( needle );
-	return 0 == strncmp( haystack, needle, needle_len );
-};
+	self->interleaved_vertices.resize( numVertices * layout->stride );
 
-// ----------------------------------------------------------------------
-/// \brief loads mesh from ply file
-/// \note any contents of mesh will be cleared before loading
-/// \return true upon success, false otherwise.
-static bool le_mesh_load_from_ply_file( le_mesh_o *self, char const *file_path_ ) {
+	uint8_t *v = self->interleaved_vertices.data();
 
-	// - Make sure file exists
+	for ( size_t i = 0; i != numVertices; i++, v += layout->stride ) {
 
-	std::filesystem::path file_path{ file_path_ };
+		memcpy( v + layout->offset_position, &self->vertices[ i ], sizeof( glm::vec3 ) );
 
-	if ( !std::filesystem::exists( file_path ) ) {
-		std::cerr << "File not found: '" << file_path << "'";
-		return false;
+		if ( quantise ) {
+			uint32_t packed;
+			if ( has_normals ) {
+				packed = glm::packSnorm4x8( glm::vec4( self->normals[ i ], 0 ) );
+				memcpy( v + layout->offset_normal, &packed, sizeof( uint32_t ) );
+			}
+			if ( has_uvs ) {
+				packed = glm::packHalf2x16( self->uvs[ i ] );
+				memcpy( v + layout->offset_uv, &packed, sizeof( uint32_t ) );
+			}
+			if ( has_colours ) {
+				packed = glm::packUnorm4x8( self->colours[ i ] );
+				memcpy( v + layout->offset_colour, &packed, sizeof( uint32_t ) );
+			}
+			if ( has_tangents ) {
+				packed = glm::packSnorm4x8( glm::vec4( self->tangents[ i ], 0 ) );
+				memcpy( v + layout->offset_tangent, &packed, sizeof( uint32_t ) );
+			}
+		} else {
+			if ( has_normals ) {
+				memcpy( v + layout->offset_normal, &self->normals[ i ], sizeof( glm::vec3 ) );
+			}
+			if ( has_uvs ) {
+				memcpy( v + layout->offset_uv, &self->uvs[ i ], sizeof( glm::vec2 ) );
+			}
+			if ( has_colours ) {
+				memcpy( v + layout->offset_colour, &self->colours[ i ], sizeof( glm::vec4 ) );
+			}
+			if ( has_tangents ) {
+				memcpy( v + layout->offset_tangent, &self->tangents[ i ], sizeof( glm::vec3 ) );
+			}
+		}
 	}
 
-	// --------| invariant: File path exists
+	if ( data ) {
+		*data = self->interleaved_vertices.data();
+	}
+}
 
-	// - Build mesh attributes structure based on header.
+// ----------------------------------------------------------------------
+// Reorders triangles for post-transform vertex cache efficiency, using Tipsify:
+// Sander, Nehab, Barczak: "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw", 2007.
+//
+// Writes reordered indices into `out_indices`, and the index offset at which each cluster
+// starts into `cluster_offsets` - a new cluster starts whenever Tipsify has to restart from
+// a vertex which is not in the cache. Clusters may be reordered without hurting cache efficiency much.
+static void mesh_optimise_vertex_cache( std::vector<uint32_t> const &indices, size_t num_vertices, uint32_t cache_size, std::vector<uint32_t> &out_indices, std::vector<uint32_t> &cluster_offsets ) {
 
-	/*
-	 * element vertex structure: attribute index tells us where to store data which we parse
-	*/
+	size_t const num_triangles = indices.size() / 3;
 
-	struct Property {
+	// Build vertex-triangle adjacency, stored as offsets into one array.
 
-		// data type for the property
-		enum class Type : uint8_t {
-			eUnknown,
-			eList,
-			eFloat,
-			eUchar,
-			eUint,
-		};
+	std::vector<uint32_t> live_count( num_vertices, 0 ); // number of triangles which use a vertex, and which have not yet been emitted
+	std::vector<uint32_t> adjacency_offsets( num_vertices + 1, 0 );
+	std::vector<uint32_t> adjacency( indices.size() );
 
-		// name for attribute in context of a mesh
-		enum class AttributeType : uint8_t {
-			eUnknown,
-			eVX,
-			eVY,
-			eVZ,
-			eNX,
-			eNY,
-			eNZ,
-			eTexU,
-			eTexV,
-			eColR,
-			eColG,
-			eColB,
-			eColA,
-		};
+	for ( auto const &i : indices ) {
+		live_count[ i ]++;
+	}
 
-		Type          type              = Type::eUnknown;
-		AttributeType attribute_type    = AttributeType::eUnknown; // only used for attributes - not lists.
-		Type          list_size_type    = Type::eUnknown;          // only used for lists
-		Type          list_content_type = Type::eUnknown;          // only used for lists
-		char const *  name              = nullptr;
-		uint8_t       name_len          = 0; ///< number of chars for name (does not include \0)
-	};
+	for ( size_t v = 0; v != num_vertices; v++ ) {
+		adjacency_offsets[ v + 1 ] = adjacency_offsets[ v ] + live_count[ v ];
+	}
 
-	struct Element {
+	{
+		std::vector<uint32_t> fill_offsets( adjacency_offsets.begin(), adjacency_offsets.end() - 1 );
+		for ( size_t t = 0; t != num_triangles; t++ ) {
+			for ( size_t k = 0; k != 3; k++ ) {
+				adjacency[ fill_offsets[ indices[ t * 3 + k ] ]++ ] = uint32_t( t );
+			}
+		}
+	}
 
-		enum class Type : uint8_t {
-			eUnknown,
-			eVertex,
-			eFace,
-		};
-		char const *          name;
-		Type                  type;
-		uint8_t               name_len; ///< number of chars for name (does not include \0)
-		uint32_t              num_elements;
-		std::vector<Property> properties;
+	std::vector<uint32_t> cache_timestamps( num_vertices, 0 );
+	std::vector<uint32_t> dead_end_stack;
+	std::vector<bool>     emitted( num_triangles, false );
+	std::vector<uint32_t> candidates;
+
+	out_indices.clear();
+	out_indices.reserve( indices.size() );
+	cluster_offsets.clear();
+
+	uint32_t timestamp = cache_size + 1;
+	uint32_t cursor    = 0; // next vertex to consider when we run out of dead-ends
+
+	// Returns the next vertex with live triangles, when no candidate is available in the cache.
+	auto skip_dead_end = [ & ]() -> int64_t {
+		while ( !dead_end_stack.empty() ) {
+			uint32_t d = dead_end_stack.back();
+			dead_end_stack.pop_back();
+			if ( live_count[ d ] > 0 ) {
+				return d;
+			}
+		}
+		while ( cursor < num_vertices ) {
+			if ( live_count[ cursor ] > 0 ) {
+				return cursor;
+			}
+			cursor++;
+		}
+		return -1;
 	};
 
-	// - Check that the header is correct (consistent, has minimum necessary attributes)
+	int64_t fanning_vertex = skip_dead_end();
 
-	// - Read file into memory
-	bool              file_load_success = true;
-	std::vector<char> file_data         = load_file( file_path, &file_load_success );
-
-	if ( !file_load_success ) {
-		std::cerr << "File could not be loaded: '" << file_path << "'";
-		return false;
+	if ( fanning_vertex >= 0 ) {
+		cluster_offsets.push_back( 0 );
 	}
 
-	static auto DELIMS{ "\r\n\0" };
-	char *      c_save_ptr; //< we use the re-entrant version of strtok, for which state is stored in here
+	while ( fanning_vertex >= 0 ) {
 
-	// --------| invariant: file was loaded.
+		candidates.clear();
 
-	char *c = strtok_r( file_data.data(), DELIMS, &c_save_ptr );
+		// Emit all triangles which use the fanning vertex, and which have not yet been emitted.
 
-	if ( 0 != strcmp( c, "ply" ) ) {
-		std::cerr << "Invalid file header: '" << file_path << "'";
-		return false;
-	}
+		for ( uint32_t a = adjacency_offsets[ fanning_vertex ]; a != adjacency_offsets[ fanning_vertex + 1 ]; a++ ) {
 
-	c = strtok_r( nullptr, DELIMS, &c_save_ptr );
+			uint32_t t = adjacency[ a ];
 
-	if ( 0 != strcmp( c, "format ascii 1.0" ) ) {
-		std::cerr << "Invalid file header: '" << file_path << "'";
-		return false;
-	}
+			if ( emitted[ t ] ) {
+				continue;
+			}
+
+			for ( size_t k = 0; k != 3; k++ ) {
+				uint32_t v = indices[ t * 3 + k ];
+				out_indices.push_back( v );
+				dead_end_stack.push_back( v );
+				candidates.push_back( v );
+				live_count[ v ]--;
+				if ( timestamp - cache_timestamps[ v ] > cache_size ) {
+					cache_timestamps[ v ] = timestamp++;
+				}
+			}
 
-	c = strtok_r( nullptr, DELIMS, &c_save_ptr );
+			emitted[ t ] = true;
+		}
 
-	// Parse header data into a vector of Element
-	std::vector<Element> elements;
+		// Pick the next fanning vertex: the candidate which will stay longest in
+		// the cache, but only if all of its remaining triangles may be emitted
+		// before it is evicted. Candidates which don't qualify have priority 0,
+		// and are never picked - if no candidate qualifies, we fall back to the
+		// dead-end stack, and then to a linear scan over all vertices.
 
-	for ( ; c != nullptr; c = strtok_r( nullptr, DELIMS, &c_save_ptr ) ) {
+		int64_t  next_vertex   = -1;
+		uint32_t best_priority = 0;
 
-		size_t last_search_string_len = 0;
+		for ( auto const &v : candidates ) {
+			if ( live_count[ v ] == 0 ) {
+				continue;
+			}
+			uint32_t priority = 0;
+			if ( timestamp - cache_timestamps[ v ] + 2 * live_count[ v ] <= cache_size ) {
+				priority = timestamp - cache_timestamps[ v ];
+			}
+			if ( priority > best_priority ) {
+				best_priority = priority;
+				next_vertex   = v;
+			}
+		}
 
-		if ( does_start_with( c, "comment", last_search_string_len ) ) {
-			// Anything after a comment will be ignored
-			continue;
+		if ( next_vertex < 0 ) {
+			next_vertex = skip_dead_end();
+			if ( next_vertex >= 0 && out_indices.size() < indices.size() ) {
+				cluster_offsets.push_back( uint32_t( out_indices.size() ) );
+			}
 		}
 
-		else if ( does_start_with( c, "element", last_search_string_len ) ) {
-			Element element;
+		fanning_vertex = next_vertex;
+	}
+}
 
-			// Note: This method replaces spaces between in-element tokens with \0 characters.
-			auto parse_element_line = []( char *c, Element &element ) -> bool {
-				element.name = c;
-				char *c_next = strchr( c, ' ' );
-				if ( c_next == nullptr ) {
-					// There must be a space character
-					assert( false );
-					return false;
-				}
-				*c_next          = 0; // insert an end-of-string token
-				element.name_len = uint8_t( c_next - c );
+// ----------------------------------------------------------------------
+// Reorders clusters of triangles so that clusters which face outwards from the
+// mesh centre are drawn first - these are more likely to occlude other clusters,
+// which reduces overdraw. See Sander et al., 2007.
+static void mesh_optimise_overdraw( le_mesh_o const *self, std::vector<uint32_t> &indices, std::vector<uint32_t> const &cluster_offsets ) {
 
-				if ( 0 == strncmp( element.name, "vertex", element.name_len ) ) {
-					element.type = Element::Type::eVertex;
-				} else if ( 0 == strncmp( element.name, "face", element.name_len ) ) {
-					element.type = Element::Type::eFace;
-				}
+	size_t const num_clusters = cluster_offsets.size();
 
-				c = c_next + 1; // adding one because we don't want the zero terminator.
+	if ( num_clusters < 2 || self->vertices.empty() ) {
+		return;
+	}
 
-				element.num_elements = uint32_t( strtoul( c, nullptr, 0 ) );
-				return true;
-			};
+	// --------| invariant: there is more than one cluster
 
-			c += last_search_string_len + 1;
+	glm::vec3 mesh_centre{ 0 };
 
-			// fetch name of element, and count of elements
-			parse_element_line( c, element );
+	for ( auto const &v : self->vertices ) {
+		mesh_centre += v;
+	}
 
-			elements.emplace_back( std::move( element ) );
+	mesh_centre /= float( self->vertices.size() );
 
-			continue;
+	struct cluster_t {
+		uint32_t begin;
+		uint32_t end;
+		float    sort_key;
+	};
+
+	std::vector<cluster_t> clusters( num_clusters );
+
+	for ( size_t c = 0; c != num_clusters; c++ ) {
+
+		auto &cluster = clusters[ c ];
+		cluster.begin = cluster_offsets[ c ];
+		cluster.end   = c + 1 < num_clusters ? cluster_offsets[ c + 1 ] : uint32_t( indices.size() );
+
+		glm::vec3 centroid{ 0 };
+		glm::vec3 normal{ 0 };
+		float     area = 0;
+
+		for ( uint32_t i = cluster.begin; i + 2 < cluster.end; i += 3 ) {
+			glm::vec3 const &p0 = self->vertices[ indices[ i + 0 ] ];
+			glm::vec3 const &p1 = self->vertices[ indices[ i + 1 ] ];
+			glm::vec3 const &p2 = self->vertices[ indices[ i + 2 ] ];
+
+			glm::vec3 n = glm::cross( p1 - p0, p2 - p0 ); // length is twice the triangle area
+			float     a = glm::length( n );
+
+			centroid += ( p0 + p1 + p2 ) * ( a / 3.f );
+			normal += n;
+			area += a;
 		}
 
-		else if ( does_start_with( c, "property", last_search_string_len ) ) {
-			Property property;
+		if ( area > 0 ) {
+			centroid /= area;
+		}
 
-			// Note: this replaces spaces between in-element tokens with \0 characters.
-			auto parse_property_line = []( char *c, Property &property ) -> bool {
-				size_t last_search_string_len = 0;
+		cluster.sort_key = glm::dot( centroid - mesh_centre, normal );
+	}
 
-				// now, we expect either list or [float|uchar] as property type
-				if ( does_start_with( c, "list", last_search_string_len ) ) {
-					c += last_search_string_len + 1;
-					property.type = Property::Type::eList;
+	std::stable_sort( clusters.begin(), clusters.end(), []( cluster_t const &lhs, cluster_t const &rhs ) -> bool {
+		return lhs.sort_key > rhs.sort_key;
+	} );
 
-					// next item will be list size type
+	std::vector<uint32_t> sorted_indices;
+	sorted_indices.reserve( indices.size() );
 
-					if ( does_start_with( c, "uchar", last_search_string_len ) ) {
-						property.list_size_type = Property::Type::eUchar;
-						c += last_search_string_len + 1;
-					} else if ( does_start_with( c, "uint", last_search_string_len ) ) {
-						property.list_size_type = Property::Type::eUint;
-						c += last_search_string_len + 1;
-					} else {
-						std::cerr << "Unknown list size type: '" << c << "'" << std::endl
-						          << std::flush;
-						assert( false );
-					}
+	for ( auto const &cluster : clusters ) {
+		sorted_indices.insert( sorted_indices.end(), indices.begin() + cluster.begin, indices.begin() + cluster.end );
+	}
 
-					// next item will be list content type
-
-					if ( does_start_with( c, "uchar", last_search_string_len ) ) {
-						property.list_content_type = Property::Type::eUchar;
-						c += last_search_string_len + 1;
-					} else if ( does_start_with( c, "uint", last_search_string_len ) ) {
-						property.list_content_type = Property::Type::eUint;
-						c += last_search_string_len + 1;
-					} else {
-						std::cerr << "Unknown list content type: '" << c << "'" << std::endl
-						          << std::flush;
-						assert( false );
-					}
+	indices.swap( sorted_indices );
+}
 
-					// last item will be list name
-
-					property.name     = c;
-					property.name_len = uint8_t( strlen( c ) );
-					return true;
-				} else {
-
-					// Non-list type
-
-					if ( does_start_with( c, "float", last_search_string_len ) ) {
-						property.type = Property::Type::eFloat;
-					} else if ( does_start_with( c, "uint", last_search_string_len ) ) {
-						property.type = Property::Type::eUint;
-					} else if ( does_start_with( c, "uchar", last_search_string_len ) ) {
-						property.type = Property::Type::eUchar;
-					} else {
-						// Unknown property type.
-						std::cerr << __PRETTY_FUNCTION__ << ": Unknown property type: " << c << std::endl
-						          << std::flush;
-						assert( false );
-						return false;
-					}
+// ----------------------------------------------------------------------
+// Reorders vertices in the order in which they are first referenced by indices,
+// so that vertex fetch walks through memory linearly. Vertices which are not
+// referenced are moved to the end.
+static void mesh_optimise_vertex_fetch( le_mesh_o *self ) {
 
-					c += last_search_string_len + 1;
-					property.name     = c;
-					property.name_len = uint8_t( strlen( c ) );
-
-					if ( 0 == strncmp( c, "x", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eVX;
-					} else if ( 0 == strncmp( c, "y", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eVY;
-					} else if ( 0 == strncmp( c, "z", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eVZ;
-					} else if ( 0 == strncmp( c, "nx", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eNX;
-					} else if ( 0 == strncmp( c, "ny", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eNY;
-					} else if ( 0 == strncmp( c, "nz", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eNZ;
-					} else if ( 0 == strncmp( c, "s", property.name_len ) ||
-					            0 == strncmp( c, "u", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eTexU;
-					} else if ( 0 == strncmp( c, "t", property.name_len ) ||
-					            0 == strncmp( c, "v", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eTexV;
-					} else if ( 0 == strncmp( c, "red", property.name_len ) ||
-					            0 == strncmp( c, "r", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eColR;
-					} else if ( 0 == strncmp( c, "green", property.name_len ) ||
-					            0 == strncmp( c, "g", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eColG;
-					} else if ( 0 == strncmp( c, "blue", property.name_len ) ||
-					            0 == strncmp( c, "b", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eColB;
-					} else if ( 0 == strncmp( c, "alpha", property.name_len ) ||
-					            0 == strncmp( c, "a", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eColA;
-					} else {
-						std::cerr << "WARNING: Attribute name not recognised: '" << c << "'" << std::endl
-						          << std::flush;
-					}
+	size_t const num_vertices = self->vertices.size();
 
-					return true;
-				}
-				std::cerr << "Expected property type must be either 'list', or one of non-list type: uchar, float, uint, but given: " << c << std::endl
-				          << std::flush;
-				assert( false );
-				return false;
-			};
+	constexpr uint32_t UNASSIGNED = ~uint32_t( 0 );
 
-			c += last_search_string_len + 1;
+	std::vector<uint32_t> remap( num_vertices, UNASSIGNED ); // old vertex index -> new vertex index
+	uint32_t              next_index = 0;
 
-			if ( !elements.empty() && parse_property_line( c, property ) ) {
-				elements.back().properties.emplace_back( std::move( property ) );
-			}
+	for ( auto &i : self->indices ) {
+		if ( remap[ i ] == UNASSIGNED ) {
+			remap[ i ] = next_index++;
+		}
+		i = remap[ i ];
+	}
 
-			continue;
+	for ( auto &r : remap ) {
+		if ( r == UNASSIGNED ) {
+			r = next_index++;
 		}
+	}
 
-		else if ( does_start_with( c, "end_header", last_search_string_len ) ) {
-			// we have reached the marker which signals the end of the header.
-			// - Move file data pointer past "end_header" line
-			c = strtok_r( nullptr, DELIMS, &c_save_ptr );
-			break;
+	auto remap_attribute = [ & ]( auto &attribute ) {
+		if ( attribute.size() != num_vertices ) {
+			return;
 		}
+		auto remapped = attribute;
+		for ( size_t v = 0; v != num_vertices; v++ ) {
+			remapped[ remap[ v ] ] = attribute[ v ];
+		}
+		attribute.swap( remapped );
+	};
 
-		// The following code only gets executed if none of the above if clauses has
-		// been triggered - this means that there is something wrong with
-		// the file. we must exit.
+	remap_attribute( self->vertices );
+	remap_attribute( self->normals );
+	remap_attribute( self->colours );
+	remap_attribute( self->uvs );
+	remap_attribute( self->tangents );
+}
 
-		std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << "Invalid file header data: '" << c << "'" << std::endl
-		          << std::flush;
+// ----------------------------------------------------------------------
 
-		assert( false );
+static void le_mesh_optimise( le_mesh_o *self, uint32_t vertex_cache_size ) {
 
-		return false;
+	if ( self->indices.size() < 3 || self->vertices.empty() ) {
+		return;
 	}
 
-	// - Clear mesh
+	// --------| invariant: mesh has at least one triangle
 
-	le_mesh_clear( self );
+	for ( auto const &i : self->indices ) {
+		if ( i >= self->vertices.size() ) {
+			std::cerr << "ERROR: Cannot optimise mesh: index out of bounds: " << i << std::endl
+			          << std::flush;
+			return;
+		}
+	}
 
-	// - Load file data
+	if ( vertex_cache_size == 0 ) {
+		vertex_cache_size = 16;
+	}
 
-	Element const *element_archetype     = elements.data();
-	auto const     element_archetype_end = elements.data() + elements.size();
-
-	// What follows now is a list of elements, one element per line.
-	// elements have properties, which are separated by commas.
-
-	for ( ; element_archetype != element_archetype_end; element_archetype++ ) {
-
-		// Check whether the current property is still part of the current element
-		// Otherwise move to the next element
-
-		// Element archetype can be either face vertex or face
-
-		if ( element_archetype->type == Element::Type::eVertex ) {
-
-			// - Make space over all attributes for number of elements.
-
-			for ( auto const &p : element_archetype->properties ) {
-				switch ( p.attribute_type ) {
-				case ( Property::AttributeType::eVX ): // intentional fall-through
-				case ( Property::AttributeType::eVY ): // intentional fall-through
-				case ( Property::AttributeType::eVZ ): // intentional fall-through
-					self->vertices.resize( element_archetype->num_elements, {} );
-					break;
-				case ( Property::AttributeType::eNX ): // intentional fall-through
-				case ( Property::AttributeType::eNY ): // intentional fall-through
-				case ( Property::AttributeType::eNZ ): // intentional fall-through
-					self->normals.resize( element_archetype->num_elements, {} );
-					break;
-				case ( Property::AttributeType::eColR ): // intentional fall-through
-				case ( Property::AttributeType::eColG ): // intentional fall-through
-				case ( Property::AttributeType::eColB ): // intentional fall-through
-				case ( Property::AttributeType::eColA ): // intentional fall-through
-					self->colours.resize( element_archetype->num_elements, {} );
-					break;
-				case ( Property::AttributeType::eTexU ): // intentional fall-through
-				case ( Property::AttributeType::eTexV ): // intentional fall-through
-					self->uvs.resize( element_archetype->num_elements, {} );
-					break;
-				case ( Property::AttributeType::eUnknown ):
-					break;
-				}
-				// TODO: check for tangents.
-			}
-
-			for ( uint32_t i = 0; i != element_archetype->num_elements && c != nullptr; ++i, c = strtok_r( nullptr, DELIMS, &c_save_ptr ) ) {
-				char *s = c;
-
-				auto *v_data  = self->vertices.empty() ? nullptr : &self->vertices[ i ];
-				auto *n_data  = self->normals.empty() ? nullptr : &self->normals[ i ];
-				auto *uv_data = self->uvs.empty() ? nullptr : &self->uvs[ i ];
-				auto *c_data  = self->colours.empty() ? nullptr : &self->colours[ i ];
-
-				for ( auto const &p : element_archetype->properties ) {
-
-					// clang-format off
-					switch ( p.attribute_type ) {
-					case ( Property::AttributeType::eVX )   : v_data->x  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eVY )   : v_data->y  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eVZ )   : v_data->z  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eNX )   : n_data->x  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eNY )   : n_data->y  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eNZ )   : n_data->z  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eTexU ) : uv_data->x = strtof( s, &s ); break;
-					case ( Property::AttributeType::eTexV ) : uv_data->y = strtof( s, &s ); break;
-					case ( Property::AttributeType::eColR ):
-						c_data->x = p.type == Property::Type::eFloat ? strtof( s, &s ) : strtoul( s, &s, 0 )/255.f; break;
-					case ( Property::AttributeType::eColG ):
-						c_data->y = p.type == Property::Type::eFloat ? strtof( s, &s ) : strtoul( s, &s, 0 )/255.f; break;
-					case ( Property::AttributeType::eColB ):
-						c_data->z = p.type == Property::Type::eFloat ? strtof( s, &s ) : strtoul( s, &s, 0 )/255.f; break;
-					case ( Property::AttributeType::eColA ):
-						c_data->w = p.type == Property::Type::eFloat ? strtof( s, &s ) : strtoul( s, &s, 0 )/255.f; break;
-					case ( Property::AttributeType::eUnknown ):
-						// TODO: what do we do if there is an unknown attribute?
-						assert( false );
-						break;
-					}
-					// clang-format on
-				}
-			}
+	std::vector<uint32_t> optimised_indices;
+	std::vector<uint32_t> cluster_offsets;
 
-		} else if ( element_archetype->type == Element::Type::eFace ) {
+	mesh_optimise_vertex_cache( self->indices, self->vertices.size(), vertex_cache_size, optimised_indices, cluster_offsets );
+	mesh_optimise_overdraw( self, optimised_indices, cluster_offsets );
 
-			// must be 3 indices per face - because our meshes can only be built from triangles, not quads or anything else.
-			self->indices.resize( element_archetype->num_elements * 3, {} );
+	self->indices.swap( optimised_indices );
 
-			auto *      current_index = self->indices.data();
-			auto *const indices_end   = self->indices.data() + self->indices.size();
+	mesh_optimise_vertex_fetch( self );
 
-			// this goes through line-by line.
-			for ( size_t line_num = 0;
-			      ( line_num != element_archetype->num_elements ) && ( current_index < indices_end ) && ( c != nullptr );
-			      ++line_num ) {
+	self->indices_u16_dirty = true;
+}
 
-				char *s = c;
+// ----------------------------------------------------------------------
+// Simulates a FIFO post-transform vertex cache of `vertex_cache_size` entries, and vertex
+// fetch through a cache of 64 byte lines, 16KB in total. If `vertex_stride` is 0, we assume
+// that only positions are fetched.
+static void le_mesh_get_statistics( le_mesh_o *self, uint32_t vertex_cache_size, uint32_t vertex_stride, le_mesh_api::mesh_statistics_t *statistics ) {
 
-				auto three = strtoul( s, &s, 0 );
-				assert( three == 3 ); // first element must be three
+	*statistics = {};
 
-				*current_index++ = strtoul( s, &s, 0 ); // first index
-				*current_index++ = strtoul( s, &s, 0 ); // second index
-				*current_index++ = strtoul( s, &s, 0 ); // third index
+	size_t const num_vertices  = self->vertices.size();
+	size_t const num_triangles = self->indices.size() / 3;
 
-				c = strtok_r( nullptr, DELIMS, &c_save_ptr );
-			}
+	if ( num_triangles == 0 || num_vertices == 0 ) {
+		return;
+	}
 
-			// parse face properties
+	// --------| invariant: mesh has at least one triangle
+
+	for ( auto const &i : self->indices ) {
+		if ( i >= num_vertices ) {
+			std::cerr << "ERROR: Cannot calculate mesh statistics: index out of bounds: " << i << std::endl
+			          << std::flush;
+			return;
 		}
-		if ( element_archetype->type == Element::Type::eUnknown ) {
-			// Not implemented yet.
+	}
 
-			auto skip_lines = [ & ]( char const *c, Element const *archetype ) {
-				for ( uint32_t i = 0; i != archetype->num_elements && c != nullptr; ++i ) {
-					c = strtok_r( nullptr, DELIMS, &c_save_ptr );
-				}
-			};
+	if ( vertex_stride == 0 ) {
+		vertex_stride = sizeof( glm::vec3 );
+	}
 
-			skip_lines( c, element_archetype );
+	constexpr uint32_t CACHE_LINE_SIZE = 64;
+	constexpr uint32_t CACHE_NUM_LINES = ( 16 * 1024 ) / CACHE_LINE_SIZE;
 
-			break;
+	// A cache entry is still resident if fewer than cache size newer entries have been added since.
+
+	std::vector<uint32_t> vertex_timestamps( num_vertices, 0 );
+	std::vector<uint32_t> line_timestamps( ( num_vertices * vertex_stride ) / CACHE_LINE_SIZE + 2, 0 );
+
+	uint32_t vertex_timestamp = vertex_cache_size + 1;
+	uint32_t line_timestamp   = CACHE_NUM_LINES + 1;
+
+	size_t num_transformed = 0;
+	size_t bytes_fetched   = 0;
+
+	for ( auto const &i : self->indices ) {
+
+		if ( vertex_timestamp - vertex_timestamps[ i ] <= vertex_cache_size ) {
+			continue; // post-transform cache hit
+		}
+
+		// --------| invariant: vertex must be transformed
+
+		vertex_timestamps[ i ] = vertex_timestamp++;
+		num_transformed++;
+
+		size_t const first_line = ( size_t( i ) * vertex_stride ) / CACHE_LINE_SIZE;
+		size_t const last_line  = ( size_t( i ) * vertex_stride + vertex_stride - 1 ) / CACHE_LINE_SIZE;
+
+		for ( size_t l = first_line; l <= last_line; l++ ) {
+			if ( line_timestamp - line_timestamps[ l ] > CACHE_NUM_LINES ) {
+				line_timestamps[ l ] = line_timestamp++;
+				bytes_fetched += CACHE_LINE_SIZE;
+			}
 		}
 	}
 
-	return true;
+	statistics->acmr        = float( num_transformed ) / float( num_triangles );
+	statistics->atvr        = float( num_transformed ) / float( num_vertices );
+	statistics->fetch_ratio = float( bytes_fetched ) / float( num_vertices * vertex_stride );
 }
 
 // ----------------------------------------------------------------------
 
-LE_MODULE_REGISTER_IMPL( le_mesh, api ) {
-	auto &le_mesh_i = static_cast<le_mesh_api *>( api )->le_mesh_i;
+static void le_mesh_build_meshlets( le_mesh_o *self, le_meshlets_o *meshlets, uint32_t max_vertices, uint32_t max_triangles ) {
+	le_mesh::le_meshlets_i.build( meshlets,
+	                              self->vertices.empty() ? nullptr : &self->vertices[ 0 ].x, uint32_t( sizeof( glm::vec3 ) ), self->vertices.size(),
+	                              self->indices.data(), self->indices.size(),
+	                              max_vertices, max_triangles );
+}
 
-	le_mesh_i.get_vertices = le_mesh_get_vertices;
-	le_mesh_i.get_indices  = le_mesh_get_indices;
-	le_mesh_i.get_uvs      = le_mesh_get_uvs;
-	le_mesh_i.get_tangents = le_mesh_get_tangents;
-	le_mesh_i.get_normals  = le_mesh_get_normals;
-	le_mesh_i.get_colours  = le_mesh_get_colours;
-	le_mesh_i.get_data     = le_mesh_get_data;
+// ----------------------------------------------------------------------
 
-	le_mesh_i.load_from_ply_file = le_mesh_load_from_ply_file;
+static void le_mesh_build_lod_chain( le_mesh_o *self, le_mesh_lod_o *lod, uint32_t max_levels, float ratio ) {
+	le_mesh::le_mesh_lod_i.build( lod,
+	                              self->vertices.empty() ? nullptr : &self->vertices[ 0 ].x, uint32_t( sizeof( glm::vec3 ) ), self->vertices.size(),
+	                              self->indices.data(), self->indices.size(),
+	                              max_levels, ratio );
+}
 
-	le_mesh_i.clear   = le_mesh_clear;
-	le_mesh_i.create  = le_mesh_create;
-	le_mesh_i.destroy = le_mesh_destroy;
+#if ( LE_MESH_USE_MMAP == 0 )
+// ----------------------------------------------------------------------
+/// \brief   file loader utility method
+/// \details loads file given by filepath and returns a vector of chars if successful
+/// \note    returns an empty vector if not successful
+static std::vector<char> load_file( const std::filesystem::path &file_path, bool *success ) {
+
+	std::vector<char> contents;
+
+	size_t        fileSize = 0;
+	std::ifstream file( file_path, std::ios::in | std::ios::binary | std::ios::ate );
+
+	if ( !file.is_open() ) {
+		std::cerr << "Unable to open file: " << std::filesystem::canonical( file_path ) << std::endl
+		          << std::flush;
+		*success = false;
+		return contents;
+	}
+
+	//	std::cout << "OK Opened file:" << std::filesystem::canonical( file_path ) << std::endl
+	//	          << std::flush;
+
+	// ----------| invariant: file is open
+
+	auto endOfFilePos = file.tellg();
+
+	if ( endOfFilePos > 0 ) {
+		fileSize = size_t( endOfFilePos );
+	} else {
+		*success = false;
+		return contents;
+	}
+
+	// ----------| invariant: file has some bytes to read
+	contents.resize( fileSize );
+
+	file.seekg( 0, std::ios::beg );
+	file.read( contents.data(), endOfFilePos );
+	file.close();
+
+	*success = true;
+	return contents;
+}
+#endif
+
+// ----------------------------------------------------------------------
+// PLY loading
+//
+// We support ascii, as well as binary little- and big-endian PLY files.
+//
+// File contents are memory-mapped where possible. Binary vertex data is
+// parsed in parallel chunks, as every vertex has the same size. Ascii files
+// are split into chunks of whole lines, which are parsed in parallel once we
+// know at which line each chunk starts.
+//
+// Faces with more than three vertices are triangulated as triangle fans.
+// ----------------------------------------------------------------------
+
+struct PlyProperty {
+
+	// data type for the property
+	enum class Type : uint8_t {
+		eUnknown,
+		eInt8,
+		eUint8,
+		eInt16,
+		eUint16,
+		eInt32,
+		eUint32,
+		eFloat32,
+		eFloat64,
+	};
+
+	// name for attribute in context of a mesh
+	enum class AttributeType : uint8_t {
+		eUnknown,
+		eVX,
+		eVY,
+		eVZ,
+		eNX,
+		eNY,
+		eNZ,
+		eTexU,
+		eTexV,
+		eColR,
+		eColG,
+		eColB,
+		eColA,
+	};
+
+	Type          type           = Type::eUnknown;          // content type for lists
+	AttributeType attribute_type = AttributeType::eUnknown; // only used for attributes - not lists.
+	Type          list_size_type = Type::eUnknown;          // only used for lists
+	bool          is_list        = false;
+	uint32_t      offset         = 0; // byte offset within element, only valid for binary elements of fixed size
+	std::string   name;
+};
+
+struct PlyElement {
+
+	enum class Type : uint8_t {
+		eUnknown,
+		eVertex,
+		eFace,
+	};
+
+	Type                     type         = Type::eUnknown;
+	size_t                   num_elements = 0;
+	uint32_t                 stride       = 0; // size in bytes for binary elements, 0 if element contains lists
+	std::string              name;
+	std::vector<PlyProperty> properties;
+};
+
+enum class PlyFormat : uint8_t {
+	eUnknown,
+	eAscii,
+	eBinaryLittleEndian,
+	eBinaryBigEndian,
+};
+
+// File contents - memory-mapped if possible
+struct PlyFileData {
+	char const *data = nullptr;
+	size_t      size = 0;
+#if ( LE_MESH_USE_MMAP )
+	void *mapped_addr = nullptr;
+#else
+	std::vector<char> contents;
+#endif
+};
+
+// ----------------------------------------------------------------------
+
+static bool ply_file_open( std::filesystem::path const &file_path, PlyFileData *file ) {
+#if ( LE_MESH_USE_MMAP )
+	int fd = open( file_path.c_str(), O_RDONLY );
+
+	if ( fd < 0 ) {
+		return false;
+	}
+
+	struct stat file_stat {};
+
+	if ( fstat( fd, &file_stat ) != 0 || file_stat.st_size <= 0 ) {
+		close( fd );
+		return false;
+	}
+
+	void *addr = mmap( nullptr, size_t( file_stat.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+
+	close( fd ); // mapping stays valid after file descriptor has been closed.
+
+	if ( addr == MAP_FAILED ) {
+		return false;
+	}
+
+	// We read through the file front-to-back.
+	madvise( addr, size_t( file_stat.st_size ), MADV_SEQUENTIAL );
+
+	file->mapped_addr = addr;
+	file->data        = static_cast<char const *>( addr );
+	file->size        = size_t( file_stat.st_size );
+
+	return true;
+#else
+	bool success   = false;
+	file->contents = load_file( file_path, &success );
+	file->data     = file->contents.data();
+	file->size     = file->contents.size();
+	return success;
+#endif
+}
+
+// ----------------------------------------------------------------------
+
+static void ply_file_close( PlyFileData *file ) {
+#if ( LE_MESH_USE_MMAP )
+	if ( file->mapped_addr ) {
+		munmap( file->mapped_addr, file->size );
+		file->mapped_addr = nullptr;
+	}
+#else
+	file->contents.clear();
+#endif
+	file->data = nullptr;
+	file->size = 0;
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t ply_type_size( PlyProperty::Type type ) {
+	switch ( type ) {
+	case PlyProperty::Type::eInt8:    // deliberate fall-through
+	case PlyProperty::Type::eUint8:   //
+		return 1;
+	case PlyProperty::Type::eInt16:   // deliberate fall-through
+	case PlyProperty::Type::eUint16:  //
+		return 2;
+	case PlyProperty::Type::eInt32:   // deliberate fall-through
+	case PlyProperty::Type::eUint32:  // deliberate fall-through
+	case PlyProperty::Type::eFloat32: //
+		return 4;
+	case PlyProperty::Type::eFloat64:
+		return 8;
+	case PlyProperty::Type::eUnknown:
+		break;
+	}
+	return 0;
+}
+
+// ----------------------------------------------------------------------
+
+static PlyProperty::Type ply_type_from_string( std::string_view const &str ) {
+	// clang-format off
+	if ( str == "char"   || str == "int8"    ) return PlyProperty::Type::eInt8;
+	if ( str == "uchar"  || str == "uint8"   ) return PlyProperty::Type::eUint8;
+	if ( str == "short"  || str == "int16"   ) return PlyProperty::Type::eInt16;
+	if ( str == "ushort" || str == "uint16"  ) return PlyProperty::Type::eUint16;
+	if ( str == "int"    || str == "int32"   ) return PlyProperty::Type::eInt32;
+	if ( str == "uint"   || str == "uint32"  ) return PlyProperty::Type::eUint32;
+	if ( str == "float"  || str == "float32" ) return PlyProperty::Type::eFloat32;
+	if ( str == "double" || str == "float64" ) return PlyProperty::Type::eFloat64;
+	// clang-format on
+	return PlyProperty::Type::eUnknown;
+}
+
+// ----------------------------------------------------------------------
+
+static PlyProperty::AttributeType ply_attribute_type_from_string( std::string_view const &str ) {
+	// clang-format off
+	if ( str == "x" ) return PlyProperty::AttributeType::eVX;
+	if ( str == "y" ) return PlyProperty::AttributeType::eVY;
+	if ( str == "z" ) return PlyProperty::AttributeType::eVZ;
+	if ( str == "nx" ) return PlyProperty::AttributeType::eNX;
+	if ( str == "ny" ) return PlyProperty::AttributeType::eNY;
+	if ( str == "nz" ) return PlyProperty::AttributeType::eNZ;
+	if ( str == "s" || str == "u" || str == "texture_u" ) return PlyProperty::AttributeType::eTexU;
+	if ( str == "t" || str == "v" || str == "texture_v" ) return PlyProperty::AttributeType::eTexV;
+	if ( str == "red"   || str == "r" ) return PlyProperty::AttributeType::eColR;
+	if ( str == "green" || str == "g" ) return PlyProperty::AttributeType::eColG;
+	if ( str == "blue"  || str == "b" ) return PlyProperty::AttributeType::eColB;
+	if ( str == "alpha" || str == "a" ) return PlyProperty::AttributeType::eColA;
+	// clang-format on
+	return PlyProperty::AttributeType::eUnknown;
+}
+
+// ----------------------------------------------------------------------
+// Splits a line into tokens separated by spaces - returns number of tokens.
+static size_t ply_tokenize( std::string_view line, std::string_view *tokens, size_t max_tokens ) {
+	size_t num_tokens = 0;
+	size_t pos        = 0;
+
+	while ( num_tokens != max_tokens ) {
+		pos = line.find_first_not_of( " \t\r", pos );
+		if ( pos == std::string_view::npos ) {
+			break;
+		}
+		size_t token_end = line.find_first_of( " \t\r", pos );
+		if ( token_end == std::string_view::npos ) {
+			token_end = line.size();
+		}
+		tokens[ num_tokens++ ] = line.substr( pos, token_end - pos );
+		pos                    = token_end;
+	}
+
+	return num_tokens;
+}
+
+// ----------------------------------------------------------------------
+// Parses PLY header - returns offset to first byte of body, or 0 if header is invalid.
+static size_t ply_parse_header( char const *data, size_t size, PlyFormat *format, std::vector<PlyElement> &elements ) {
+
+	size_t pos      = 0;
+	size_t line_num = 0;
+
+	std::string_view tokens[ 6 ];
+
+	while ( pos < size ) {
+
+		char const *line_end = static_cast<char const *>( memchr( data + pos, '\n', size - pos ) );
+
+		if ( line_end == nullptr ) {
+			break;
+		}
+
+		std::string_view line( data + pos, size_t( line_end - ( data + pos ) ) );
+		pos = size_t( line_end - data ) + 1;
+
+		size_t num_tokens = ply_tokenize( line, tokens, 6 );
+
+		if ( line_num++ == 0 ) {
+			if ( num_tokens != 1 || tokens[ 0 ] != "ply" ) {
+				return 0;
+			}
+			continue;
+		}
+
+		if ( num_tokens == 0 || tokens[ 0 ] == "comment" || tokens[ 0 ] == "obj_info" ) {
+			// Anything after a comment will be ignored
+			continue;
+		}
+
+		if ( tokens[ 0 ] == "format" && num_tokens == 3 ) {
+			if ( tokens[ 1 ] == "ascii" ) {
+				*format = PlyFormat::eAscii;
+			} else if ( tokens[ 1 ] == "binary_little_endian" ) {
+				*format = PlyFormat::eBinaryLittleEndian;
+			} else if ( tokens[ 1 ] == "binary_big_endian" ) {
+				*format = PlyFormat::eBinaryBigEndian;
+			} else {
+				return 0;
+			}
+			continue;
+		}
+
+		if ( tokens[ 0 ] == "element" && num_tokens == 3 ) {
+			PlyElement element;
+			element.name         = std::string( tokens[ 1 ] );
+			element.num_elements = size_t( strtoull( std::string( tokens[ 2 ] ).c_str(), nullptr, 10 ) );
+
+			if ( element.name == "vertex" ) {
+				element.type = PlyElement::Type::eVertex;
+			} else if ( element.name == "face" ) {
+				element.type = PlyElement::Type::eFace;
+			}
+
+			elements.emplace_back( std::move( element ) );
+			continue;
+		}
+
+		if ( tokens[ 0 ] == "property" && !elements.empty() ) {
+			PlyProperty property;
+
+			if ( num_tokens == 5 && tokens[ 1 ] == "list" ) {
+				property.is_list        = true;
+				property.list_size_type = ply_type_from_string( tokens[ 2 ] );
+				property.type           = ply_type_from_string( tokens[ 3 ] );
+				property.name           = std::string( tokens[ 4 ] );
+			} else if ( num_tokens == 3 ) {
+				property.type           = ply_type_from_string( tokens[ 1 ] );
+				property.name           = std::string( tokens[ 2 ] );
+				property.attribute_type = ply_attribute_type_from_string( tokens[ 2 ] );
+
+				if ( property.attribute_type == PlyProperty::AttributeType::eUnknown ) {
+					std::cerr << "WARNING: Attribute name not recognised: '" << property.name << "'" << std::endl
+					          << std::flush;
+				}
+			} else {
+				return 0;
+			}
+
+			if ( property.type == PlyProperty::Type::eUnknown ||
+			     ( property.is_list && property.list_size_type == PlyProperty::Type::eUnknown ) ) {
+				std::cerr << "ERROR: Unknown property type: '" << line << "'" << std::endl
+				          << std::flush;
+				return 0;
+			}
+
+			elements.back().properties.emplace_back( std::move( property ) );
+			continue;
+		}
+
+		if ( tokens[ 0 ] == "end_header" ) {
+			// we have reached the marker which signals the end of the header.
+			break;
+		}
+
+		std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << "Invalid file header data: '" << line << "'" << std::endl
+		          << std::flush;
+		return 0;
+	}
+
+	if ( *format == PlyFormat::eUnknown ) {
+		return 0;
+	}
+
+	// Calculate byte offsets for properties of binary elements which have a fixed size.
+
+	for ( auto &element : elements ) {
+		uint32_t offset = 0;
+		for ( auto &p : element.properties ) {
+			if ( p.is_list && element.type == PlyElement::Type::eVertex ) {
+				// We parse vertices in parallel, which needs every vertex to have the same size.
+				std::cerr << "ERROR: List properties are not supported for vertex elements: '" << p.name << "'" << std::endl
+				          << std::flush;
+				return 0;
+			}
+			if ( p.is_list ) {
+				offset = 0;
+				break;
+			}
+			p.offset = offset;
+			offset += ply_type_size( p.type );
+		}
+		element.stride = offset;
+	}
+
+	return pos;
+}
+
+// ----------------------------------------------------------------------
+// Reads a binary value of given type, and converts it to double.
+static inline double ply_read_binary( char const *p, PlyProperty::Type type, bool swap_bytes ) {
+
+	char bytes[ 8 ];
+	auto num_bytes = ply_type_size( type );
+
+	if ( swap_bytes ) {
+		for ( uint32_t i = 0; i != num_bytes; i++ ) {
+			bytes[ i ] = p[ num_bytes - 1 - i ];
+		}
+	} else {
+		memcpy( bytes, p, num_bytes );
+	}
+
+	// clang-format off
+	switch ( type ) {
+	case PlyProperty::Type::eInt8:    { int8_t   v; memcpy( &v, bytes, 1 ); return v; }
+	case PlyProperty::Type::eUint8:   { uint8_t  v; memcpy( &v, bytes, 1 ); return v; }
+	case PlyProperty::Type::eInt16:   { int16_t  v; memcpy( &v, bytes, 2 ); return v; }
+	case PlyProperty::Type::eUint16:  { uint16_t v; memcpy( &v, bytes, 2 ); return v; }
+	case PlyProperty::Type::eInt32:   { int32_t  v; memcpy( &v, bytes, 4 ); return v; }
+	case PlyProperty::Type::eUint32:  { uint32_t v; memcpy( &v, bytes, 4 ); return v; }
+	case PlyProperty::Type::eFloat32: { float    v; memcpy( &v, bytes, 4 ); return v; }
+	case PlyProperty::Type::eFloat64: { double   v; memcpy( &v, bytes, 8 ); return v; }
+	case PlyProperty::Type::eUnknown: break;
+	}
+	// clang-format on
+
+	return 0;
+}
+
+// ----------------------------------------------------------------------
+// Fast ascii number parser - parses integers and floating point numbers,
+// and advances `c` past the number. Considerably faster than strtof, as it
+// does not depend on locale, and does not need a zero-terminated string.
+static inline double ply_parse_number( char const *&c, char const *end ) {
+
+	static constexpr double POW10[] = {
+	    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	while ( c != end && ( *c == ' ' || *c == '\t' ) ) {
+		c++;
+	}
+
+	char const *const start = c;
+
+	bool negative = false;
+
+	if ( c != end && ( *c == '-' || *c == '+' ) ) {
+		negative = ( *c == '-' );
+		c++;
+	}
+
+	uint64_t mantissa     = 0;
+	int32_t  exponent     = 0;
+	uint32_t num_digits   = 0;
+	bool     found_digits = false;
+
+	for ( ; c != end && uint8_t( *c - '0' ) < 10; c++ ) {
+		found_digits = true;
+		if ( num_digits < 19 ) {
+			mantissa = mantissa * 10 + uint8_t( *c - '0' );
+			num_digits += ( mantissa != 0 );
+		} else {
+			exponent++; // digits beyond what we can store only affect magnitude
+		}
+	}
+
+	if ( c != end && *c == '.' ) {
+		c++;
+		for ( ; c != end && uint8_t( *c - '0' ) < 10; c++ ) {
+			found_digits = true;
+			if ( num_digits < 19 ) {
+				mantissa = mantissa * 10 + uint8_t( *c - '0' );
+				num_digits += ( mantissa != 0 );
+				exponent--;
+			}
+		}
+	}
+
+	if ( found_digits && c != end && ( *c == 'e' || *c == 'E' ) ) {
+		c++;
+		bool exponent_negative = false;
+		if ( c != end && ( *c == '-' || *c == '+' ) ) {
+			exponent_negative = ( *c == '-' );
+			c++;
+		}
+		int32_t e = 0;
+		for ( ; c != end && uint8_t( *c - '0' ) < 10; c++ ) {
+			if ( e < 10000 ) {
+				e = e * 10 + ( *c - '0' );
+			}
+		}
+		exponent += exponent_negative ? -e : e;
+	}
+
+	if ( !found_digits ) {
+		// This is not a plain number (it could be "nan", or "inf") - we
+		// fall back to strtod, for which we need a zero-terminated copy.
+		char   buf[ 64 ];
+		size_t len = 0;
+		for ( c = start; c != end && len + 1 < sizeof( buf ) && *c != ' ' && *c != '\t' && *c != '\r' && *c != '\n'; c++ ) {
+			buf[ len++ ] = *c;
+		}
+		buf[ len ] = 0;
+		return strtod( buf, nullptr );
+	}
+
+	double value = double( mantissa );
+
+	if ( exponent < 0 ) {
+		value = exponent >= -22 ? value / POW10[ -exponent ] : value * pow( 10.0, exponent );
+	} else if ( exponent > 0 ) {
+		value = exponent <= 22 ? value * POW10[ exponent ] : value * pow( 10.0, exponent );
+	}
+
+	return negative ? -value : value;
+}
+
+// ----------------------------------------------------------------------
+
+static inline void ply_store_vertex_attribute( le_mesh_o *self, size_t i, PlyProperty const &p, double value ) {
+
+	// Integer colour values are normalised to [0..1]
+	float colour_scale = 1.f;
+
+	if ( p.type == PlyProperty::Type::eUint8 ) {
+		colour_scale = 1.f / 255.f;
+	} else if ( p.type == PlyProperty::Type::eUint16 ) {
+		colour_scale = 1.f / 65535.f;
+	}
+
+	// clang-format off
+	switch ( p.attribute_type ) {
+	case ( PlyProperty::AttributeType::eVX )   : self->vertices[ i ].x = float( value ); break;
+	case ( PlyProperty::AttributeType::eVY )   : self->vertices[ i ].y = float( value ); break;
+	case ( PlyProperty::AttributeType::eVZ )   : self->vertices[ i ].z = float( value ); break;
+	case ( PlyProperty::AttributeType::eNX )   : self->normals[ i ].x  = float( value ); break;
+	case ( PlyProperty::AttributeType::eNY )   : self->normals[ i ].y  = float( value ); break;
+	case ( PlyProperty::AttributeType::eNZ )   : self->normals[ i ].z  = float( value ); break;
+	case ( PlyProperty::AttributeType::eTexU ) : self->uvs[ i ].x      = float( value ); break;
+	case ( PlyProperty::AttributeType::eTexV ) : self->uvs[ i ].y      = float( value ); break;
+	case ( PlyProperty::AttributeType::eColR ) : self->colours[ i ].x  = float( value ) * colour_scale; break;
+	case ( PlyProperty::AttributeType::eColG ) : self->colours[ i ].y  = float( value ) * colour_scale; break;
+	case ( PlyProperty::AttributeType::eColB ) : self->colours[ i ].z  = float( value ) * colour_scale; break;
+	case ( PlyProperty::AttributeType::eColA ) : self->colours[ i ].w  = float( value ) * colour_scale; break;
+	case ( PlyProperty::AttributeType::eUnknown ): break; // unknown attributes are ignored
+	}
+	// clang-format on
+}
+
+// ----------------------------------------------------------------------
+// Adds indices for a face - faces with more than three vertices are triangulated as a fan.
+static inline void ply_store_face( std::vector<uint32_t> &indices, uint32_t const *face_indices, uint32_t count ) {
+	for ( uint32_t k = 2; k < count; k++ ) {
+		indices.push_back( face_indices[ 0 ] );
+		indices.push_back( face_indices[ k - 1 ] );
+		indices.push_back( face_indices[ k ] );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Calls `fun` for each task index in [0..num_tasks) - in parallel if the job system is available.
+static void ply_run_tasks( size_t num_tasks, void *user_data, void ( *fun )( void *user_data, size_t task_idx ) ) {
+
+#if ( LE_MT > 0 )
+	if ( num_tasks > 1 ) {
+
+		struct task_param_t {
+			void *user_data;
+			void ( *fun )( void *user_data, size_t task_idx );
+			size_t task_idx;
+		};
+
+		std::vector<task_param_t>   params( num_tasks );
+		std::vector<le_jobs::job_t> jobs;
+		jobs.reserve( num_tasks );
+
+		for ( size_t i = 0; i != num_tasks; i++ ) {
+			params[ i ] = { user_data, fun, i };
+			jobs.push_back( { []( void *param ) {
+				                 auto p = static_cast<task_param_t *>( param );
+				                 p->fun( p->user_data, p->task_idx );
+			                 },
+			                  &params[ i ] } );
+		}
+
+		le_jobs::counter_t *counter;
+		le_jobs::run_jobs( jobs.data(), uint32_t( jobs.size() ), &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
+		return;
+	}
+#endif
+
+	for ( size_t i = 0; i != num_tasks; i++ ) {
+		fun( user_data, i );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Returns size in bytes of a single binary element, which may contain lists.
+static size_t ply_binary_element_size( char const *p, char const *end, PlyElement const &element, bool swap_bytes ) {
+	size_t size = 0;
+	for ( auto const &prop : element.properties ) {
+		if ( prop.is_list ) {
+			uint32_t size_bytes = ply_type_size( prop.list_size_type );
+			if ( size_t( end - p ) < size + size_bytes ) {
+				return 0;
+			}
+			size_t count = size_t( ply_read_binary( p + size, prop.list_size_type, swap_bytes ) );
+			size += size_bytes + count * ply_type_size( prop.type );
+		} else {
+			size += ply_type_size( prop.type );
+		}
+	}
+	return size;
+}
+
+// ----------------------------------------------------------------------
+
+static bool ply_parse_binary( le_mesh_o *self, char const *body, char const *end, std::vector<PlyElement> const &elements, bool swap_bytes ) {
+
+	static constexpr size_t VERTICES_PER_TASK = 1 << 16;
+
+	char const *c = body;
+
+	for ( auto const &element : elements ) {
+
+		if ( element.type == PlyElement::Type::eVertex ) {
+
+			// Vertex elements with list properties were rejected when we parsed the header,
+			// which means that every vertex has the same size.
+
+			if ( element.stride != 0 && size_t( end - c ) / element.stride < element.num_elements ) {
+				return false;
+			}
+
+			// --------| invariant: all vertex data is available
+
+			// Every vertex has the same size, which means that we can parse vertices in parallel chunks.
+
+			struct vertex_task_t {
+				le_mesh_o *       mesh;
+				PlyElement const *element;
+				char const *      data;
+				bool              swap_bytes;
+			} task{ self, &element, c, swap_bytes };
+
+			size_t num_tasks = ( element.num_elements + VERTICES_PER_TASK - 1 ) / VERTICES_PER_TASK;
+
+			ply_run_tasks( num_tasks, &task, []( void *user_data, size_t task_idx ) {
+				auto         t     = static_cast<vertex_task_t *>( user_data );
+				size_t const begin = task_idx * VERTICES_PER_TASK;
+				size_t const end   = std::min( begin + VERTICES_PER_TASK, t->element->num_elements );
+				for ( size_t i = begin; i != end; i++ ) {
+					char const *v = t->data + i * t->element->stride;
+					for ( auto const &p : t->element->properties ) {
+						ply_store_vertex_attribute( t->mesh, i, p, ply_read_binary( v + p.offset, p.type, t->swap_bytes ) );
+					}
+				}
+			} );
+
+			c += element.num_elements * element.stride;
+
+		} else if ( element.type == PlyElement::Type::eFace ) {
+
+			self->indices.reserve( element.num_elements * 3 );
+
+			std::vector<uint32_t> face_indices;
+
+			for ( size_t i = 0; i != element.num_elements; i++ ) {
+				for ( auto const &p : element.properties ) {
+
+					if ( !p.is_list ) {
+						if ( size_t( end - c ) < ply_type_size( p.type ) ) {
+							return false;
+						}
+						c += ply_type_size( p.type ); // we ignore non-list face properties
+						continue;
+					}
+
+					uint32_t const size_bytes    = ply_type_size( p.list_size_type );
+					uint32_t const content_bytes = ply_type_size( p.type );
+
+					if ( size_t( end - c ) < size_bytes ) {
+						return false;
+					}
+
+					uint32_t count = uint32_t( ply_read_binary( c, p.list_size_type, swap_bytes ) );
+					c += size_bytes;
+
+					if ( size_t( end - c ) < size_t( count ) * content_bytes ) {
+						return false;
+					}
+
+					face_indices.resize( count );
+					for ( uint32_t k = 0; k != count; k++, c += content_bytes ) {
+						face_indices[ k ] = uint32_t( ply_read_binary( c, p.type, swap_bytes ) );
+					}
+
+					ply_store_face( self->indices, face_indices.data(), count );
+				}
+			}
+
+		} else {
+
+			// Skip elements which we don't know about
+
+			if ( element.stride != 0 ) {
+				if ( size_t( end - c ) / element.stride < element.num_elements ) {
+					return false;
+				}
+				c += element.num_elements * element.stride;
+			} else {
+				for ( size_t i = 0; i != element.num_elements; i++ ) {
+					size_t element_size = ply_binary_element_size( c, end, element, swap_bytes );
+					if ( element_size == 0 || size_t( end - c ) < element_size ) {
+						return false;
+					}
+					c += element_size;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static bool ply_parse_ascii( le_mesh_o *self, char const *body, char const *end, std::vector<PlyElement> const &elements ) {
+
+	static constexpr size_t BYTES_PER_CHUNK = 4 << 20;
+
+	// Split body into chunks of whole lines.
+
+	struct chunk_t {
+		char const *          begin;
+		char const *          end;
+		size_t                first_line;  // index of first line in this chunk, relative to body
+		size_t                num_lines;   // number of lines in this chunk
+		std::vector<uint32_t> indices;     // triangle indices for faces in this chunk
+		bool                  is_valid;    // false if chunk could not be parsed
+	};
+
+	std::vector<chunk_t> chunks;
+
+	for ( char const *c = body; c < end; ) {
+		char const *chunk_end = c + std::min( BYTES_PER_CHUNK, size_t( end - c ) );
+		if ( chunk_end != end ) {
+			char const *eol = static_cast<char const *>( memchr( chunk_end, '\n', size_t( end - chunk_end ) ) );
+			chunk_end       = eol ? eol + 1 : end;
+		}
+		chunks.push_back( { c, chunk_end, 0, 0, {}, true } );
+		c = chunk_end;
+	}
+
+	// Count lines per chunk, so that we know which line each chunk starts with.
+
+	ply_run_tasks( chunks.size(), chunks.data(), []( void *user_data, size_t task_idx ) {
+		auto &chunk = static_cast<chunk_t *>( user_data )[ task_idx ];
+		chunk.num_lines = size_t( std::count( chunk.begin, chunk.end, '\n' ) );
+		if ( chunk.end != chunk.begin && *( chunk.end - 1 ) != '\n' ) {
+			chunk.num_lines++; // last line has no line break
+		}
+	} );
+
+	for ( size_t i = 1; i < chunks.size(); i++ ) {
+		chunks[ i ].first_line = chunks[ i - 1 ].first_line + chunks[ i - 1 ].num_lines;
+	}
+
+	// Parse chunks - each line is one element, and elements are stored in the order
+	// in which they are declared in the header.
+
+	struct ascii_task_t {
+		le_mesh_o *                    mesh;
+		std::vector<PlyElement> const *elements;
+		chunk_t *                      chunks;
+	} task{ self, &elements, chunks.data() };
+
+	ply_run_tasks( chunks.size(), &task, []( void *user_data, size_t task_idx ) {
+		auto  t     = static_cast<ascii_task_t *>( user_data );
+		auto &chunk = t->chunks[ task_idx ];
+
+		std::vector<uint32_t> face_indices;
+
+		// Find element, and element index for first line in this chunk
+
+		size_t element_idx   = 0;
+		size_t element_start = 0; // line at which current element starts
+
+		auto const &elements = *t->elements;
+
+		char const *c = chunk.begin;
+
+		for ( size_t line = chunk.first_line; c < chunk.end; line++ ) {
+
+			while ( element_idx < elements.size() && line >= element_start + elements[ element_idx ].num_elements ) {
+				element_start += elements[ element_idx ].num_elements;
+				element_idx++;
+			}
+
+			if ( element_idx == elements.size() ) {
+				break; // lines beyond the last element are ignored
+			}
+
+			// --------| invariant: line belongs to element at element_idx
+
+			char const *line_end = static_cast<char const *>( memchr( c, '\n', size_t( chunk.end - c ) ) );
+
+			if ( line_end == nullptr ) {
+				line_end = chunk.end;
+			}
+
+			auto const & element = elements[ element_idx ];
+			size_t const i       = line - element_start;
+
+			if ( element.type == PlyElement::Type::eVertex ) {
+				for ( auto const &p : element.properties ) {
+					ply_store_vertex_attribute( t->mesh, i, p, ply_parse_number( c, line_end ) );
+				}
+			} else if ( element.type == PlyElement::Type::eFace ) {
+				for ( auto const &p : element.properties ) {
+					if ( !p.is_list ) {
+						ply_parse_number( c, line_end ); // we ignore non-list face properties
+						continue;
+					}
+					uint32_t count = uint32_t( ply_parse_number( c, line_end ) );
+					face_indices.resize( count );
+					for ( uint32_t k = 0; k != count; k++ ) {
+						face_indices[ k ] = uint32_t( ply_parse_number( c, line_end ) );
+					}
+					ply_store_face( chunk.indices, face_indices.data(), count );
+				}
+			}
+
+			c = line_end + 1;
+		}
+	} );
+
+	// Gather indices from all chunks, in order.
+
+	size_t num_indices = 0;
+	for ( auto const &chunk : chunks ) {
+		num_indices += chunk.indices.size();
+	}
+
+	self->indices.reserve( num_indices );
+
+	for ( auto &chunk : chunks ) {
+		self->indices.insert( self->indices.end(), chunk.indices.begin(), chunk.indices.end() );
+		chunk.indices = {};
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/// \brief loads mesh from ply file
+/// \note any contents of mesh will be cleared before loading
+/// \return true upon success, false otherwise.
+static bool le_mesh_load_from_ply_file( le_mesh_o *self, char const *file_path_ ) {
+
+	// - Make sure file exists
+
+	std::filesystem::path file_path{ file_path_ };
+
+	if ( !std::filesystem::exists( file_path ) ) {
+		std::cerr << "File not found: '" << file_path << "'";
+		return false;
+	}
+
+	// --------| invariant: File path exists
+
+	PlyFileData file;
+
+	if ( !ply_file_open( file_path, &file ) ) {
+		std::cerr << "File could not be loaded: '" << file_path << "'";
+		return false;
+	}
+
+	// --------| invariant: file was loaded.
+
+	// - Parse header into a vector of Element
+
+	PlyFormat               format = PlyFormat::eUnknown;
+	std::vector<PlyElement> elements;
+
+	size_t body_offset = ply_parse_header( file.data, file.size, &format, elements );
+
+	if ( body_offset == 0 ) {
+		std::cerr << "Invalid file header: '" << file_path << "'";
+		ply_file_close( &file );
+		return false;
+	}
+
+	// Every element with properties takes up at least one byte of the body, ascii or binary -
+	// we check this before we allocate space for elements, so that a corrupt element count
+	// can't make us allocate more memory than the file could possibly describe.
+
+	for ( auto const &element : elements ) {
+		if ( !element.properties.empty() && element.num_elements > file.size - body_offset ) {
+			std::cerr << "ERROR: File data is incomplete: '" << file_path << "'" << std::endl
+			          << std::flush;
+			ply_file_close( &file );
+			return false;
+		}
+	}
+
+	// - Clear mesh
+
+	le_mesh_clear( self );
+
+	// - Make space over all attributes for number of vertices.
+
+	for ( auto const &element : elements ) {
+
+		if ( element.type != PlyElement::Type::eVertex ) {
+			continue;
+		}
+
+		for ( auto const &p : element.properties ) {
+			switch ( p.attribute_type ) {
+			case ( PlyProperty::AttributeType::eVX ): // intentional fall-through
+			case ( PlyProperty::AttributeType::eVY ): // intentional fall-through
+			case ( PlyProperty::AttributeType::eVZ ): // intentional fall-through
+				self->vertices.resize( element.num_elements, {} );
+				break;
+			case ( PlyProperty::AttributeType::eNX ): // intentional fall-through
+			case ( PlyProperty::AttributeType::eNY ): // intentional fall-through
+			case ( PlyProperty::AttributeType::eNZ ): // intentional fall-through
+				self->normals.resize( element.num_elements, {} );
+				break;
+			case ( PlyProperty::AttributeType::eColR ): // intentional fall-through
+			case ( PlyProperty::AttributeType::eColG ): // intentional fall-through
+			case ( PlyProperty::AttributeType::eColB ): // intentional fall-through
+			case ( PlyProperty::AttributeType::eColA ): // intentional fall-through
+				self->colours.resize( element.num_elements, {} );
+				break;
+			case ( PlyProperty::AttributeType::eTexU ): // intentional fall-through
+			case ( PlyProperty::AttributeType::eTexV ): // intentional fall-through
+				self->uvs.resize( element.num_elements, {} );
+				break;
+			case ( PlyProperty::AttributeType::eUnknown ):
+				break;
+			}
+			// TODO: check for tangents.
+		}
+	}
+
+	// - Load file data
+
+	char const *body = file.data + body_offset;
+	char const *end  = file.data + file.size;
+
+	bool result = false;
+
+	switch ( format ) {
+	case PlyFormat::eAscii:
+		result = ply_parse_ascii( self, body, end, elements );
+		break;
+	case PlyFormat::eBinaryLittleEndian: // deliberate fall-through
+	case PlyFormat::eBinaryBigEndian: {
+		uint16_t const endian_test         = 1;
+		bool const     host_little_endian  = *reinterpret_cast<uint8_t const *>( &endian_test ) == 1;
+		bool const     file_little_endian  = format == PlyFormat::eBinaryLittleEndian;
+		result                             = ply_parse_binary( self, body, end, elements, host_little_endian != file_little_endian );
+	} break;
+	case PlyFormat::eUnknown:
+		break;
+	}
+
+	ply_file_close( &file );
+
+	if ( !result ) {
+		std::cerr << "ERROR: File data is incomplete: '" << file_path << "'" << std::endl
+		          << std::flush;
+		le_mesh_clear( self );
+		return false;
+	}
+
+	// Make sure that all indices reference valid vertices.
+
+	for ( auto const &i : self->indices ) {
+		if ( i >= self->vertices.size() ) {
+			std::cerr << "ERROR: Index out of bounds in file: '" << file_path << "'" << std::endl
+			          << std::flush;
+			le_mesh_clear( self );
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+extern void register_le_meshlets_api( void *api ); // in le_meshlets.cpp
+extern void register_le_mesh_lod_api( void *api ); // in le_mesh_lod.cpp
+
+LE_MODULE_REGISTER_IMPL( le_mesh, api ) {
+	auto &le_mesh_i = static_cast<le_mesh_api *>( api )->le_mesh_i;
+
+	le_mesh_i.get_vertices = le_mesh_get_vertices;
+	le_mesh_i.get_indices  = le_mesh_get_indices;
+	le_mesh_i.get_uvs      = le_mesh_get_uvs;
+	le_mesh_i.get_tangents = le_mesh_get_tangents;
+	le_mesh_i.get_normals  = le_mesh_get_normals;
+	le_mesh_i.get_colours  = le_mesh_get_colours;
+	le_mesh_i.get_data     = le_mesh_get_data;
+
+	le_mesh_i.get_indices_u32          = le_mesh_get_indices_u32;
+	le_mesh_i.get_data_u32             = le_mesh_get_data_u32;
+	le_mesh_i.get_interleaved_vertices = le_mesh_get_interleaved_vertices;
+	le_mesh_i.optimise                 = le_mesh_optimise;
+	le_mesh_i.get_statistics           = le_mesh_get_statistics;
+	le_mesh_i.build_meshlets           = le_mesh_build_meshlets;
+	le_mesh_i.build_lod_chain          = le_mesh_build_lod_chain;
+
+	le_mesh_i.load_from_ply_file = le_mesh_load_from_ply_file;
+
+	le_mesh_i.clear   = le_mesh_clear;
+	le_mesh_i.create  = le_mesh_create;
+	le_mesh_i.destroy = le_mesh_destroy;
+
+	register_le_meshlets_api( api );
+	register_le_mesh_lod_api( api );
 }
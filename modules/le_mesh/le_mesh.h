@@ -4,10 +4,107 @@
 #include "le_core.h"
 
 struct le_mesh_o;
+struct le_meshlets_o;
+struct le_mesh_lod_o;
 
 // clang-format off
 struct le_mesh_api {
 
+	static constexpr uint32_t ATTRIBUTE_NOT_PRESENT = ~uint32_t(0);
+
+	// Layout of interleaved vertex data, as returned by `get_interleaved_vertices`.
+	// Offsets are in bytes, relative to the start of each vertex. Attributes which the
+	// mesh does not have are marked with ATTRIBUTE_NOT_PRESENT.
+	struct interleaved_vertex_layout_t {
+		uint32_t stride;
+		uint32_t offset_position; // float x3
+		uint32_t offset_normal;   // float x3, quantised: snorm8  x4 (w = 0)
+		uint32_t offset_uv;       // float x2, quantised: float16 x2
+		uint32_t offset_colour;   // float x4, quantised: unorm8  x4
+		uint32_t offset_tangent;  // float x3, quantised: snorm8  x4 (w = 0)
+	};
+
+	struct mesh_statistics_t {
+		float acmr;        // average cache miss ratio: transformed vertices per triangle (lower is better, optimum: 0.5)
+		float atvr;        // average transformed vertex ratio: transformed vertices per vertex (lower is better, optimum: 1.0)
+		float fetch_ratio; // bytes fetched from vertex memory per byte of vertex data (lower is better, optimum: 1.0)
+	};
+
+	// Meshlets partition a mesh into small clusters of triangles which may be culled individually,
+	// either on the cpu, or by a task shader. Meshlet layout matches std430, so that meshlets may be
+	// uploaded verbatim.
+	static constexpr uint32_t MESHLET_MAX_VERTICES  = 64;  // default - vertices per meshlet may not exceed 255, as local vertex indices are 8 bit
+	static constexpr uint32_t MESHLET_MAX_TRIANGLES = 124; // default
+
+	struct meshlet_t {
+		float    centre[ 3 ];     // bounding sphere centre, in object space
+		float    radius;          // bounding sphere radius
+		float    cone_axis[ 3 ];  // normal cone axis: average direction of triangle normals
+		float    cone_cutoff;     // sine of normal cone half-angle - 1 if meshlet may never be backface-culled
+		uint32_t vertex_offset;   // first element in meshlet vertex indices
+		uint32_t vertex_count;    //
+		uint32_t triangle_offset; // first triangle in meshlet triangles, and in meshlet-ordered indices
+		uint32_t triangle_count;  //
+	};
+
+	struct meshlet_cull_params_t {
+		float planes[ 6 ][ 4 ];     // frustum planes in object space - points p inside the frustum fulfil dot( plane.xyz, p ) + plane.w >= 0
+		float camera_position[ 3 ]; // camera position in object space
+		float radius_scale;         // scale applied to radii - use the largest scale factor of the object-to-world transform if planes are normalised in world space
+		bool  cull_backfacing;      // only valid if object-to-world transform has uniform scale
+	};
+
+	struct le_meshlets_interface_t {
+
+		le_meshlets_o * ( * create  ) ( );
+		void            ( * destroy ) ( le_meshlets_o* self );
+
+		// Partitions a triangle list into meshlets of at most max_vertices vertices and max_triangles triangles.
+		// Positions are read as float x3, position_stride is given in bytes. Any previous contents are replaced.
+		void (*build)( le_meshlets_o* self, float const* positions, uint32_t position_stride, size_t num_vertices, uint32_t const* indices, size_t num_indices, uint32_t max_vertices, uint32_t max_triangles );
+
+		void (*get_meshlets       )( le_meshlets_o* self, size_t& count, meshlet_t const** meshlets );
+		void (*get_vertex_indices )( le_meshlets_o* self, size_t& count, uint32_t const** vertex_indices ); // meshlet-local vertex index -> mesh vertex index
+		void (*get_triangles      )( le_meshlets_o* self, size_t& count, uint8_t const** triangles );       // three meshlet-local vertex indices per triangle
+		void (*get_indices        )( le_meshlets_o* self, size_t& count, uint32_t const** indices );        // all triangles in meshlet order, as mesh vertex indices
+
+		// Writes indices of meshlets which may be visible into visible_meshlets, which must have space for
+		// meshlet_count elements. Returns number of visible meshlets - visible meshlets keep their order.
+		size_t (*cull)( meshlet_t const* meshlets, size_t meshlet_count, meshlet_cull_params_t const* params, uint32_t* visible_meshlets );
+	};
+
+	// Level-of-detail chains: each level is a list of indices into the original mesh's vertices,
+	// with about half the triangles of the level before it. Level 0 is the original mesh.
+	struct lod_level_t {
+		uint32_t index_offset; // first index for this level in lod indices
+		uint32_t index_count;  //
+		float    error;        // largest distance from the original mesh along triangle normals, in object-space units
+	};
+
+	struct lod_select_params_t {
+		float distance;         // distance from camera to closest point of the object's bounds, in world units
+		float object_scale;     // largest scale factor of object-to-world transform
+		float projection_scale; // pixels per world unit at distance 1: viewport_height / ( 2 * tan( fovy / 2 ) )
+		float max_pixel_error;  // largest acceptable error, in pixels
+	};
+
+	struct le_mesh_lod_interface_t {
+
+		le_mesh_lod_o * ( * create  ) ( );
+		void            ( * destroy ) ( le_mesh_lod_o* self );
+
+		// Builds a chain of at most max_levels levels, by quadric error metric simplification. Each level keeps
+		// roughly `ratio` of the triangles of the level before it (0.5 if ratio is not within ]0..1[).
+		// Positions are read as float x3, position_stride is given in bytes. Any previous contents are replaced.
+		void (*build)( le_mesh_lod_o* self, float const* positions, uint32_t position_stride, size_t num_vertices, uint32_t const* indices, size_t num_indices, uint32_t max_levels, float ratio );
+
+		void (*get_levels  )( le_mesh_lod_o* self, size_t& count, lod_level_t const** levels );
+		void (*get_indices )( le_mesh_lod_o* self, size_t& count, uint32_t const** indices ); // indices for all levels
+
+		// Returns the coarsest level whose projected error stays within params->max_pixel_error.
+		uint32_t (*select_level)( lod_level_t const* levels, size_t level_count, lod_select_params_t const* params );
+	};
+
 	struct le_mesh_interface_t {
 
 		le_mesh_o *    ( * create                   ) ( );
@@ -21,14 +118,37 @@ struct le_mesh_api {
 		void (*get_uvs      )( le_mesh_o *self, size_t& count, float const **   uvs     );
 		void (*get_tangents )( le_mesh_o *self, size_t& count, float const **   tangents);
 		void (*get_indices  )( le_mesh_o *self, size_t& count, uint16_t const ** indices );
+		void (*get_indices_u32 )( le_mesh_o *self, size_t& count, uint32_t const ** indices );
 
+		// NOTE: 16 bit indices are only available if the mesh has no more than 65536 vertices - otherwise
+		// index count is returned as 0; use `get_indices_u32` / `get_data_u32` for larger meshes.
 		void (*get_data     )( le_mesh_o *self, size_t& numVertices, size_t& numIndices, float const** vertices, float const **normals, float const **uvs, float const  ** colours, uint16_t const **indices);
+		void (*get_data_u32 )( le_mesh_o *self, size_t& numVertices, size_t& numIndices, float const** vertices, float const **normals, float const **uvs, float const  ** colours, uint32_t const **indices);
+
+		// Returns vertex attributes interleaved into a single stream - optionally quantised, see interleaved_vertex_layout_t.
+		// Data is owned by the mesh, and remains valid until the next call to this method, or until the mesh changes.
+		void (*get_interleaved_vertices)( le_mesh_o *self, bool quantise, interleaved_vertex_layout_t* layout, size_t& numVertices, void const ** data );
+
+		// Reorders triangles for post-transform vertex cache efficiency (Tipsify) and reduced overdraw,
+		// then reorders vertices in order of first use for vertex fetch locality. Does not change the mesh's appearance.
+		void (*optimise     )( le_mesh_o *self, uint32_t vertex_cache_size );
+
+		// Simulates post-transform vertex cache (FIFO), and vertex fetch for given vertex stride in bytes.
+		void (*get_statistics)( le_mesh_o *self, uint32_t vertex_cache_size, uint32_t vertex_stride, mesh_statistics_t* statistics );
+
+		// Builds meshlets from the mesh's positions and indices - see le_meshlets_interface_t.
+		void (*build_meshlets)( le_mesh_o *self, le_meshlets_o* meshlets, uint32_t max_vertices, uint32_t max_triangles );
+
+		// Builds a level-of-detail chain from the mesh's positions and indices - see le_mesh_lod_interface_t.
+		void (*build_lod_chain)( le_mesh_o *self, le_mesh_lod_o* lod, uint32_t max_levels, float ratio );
 
 		bool (*load_from_ply_file)( le_mesh_o *self, char const *file_path );
 
 	};
 
 	le_mesh_interface_t       le_mesh_i;
+	le_meshlets_interface_t   le_meshlets_i;
+	le_mesh_lod_interface_t   le_mesh_lod_i;
 };
 // clang-format on
 LE_MODULE( le_mesh );
@@ -39,6 +159,8 @@ LE_MODULE_LOAD_DEFAULT( le_mesh );
 namespace le_mesh {
 const auto         api       = le_mesh_api_i;
 static const auto &le_mesh_i = api -> le_mesh_i;
+static const auto &le_meshlets_i = api -> le_meshlets_i;
+static const auto &le_mesh_lod_i = api -> le_mesh_lod_i;
 } // namespace le_mesh
 
 class LeMesh : NoCopy, NoMove {
@@ -73,7 +195,7 @@ class LeMesh : NoCopy, NoMove {
 	}
 
 	void getNormals( size_t &count, float const **pNormals = nullptr ) {
-		this_i.get_vertices( self, count, pNormals );
+		this_i.get_normals( self, count, pNormals );
 	}
 
 	void getUvs( size_t &count, float const **pUvs = nullptr ) {
@@ -88,6 +210,36 @@ class LeMesh : NoCopy, NoMove {
 		this_i.get_data( self, numVertices, numIndices, pVertices, pNormals, pUvs, pColours, pIndices );
 	}
 
+	void getIndices( size_t &count, uint32_t const **pIndices ) {
+		this_i.get_indices_u32( self, count, pIndices );
+	}
+
+	void getData( size_t &numVertices, size_t &numIndices, float const **pVertices, float const **pNormals, float const **pUvs, float const **pColours, uint32_t const **pIndices ) {
+		this_i.get_data_u32( self, numVertices, numIndices, pVertices, pNormals, pUvs, pColours, pIndices );
+	}
+
+	void getInterleavedVertices( bool quantise, le_mesh_api::interleaved_vertex_layout_t &layout, size_t &numVertices, void const **pData ) {
+		this_i.get_interleaved_vertices( self, quantise, &layout, numVertices, pData );
+	}
+
+	void optimise( uint32_t vertexCacheSize = 16 ) {
+		this_i.optimise( self, vertexCacheSize );
+	}
+
+	le_mesh_api::mesh_statistics_t getStatistics( uint32_t vertexCacheSize = 16, uint32_t vertexStride = 0 ) {
+		le_mesh_api::mesh_statistics_t stats{};
+		this_i.get_statistics( self, vertexCacheSize, vertexStride, &stats );
+		return stats;
+	}
+
+	void buildMeshlets( le_meshlets_o *meshlets, uint32_t maxVertices = le_mesh_api::MESHLET_MAX_VERTICES, uint32_t maxTriangles = le_mesh_api::MESHLET_MAX_TRIANGLES ) {
+		this_i.build_meshlets( self, meshlets, maxVertices, maxTriangles );
+	}
+
+	void buildLodChain( le_mesh_lod_o *lod, uint32_t maxLevels = 8, float ratio = 0.5f ) {
+		this_i.build_lod_chain( self, lod, maxLevels, ratio );
+	}
+
 	bool loadFromPlyFile( char const *file_path ) {
 		return this_i.load_from_ply_file( self, file_path );
 	}
@@ -99,6 +251,74 @@ class LeMesh : NoCopy, NoMove {
 #	endif
 };
 
+class LeMeshlets : NoCopy, NoMove {
+#	ifndef this_i
+#		define this_i le_mesh::le_meshlets_i
+
+	le_meshlets_o *self;
+
+  public:
+	LeMeshlets()
+	    : self( this_i.create() ) {
+	}
+
+	~LeMeshlets() {
+		this_i.destroy( self );
+	}
+
+	void getMeshlets( size_t &count, le_mesh_api::meshlet_t const **pMeshlets = nullptr ) {
+		this_i.get_meshlets( self, count, pMeshlets );
+	}
+
+	void getVertexIndices( size_t &count, uint32_t const **pVertexIndices = nullptr ) {
+		this_i.get_vertex_indices( self, count, pVertexIndices );
+	}
+
+	void getTriangles( size_t &count, uint8_t const **pTriangles = nullptr ) {
+		this_i.get_triangles( self, count, pTriangles );
+	}
+
+	void getIndices( size_t &count, uint32_t const **pIndices = nullptr ) {
+		this_i.get_indices( self, count, pIndices );
+	}
+
+	operator auto() {
+		return self;
+	}
+#		undef this_i
+#	endif
+};
+
+class LeMeshLod : NoCopy, NoMove {
+#	ifndef this_i
+#		define this_i le_mesh::le_mesh_lod_i
+
+	le_mesh_lod_o *self;
+
+  public:
+	LeMeshLod()
+	    : self( this_i.create() ) {
+	}
+
+	~LeMeshLod() {
+		this_i.destroy( self );
+	}
+
+	void getLevels( size_t &count, le_mesh_api::lod_level_t const **pLevels = nullptr ) {
+		this_i.get_levels( self, count, pLevels );
+	}
+
+	void getIndices( size_t &count, uint32_t const **pIndices = nullptr ) {
+		this_i.get_indices( self, count, pIndices );
+	}
+
+	operator auto() {
+		return self;
+	}
+#		undef this_i
+#	endif
+};
+
 #endif // __cplusplus
 
 #endif
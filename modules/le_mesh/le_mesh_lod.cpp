@@ -0,0 +1,742 @@
+#include "le_mesh.h"
+#include "le_core.h"
+
+#include <math.h>
+#include <float.h>
+#include <string.h>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+#include "glm/glm.hpp"
+
+/*
+ * Level-of-detail chains via quadric error metric simplification
+ *
+ * We simplify by collapsing edges, always moving one endpoint onto the other.
+ * This means that simplified levels only ever refer to vertices of the
+ * original mesh, and all levels can share the same vertex buffer - a level of
+ * detail is nothing but a different list of indices.
+ *
+ * Each vertex accumulates the planes of its adjacent triangles as a quadric
+ * (Garland & Heckbert 1997), so that the cost of a collapse is the (area-
+ * weighted mean) squared distance of the new position to these planes. Border
+ * edges receive additional perpendicular planes, so that open borders stay put.
+ * Quadric costs only decide the order of collapses: the error which we report
+ * for each level is a bound, see below.
+ *
+ * Vertices which share a position (e.g. across uv seams, or in flat-shaded
+ * meshes) are welded before simplification, so that seams can't tear open.
+ * Each triangle corner keeps track of the original vertex - and with it, the
+ * attributes - it uses. A vertex which sits on an attribute seam (its corners
+ * use more than one original vertex) never moves, and a corner which moves
+ * takes the original vertex which the collapsing triangles used at the
+ * collapse target - so that corners never take attributes from the other
+ * side of a seam. Note that this means that meshes in which no vertices are
+ * shared between triangles (e.g. flat-shaded meshes) can't be simplified.
+ *
+ * Error: when a vertex moves onto its neighbour, each triangle around it is
+ * replaced by a triangle which shares two of its corners. Any point on the
+ * old triangle lies at most as far from the plane of the new triangle as the
+ * moving vertex does, and vice versa for the vertex it moves onto. We take
+ * the largest of these distances for each collapse, and each vertex keeps the
+ * largest error which ended in it: the error of the vertex that moved, plus
+ * the distance of the collapse. The error of a level is the largest error of
+ * any vertex - unlike quadric costs, which are area-weighted means, this is a
+ * maximum distance, measured along triangle normals: it does not count
+ * vertices sliding within the surface.
+ *
+ */
+
+struct le_mesh_lod_o {
+	std::vector<le_mesh_api::lod_level_t> levels;
+	std::vector<uint32_t>                 indices; // indices for all levels, back-to-back, finest level first
+};
+
+static constexpr float LOD_BORDER_WEIGHT  = 10.f;  // weight for planes which keep border edges in place
+static constexpr float LOD_MIN_NORMAL_DOT = 0.25f; // collapses which rotate a triangle's normal further than this are rejected
+static constexpr float LOD_MIN_REDUCTION  = 0.9f;  // stop building levels if a level keeps more than this fraction of triangles
+static constexpr float LOD_DEFAULT_RATIO  = 0.5f;  // default ratio of triangles kept from one level to the next
+
+// Symmetric 4x4 matrix - we only store the upper triangle.
+struct lod_quadric_t {
+	double a00, a01, a02, a03;
+	double a11, a12, a13;
+	double a22, a23;
+	double a33;
+	double weight; // sum of weights of all planes, so that we can return a mean
+};
+
+// ----------------------------------------------------------------------
+
+static void lod_quadric_add_plane( lod_quadric_t &q, glm::vec3 const &n, float d, float weight ) {
+	double const x = n.x, y = n.y, z = n.z, w = d;
+
+	q.a00 += weight * x * x;
+	q.a01 += weight * x * y;
+	q.a02 += weight * x * z;
+	q.a03 += weight * x * w;
+	q.a11 += weight * y * y;
+	q.a12 += weight * y * z;
+	q.a13 += weight * y * w;
+	q.a22 += weight * z * z;
+	q.a23 += weight * z * w;
+	q.a33 += weight * w * w;
+	q.weight += weight;
+}
+
+// ----------------------------------------------------------------------
+
+static void lod_quadric_add( lod_quadric_t &q, lod_quadric_t const &other ) {
+	double *      dst = &q.a00;
+	double const *src = &other.a00;
+	for ( size_t i = 0; i != sizeof( lod_quadric_t ) / sizeof( double ); i++ ) {
+		dst[ i ] += src[ i ];
+	}
+}
+
+// ----------------------------------------------------------------------
+// Returns mean squared distance of p to all planes in q.
+static double lod_quadric_error( lod_quadric_t const &q, glm::vec3 const &p ) {
+	double const x = p.x, y = p.y, z = p.z;
+
+	double error =
+	    q.a00 * x * x + 2 * q.a01 * x * y + 2 * q.a02 * x * z + 2 * q.a03 * x +
+	    q.a11 * y * y + 2 * q.a12 * y * z + 2 * q.a13 * y +
+	    q.a22 * z * z + 2 * q.a23 * z +
+	    q.a33;
+
+	return q.weight > 0 ? std::max( error, 0.0 ) / q.weight : 0.0;
+}
+
+// ----------------------------------------------------------------------
+
+struct lod_collapse_t {
+	double   cost;
+	uint32_t from; // vertex which moves
+	uint32_t to;   // vertex which stays
+
+	bool operator<( lod_collapse_t const &rhs ) const {
+		return cost < rhs.cost;
+	}
+};
+
+// Welded mesh, shared by all levels of a chain.
+struct lod_weld_t {
+	std::vector<uint32_t>  canonical; // original vertex index -> welded vertex index
+	std::vector<glm::vec3> positions; // welded vertex positions
+};
+
+// ----------------------------------------------------------------------
+
+static void lod_weld( lod_weld_t &weld, float const *positions, uint32_t position_stride, size_t num_vertices ) {
+
+	struct position_hash_t {
+		size_t operator()( glm::vec3 const &p ) const {
+			uint32_t bits[ 3 ];
+			memcpy( bits, &p.x, sizeof( bits ) );
+			return size_t( bits[ 0 ] * 73856093u ) ^ size_t( bits[ 1 ] * 19349663u ) ^ size_t( bits[ 2 ] * 83492791u );
+		}
+	};
+
+	struct position_equal_t {
+		bool operator()( glm::vec3 const &lhs, glm::vec3 const &rhs ) const {
+			return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
+		}
+	};
+
+	std::unordered_map<glm::vec3, uint32_t, position_hash_t, position_equal_t> welded;
+	welded.reserve( num_vertices );
+
+	weld.canonical.resize( num_vertices );
+	weld.positions.clear();
+
+	for ( size_t i = 0; i != num_vertices; i++ ) {
+		float const *p = reinterpret_cast<float const *>( reinterpret_cast<char const *>( positions ) + i * position_stride );
+		glm::vec3    position( p[ 0 ], p[ 1 ], p[ 2 ] );
+
+		auto it = welded.emplace( position, uint32_t( weld.positions.size() ) );
+
+		if ( it.second ) {
+			weld.positions.push_back( position );
+		}
+
+		weld.canonical[ i ] = it.first->second;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Simplifies triangle list `indices` (original vertex indices) until it has at most
+// target_index_count indices, or no more collapses are possible.
+//
+// `vertex_error` holds the error accumulated by each welded vertex, and carries
+// over from one level to the next. Returns the largest error of any vertex which
+// received a moving vertex.
+static float lod_simplify( lod_weld_t const &weld, std::vector<uint32_t> const &indices, size_t target_index_count, std::vector<float> &vertex_error, std::vector<uint32_t> &result ) {
+
+	size_t const num_vertices = weld.positions.size();
+
+	// -- Gather triangles in welded vertex indices - triangles which are degenerate
+	// after welding are dropped.
+
+	std::vector<uint32_t> triangles;     // welded vertex indices, 3 per triangle
+	std::vector<uint32_t> corners;       // original vertex indices, 3 per triangle - these carry attributes
+	std::vector<uint8_t>  triangle_dead; // whether triangle collapsed
+	triangles.reserve( indices.size() );
+	corners.reserve( indices.size() );
+
+	for ( size_t i = 0; i + 2 < indices.size(); i += 3 ) {
+		uint32_t a = weld.canonical[ indices[ i + 0 ] ];
+		uint32_t b = weld.canonical[ indices[ i + 1 ] ];
+		uint32_t c = weld.canonical[ indices[ i + 2 ] ];
+		if ( a == b || b == c || c == a ) {
+			continue;
+		}
+		triangles.insert( triangles.end(), { a, b, c } );
+		corners.insert( corners.end(), { indices[ i + 0 ], indices[ i + 1 ], indices[ i + 2 ] } );
+	}
+
+	size_t const num_triangles = triangles.size() / 3;
+	size_t       num_live      = num_triangles;
+
+	triangle_dead.assign( num_triangles, 0 );
+
+	// -- Vertex -> triangle adjacency
+
+	std::vector<std::vector<uint32_t>> adjacency( num_vertices );
+
+	for ( size_t t = 0; t != num_triangles; t++ ) {
+		for ( size_t k = 0; k != 3; k++ ) {
+			adjacency[ triangles[ t * 3 + k ] ].push_back( uint32_t( t ) );
+		}
+	}
+
+	// -- Quadrics: one plane per adjacent triangle, weighted by triangle area,
+	// plus perpendicular planes for border edges.
+
+	std::vector<lod_quadric_t> quadrics( num_vertices, lod_quadric_t{} );
+
+	// -- Find border edges: we sort all triangle edges by their endpoints - an edge
+	// which appears only once belongs to only one triangle, and is a border edge.
+
+	std::vector<uint8_t> is_border_edge( num_triangles * 3, 0 ); // for edge starting at each triangle corner
+	{
+		struct edge_t {
+			uint64_t key;    // undirected edge: smaller vertex index in upper 32 bits
+			uint32_t corner; // triangle corner at which this edge starts
+		};
+
+		std::vector<edge_t> edges( num_triangles * 3 );
+
+		for ( size_t c = 0; c != num_triangles * 3; c++ ) {
+			uint32_t const a = triangles[ c ];
+			uint32_t const b = triangles[ c - c % 3 + ( c + 1 ) % 3 ];
+			edges[ c ]       = { a < b ? ( uint64_t( a ) << 32 | b ) : ( uint64_t( b ) << 32 | a ), uint32_t( c ) };
+		}
+
+		std::sort( edges.begin(), edges.end(), []( edge_t const &lhs, edge_t const &rhs ) { return lhs.key < rhs.key; } );
+
+		for ( size_t i = 0; i != edges.size(); ) {
+			size_t j = i + 1;
+			while ( j != edges.size() && edges[ j ].key == edges[ i ].key ) {
+				j++;
+			}
+			if ( j - i == 1 ) {
+				is_border_edge[ edges[ i ].corner ] = 1;
+			}
+			i = j;
+		}
+	}
+
+	for ( size_t t = 0; t != num_triangles; t++ ) {
+		uint32_t const *tri = &triangles[ t * 3 ];
+
+		glm::vec3 const &p0 = weld.positions[ tri[ 0 ] ];
+		glm::vec3 const &p1 = weld.positions[ tri[ 1 ] ];
+		glm::vec3 const &p2 = weld.positions[ tri[ 2 ] ];
+
+		glm::vec3 n      = glm::cross( p1 - p0, p2 - p0 );
+		float     length = glm::length( n );
+
+		if ( length == 0.f ) {
+			continue;
+		}
+
+		n /= length;
+
+		for ( size_t k = 0; k != 3; k++ ) {
+			lod_quadric_add_plane( quadrics[ tri[ k ] ], n, -glm::dot( n, p0 ), length * 0.5f );
+		}
+	}
+
+	for ( size_t t = 0; t != num_triangles; t++ ) {
+		uint32_t const *tri = &triangles[ t * 3 ];
+
+		glm::vec3 const &p0 = weld.positions[ tri[ 0 ] ];
+		glm::vec3 const &p1 = weld.positions[ tri[ 1 ] ];
+		glm::vec3 const &p2 = weld.positions[ tri[ 2 ] ];
+
+		glm::vec3 const n = glm::cross( p1 - p0, p2 - p0 );
+
+		for ( size_t k = 0; k != 3; k++ ) {
+			uint32_t a = tri[ k ];
+			uint32_t b = tri[ ( k + 1 ) % 3 ];
+
+			if ( !is_border_edge[ t * 3 + k ] ) {
+				continue;
+			}
+
+			// --------| invariant: edge a-b is a border edge
+
+			glm::vec3 const edge         = weld.positions[ b ] - weld.positions[ a ];
+			glm::vec3       border_n     = glm::cross( edge, n );
+			float const     border_len   = glm::length( border_n );
+			float const     edge_len_sqr = glm::dot( edge, edge );
+
+			if ( border_len == 0.f ) {
+				continue;
+			}
+
+			border_n /= border_len;
+
+			float const d = -glm::dot( border_n, weld.positions[ a ] );
+
+			lod_quadric_add_plane( quadrics[ a ], border_n, d, edge_len_sqr * LOD_BORDER_WEIGHT );
+			lod_quadric_add_plane( quadrics[ b ], border_n, d, edge_len_sqr * LOD_BORDER_WEIGHT );
+		}
+	}
+
+	// -- Collapses
+	//
+	// We collapse in passes: each pass calculates the cost of all live edges, and then
+	// collapses the cheapest edges whose neighbourhoods don't overlap - so that costs
+	// calculated at the start of a pass stay valid throughout the pass. This touches
+	// memory in order, and is much faster than a priority queue with lazy updates.
+
+	std::vector<uint32_t> collapsed_into( num_vertices, uint32_t( ~0u ) ); // ~0 if vertex was not collapsed
+	std::vector<uint8_t>  locked( num_vertices, 0 );                     // whether neighbourhood of vertex changed during current pass
+
+	// Candidate collapses, one per live edge. A collapse only changes the quadric of
+	// the vertex which stays, which means that after each pass we only need to
+	// recalculate candidates for edges around vertices which took part in a collapse.
+	// Initially, all vertices count as changed.
+	std::vector<lod_collapse_t> collapses;
+	std::vector<uint32_t>       changed_vertices( num_vertices );
+	std::vector<uint8_t>        changed( num_vertices, 1 );
+
+	for ( uint32_t v = 0; v != num_vertices; v++ ) {
+		changed_vertices[ v ] = v;
+	}
+
+	auto calculate_collapse = [ & ]( uint32_t a, uint32_t b ) -> lod_collapse_t {
+		lod_quadric_t q = quadrics[ a ];
+		lod_quadric_add( q, quadrics[ b ] );
+
+		double const cost_a_to_b = lod_quadric_error( q, weld.positions[ b ] );
+		double const cost_b_to_a = lod_quadric_error( q, weld.positions[ a ] );
+
+		if ( cost_a_to_b <= cost_b_to_a ) {
+			return { cost_a_to_b, a, b };
+		} else {
+			return { cost_b_to_a, b, a };
+		}
+	};
+
+	// We visit neighbours of a vertex by iterating over its triangles, which means
+	// that we see most neighbours twice. We mark visited neighbours with a stamp,
+	// which is unique for each visit, so that we never need to clear marks.
+	std::vector<uint32_t> neighbour_stamp( num_vertices, 0 );
+	uint32_t              stamp = 0;
+
+	auto for_each_neighbour = [ & ]( uint32_t v, auto &&fun ) {
+		for ( uint32_t t : adjacency[ v ] ) {
+			if ( triangle_dead[ t ] ) {
+				continue;
+			}
+			for ( size_t k = 0; k != 3; k++ ) {
+				if ( triangles[ t * 3 + k ] != v ) {
+					fun( triangles[ t * 3 + k ] );
+				}
+			}
+		}
+	};
+
+	float max_error   = 0;
+	bool  limit_costs = true; // whether to only consider collapses up to a cost limit in the current pass
+
+	while ( num_live * 3 > target_index_count ) {
+
+		// -- Update candidate collapses: drop candidates which involve a vertex that
+		// changed during the last pass, and recalculate candidates for all live edges
+		// around changed vertices.
+
+		collapses.erase( std::remove_if( collapses.begin(), collapses.end(),
+		                                 [ & ]( lod_collapse_t const &c ) { return changed[ c.from ] || changed[ c.to ]; } ),
+		                 collapses.end() );
+
+		for ( uint32_t v : changed_vertices ) {
+			if ( collapsed_into[ v ] != uint32_t( ~0u ) ) {
+				continue;
+			}
+			uint32_t const stamp_v = ++stamp;
+			for_each_neighbour( v, [ & ]( uint32_t n ) {
+				// If both endpoints changed, only the smaller one adds the edge.
+				if ( neighbour_stamp[ n ] != stamp_v && ( !changed[ n ] || v < n ) ) {
+					neighbour_stamp[ n ] = stamp_v;
+					collapses.push_back( calculate_collapse( v, n ) );
+				}
+			} );
+		}
+
+		std::fill( changed.begin(), changed.end(), 0 );
+		changed_vertices.clear();
+
+		if ( collapses.empty() ) {
+			break;
+		}
+
+		// Each collapse removes about two triangles. We only consider collapses which
+		// cost little more than the collapse which would take us to our target, so that
+		// expensive collapses don't pre-empt cheap collapses which become available in
+		// later passes. Only collapses within this limit need sorting.
+
+		size_t const goal = std::min( collapses.size() - 1, ( num_live - target_index_count / 3 ) / 2 );
+
+		std::nth_element( collapses.begin(), collapses.begin() + goal, collapses.end() );
+
+		double const cost_limit = collapses[ goal ].cost * 1.5;
+
+		auto const collapses_end = limit_costs
+		                               ? std::partition( collapses.begin() + goal, collapses.end(),
+		                                                 [ & ]( lod_collapse_t const &c ) { return c.cost <= cost_limit; } )
+		                               : collapses.end();
+
+		std::sort( collapses.begin(), collapses_end );
+
+		std::fill( locked.begin(), locked.end(), 0 );
+
+		size_t num_collapsed = 0;
+
+		for ( auto it = collapses.begin(); it != collapses_end && num_live * 3 > target_index_count; it++ ) {
+
+			uint32_t const from = it->from;
+			uint32_t const to   = it->to;
+
+			if ( locked[ from ] || locked[ to ] ) {
+				continue; // cost of this collapse may have changed
+			}
+
+			// -- Link condition: vertices which are neighbours of both endpoints must
+			// be exactly the vertices opposite the collapsing edge - otherwise the
+			// collapse would create non-manifold geometry.
+
+			size_t num_common = 0;
+
+			uint32_t const stamp_from   = ++stamp;
+			uint32_t const stamp_common = ++stamp;
+
+			for_each_neighbour( from, [ & ]( uint32_t n ) {
+				neighbour_stamp[ n ] = stamp_from;
+			} );
+
+			for_each_neighbour( to, [ & ]( uint32_t n ) {
+				if ( neighbour_stamp[ n ] == stamp_from ) {
+					neighbour_stamp[ n ] = stamp_common; // so that we count each common neighbour only once
+					num_common++;
+				}
+			} );
+
+			size_t num_shared = 0; // number of live triangles which contain both from and to
+
+			// -- Attribute seams: all corners at `from` must use the same original vertex,
+			// and all triangles which collapse must use the same original vertex at `to` -
+			// this is the vertex which the corners that move will use from now on.
+
+			uint32_t const no_vertex   = uint32_t( ~0u );
+			uint32_t       vertex_from = no_vertex;
+			uint32_t       vertex_to   = no_vertex;
+
+			bool  is_valid = true;
+			float distance = 0.f; // largest distance between triangles around `from` before, and after the collapse
+
+			for ( uint32_t t : adjacency[ from ] ) {
+				if ( triangle_dead[ t ] ) {
+					continue;
+				}
+
+				uint32_t const *tri = &triangles[ t * 3 ];
+
+				for ( size_t k = 0; k != 3; k++ ) {
+					if ( tri[ k ] == from ) {
+						if ( vertex_from != no_vertex && vertex_from != corners[ t * 3 + k ] ) {
+							is_valid = false; // `from` sits on an attribute seam
+						}
+						vertex_from = corners[ t * 3 + k ];
+					}
+				}
+
+				if ( tri[ 0 ] == to || tri[ 1 ] == to || tri[ 2 ] == to ) {
+					for ( size_t k = 0; k != 3; k++ ) {
+						if ( tri[ k ] == to ) {
+							if ( vertex_to != no_vertex && vertex_to != corners[ t * 3 + k ] ) {
+								is_valid = false; // collapsing triangles disagree about attributes at `to`
+							}
+							vertex_to = corners[ t * 3 + k ];
+						}
+					}
+					num_shared++;
+					continue;
+				}
+
+				if ( !is_valid ) {
+					break;
+				}
+
+				// -- Triangle survives the collapse - make sure that it doesn't flip, or degenerate.
+
+				glm::vec3 p[ 3 ];
+				glm::vec3 q[ 3 ];
+				for ( size_t k = 0; k != 3; k++ ) {
+					p[ k ] = weld.positions[ tri[ k ] ];
+					q[ k ] = weld.positions[ tri[ k ] == from ? to : tri[ k ] ];
+				}
+
+				glm::vec3 n_before = glm::cross( p[ 1 ] - p[ 0 ], p[ 2 ] - p[ 0 ] );
+				glm::vec3 n_after  = glm::cross( q[ 1 ] - q[ 0 ], q[ 2 ] - q[ 0 ] );
+
+				float const len_before = glm::length( n_before );
+				float const len_after  = glm::length( n_after );
+
+				if ( len_after == 0.f || ( len_before > 0.f && glm::dot( n_before, n_after ) < LOD_MIN_NORMAL_DOT * len_before * len_after ) ) {
+					is_valid = false;
+					break;
+				}
+
+				// A point on the triangle before the collapse lies at most as far from the plane
+				// of the triangle after the collapse as `from` does - and vice versa for `to`.
+
+				distance = std::max( distance, fabsf( glm::dot( n_after, weld.positions[ from ] - q[ 0 ] ) ) / len_after );
+
+				if ( len_before > 0.f ) {
+					distance = std::max( distance, fabsf( glm::dot( n_before, weld.positions[ to ] - p[ 0 ] ) ) / len_before );
+				}
+			}
+
+			if ( !is_valid || num_shared == 0 || num_common != num_shared ) {
+				continue;
+			}
+
+			// --------| invariant: collapse is valid - we move `from` onto `to`
+
+			for ( uint32_t t : adjacency[ from ] ) {
+				if ( triangle_dead[ t ] ) {
+					continue;
+				}
+
+				uint32_t *tri = &triangles[ t * 3 ];
+
+				if ( tri[ 0 ] == to || tri[ 1 ] == to || tri[ 2 ] == to ) {
+					triangle_dead[ t ] = 1;
+					num_live--;
+					continue;
+				}
+
+				for ( size_t k = 0; k != 3; k++ ) {
+					if ( tri[ k ] == from ) {
+						tri[ k ]             = to;
+						corners[ t * 3 + k ] = vertex_to;
+					}
+				}
+
+				adjacency[ to ].push_back( t );
+			}
+
+			adjacency[ from ].clear();
+			adjacency[ from ].shrink_to_fit();
+
+			// Remove dead triangles from adjacency of surviving vertex.
+			adjacency[ to ].erase( std::remove_if( adjacency[ to ].begin(), adjacency[ to ].end(),
+			                                       [ & ]( uint32_t t ) { return triangle_dead[ t ] != 0; } ),
+			                       adjacency[ to ].end() );
+
+			lod_quadric_add( quadrics[ to ], quadrics[ from ] );
+			collapsed_into[ from ] = to;
+
+			changed[ from ] = 1;
+			changed[ to ]   = 1;
+			changed_vertices.push_back( to );
+
+			float const error = vertex_error[ from ] + distance;
+
+			vertex_error[ to ] = std::max( vertex_error[ to ], error );
+			max_error          = std::max( max_error, vertex_error[ to ] );
+			num_collapsed++;
+
+			// -- Lock the neighbourhood of the surviving vertex for the rest of this pass:
+			// its quadric, and the triangles around it have changed.
+
+			locked[ from ] = 1;
+			locked[ to ]   = 1;
+
+			for_each_neighbour( to, [ & ]( uint32_t n ) {
+				locked[ n ] = 1;
+			} );
+		}
+
+		if ( num_collapsed == 0 ) {
+			if ( !limit_costs ) {
+				break; // no more valid collapses
+			}
+			limit_costs = false; // no valid collapses within limit - try all collapses
+		} else {
+			limit_costs = true;
+		}
+	}
+
+	// -- Write out surviving triangles, using the original vertex of each corner.
+
+	result.clear();
+	result.reserve( num_live * 3 );
+
+	for ( size_t t = 0; t != num_triangles; t++ ) {
+		if ( triangle_dead[ t ] ) {
+			continue;
+		}
+		result.insert( result.end(), &corners[ t * 3 ], &corners[ t * 3 ] + 3 );
+	}
+
+	return max_error;
+}
+
+// ----------------------------------------------------------------------
+
+static le_mesh_lod_o *le_mesh_lod_create() {
+	auto self = new le_mesh_lod_o();
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_mesh_lod_destroy( le_mesh_lod_o *self ) {
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+// Builds a chain of levels of detail: level 0 is the original mesh; each following
+// level keeps roughly `ratio` of the triangles of the level before it.
+static void le_mesh_lod_build( le_mesh_lod_o *self, float const *positions, uint32_t position_stride, size_t num_vertices, uint32_t const *indices, size_t num_indices, uint32_t max_levels, float ratio ) {
+
+	self->levels.clear();
+	self->indices.clear();
+
+	if ( position_stride == 0 ) {
+		position_stride = sizeof( float ) * 3;
+	}
+
+	if ( ratio <= 0.f || ratio >= 1.f ) {
+		ratio = LOD_DEFAULT_RATIO;
+	}
+
+	num_indices -= num_indices % 3;
+
+	for ( size_t i = 0; i != num_indices; i++ ) {
+		if ( indices[ i ] >= num_vertices ) {
+			return; // invalid index
+		}
+	}
+
+	if ( num_indices == 0 || max_levels == 0 ) {
+		return;
+	}
+
+	// --------| invariant: all indices are valid
+
+	self->indices.assign( indices, indices + num_indices );
+	self->levels.push_back( { 0, uint32_t( num_indices ), 0.f } );
+
+	lod_weld_t weld;
+	lod_weld( weld, positions, position_stride, num_vertices );
+
+	std::vector<uint32_t> current( indices, indices + num_indices );
+	std::vector<uint32_t> simplified;
+	std::vector<float>    vertex_error( weld.positions.size(), 0.f );
+
+	float error = 0.f;
+
+	while ( self->levels.size() < max_levels ) {
+
+		size_t const target_index_count = size_t( float( current.size() / 3 ) * ratio ) * 3;
+
+		if ( target_index_count == 0 ) {
+			break;
+		}
+
+		// Each level is simplified from the level before it - vertex errors carry over,
+		// so that the error of each level is relative to the original mesh.
+		error = std::max( error, lod_simplify( weld, current, target_index_count, vertex_error, simplified ) );
+
+		if ( simplified.empty() || float( simplified.size() ) > float( current.size() ) * LOD_MIN_REDUCTION ) {
+			break; // mesh can't be simplified much further
+		}
+
+		self->levels.push_back( { uint32_t( self->indices.size() ), uint32_t( simplified.size() ), error } );
+		self->indices.insert( self->indices.end(), simplified.begin(), simplified.end() );
+
+		std::swap( current, simplified );
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void le_mesh_lod_get_levels( le_mesh_lod_o *self, size_t &count, le_mesh_api::lod_level_t const **levels ) {
+	count = self->levels.size();
+	if ( levels ) {
+		*levels = self->levels.data();
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void le_mesh_lod_get_indices( le_mesh_lod_o *self, size_t &count, uint32_t const **indices ) {
+	count = self->indices.size();
+	if ( indices ) {
+		*indices = self->indices.data();
+	}
+}
+
+// ----------------------------------------------------------------------
+// Returns the coarsest level whose error, projected onto the screen, stays below max_pixel_error.
+static uint32_t le_mesh_lod_select_level( le_mesh_api::lod_level_t const *levels, size_t level_count, le_mesh_api::lod_select_params_t const *params ) {
+
+	if ( level_count == 0 ) {
+		return 0;
+	}
+
+	// Projected size in pixels of one object-space unit at given distance.
+	float const distance        = std::max( params->distance, FLT_MIN );
+	float const pixels_per_unit = params->object_scale * params->projection_scale / distance;
+
+	uint32_t level = 0;
+
+	for ( uint32_t i = 1; i < level_count; i++ ) {
+		if ( levels[ i ].error * pixels_per_unit > params->max_pixel_error ) {
+			break; // errors increase monotonically along the chain
+		}
+		level = i;
+	}
+
+	return level;
+}
+
+// ----------------------------------------------------------------------
+
+void register_le_mesh_lod_api( void *api_ ) {
+	auto &le_mesh_lod_i = static_cast<le_mesh_api *>( api_ )->le_mesh_lod_i;
+
+	le_mesh_lod_i.create       = le_mesh_lod_create;
+	le_mesh_lod_i.destroy      = le_mesh_lod_destroy;
+	le_mesh_lod_i.build        = le_mesh_lod_build;
+	le_mesh_lod_i.get_levels   = le_mesh_lod_get_levels;
+	le_mesh_lod_i.get_indices  = le_mesh_lod_get_indices;
+	le_mesh_lod_i.select_level = le_mesh_lod_select_level;
+}
@@ -6,12 +6,17 @@
 #include "glm/glm.hpp"
 
 struct le_mesh_o {
-	std::vector<uint16_t>  indices;  // list of indices
+	std::vector<uint32_t>  indices;  // list of indices
 	std::vector<glm::vec3> vertices; // 3d position in model space
 	std::vector<glm::vec3> normals;  // normalised normal, per-vertex
 	std::vector<glm::vec4> colours;  // rgba colour, per-vertex
 	std::vector<glm::vec2> uvs;      // uv coordintates    , per-vertex
 	std::vector<glm::vec3> tangents; // normalised tangents, per-vertex
+
+	std::vector<uint16_t> indices_u16;               // 16 bit copy of indices, built on demand for 16 bit index getters
+	bool                  indices_u16_dirty = true;  // set whenever indices change (clear, load, optimise) - 16 bit copy must be rebuilt
+	bool                  indices_u16_valid = false; // false if most recent rebuild found that indices don't fit into 16 bits
+	std::vector<uint8_t>  interleaved_vertices;      // interleaved vertex data, built on demand
 };
 
 #endif
@@ -0,0 +1,404 @@
+#include "le_mesh.h"
+#include "le_core.h"
+
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include "glm/glm.hpp"
+
+/*
+ * Meshlet builder
+ *
+ * We grow meshlets greedily: starting from a seed triangle, we keep adding the
+ * triangle adjacent to the current meshlet which introduces the fewest new
+ * vertices. This keeps meshlets compact, which gives us tight bounding spheres,
+ * and narrow normal cones, both of which make culling more effective.
+ *
+ * A meshlet is closed once it reaches its vertex or triangle limit, or if
+ * none of its neighbouring triangles fit anymore.
+ *
+ */
+
+struct le_meshlets_o {
+	std::vector<le_mesh_api::meshlet_t> meshlets;
+	std::vector<uint32_t>               vertex_indices; // meshlet-local vertex index -> mesh vertex index, for all meshlets
+	std::vector<uint8_t>                triangles;      // three meshlet-local vertex indices per triangle, for all meshlets
+	std::vector<uint32_t>               indices;        // all triangles in meshlet order, as mesh vertex indices
+};
+
+static constexpr uint8_t MESHLET_VERTEX_UNUSED = 0xff; // marks a vertex which is not part of the current meshlet
+
+// ----------------------------------------------------------------------
+
+static le_meshlets_o *le_meshlets_create() {
+	auto self = new le_meshlets_o();
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_meshlets_destroy( le_meshlets_o *self ) {
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+// Calculates bounding sphere, and normal cone for the most recently added meshlet.
+static void meshlet_calculate_bounds( le_meshlets_o *self, float const *positions, uint32_t position_stride ) {
+
+	le_mesh_api::meshlet_t &meshlet = self->meshlets.back();
+
+	auto get_position = [ & ]( uint32_t local_index ) -> glm::vec3 {
+		uint32_t const vertex_index = self->vertex_indices[ meshlet.vertex_offset + local_index ];
+		float const *  p            = reinterpret_cast<float const *>( reinterpret_cast<char const *>( positions ) + size_t( vertex_index ) * position_stride );
+		return glm::vec3( p[ 0 ], p[ 1 ], p[ 2 ] );
+	};
+
+	// -- Bounding sphere: centred on bounding box
+
+	glm::vec3 bounds_min = get_position( 0 );
+	glm::vec3 bounds_max = bounds_min;
+
+	for ( uint32_t i = 1; i < meshlet.vertex_count; i++ ) {
+		glm::vec3 p = get_position( i );
+		bounds_min  = glm::min( bounds_min, p );
+		bounds_max  = glm::max( bounds_max, p );
+	}
+
+	glm::vec3 centre = ( bounds_min + bounds_max ) * 0.5f;
+	float     radius = 0;
+
+	for ( uint32_t i = 0; i < meshlet.vertex_count; i++ ) {
+		radius = std::max( radius, glm::length( get_position( i ) - centre ) );
+	}
+
+	// -- Normal cone: axis is the average of all triangle normals, the cone
+	// must contain all triangle normals.
+
+	uint8_t const *triangles = self->triangles.data() + size_t( meshlet.triangle_offset ) * 3;
+
+	std::vector<glm::vec3> normals;
+	normals.reserve( meshlet.triangle_count );
+
+	glm::vec3 axis{ 0 };
+
+	for ( uint32_t t = 0; t != meshlet.triangle_count; t++ ) {
+		glm::vec3 a = get_position( triangles[ t * 3 + 0 ] );
+		glm::vec3 b = get_position( triangles[ t * 3 + 1 ] );
+		glm::vec3 c = get_position( triangles[ t * 3 + 2 ] );
+
+		glm::vec3 n      = glm::cross( b - a, c - a );
+		float     length = glm::length( n );
+
+		if ( length > 0.f ) {
+			// degenerate triangles are invisible, and don't contribute to the cone.
+			normals.push_back( n / length );
+			axis += n / length;
+		}
+	}
+
+	float axis_length = glm::length( axis );
+	float cone_cutoff = 1.f; // default: never cull
+
+	if ( axis_length > 0.f ) {
+		axis /= axis_length;
+
+		float min_dot = 1.f;
+		for ( auto const &n : normals ) {
+			min_dot = std::min( min_dot, glm::dot( n, axis ) );
+		}
+
+		// If the normal cone is wider than ~84 degrees, there is hardly any
+		// camera position from which all triangles could be back-facing.
+		if ( min_dot > 0.1f ) {
+			// We need sin of cone half-angle: cos of half-angle is min_dot.
+			cone_cutoff = sqrtf( 1.f - min_dot * min_dot );
+		}
+	}
+
+	meshlet.centre[ 0 ]    = centre.x;
+	meshlet.centre[ 1 ]    = centre.y;
+	meshlet.centre[ 2 ]    = centre.z;
+	meshlet.radius         = radius;
+	meshlet.cone_axis[ 0 ] = axis.x;
+	meshlet.cone_axis[ 1 ] = axis.y;
+	meshlet.cone_axis[ 2 ] = axis.z;
+	meshlet.cone_cutoff    = cone_cutoff;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_meshlets_build( le_meshlets_o *self, float const *positions, uint32_t position_stride, size_t num_vertices, uint32_t const *indices, size_t num_indices, uint32_t max_vertices, uint32_t max_triangles ) {
+
+	self->meshlets.clear();
+	self->vertex_indices.clear();
+	self->triangles.clear();
+	self->indices.clear();
+
+	max_vertices  = std::min( std::max( max_vertices, 3u ), 255u );
+	max_triangles = std::max( max_triangles, 1u );
+
+	if ( position_stride == 0 ) {
+		position_stride = sizeof( float ) * 3;
+	}
+
+	size_t const num_triangles = num_indices / 3;
+
+	if ( num_triangles == 0 || num_vertices == 0 ) {
+		return;
+	}
+
+	// -- Build vertex -> triangle adjacency, and count triangles which are still
+	// available for each vertex.
+
+	std::vector<uint32_t> adjacency_offsets( num_vertices + 1, 0 );
+	std::vector<uint32_t> adjacency( num_triangles * 3 );
+	std::vector<uint32_t> live_triangles( num_vertices, 0 );
+
+	for ( size_t i = 0; i != num_triangles * 3; i++ ) {
+		if ( indices[ i ] >= num_vertices ) {
+			return; // invalid index
+		}
+		live_triangles[ indices[ i ] ]++;
+	}
+
+	for ( size_t v = 0; v != num_vertices; v++ ) {
+		adjacency_offsets[ v + 1 ] = adjacency_offsets[ v ] + live_triangles[ v ];
+	}
+
+	{
+		std::vector<uint32_t> fill( adjacency_offsets.begin(), adjacency_offsets.end() - 1 );
+		for ( size_t t = 0; t != num_triangles; t++ ) {
+			for ( size_t k = 0; k != 3; k++ ) {
+				adjacency[ fill[ indices[ t * 3 + k ] ]++ ] = uint32_t( t );
+			}
+		}
+	}
+
+	std::vector<uint8_t>  triangle_used( num_triangles, 0 );
+	std::vector<uint8_t>  local_index( num_vertices, MESHLET_VERTEX_UNUSED );
+	std::vector<uint32_t> candidates;
+
+	self->meshlets.reserve( num_triangles / max_triangles + 1 );
+	self->triangles.reserve( num_triangles * 3 );
+	self->indices.reserve( num_triangles * 3 );
+
+	le_mesh_api::meshlet_t meshlet{};
+
+	auto count_new_vertices = [ & ]( uint32_t t ) -> uint32_t {
+		return uint32_t( local_index[ indices[ t * 3 + 0 ] ] == MESHLET_VERTEX_UNUSED ) +
+		       uint32_t( local_index[ indices[ t * 3 + 1 ] ] == MESHLET_VERTEX_UNUSED ) +
+		       uint32_t( local_index[ indices[ t * 3 + 2 ] ] == MESHLET_VERTEX_UNUSED );
+	};
+
+	auto close_meshlet = [ & ]() {
+		if ( meshlet.triangle_count == 0 ) {
+			return;
+		}
+
+		self->meshlets.push_back( meshlet );
+		meshlet_calculate_bounds( self, positions, position_stride );
+
+		for ( uint32_t i = 0; i != meshlet.vertex_count; i++ ) {
+			local_index[ self->vertex_indices[ meshlet.vertex_offset + i ] ] = MESHLET_VERTEX_UNUSED;
+		}
+
+		meshlet                 = {};
+		meshlet.vertex_offset   = uint32_t( self->vertex_indices.size() );
+		meshlet.triangle_offset = uint32_t( self->indices.size() / 3 );
+
+		candidates.clear();
+	};
+
+	auto add_triangle = [ & ]( uint32_t t ) {
+		triangle_used[ t ] = 1;
+
+		for ( size_t k = 0; k != 3; k++ ) {
+			uint32_t v = indices[ t * 3 + k ];
+
+			if ( local_index[ v ] == MESHLET_VERTEX_UNUSED ) {
+				local_index[ v ] = uint8_t( meshlet.vertex_count++ );
+				self->vertex_indices.push_back( v );
+
+				// All triangles which share this vertex become candidates for this meshlet.
+				for ( uint32_t a = adjacency_offsets[ v ]; a != adjacency_offsets[ v + 1 ]; a++ ) {
+					if ( !triangle_used[ adjacency[ a ] ] ) {
+						candidates.push_back( adjacency[ a ] );
+					}
+				}
+			}
+
+			live_triangles[ v ]--;
+			self->triangles.push_back( local_index[ v ] );
+			self->indices.push_back( v );
+		}
+
+		meshlet.triangle_count++;
+	};
+
+	size_t seed_cursor = 0; // all triangles before seed_cursor have been used
+
+	for ( size_t num_used = 0; num_used != num_triangles; num_used++ ) {
+
+		// -- Find best candidate among triangles adjacent to current meshlet. We
+		// prefer triangles which add the fewest new vertices, then triangles whose
+		// vertices have the fewest remaining triangles, so that we don't leave
+		// behind isolated triangles.
+
+		uint32_t best       = uint32_t( ~0u );
+		uint32_t best_new   = 4;
+		uint32_t best_live  = uint32_t( ~0u );
+		size_t   num_remain = 0;
+
+		for ( size_t c = 0; c != candidates.size(); c++ ) {
+			uint32_t t = candidates[ c ];
+
+			if ( triangle_used[ t ] ) {
+				continue;
+			}
+
+			candidates[ num_remain++ ] = t; // compact candidate list as we go
+
+			uint32_t num_new = count_new_vertices( t );
+			uint32_t live    = live_triangles[ indices[ t * 3 + 0 ] ] +
+			                live_triangles[ indices[ t * 3 + 1 ] ] +
+			                live_triangles[ indices[ t * 3 + 2 ] ];
+
+			if ( num_new < best_new || ( num_new == best_new && live < best_live ) ) {
+				best      = t;
+				best_new  = num_new;
+				best_live = live;
+			}
+		}
+
+		candidates.resize( num_remain );
+
+		if ( best != uint32_t( ~0u ) && meshlet.vertex_count + best_new > max_vertices ) {
+			// Best candidate doesn't fit - start a new meshlet, seeded with this triangle.
+			close_meshlet();
+		}
+
+		if ( best == uint32_t( ~0u ) ) {
+
+			// There are no more triangles adjacent to the current meshlet.
+			// If meshlet is already reasonably full we close it, otherwise
+			// we continue with the next available triangle.
+
+			if ( meshlet.triangle_count * 2 >= max_triangles ) {
+				close_meshlet();
+			}
+
+			while ( triangle_used[ seed_cursor ] ) {
+				seed_cursor++;
+			}
+
+			best = uint32_t( seed_cursor );
+
+			if ( meshlet.vertex_count + count_new_vertices( best ) > max_vertices ) {
+				close_meshlet();
+			}
+		}
+
+		// --------| invariant: best triangle fits into current meshlet
+
+		add_triangle( best );
+
+		if ( meshlet.triangle_count == max_triangles ) {
+			close_meshlet();
+		}
+	}
+
+	close_meshlet();
+}
+
+// ----------------------------------------------------------------------
+
+static void le_meshlets_get_meshlets( le_meshlets_o *self, size_t &count, le_mesh_api::meshlet_t const **meshlets ) {
+	count = self->meshlets.size();
+	if ( meshlets ) {
+		*meshlets = self->meshlets.data();
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void le_meshlets_get_vertex_indices( le_meshlets_o *self, size_t &count, uint32_t const **vertex_indices ) {
+	count = self->vertex_indices.size();
+	if ( vertex_indices ) {
+		*vertex_indices = self->vertex_indices.data();
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void le_meshlets_get_triangles( le_meshlets_o *self, size_t &count, uint8_t const **triangles ) {
+	count = self->triangles.size() / 3;
+	if ( triangles ) {
+		*triangles = self->triangles.data();
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void le_meshlets_get_indices( le_meshlets_o *self, size_t &count, uint32_t const **indices ) {
+	count = self->indices.size();
+	if ( indices ) {
+		*indices = self->indices.data();
+	}
+}
+
+// ----------------------------------------------------------------------
+// Culls meshlets against frustum, and - optionally - normal cones against camera position.
+//
+// This mirrors what a task shader would do for each meshlet, so that the same
+// meshlet data may be used for cpu as well as for gpu culling.
+static size_t le_meshlets_cull( le_mesh_api::meshlet_t const *meshlets, size_t meshlet_count, le_mesh_api::meshlet_cull_params_t const *params, uint32_t *visible_meshlets ) {
+
+	size_t num_visible = 0;
+
+	glm::vec3 const camera_position( params->camera_position[ 0 ], params->camera_position[ 1 ], params->camera_position[ 2 ] );
+
+	for ( size_t i = 0; i != meshlet_count; i++ ) {
+
+		le_mesh_api::meshlet_t const &m = meshlets[ i ];
+
+		glm::vec3 const centre( m.centre[ 0 ], m.centre[ 1 ], m.centre[ 2 ] );
+		float const     radius = m.radius * params->radius_scale;
+
+		bool visible = true;
+
+		for ( size_t p = 0; p != 6 && visible; p++ ) {
+			float const *plane = params->planes[ p ];
+			visible            = plane[ 0 ] * centre.x + plane[ 1 ] * centre.y + plane[ 2 ] * centre.z + plane[ 3 ] >= -radius;
+		}
+
+		if ( visible && params->cull_backfacing ) {
+			// Meshlet is back-facing if all its triangles face away from the camera,
+			// from anywhere within its bounding sphere.
+			glm::vec3 const axis( m.cone_axis[ 0 ], m.cone_axis[ 1 ], m.cone_axis[ 2 ] );
+			glm::vec3 const view = centre - camera_position;
+			visible              = glm::dot( view, axis ) < m.cone_cutoff * glm::length( view ) + m.radius;
+		}
+
+		if ( visible ) {
+			visible_meshlets[ num_visible++ ] = uint32_t( i );
+		}
+	}
+
+	return num_visible;
+}
+
+// ----------------------------------------------------------------------
+
+void register_le_meshlets_api( void *api_ ) {
+	auto &le_meshlets_i = static_cast<le_mesh_api *>( api_ )->le_meshlets_i;
+
+	le_meshlets_i.create             = le_meshlets_create;
+	le_meshlets_i.destroy            = le_meshlets_destroy;
+	le_meshlets_i.build              = le_meshlets_build;
+	le_meshlets_i.get_meshlets       = le_meshlets_get_meshlets;
+	le_meshlets_i.get_vertex_indices = le_meshlets_get_vertex_indices;
+	le_meshlets_i.get_triangles      = le_meshlets_get_triangles;
+	le_meshlets_i.get_indices        = le_meshlets_get_indices;
+	le_meshlets_i.cull               = le_meshlets_cull;
+}
@@ -72,14 +72,14 @@ static void le_mesh_generator_generate_sphere( le_mesh_o *mesh,
 
 	size_t   ix;
 	size_t   iy;
-	uint16_t index = 0;
+	uint32_t index = 0;
 
-	std::vector<std::vector<uint16_t>> grid; // holds indices for rows of vertices
+	std::vector<std::vector<uint32_t>> grid; // holds indices for rows of vertices
 
 	// Generate vertices, normals and uvs
 	for ( iy = 0; iy <= heightSegments; iy++ ) {
 
-		std::vector<uint16_t> verticesRow;
+		std::vector<uint32_t> verticesRow;
 
 		float v = iy / float( heightSegments );
 
@@ -1,9 +1,12 @@
 #include "le_parameter_store.h"
 #include "le_core.h"
+#include "le_hash_util.h"
 #include <unordered_map>
 #include "assert.h"
+#include <atomic>
+#include <deque>
 #include <string>
-#include <fstream>    // for file loading
+#include <string_view>
 #include <iostream>   // for file loading
 #include <filesystem> // to test whether file exists
 #include <vector>
@@ -23,7 +26,7 @@ static const char *PARAMETER_TYPE_AS_STRING[ 5 ] = {
 };
 
 struct le_parameter_o {
-	le_parameter_store_api::Type type;
+	le_parameter_store_api::Type type = Type::eUnknown;
 	union Data {
 		float    as_float[ 3 ];
 		uint32_t as_u32[ 3 ];
@@ -31,9 +34,14 @@ struct le_parameter_o {
 		bool     as_bool[ 3 ];
 		char     as_bytes[ 4 ][ 3 ];
 	};
-	Data value; // value, range_min, range_max
+	Data                  value{};         // value, range_min, range_max
+	std::atomic<uint64_t> generation{ 0 }; // store generation at which this parameter was last changed
+	le_parameter_store_o *store = nullptr; // store which owns this parameter
+	uint32_t              index = 0;       // index of this parameter in its store
 };
 
+static void le_parameter_mark_changed( le_parameter_o *self );
+
 static float *le_parameter_set_float( le_parameter_o *self, float val, float val_min = 0.f, float val_max = 1.f ) {
 	if ( nullptr == self ) {
 		return nullptr;
@@ -42,6 +50,7 @@ static float *le_parameter_set_float( le_parameter_o *self, float val, float val
 	self->value.as_float[ 0 ] = val;
 	self->value.as_float[ 1 ] = val_min;
 	self->value.as_float[ 2 ] = val_max;
+	le_parameter_mark_changed( self );
 	return &self->value.as_float[ 0 ];
 }
 static uint32_t *le_parameter_set_u32( le_parameter_o *self, uint32_t val, uint32_t val_min = 0, uint32_t val_max = UINT32_MAX ) {
@@ -52,6 +61,7 @@ static uint32_t *le_parameter_set_u32( le_parameter_o *self, uint32_t val, uint3
 	self->value.as_u32[ 0 ] = val;
 	self->value.as_u32[ 1 ] = val_min;
 	self->value.as_u32[ 2 ] = val_max;
+	le_parameter_mark_changed( self );
 	return &self->value.as_u32[ 0 ];
 }
 static int32_t *le_parameter_set_i32( le_parameter_o *self, int32_t val, int32_t val_min = INT32_MIN, int32_t val_max = INT32_MAX ) {
@@ -62,6 +72,7 @@ static int32_t *le_parameter_set_i32( le_parameter_o *self, int32_t val, int32_t
 	self->value.as_i32[ 0 ] = val;
 	self->value.as_i32[ 1 ] = val_min;
 	self->value.as_i32[ 2 ] = val_max;
+	le_parameter_mark_changed( self );
 	return &self->value.as_i32[ 0 ];
 }
 static bool *le_parameter_set_bool( le_parameter_o *self, bool val ) {
@@ -72,6 +83,7 @@ static bool *le_parameter_set_bool( le_parameter_o *self, bool val ) {
 	self->value.as_bool[ 0 ] = val;
 	self->value.as_bool[ 1 ] = false;
 	self->value.as_bool[ 2 ] = true;
+	le_parameter_mark_changed( self );
 	return &self->value.as_bool[ 0 ];
 }
 // Note: getters will return nullptr if type does not match internal parameter type.
@@ -104,6 +116,7 @@ static void le_parameter_set_type( le_parameter_o *self, Type type ) {
 		return;
 	}
 	self->type = type;
+	le_parameter_mark_changed( self );
 }
 static Type le_parameter_get_type( le_parameter_o *self ) {
 	if ( nullptr == self ) {
@@ -113,40 +126,162 @@ static Type le_parameter_get_type( le_parameter_o *self ) {
 }
 
 // ----------------------------------------------------------------------
+// Parameters are kept in a deque, so that their addresses stay fixed when
+// parameters are added. Names are kept in a separate array, at the same
+// index as the parameter which they name, and lookup goes via name hash.
 struct le_parameter_store_o {
-	std::unordered_map<std::string, le_parameter_o> store;
+	std::deque<le_parameter_o>                                   parameters;
+	std::vector<std::string>                                     names;
+	std::unordered_map<uint64_t, le_parameter_o *, IdentityHash> lookup;          // name hash -> parameter
+	std::atomic<uint64_t>                                        generation{ 0 }; // increases with each change to any parameter
 };
 
 // ----------------------------------------------------------------------
+// Must give the same result as `hash_64_fnv1a_const`, so that handles
+// calculated at compile time match. Note that this means that we must
+// not cast chars to unsigned before xor-ing them into the hash.
+static inline uint64_t le_parameter_name_hash( std::string_view const &name ) {
+	uint64_t hash = FNV1A_VAL_64_CONST;
+	for ( char const c : name ) {
+		hash = ( hash ^ uint64_t( c ) ) * FNV1A_PRIME_64_CONST;
+	}
+	return hash;
+}
 
-static le_parameter_o *le_parameter_store_get_parameter( le_parameter_store_o *self, char const *name ) {
-	auto it = self->store.find( name );
-	if ( it == self->store.end() ) {
+// ----------------------------------------------------------------------
+// Tags parameter with a new store generation.
+//
+// We store the parameter generation *before* we publish it by incrementing
+// the store generation - that way, anyone who reads store generation `n`
+// is guaranteed to also see all parameters tagged with generations up to,
+// and including `n`. If another thread publishes a change in-between, we
+// try again with the next generation.
+static void le_parameter_mark_changed( le_parameter_o *self ) {
+	if ( nullptr == self || nullptr == self->store ) {
+		return;
+	}
+	auto &store_generation = self->store->generation;
+
+	uint64_t generation = store_generation.load( std::memory_order_acquire );
+	do {
+		self->generation.store( generation + 1, std::memory_order_release );
+	} while ( !store_generation.compare_exchange_weak( generation, generation + 1, std::memory_order_acq_rel, std::memory_order_acquire ) );
+}
+
+// ----------------------------------------------------------------------
+
+static uint64_t le_parameter_get_generation( le_parameter_o *self ) {
+	if ( nullptr == self ) {
+		return 0;
+	}
+	return self->generation.load( std::memory_order_acquire );
+}
+
+// ----------------------------------------------------------------------
+
+static bool le_parameter_changed_since( le_parameter_o *self, uint64_t generation ) {
+	return le_parameter_get_generation( self ) > generation;
+}
+
+// ----------------------------------------------------------------------
+
+static le_parameter_o *le_parameter_store_get_parameter_by_handle( le_parameter_store_o *self, uint64_t handle ) {
+	auto it = self->lookup.find( handle );
+	if ( it == self->lookup.end() ) {
 		return nullptr;
 	}
-	return &it->second;
+	return it->second;
+}
+
+// ----------------------------------------------------------------------
+
+static le_parameter_o *le_parameter_store_find_parameter( le_parameter_store_o *self, std::string_view const &name, uint64_t name_hash ) {
+	auto param = le_parameter_store_get_parameter_by_handle( self, name_hash );
+	if ( param && self->names[ param->index ] != name ) {
+		assert( false && "parameter name hash collision" );
+		return nullptr;
+	}
+	return param;
+}
+
+// ----------------------------------------------------------------------
+
+static le_parameter_o *le_parameter_store_get_parameter( le_parameter_store_o *self, char const *name ) {
+	std::string_view name_view( name );
+	return le_parameter_store_find_parameter( self, name_view, le_parameter_name_hash( name_view ) );
 }
 
 // ----------------------------------------------------------------------
-// Search for given parameter, based on its address.
 // return parameter name if found, nullptr if not found.
 static char const *le_parameter_store_get_name( le_parameter_store_o *self, le_parameter_o *param ) {
-	auto it = self->store.begin();
-	for ( ; it != self->store.end(); it++ ) {
-		if ( &it->second == param ) {
-			break;
-		}
-	}
-	if ( it == self->store.end() ) {
+	if ( nullptr == param || param->store != self ) {
 		return nullptr;
 	}
-	return it->first.c_str();
+	return self->names[ param->index ].c_str();
+}
+
+// ----------------------------------------------------------------------
+// Returns existing parameter if a parameter with the given name already exists.
+static le_parameter_o *le_parameter_store_produce_parameter( le_parameter_store_o *self, std::string_view const &name ) {
+
+	uint64_t name_hash = le_parameter_name_hash( name );
+
+	auto it = self->lookup.find( name_hash );
+
+	if ( it != self->lookup.end() ) {
+		if ( self->names[ it->second->index ] != name ) {
+			assert( false && "parameter name hash collision" );
+			return nullptr;
+		}
+		return it->second;
+	}
+
+	// ----------| invariant: parameter does not yet exist
+
+	auto &param = self->parameters.emplace_back();
+	param.store = self;
+	param.index = uint32_t( self->names.size() );
+
+	self->names.emplace_back( name );
+	self->lookup[ name_hash ] = &param;
+
+	le_parameter_mark_changed( &param );
+
+	return &param;
 }
 
 // ----------------------------------------------------------------------
 
 static le_parameter_o *le_parameter_store_add_parameter( le_parameter_store_o *self, char const *name ) {
-	return &self->store[ name ];
+	return le_parameter_store_produce_parameter( self, std::string_view( name ) );
+}
+
+// ----------------------------------------------------------------------
+
+static uint64_t le_parameter_store_get_generation( le_parameter_store_o *self ) {
+	return self->generation.load( std::memory_order_acquire );
+}
+
+// ----------------------------------------------------------------------
+
+static size_t le_parameter_store_get_changed_parameters( le_parameter_store_o *self, uint64_t generation, le_parameter_o **changed, size_t max_count ) {
+
+	if ( self->generation.load( std::memory_order_acquire ) <= generation ) {
+		return 0; // nothing changed - we don't have to look at any parameters.
+	}
+
+	size_t num_changed = 0;
+
+	for ( auto &param : self->parameters ) {
+		if ( param.generation.load( std::memory_order_acquire ) > generation ) {
+			if ( changed && num_changed < max_count ) {
+				changed[ num_changed ] = &param;
+			}
+			num_changed++;
+		}
+	}
+
+	return num_changed;
 }
 
 // ----------------------------------------------------------------------
@@ -278,34 +413,53 @@ static bool le_parameter_store_load_from_file( le_parameter_store_o *self, char
 
 	// ----------
 
-	std::ifstream file( file_path, std::ios::in | std::ios::ate );
+	std::string contents;
 
-	size_t file_sz = file.tellg();
-	file.seekg( 0, std::ios::beg );
+	{
+		auto file = fopen( file_path, "rb" );
 
-	std::string contents;
-	contents.resize( file_sz );
-	file.readsome( contents.data(), file_sz );
-	file.close();
+		if ( nullptr == file ) {
+			std::cerr << "File '" << file_path << "' could not be opened." << std::endl;
+			return false;
+		}
+
+		fseek( file, 0, SEEK_END );
+		long file_sz = ftell( file );
+		fseek( file, 0, SEEK_SET );
+
+		contents.resize( file_sz > 0 ? size_t( file_sz ) : 0 );
+		contents.resize( fread( contents.data(), 1, contents.size(), file ) );
+		fclose( file );
+	}
 
 	// Use jsmn to parse file contents
+	//
+	// Instead of parsing twice - once to count tokens, and once more to fill
+	// them in - we start with an estimate for the number of tokens, and grow
+	// the token array if jsmn tells us that it ran out of tokens. jsmn picks
+	// up parsing where it left off in that case.
 
-	std::vector<jsmntok_t> tokens;
+	std::vector<jsmntok_t> tokens( contents.size() / 8 + 16 );
 	jsmn_parser            parser{};
 
 	jsmn_init( &parser );
 
-	// Calling parse() with nullptr for tokens gets the number of required tokens.
-	int n_elements = jsmn_parse( &parser, contents.c_str(), contents.size(), nullptr, 0 );
+	int n_elements = 0;
+
+	for ( ;; ) {
+		n_elements = jsmn_parse( &parser, contents.c_str(), contents.size(), tokens.data(), tokens.size() );
+		if ( n_elements != JSMN_ERROR_NOMEM ) {
+			break;
+		}
+		tokens.resize( tokens.size() * 2 );
+	}
+
 	if ( n_elements < 1 ) {
 		std::cerr << "ERROR [json parser]: No tokens found in file: '" << file_path << "'";
 		return false;
 	}
 
 	tokens.resize( n_elements );
-	jsmn_init( &parser ); // We must reset parser
-
-	n_elements = jsmn_parse( &parser, contents.c_str(), contents.size(), tokens.data(), tokens.size() );
 
 	if ( n_elements < 1 || tokens[ 0 ].type != JSMN_OBJECT ) {
 		std::cerr << "ERROR [json parser]: Expected object as first element in file: '" << file_path << "'";
@@ -332,6 +486,8 @@ static bool le_parameter_store_load_from_file( le_parameter_store_o *self, char
 	std::vector<int> parameters;
 	std::vector<int> properties;
 
+	size_t num_parameters_set = 0;
+
 	find_children( tokens.begin(), tokens.end(), tokens.begin(), parameters );
 
 	// `children` now contains indices for children of the main object
@@ -458,8 +614,10 @@ static bool le_parameter_store_load_from_file( le_parameter_store_o *self, char
 		}
 
 		if ( success ) {
-			auto store_param = le_parameter_store_add_parameter( self, std::string( parameter_name ).c_str() );
-			std::cout << "Setting parameter: '" << parameter_name << "'" << std::endl;
+			auto store_param = le_parameter_store_produce_parameter( self, parameter_name );
+			if ( nullptr == store_param ) {
+				continue;
+			}
 			if ( store_param->type != tmp_param.type && store_param->type != Type::eUnknown ) {
 				std::cout << "WARNING: Parameter store: type mismatch. Parameter type was given as: "
 				          << PARAMETER_TYPE_AS_STRING[ uint( tmp_param.type ) ]
@@ -468,10 +626,15 @@ static bool le_parameter_store_load_from_file( le_parameter_store_o *self, char
 				          << "." << std::endl;
 				break;
 			}
-			*store_param = tmp_param;
+			store_param->type  = tmp_param.type;
+			store_param->value = tmp_param.value;
+			le_parameter_mark_changed( store_param );
+			num_parameters_set++;
 		}
 	}
 
+	std::cout << "Set " << num_parameters_set << " parameters from file: '" << file_path << "'" << std::endl;
+
 	return true;
 }
 
@@ -490,16 +653,11 @@ static bool le_parameter_store_save_to_file( le_parameter_store_o *self, char co
 
 	fputs( "{", file );
 
-	auto a = self->store.cbegin();
-
-	if ( a != self->store.cend() ) {
-		print_entry( file, a->first, a->second );
-		a++;
-	}
-
-	for ( ; a != self->store.cend(); a++ ) {
-		fputs( ",", file );
-		print_entry( file, a->first, a->second );
+	for ( size_t i = 0; i != self->parameters.size(); i++ ) {
+		if ( i != 0 ) {
+			fputs( ",", file );
+		}
+		print_entry( file, self->names[ i ], self->parameters[ i ] );
 	}
 
 	fputs( "\n}", file );
@@ -540,15 +698,22 @@ LE_MODULE_REGISTER_IMPL( le_parameter_store, api ) {
 	le_parameter_i.get_type = le_parameter_get_type;
 	le_parameter_i.set_type = le_parameter_set_type;
 
+	le_parameter_i.mark_changed   = le_parameter_mark_changed;
+	le_parameter_i.get_generation = le_parameter_get_generation;
+	le_parameter_i.changed_since  = le_parameter_changed_since;
+
 	// -- parameter store
 	auto &le_parameter_store_i = static_cast<le_parameter_store_api *>( api )->le_parameter_store_i;
 
 	le_parameter_store_i.create  = le_parameter_store_create;
 	le_parameter_store_i.destroy = le_parameter_store_destroy;
 
-	le_parameter_store_i.add_parameter  = le_parameter_store_add_parameter;
-	le_parameter_store_i.get_parameter  = le_parameter_store_get_parameter;
-	le_parameter_store_i.get_name       = le_parameter_store_get_name;
-	le_parameter_store_i.save_to_file   = le_parameter_store_save_to_file;
-	le_parameter_store_i.load_from_file = le_parameter_store_load_from_file;
+	le_parameter_store_i.add_parameter           = le_parameter_store_add_parameter;
+	le_parameter_store_i.get_parameter           = le_parameter_store_get_parameter;
+	le_parameter_store_i.get_parameter_by_handle = le_parameter_store_get_parameter_by_handle;
+	le_parameter_store_i.get_name                = le_parameter_store_get_name;
+	le_parameter_store_i.save_to_file            = le_parameter_store_save_to_file;
+	le_parameter_store_i.load_from_file          = le_parameter_store_load_from_file;
+	le_parameter_store_i.get_generation          = le_parameter_store_get_generation;
+	le_parameter_store_i.get_changed_parameters  = le_parameter_store_get_changed_parameters;
 }
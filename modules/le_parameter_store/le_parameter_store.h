@@ -2,6 +2,7 @@
 #define GUARD_le_parameter_store_H
 
 #include "le_core.h"
+#include "le_hash_util.h"
 
 struct le_parameter_store_o;
 struct le_parameter_o;
@@ -20,8 +21,21 @@ Element [0] is the actual parameter value
 Element [1] is the parameter min value
 Element [2] is the parameter max value
 
+Parameters may be looked up by name, or by handle. A parameter handle is the 64 bit fnv1a hash of
+the parameter name, which you can calculate at compile-time via `LE_PARAMETER_HANDLE("name")`.
+
+Each change to a parameter increments the generation of the parameter store, and tags the parameter
+with the new generation. To find out whether anything changed, compare the store's generation with
+the generation you last saw; to find out which parameters changed, use `get_changed_parameters`.
+Setters, and `load_from_file`, update generations automatically; if you write to a parameter via a
+pointer, call `mark_changed` on the parameter once you're done. Generations may be queried, and
+parameters marked as changed from any thread without locking.
+
 */
 
+// Returns a compile-time calculated handle for a parameter with the given name.
+#define LE_PARAMETER_HANDLE( x ) hash_64_fnv1a_const( x )
+
 // clang-format off
 struct le_parameter_store_api {
 
@@ -47,6 +61,10 @@ struct le_parameter_store_api {
         uint32_t* (*as_u32  )( le_parameter_o *self); // may return nullptr if wrong type 
         int32_t*  (*as_i32  )( le_parameter_o *self); // may return nullptr if wrong type 
         bool*     (*as_bool )( le_parameter_o *self); // may return nullptr if wrong type 
+
+        void     (*mark_changed  )( le_parameter_o *self );                      // call this after writing to a parameter via pointer
+        uint64_t (*get_generation)( le_parameter_o *self );                      // store generation at which parameter was last changed
+        bool     (*changed_since )( le_parameter_o *self, uint64_t generation ); // true if parameter changed after given store generation
         
     };
 
@@ -58,11 +76,19 @@ struct le_parameter_store_api {
         le_parameter_o* (*get_parameter)(le_parameter_store_o* self, char const* name); // may return nullptr, if parameter not found.
         le_parameter_o* (*add_parameter)(le_parameter_store_o* self, char const* name);
 
+        le_parameter_o* (*get_parameter_by_handle)(le_parameter_store_o* self, uint64_t handle); // may return nullptr, if parameter not found.
+
         char const *    (*get_name)(le_parameter_store_o* self, le_parameter_o* param); // may return nullptr if not found
 
         bool (*save_to_file)(le_parameter_store_o* self, char const * file_path);
         bool (*load_from_file)(le_parameter_store_o* self, char const * file_path);
 
+        uint64_t (*get_generation)(le_parameter_store_o* self); // increases with every change to any parameter in this store
+
+        // Writes up to `max_count` parameters which changed after `generation` into `changed`,
+        // returns the total number of parameters which changed after `generation`.
+        size_t (*get_changed_parameters)(le_parameter_store_o* self, uint64_t generation, le_parameter_o** changed, size_t max_count);
+
 	};
 
 	le_parameter_interface_t       le_parameter_i;
@@ -141,6 +167,16 @@ class LeParameter {
 	bool *asBool() {
 		return le_parameter_store::le_parameter_i.as_bool( self );
 	}
+	// ----
+	void markChanged() {
+		le_parameter_store::le_parameter_i.mark_changed( self );
+	}
+	uint64_t getGeneration() {
+		return le_parameter_store::le_parameter_i.get_generation( self );
+	}
+	bool changedSince( uint64_t generation ) {
+		return le_parameter_store::le_parameter_i.changed_since( self, generation );
+	}
 
 	le_parameter_store_api::Type getType() {
 		return le_parameter_store::le_parameter_i.get_type( self );
@@ -176,6 +212,10 @@ class LeParameterStore : NoCopy, NoMove {
 		return le_parameter_store::le_parameter_store_i.add_parameter( self, name );
 	}
 
+	le_parameter_o *getParameterByHandle( uint64_t handle ) {
+		return le_parameter_store::le_parameter_store_i.get_parameter_by_handle( self, handle );
+	}
+
 	char const *getName( le_parameter_o *param ) {
 		return le_parameter_store::le_parameter_store_i.get_name( self, param );
 	}
@@ -188,6 +228,14 @@ class LeParameterStore : NoCopy, NoMove {
 		return le_parameter_store::le_parameter_store_i.load_from_file( self, file_path );
 	}
 
+	uint64_t getGeneration() {
+		return le_parameter_store::le_parameter_store_i.get_generation( self );
+	}
+
+	size_t getChangedParameters( uint64_t generation, le_parameter_o **changed, size_t max_count ) {
+		return le_parameter_store::le_parameter_store_i.get_changed_parameters( self, generation, changed, max_count );
+	}
+
 	operator auto() {
 		return self;
 	}
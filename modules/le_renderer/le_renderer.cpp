@@ -5,6 +5,7 @@
 
 #include "le_backend_vk.h"
 #include "le_swapchain_vk.h"
+#include "le_log.h"
 
 #include <iostream>
 #include <iomanip>
@@ -12,15 +13,19 @@
 #include <vector>
 #include "assert.h"
 #include <mutex>
+#include <atomic>
 #include <unordered_map>
 #include <algorithm>
 #include <string>
 #include <cstring> // for memcpy
+#include <sstream> // for chrome trace
 
 #include "private/le_resource_handle_t.inl"
 
 const uint64_t LE_RENDERPASS_MARKER_EXTERNAL = hash_64_fnv1a_const( "rp-external" );
 
+static constexpr auto LOGGER_LABEL = "le_renderer";
+
 using NanoTime = std::chrono::time_point<std::chrono::high_resolution_clock>;
 
 #include "le_jobs.h"
@@ -67,20 +72,166 @@ struct FrameData {
 	Meta   meta;
 };
 
+// Timings for a frame which has been processed by the gpu - we keep a history of these
+// so that they can be queried, and written out as a chrome trace.
+struct FrameTimingsRecord {
+	le_renderer_frame_timings_t         timings{}; // timings.passes points to passes.data()
+	std::vector<le_renderpass_timing_t> passes;    // pass.debug_name points to passNames
+	std::vector<std::string>            passNames; //
+};
+
+static constexpr size_t LE_RENDERER_TIMINGS_HISTORY_LENGTH = 120; // number of frames for which we keep timings
+
 struct le_texture_handle_t {
 	std::string debug_name;
 };
 
-struct le_texture_handle_store_t {
-	std::unordered_multimap<std::string, le_texture_handle_t> texture_handles;
-	std::mutex                                                mtx;
-};
+// Handle stores intern handles, so that equal names map to the same handle.
+//
+// Lookups are lock-free: a store is a fixed-size table of buckets, each bucket holds an
+// insert-only singly linked list of nodes. Nodes are published via compare-and-swap on
+// the bucket head, and never removed while the store is alive - once a thread can see
+// a node, that node, and all nodes following it, are immutable.
+//
+// Handles point to node values, and are therefore stable for the lifetime of the store.
+//
+// Additionally, each thread keeps a small direct-mapped cache of recently produced
+// handles, so that repeated requests for the same handle (typically once per frame,
+// or once per draw) don't even need to walk a bucket list.
+template <typename T>
+struct le_handle_store_t {
+
+	struct Node {
+		T        value;
+		uint64_t hash;
+		Node *   next; // immutable once node has been published
+	};
+
+	struct CacheEntry {
+		uint64_t hash;
+		uint64_t generation; // generation of the store which produced this entry - 0 means empty
+		T *      value;
+	};
+
+	static constexpr size_t BUCKET_COUNT = 1 << 16; // must be power of two - the table never grows, so we size it for tens of thousands of names (512KB per store)
+	static constexpr size_t CACHE_SIZE   = 256;     // number of thread-local cache entries, must be power of two
+
+	std::atomic<Node *> buckets[ BUCKET_COUNT ]{}; // heads of bucket lists
+	std::atomic<Node *> anonymous_nodes{};         // nodes for unnamed handles - these are never looked up
+	uint64_t const      generation;                // unique per store, so that thread-local caches may detect stale entries
+
+	le_handle_store_t()
+	    : generation( next_generation() ) {
+	}
+
+	~le_handle_store_t() {
+		for ( auto &bucket : buckets ) {
+			delete_list( bucket.load( std::memory_order_acquire ) );
+		}
+		delete_list( anonymous_nodes.load( std::memory_order_acquire ) );
+	}
+
+	// Calls `visit` on every handle value in this store. Must not be called concurrently with inserts.
+	template <typename Visitor>
+	void for_each( Visitor const &visit ) {
+		for ( auto &bucket : buckets ) {
+			for ( Node *n = bucket.load( std::memory_order_acquire ); n != nullptr; n = n->next ) {
+				visit( n->value );
+			}
+		}
+		for ( Node *n = anonymous_nodes.load( std::memory_order_acquire ); n != nullptr; n = n->next ) {
+			visit( n->value );
+		}
+	}
+
+	// Inserts a new value, which will not take part in lookups.
+	T *insert_anonymous( T &&value ) {
+		Node *node = new Node{ std::move( value ), 0, anonymous_nodes.load( std::memory_order_relaxed ) };
+		while ( !anonymous_nodes.compare_exchange_weak( node->next, node, std::memory_order_release, std::memory_order_relaxed ) ) {
+		}
+		return &node->value;
+	}
+
+	// Returns the value for which `is_equal` holds true, if found. Otherwise inserts
+	// and returns the value returned by `make`. If another thread inserted an equal value
+	// concurrently, the value which was created by this thread is passed to `discard`, and
+	// the value inserted by the other thread is returned.
+	template <typename IsEqual, typename Make, typename Discard>
+	T *produce( uint64_t hash, IsEqual const &is_equal, Make const &make, Discard const &discard ) {
+
+		static thread_local CacheEntry cache[ CACHE_SIZE ]{};
+
+		CacheEntry &cached = cache[ hash & ( CACHE_SIZE - 1 ) ];
+
+		if ( cached.generation == generation && cached.hash == hash && is_equal( *cached.value ) ) {
+			return cached.value;
+		}
+
+		// ---------| invariant: not found in thread-local cache
+
+		T *value = find_or_insert( hash, is_equal, make, discard );
+
+		cached = { hash, generation, value };
+
+		return value;
+	}
+
+  private:
+	template <typename IsEqual, typename Make, typename Discard>
+	T *find_or_insert( uint64_t hash, IsEqual const &is_equal, Make const &make, Discard const &discard ) {
 
-struct le_resource_handle_store_t {
-	std::unordered_multimap<le_resource_handle_data_t, le_resource_handle_t, le_resource_handle_data_hash> resource_handles;
-	std::mutex                                                                                             mtx;
+		std::atomic<Node *> &bucket = buckets[ hash & ( BUCKET_COUNT - 1 ) ];
+
+		Node *head      = bucket.load( std::memory_order_acquire );
+		Node *scan_stop = nullptr; // nodes from here onwards have already been checked
+		Node *new_node  = nullptr;
+
+		for ( ;; ) {
+
+			for ( Node *n = head; n != scan_stop; n = n->next ) {
+				if ( n->hash == hash && is_equal( n->value ) ) {
+					if ( new_node ) {
+						// Another thread was quicker to insert an equal value.
+						discard( new_node->value );
+						delete new_node;
+					}
+					return &n->value;
+				}
+			}
+
+			if ( nullptr == new_node ) {
+				new_node = new Node{ make(), hash, nullptr };
+			}
+
+			new_node->next = head;
+
+			if ( bucket.compare_exchange_weak( head, new_node, std::memory_order_release, std::memory_order_acquire ) ) {
+				return &new_node->value;
+			}
+
+			// Bucket head changed: we only need to check nodes which were
+			// inserted since we last looked.
+			scan_stop = new_node->next;
+		}
+	}
+
+	static void delete_list( Node *n ) {
+		while ( n ) {
+			Node *next = n->next;
+			delete n;
+			n = next;
+		}
+	}
+
+	static uint64_t next_generation() {
+		static std::atomic<uint64_t> counter{ 0 };
+		return ++counter;
+	}
 };
 
+using le_texture_handle_store_t  = le_handle_store_t<le_texture_handle_t>;
+using le_resource_handle_store_t = le_handle_store_t<le_resource_handle_t>;
+
 static le_texture_handle_store_t *get_texture_handle_library( bool erase = false ) {
 
 	static le_texture_handle_store_t *texture_handle_library = nullptr;
@@ -152,6 +303,10 @@ struct le_renderer_o {
 	size_t                 numSwapchainImages = 0;
 	size_t                 currentFrameNumber = size_t( ~0 ); // ever increasing number of current frame
 	le_renderer_settings_t settings;
+
+	std::vector<FrameTimingsRecord> timingsHistory;                      // ring buffer, timings for most recently completed frames
+	size_t                          timingsHistoryLatest = ~size_t( 0 ); // index of most recently written element in timingsHistory
+	std::mutex                      timingsMtx;                          // protects timingsHistory, as frames may be cleared on worker threads
 };
 
 static void renderer_clear_frame( le_renderer_o *self, size_t frameIndex ); // ffdecl
@@ -173,35 +328,24 @@ static le_renderer_o *renderer_create() {
 // creates a new handle if no name was given, or given name was not found in list of current handles.
 static le_texture_handle renderer_produce_texture_handle( char const *maybe_name ) {
 
-	// lock handle library for reading/writing
 	static le_texture_handle_store_t *texture_handle_library = get_texture_handle_library();
-	std::scoped_lock                  lock( texture_handle_library->mtx );
-
-	le_texture_handle handle;
-
-	if ( maybe_name ) {
-		// if a string was given, search for multimap and see if we can find something.
-		auto it = texture_handle_library->texture_handles.find( maybe_name );
-		if ( it == texture_handle_library->texture_handles.end() ) {
-			// not found, insert a new element
-			handle = &texture_handle_library->texture_handles.emplace( maybe_name, le_texture_handle_t( { maybe_name } ) )->second;
-		} else {
-			// found, return a pointer to the found element
-			handle = &it->second;
-		}
-	} else {
+
+	if ( nullptr == maybe_name ) {
 		// no name given: handle is set to address of newly inserted element
-		// As this is a multimap, there can be any number of textures with the same
-		// key "unnamed" in the map.
-		handle = &texture_handle_library->texture_handles.emplace( "unnamed", le_texture_handle_t{} )->second;
+		// There can be any number of unnamed textures.
+		return texture_handle_library->insert_anonymous( le_texture_handle_t{} );
 	}
 
-	// handle is a pointer to the element in the container, and as such it is
-	// guaranteed to stay valid, even through rehashes of the texture_handles
-	// container, because that's a guarantee that maps give us in c++, until
-	// the element gets erased.
+	// ---------| invariant: a name was given - see if we can find a matching handle.
+
+	return texture_handle_library->produce(
+	    hash_64_fnv1a( maybe_name ),
+	    [ maybe_name ]( le_texture_handle_t const &h ) -> bool { return h.debug_name == maybe_name; },
+	    [ maybe_name ]() -> le_texture_handle_t { return { maybe_name }; },
+	    []( le_texture_handle_t & ) {} );
 
-	return handle;
+	// handle is a pointer to an element in the store, and as such it is
+	// guaranteed to stay valid until the store gets destroyed.
 }
 
 // ----------------------------------------------------------------------
@@ -224,43 +368,32 @@ le_resource_handle renderer_produce_resource_handle(
     le_resource_handle    reference_handle = nullptr ) {
 
 	static le_resource_handle_store_t *resource_handle_library = get_resource_handle_library();
-	// lock handle library for reading/writing
-	std::scoped_lock lock( resource_handle_library->mtx );
-
-	le_resource_handle handle;
-
-	le_resource_handle_data_t *p_data = new le_resource_handle_data_t{};
-	p_data->flags                     = flags;
-	p_data->num_samples               = num_samples;
-	p_data->reference_handle          = reference_handle;
-	p_data->type                      = resource_type;
-	p_data->index                     = index;
-
-	if ( maybe_name && maybe_name[ 0 ] != '\0' ) {
-		memcpy( p_data->debug_name, maybe_name, sizeof( p_data->debug_name ) );
-		// if a string was given, search for multimap and see if we can find something.
-		auto it = resource_handle_library->resource_handles.find( *p_data );
-		if ( it == resource_handle_library->resource_handles.end() ) {
-			// not found, insert a new element
-			handle = &resource_handle_library->resource_handles.emplace( *p_data, le_resource_handle_t{ p_data } )->second;
-		} else {
-			// found, return a pointer to the found element
-			handle = &it->second;
-			delete ( p_data );
-		}
-	} else {
+
+	le_resource_handle_data_t key{};
+	key.flags            = flags;
+	key.num_samples      = num_samples;
+	key.reference_handle = reference_handle;
+	key.type             = resource_type;
+	key.index            = index;
+
+	if ( nullptr == maybe_name || maybe_name[ 0 ] == '\0' ) {
 		// no name given: handle is set to address of newly inserted element
-		// As this is a multimap, there can be any number of textures with the same
-		// key "unnamed" in the map.
-		handle = &resource_handle_library->resource_handles.emplace( *p_data, le_resource_handle_t{ p_data } )->second;
+		// There can be any number of unnamed resources.
+		return resource_handle_library->insert_anonymous( le_resource_handle_t{ new le_resource_handle_data_t( key ) } );
 	}
 
-	// handle is a pointer to the element in the container, and as such it is
-	// guaranteed to stay valid, even through rehashes of the resource_handle_library
-	// container, because that's a guarantee that maps give us in c++, until
-	// the element gets erased.
+	// ---------| invariant: a name was given - see if we can find a matching handle.
+
+	strncpy( key.debug_name, maybe_name, sizeof( key.debug_name ) - 1 );
+
+	return resource_handle_library->produce(
+	    le_resource_handle_data_hash()( key ),
+	    [ &key ]( le_resource_handle_t const &h ) -> bool { return *h.data == key; },
+	    [ &key ]() -> le_resource_handle_t { return { new le_resource_handle_data_t( key ) }; },
+	    []( le_resource_handle_t &h ) { delete h.data; } );
 
-	return handle;
+	// handle is a pointer to an element in the store, and as such it is
+	// guaranteed to stay valid until the store gets destroyed.
 }
 
 static le_img_resource_handle renderer_produce_img_resource_handle( char const *maybe_name, uint8_t num_samples,
@@ -306,9 +439,7 @@ static void renderer_destroy( le_renderer_o *self ) {
 		le_resource_handle_store_t *resource_handle_library = get_resource_handle_library();
 		if ( resource_handle_library ) {
 			// we must deallocate manually allocated data for resource handles
-			for ( auto &e : resource_handle_library->resource_handles ) {
-				delete ( e.second.data );
-			}
+			resource_handle_library->for_each( []( le_resource_handle_t &h ) { delete ( h.data ); } );
 			// Delete static pointer to resource handle library
 			get_resource_handle_library( true );
 		}
@@ -370,10 +501,12 @@ static void renderer_setup( le_renderer_o *self, le_renderer_settings_t const &s
 		self->backend = vk_backend_i.create();
 
 		le_backend_vk_settings_t backend_settings{};
-		backend_settings.pSwapchain_settings          = self->settings.swapchain_settings;
-		backend_settings.num_swapchain_settings       = self->settings.num_swapchain_settings;
-		backend_settings.requestedDeviceExtensions    = settings.requested_device_extensions;
-		backend_settings.numRequestedDeviceExtensions = settings.requested_device_extensions_count;
+		backend_settings.pSwapchain_settings            = self->settings.swapchain_settings;
+		backend_settings.num_swapchain_settings         = self->settings.num_swapchain_settings;
+		backend_settings.requestedDeviceExtensions      = settings.requested_device_extensions;
+		backend_settings.numRequestedDeviceExtensions   = settings.requested_device_extensions_count;
+		backend_settings.enable_gpu_timestamps          = settings.enable_gpu_timestamps;
+		backend_settings.enable_gpu_pipeline_statistics = settings.enable_gpu_pipeline_statistics;
 
 #if ( LE_MT > 0 )
 		backend_settings.concurrency_count = LE_MT;
@@ -406,6 +539,216 @@ static le_renderer_settings_t const *renderer_get_settings( le_renderer_o *self
 	return &self->settings;
 }
 
+// ----------------------------------------------------------------------
+// Stores cpu timings, and gpu timings (if any) of a frame which has been processed
+// by the gpu into the renderer's timings history.
+static void renderer_store_frame_timings( le_renderer_o *self, size_t frameIndex ) {
+
+	using namespace le_backend_vk; // for vk_backend_i
+
+	auto const &frame = self->frames[ frameIndex ];
+
+	auto to_nanoseconds = []( NanoTime const &t ) -> uint64_t {
+		return uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>( t.time_since_epoch() ).count() );
+	};
+
+	le_renderpass_timing_t const *pass_timings       = nullptr;
+	uint32_t                      pass_timings_count = 0;
+
+	// Unless gpu profiling is enabled, there are no pass timings to copy, and we keep
+	// cpu timings for the most recent frame only, instead of a history.
+
+	size_t history_length = 1;
+
+	if ( self->settings.enable_gpu_timestamps ) {
+		vk_backend_i.get_frame_pass_timings( self->backend, frameIndex, &pass_timings, &pass_timings_count );
+		history_length = LE_RENDERER_TIMINGS_HISTORY_LENGTH;
+	}
+
+	std::scoped_lock lock( self->timingsMtx );
+
+	if ( self->timingsHistory.size() < history_length ) {
+		self->timingsHistory.emplace_back();
+		self->timingsHistoryLatest = self->timingsHistory.size() - 1;
+	} else {
+		self->timingsHistoryLatest = ( self->timingsHistoryLatest + 1 ) % history_length;
+	}
+
+	auto &record = self->timingsHistory[ self->timingsHistoryLatest ];
+
+	// Copy pass timings, and pass names, as the backend is free to recycle these.
+	record.passes.assign( pass_timings, pass_timings + pass_timings_count );
+	record.passNames.resize( pass_timings_count );
+
+	for ( size_t i = 0; i != pass_timings_count; i++ ) {
+		record.passNames[ i ]         = pass_timings[ i ].debug_name ? pass_timings[ i ].debug_name : "";
+		record.passes[ i ].debug_name = record.passNames[ i ].c_str();
+	}
+
+	auto &t              = record.timings;
+	t.frame_number       = frame.frameNumber;
+	t.cpu_record_begin   = to_nanoseconds( frame.meta.time_record_frame_start );
+	t.cpu_record_end     = to_nanoseconds( frame.meta.time_record_frame_end );
+	t.cpu_acquire_begin  = to_nanoseconds( frame.meta.time_acquire_frame_start );
+	t.cpu_acquire_end    = to_nanoseconds( frame.meta.time_acquire_frame_end );
+	t.cpu_process_begin  = to_nanoseconds( frame.meta.time_process_frame_start );
+	t.cpu_process_end    = to_nanoseconds( frame.meta.time_process_frame_end );
+	t.cpu_dispatch_begin = to_nanoseconds( frame.meta.time_dispatch_frame_start );
+	t.cpu_dispatch_end   = to_nanoseconds( frame.meta.time_dispatch_frame_end );
+	t.passes             = record.passes.data();
+	t.passes_count       = uint32_t( record.passes.size() );
+}
+
+// ----------------------------------------------------------------------
+// Returns timings for the most recent frame which has been processed by the gpu.
+// Returns false if no timings are available yet.
+static bool renderer_get_frame_timings( le_renderer_o *self, le_renderer_frame_timings_t *timings ) {
+
+	std::scoped_lock lock( self->timingsMtx );
+
+	if ( self->timingsHistory.empty() ) {
+		return false;
+	}
+
+	*timings = self->timingsHistory[ self->timingsHistoryLatest ].timings;
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Writes timings history as a json file which may be loaded into chrome://tracing,
+// or https://ui.perfetto.dev
+//
+// Gpu timestamps use a different timebase than cpu timestamps - we align gpu events
+// so that the first gpu event of the oldest frame in history begins when that frame
+// was dispatched. This is an approximation, but it keeps relative gpu timings intact.
+static bool renderer_write_chrome_trace( le_renderer_o *self, char const *file_path ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	std::scoped_lock lock( self->timingsMtx );
+
+	if ( self->timingsHistory.empty() ) {
+		logger.warn( "Could not write chrome trace: no frame timings available." );
+		return false;
+	}
+
+	size_t const numRecords = self->timingsHistory.size();
+	size_t const oldest     = ( self->timingsHistoryLatest + 1 ) % numRecords;
+
+	auto record_at = [ & ]( size_t i ) -> FrameTimingsRecord const & {
+		return self->timingsHistory[ ( oldest + i ) % numRecords ];
+	};
+
+	// -- Find origin for cpu timestamps, and offset between gpu and cpu timestamps.
+
+	uint64_t const cpu_origin       = record_at( 0 ).timings.cpu_record_begin;
+	int64_t        gpu_offset       = 0; // add to gpu timestamp to get (approximate) cpu timestamp
+	bool           gpu_offset_found = false;
+
+	for ( size_t i = 0; i != numRecords && !gpu_offset_found; i++ ) {
+		auto const &r = record_at( i );
+		for ( auto const &p : r.passes ) {
+			if ( p.has_timestamps ) {
+				gpu_offset       = int64_t( r.timings.cpu_dispatch_begin ) - int64_t( p.gpu_time_begin );
+				gpu_offset_found = true;
+				break;
+			}
+		}
+	}
+
+	auto to_us = [ & ]( int64_t t_ns ) -> double {
+		return double( t_ns - int64_t( cpu_origin ) ) / 1000.0;
+	};
+
+	std::ostringstream os;
+	os << std::fixed << std::setprecision( 3 );
+
+	os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+	os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"CPU\"}}," << std::endl;
+	os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"GPU\"}}," << std::endl;
+	os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"graphics queue\"}}," << std::endl;
+	os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"async compute queue\"}}";
+
+	// Note: leaves the event's `args` object open, so that callers may add more arguments.
+	auto write_event = [ & ]( char const *name, int pid, int tid, int64_t begin_ns, int64_t end_ns, uint64_t frame_number ) {
+		os << "," << std::endl
+		   << "{\"name\":\"";
+		// Escape characters which are not allowed in json strings
+		for ( char const *c = name; *c; c++ ) {
+			if ( *c == '"' || *c == '\\' ) {
+				os << '\\';
+			}
+			if ( uint8_t( *c ) >= 0x20 ) {
+				os << *c;
+			}
+		}
+		os << "\",\"ph\":\"X\",\"pid\":" << pid
+		   << ",\"tid\":" << tid
+		   << ",\"ts\":" << to_us( begin_ns )
+		   << ",\"dur\":" << double( end_ns - begin_ns ) / 1000.0
+		   << ",\"args\":{\"frame\":" << frame_number;
+	};
+
+	static char const *pipeline_statistic_names[ le_renderpass_timing_t::ePipelineStatisticCount ] = {
+	    "ia_vertices",
+	    "ia_primitives",
+	    "vs_invocations",
+	    "clipping_invocations",
+	    "clipping_primitives",
+	    "fs_invocations",
+	    "cs_invocations",
+	};
+
+	for ( size_t i = 0; i != numRecords; i++ ) {
+		auto const &t = record_at( i ).timings;
+
+		// -- cpu phases
+		write_event( "record", 0, 0, int64_t( t.cpu_record_begin ), int64_t( t.cpu_record_end ), t.frame_number );
+		os << "}}";
+		write_event( "acquire", 0, 0, int64_t( t.cpu_acquire_begin ), int64_t( t.cpu_acquire_end ), t.frame_number );
+		os << "}}";
+		write_event( "process", 0, 0, int64_t( t.cpu_process_begin ), int64_t( t.cpu_process_end ), t.frame_number );
+		os << "}}";
+		write_event( "dispatch", 0, 0, int64_t( t.cpu_dispatch_begin ), int64_t( t.cpu_dispatch_end ), t.frame_number );
+		os << "}}";
+
+		// -- gpu passes
+		for ( auto const &p : record_at( i ).passes ) {
+			if ( !p.has_timestamps ) {
+				continue;
+			}
+			write_event( p.debug_name, 1, p.is_async_compute ? 1 : 0,
+			             int64_t( p.gpu_time_begin ) + gpu_offset,
+			             int64_t( p.gpu_time_end ) + gpu_offset,
+			             t.frame_number );
+			if ( p.has_pipeline_statistics ) {
+				for ( uint32_t s = 0; s != le_renderpass_timing_t::ePipelineStatisticCount; s++ ) {
+					os << ",\"" << pipeline_statistic_names[ s ] << "\":" << p.pipeline_statistics[ s ];
+				}
+			}
+			os << "}}";
+		}
+	}
+
+	os << std::endl
+	   << "]}" << std::endl;
+
+	FILE *out_file = fopen( file_path, "wb" );
+
+	if ( out_file == nullptr ) {
+		logger.error( "Could not open file for writing chrome trace: '%s'", file_path );
+		return false;
+	}
+
+	fprintf( out_file, "%s", os.str().c_str() );
+	fclose( out_file );
+
+	logger.info( "Wrote chrome trace: '%s'", file_path );
+
+	return true;
+}
+
 // ----------------------------------------------------------------------
 
 static void renderer_clear_frame( le_renderer_o *self, size_t frameIndex ) {
@@ -439,6 +782,10 @@ static void renderer_clear_frame( le_renderer_o *self, size_t frameIndex ) {
 			frame.state = FrameData::State::eFailedClear;
 			return;
 		}
+
+		if ( frame.state == FrameData::State::eDispatched ) {
+			renderer_store_frame_timings( self, frameIndex );
+		}
 	}
 
 	rendergraph_i.reset( frame.rendergraph );
@@ -848,6 +1195,8 @@ LE_MODULE_REGISTER_IMPL( le_renderer, api ) {
 	le_renderer_i.get_swapchain_extent   = renderer_get_swapchain_extent;
 	le_renderer_i.get_pipeline_manager   = renderer_get_pipeline_manager;
 	le_renderer_i.get_backend            = renderer_get_backend;
+	le_renderer_i.get_frame_timings      = renderer_get_frame_timings;
+	le_renderer_i.write_chrome_trace     = renderer_write_chrome_trace;
 
 	le_renderer_i.produce_texture_handle  = renderer_produce_texture_handle;
 	le_renderer_i.texture_handle_get_name = texture_handle_get_name;
@@ -47,6 +47,13 @@ struct le_renderer_api {
 
 		le_pipeline_manager_o*         ( *get_pipeline_manager    )( le_renderer_o* self );
 
+		/// Cpu phase timings and per-pass gpu timings for the most recent frame which was processed by the gpu.
+		/// Gpu timings are only available if enabled via le_renderer_settings_t. Returns false if no timings available yet.
+		bool                           ( *get_frame_timings       )( le_renderer_o* self, le_renderer_frame_timings_t* timings );
+		/// Writes timings for recent frames to file_path, in chrome trace event json format.
+		/// Unless gpu timestamps are enabled, only the most recent frame is kept, and written.
+		bool                           ( *write_chrome_trace      )( le_renderer_o* self, char const * file_path );
+
         le_texture_handle              ( *produce_texture_handle  )(char const * maybe_name );
         char const *                   ( *texture_handle_get_name )(le_texture_handle handle);
 
@@ -97,6 +104,8 @@ struct le_renderer_api {
 		const char*                     ( *get_debug_name       )( const le_renderpass_o* obj );
 		uint64_t                        ( *get_id               )( const le_renderpass_o* obj );
 		LeRenderPassType                ( *get_type             )( const le_renderpass_o* obj );
+		bool                            ( *get_is_async_compute )( const le_renderpass_o* obj ); // set by rendergraph: pass may execute on dedicated compute queue
+		bool                            ( *get_waits_for_async_compute )( const le_renderpass_o* obj ); // set by rendergraph: pass must wait for async compute passes
 		le_command_buffer_encoder_o*    ( *steal_encoder        )( le_renderpass_o* obj );
 		void                            ( *get_image_attachments)(const le_renderpass_o* obj, const le_image_attachment_info_t** pAttachments, const le_img_resource_handle ** pResourceIds, size_t* numAttachments);
 
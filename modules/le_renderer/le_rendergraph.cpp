@@ -69,6 +69,9 @@ struct le_renderpass_o {
 	le::SampleCountFlagBits sample_count = le::SampleCountFlagBits::e1; // < SampleCount for all attachments.
 	uint32_t                isRoot       = false;                       // whether pass *must* be processed
 
+	uint32_t is_async_compute        = false; // set during rendergraph.build: pass may execute on a dedicated compute queue
+	uint32_t waits_for_async_compute = false; // set during rendergraph.build: first non-async pass which depends on async compute passes
+
 	std::vector<le_resource_handle>    resources;              // all resources used in this pass
 	std::vector<LeResourceAccessFlags> resources_access_flags; // access flags for all resources, in sync with resources
 	std::vector<LeResourceUsageFlags>  resources_usage;        // declared usage for each resource, in sync with resources
@@ -415,6 +418,14 @@ static LeRenderPassType renderpass_get_type( le_renderpass_o const *self ) {
 	return self->type;
 }
 
+static bool renderpass_get_is_async_compute( le_renderpass_o const *self ) {
+	return self->is_async_compute;
+}
+
+static bool renderpass_get_waits_for_async_compute( le_renderpass_o const *self ) {
+	return self->waits_for_async_compute;
+}
+
 static void renderpass_get_used_resources( le_renderpass_o const *self, le_resource_handle const **pResources, LeResourceUsageFlags const **pResourcesUsage, size_t *count ) {
 	assert( self->resources_usage.size() == self->resources.size() );
 
@@ -595,6 +606,79 @@ static void tasks_calculate_sort_indices( Task const *const tasks, const size_t
 	}
 }
 
+/// \brief Tag compute passes which may execute on a dedicated compute queue.
+/// \details A compute pass is tagged as async compute if it does not depend on any
+///          earlier pass which must execute on the graphics queue: it must not read
+///          anything such a pass writes, and it must not write anything such a pass
+///          reads or writes. Async compute passes may only use buffer resources, so
+///          that they never need image layout transitions.
+///
+///          We also tag the first graphics queue pass which touches any resource used
+///          by async compute passes - submission of this pass, and all subsequent
+///          graphics queue passes, must wait for async compute passes to complete.
+///
+/// Note: `sortIndices` must have been calculated, `passes` must hold `numTasks` elements.
+static void tasks_tag_async_compute( Task const *const tasks, le_renderpass_o **passes, uint32_t const *sortIndices, const size_t numTasks ) {
+
+	BitField graphics_reads{};
+	BitField graphics_writes{};
+	BitField async_reads{};
+	BitField async_writes{};
+
+	bool found_wait_pass = false;
+
+	for ( size_t i = 0; i != numTasks; i++ ) {
+
+		auto const &task = tasks[ i ];
+		auto        pass = passes[ i ];
+
+		pass->is_async_compute        = false;
+		pass->waits_for_async_compute = false;
+
+		if ( sortIndices[ i ] == ( ~0u ) ) {
+			// Pass does not contribute
+			continue;
+		}
+
+		BitField reads = task.reads;
+		reads[ 0 ]     = false; // first bit only marks a root/contributing task - it is not a resource
+
+		bool may_be_async =
+		    pass->type == LeRenderPassType::LE_RENDER_PASS_TYPE_COMPUTE &&
+		    pass->textureIds.empty() &&
+		    ( reads & graphics_writes ).none() &&                          // no read after write from graphics queue pass
+		    ( task.writes & ( graphics_reads | graphics_writes ) ).none(); // no write after read or write from graphics queue pass
+
+		if ( may_be_async ) {
+			for ( auto const &r : pass->resources ) {
+				if ( r->data->type != LeResourceType::eBuffer ) {
+					may_be_async = false;
+					break;
+				}
+			}
+		}
+
+		if ( may_be_async ) {
+			pass->is_async_compute = true;
+			async_reads |= reads;
+			async_writes |= task.writes;
+			continue;
+		}
+
+		// ----------| invariant: pass must execute on graphics queue
+
+		if ( !found_wait_pass &&
+		     ( ( reads & async_writes ).any() ||
+		       ( task.writes & ( async_reads | async_writes ) ).any() ) ) {
+			pass->waits_for_async_compute = true;
+			found_wait_pass               = true;
+		}
+
+		graphics_reads |= reads;
+		graphics_writes |= task.writes;
+	}
+}
+
 // returns path to current executable.
 std::filesystem::path getexepath() {
 	char result[ 1024 ] = { 0 };
@@ -893,6 +977,9 @@ static void rendergraph_build( le_rendergraph_o *self, size_t frame_number ) {
 	// Associate sort indices to tasks
 	tasks_calculate_sort_indices( tasks.data(), tasks.size(), self->sortIndices.data() );
 
+	// Find out which compute passes may execute on a dedicated compute queue
+	tasks_tag_async_compute( tasks.data(), self->passes.data(), self->sortIndices.data(), tasks.size() );
+
 #if ( DEBUG_GENERATE_DOT_GRAPH )
 	{
 		// We must check if the renderpass has somehow changed - if we detect change, save out a new .dot file.
@@ -1229,6 +1316,8 @@ void register_le_rendergraph_api( void *api_ ) {
 	le_renderpass_i.get_id                       = renderpass_get_id;
 	le_renderpass_i.get_debug_name               = renderpass_get_debug_name;
 	le_renderpass_i.get_type                     = renderpass_get_type;
+	le_renderpass_i.get_is_async_compute         = renderpass_get_is_async_compute;
+	le_renderpass_i.get_waits_for_async_compute  = renderpass_get_waits_for_async_compute;
 	le_renderpass_i.get_width                    = renderpass_get_width;
 	le_renderpass_i.set_width                    = renderpass_set_width;
 	le_renderpass_i.set_sample_count             = renderpass_set_sample_count;
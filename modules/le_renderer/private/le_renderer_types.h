@@ -1037,9 +1037,54 @@ struct le_renderer_settings_t {
 	uint32_t                requested_device_extensions_count = 0;       //
 	le_swapchain_settings_t swapchain_settings[ 16 ]          = {};
 	size_t                  num_swapchain_settings            = 1;
+	bool                    enable_gpu_timestamps             = false; // optional: measure gpu time for each renderpass, see renderer_i.get_frame_timings
+	bool                    enable_gpu_pipeline_statistics    = false; // optional: query pipeline statistics for each renderpass, requires enable_gpu_timestamps, ignored if the device does not support pipeline statistics queries
+};
+
+// Gpu profiling results for one renderpass, available once the gpu has finished
+// processing the frame which contained the renderpass.
+struct le_renderpass_timing_t {
+
+	enum PipelineStatistic : uint32_t {
+		eInputAssemblyVertices = 0,
+		eInputAssemblyPrimitives,
+		eVertexShaderInvocations,
+		eClippingInvocations,
+		eClippingPrimitives,
+		eFragmentShaderInvocations,
+		eComputeShaderInvocations,
+		ePipelineStatisticCount, // must be last
+	};
+
+	char const *debug_name;                                     // non-owning
+	uint64_t    gpu_time_begin;                                 // gpu timestamp in nanoseconds (device timebase) when pass began
+	uint64_t    gpu_time_end;                                   // gpu timestamp in nanoseconds (device timebase) when pass ended
+	uint64_t    pipeline_statistics[ ePipelineStatisticCount ]; // only valid if has_pipeline_statistics
+	uint32_t    has_timestamps;                                 // false if timestamps were not available for this pass
+	uint32_t    has_pipeline_statistics;                        // false if pipeline statistics were not queried for this pass
+	uint32_t    is_async_compute;                               // pass was executed on the async compute queue
+};
+
+// Cpu phase timings for one frame, plus gpu timings for each of its renderpasses.
+// Cpu timestamps are given in nanoseconds (renderer clock), gpu timestamps are in device
+// timebase, and must not be compared directly with cpu timestamps.
+struct le_renderer_frame_timings_t {
+	uint64_t                      frame_number;
+	uint64_t                      cpu_record_begin;
+	uint64_t                      cpu_record_end;
+	uint64_t                      cpu_acquire_begin;
+	uint64_t                      cpu_acquire_end;
+	uint64_t                      cpu_process_begin;
+	uint64_t                      cpu_process_end;
+	uint64_t                      cpu_dispatch_begin;
+	uint64_t                      cpu_dispatch_end;
+	le_renderpass_timing_t const *passes; // non-owning, valid until next call to renderer.update
+	uint32_t                      passes_count;
 };
 
 // specifies parameters for an image write operation.
+// Writes which only cover a sub-region of an image preserve the rest of the image's
+// contents - this requires that the pass declares the image with TRANSFER_DST usage.
 struct le_write_to_image_settings_t {
 	uint32_t image_w         = 0; // image (slice) width in texels
 	uint32_t image_h         = 0; // image (slice) height in texels
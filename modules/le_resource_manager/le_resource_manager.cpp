@@ -1,31 +1,107 @@
 #include "le_resource_manager.h"
 #include "le_core.h"
+#include "le_log.h"
 #include "le_renderer.h"
 #include "le_pixels.h"
+#include "le_file_watcher.h"
+
+#ifndef LE_MT
+#	define LE_MT 0
+#endif
+
+#if ( LE_MT > 0 )
+#	include "le_jobs.h"
+#endif
 
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <algorithm>
 #include <assert.h>
 
 #include "private/le_resource_handle_t.inl"
 
+static constexpr auto LOGGER_LABEL = "le_resource_manager";
+
+// Default upper bound for the number of bytes of pixel data which the resource manager
+// will hand to the transfer pass per frame. Images which don't fit into the budget for
+// the current frame are uploaded in subsequent frames.
+static constexpr uint64_t LE_RESOURCE_MANAGER_DEFAULT_UPLOAD_BUDGET = 64ull << 20; // 64 MB
+
+// Decoded pixels wait in memory until they are uploaded - we only admit new decodes
+// while the number of bytes which are being decoded, or which wait for upload, stays
+// below this many frames' worth of upload budget. With the job system, this lets
+// decoding run ahead of uploads, without decoding all images at once.
+#if ( LE_MT > 0 )
+static constexpr uint64_t LE_RESOURCE_MANAGER_DECODE_FRAMES_AHEAD = 2;
+#else
+static constexpr uint64_t LE_RESOURCE_MANAGER_DECODE_FRAMES_AHEAD = 1;
+#endif
+
 // ----------------------------------------------------------------------
 
 struct le_resource_manager_o {
 
+	enum class LayerState : uint32_t {
+		eNeedsDecode = 0, // source must be (re-)decoded
+		eDecoding,        // source is being decoded, pixels not yet available
+		eReady,           // pixels are decoded, waiting for upload
+		eUploaded,        // pixels have been uploaded, pixels have been released
+		eFailed,          // source could not be decoded
+	};
+
 	struct image_data_layer_t {
-		le_pixels_o *pixels;
+		le_pixels_o *pixels           = nullptr; // owned, only valid in state eReady
 		std::string  path;
-		bool         was_uploaded = false;
+		LayerState   state            = LayerState::eNeedsDecode;
+		bool         reload_requested = false; // source changed while it was being decoded
 	};
 
 	struct resource_item_t {
 		le_img_resource_handle          image_handle;
 		le_resource_info_t              image_info;
+		uint32_t                        num_channels;
+		le_pixels_info::Type            pixels_type;
 		std::vector<image_data_layer_t> image_layers; // must have at least one element
 	};
 
-	std::vector<resource_item_t> resources;
+	struct decode_batch_t; // ffdecl.
+
+	struct decode_request_t {
+		decode_batch_t *     batch;
+		std::string          path; // copy, so that decoding does not depend on resources staying put
+		uint32_t             num_channels;
+		le_pixels_info::Type pixels_type;
+		uint32_t             resource_idx;
+		uint32_t             layer_idx;
+		le_pixels_o *        result;
+	};
+
+	// A batch of decode requests which were issued in the same frame. With the job system
+	// available, requests are decoded on worker threads, and the batch is collected once
+	// all its requests have completed.
+	struct decode_batch_t {
+		std::vector<decode_request_t> requests;
+		std::atomic<uint32_t>         num_pending;
+#if ( LE_MT > 0 )
+		le_jobs::counter_t *counter;
+#endif
+	};
+
+	struct upload_t {
+		uint32_t resource_idx;
+		uint32_t layer_idx;
+	};
+
+	std::vector<resource_item_t>  resources;
+	std::vector<decode_batch_t *> decode_batches; // owning; batches in flight
+	std::vector<upload_t>         uploads;        // layers to upload with the current frame
+
+	uint64_t upload_budget; // max number of bytes to upload per frame
+
+	le_file_watcher_o *                  file_watcher;
+	std::unordered_map<std::string, int> watch_ids; // one watch per source path
 };
 
 // TODO:
@@ -36,32 +112,25 @@ static bool setupTransferPass( le_renderpass_o *pRp, void *user_data ) {
 	le::RenderPass rp{ pRp };
 	auto           manager = static_cast<le_resource_manager_o const *>( user_data );
 
-	if ( manager->resources.empty() ) {
+	if ( manager->uploads.empty() ) {
 		return false;
 	}
 
 	// --------| invariant: some elements need upload
 
-	bool needsTransfer = false;
-
-	for ( auto const &r : manager->resources ) {
+	// uploads are sorted by resource index, which means we need to declare
+	// each resource only once.
 
-		bool uses_resource = false;
+	uint32_t previous_resource_idx = ~uint32_t( 0 );
 
-		for ( auto const &layer : r.image_layers ) {
-			if ( layer.was_uploaded == false ) {
-				uses_resource = true;
-				break;
-			}
-		}
-
-		if ( uses_resource ) {
-			rp.useImageResource( r.image_handle, { LE_IMAGE_USAGE_TRANSFER_DST_BIT } );
-			needsTransfer = true;
+	for ( auto const &u : manager->uploads ) {
+		if ( u.resource_idx != previous_resource_idx ) {
+			rp.useImageResource( manager->resources[ u.resource_idx ].image_handle, { LE_IMAGE_USAGE_TRANSFER_DST_BIT } );
+			previous_resource_idx = u.resource_idx;
 		}
 	}
 
-	return needsTransfer;
+	return true;
 }
 
 // ----------------------------------------------------------------------
@@ -72,53 +141,267 @@ static void execTransferPass( le_command_buffer_encoder_o *pEncoder, void *user_
 	// we will probably end up with a number of write operations which will all target the same image resource,
 	// but will write into different aspects of memory associated with the resource.
 
-	// First figure out whether we must write to an image at all
-
 	using namespace le_pixels;
 
-	for ( auto &r : manager->resources ) {
+	for ( auto const &u : manager->uploads ) {
+
+		auto &r     = manager->resources[ u.resource_idx ];
+		auto &layer = r.image_layers[ u.layer_idx ];
+
+		if ( layer.state != le_resource_manager_o::LayerState::eReady ) {
+			// layer may have been flagged for reload since it was scheduled for upload.
+			continue;
+		}
+
+		// --------| invariant: layer has pixels which were not yet uploaded.
+
+		// We only write the base mip level - if the image has more than one mip level,
+		// the backend generates the remaining mip chain by successively blitting from
+		// the base mip level on the GPU.
+
+		le_write_to_image_settings_t write_info =
+		    le::WriteToImageSettingsBuilder()
+		        .setDstMiplevel( 0 )
+		        .setNumMiplevels( r.image_info.image.mipLevels )
+		        .setArrayLayer( u.layer_idx ) // faces are indexed: +x, -x, +y, -y, +z, -z
+		        .setImageH( r.image_info.image.extent.height )
+		        .setImageW( r.image_info.image.extent.width )
+		        .setImageD( r.image_info.image.extent.depth )
+		        .build();
+
+		auto     info      = le_pixels_i.get_info( layer.pixels );
+		uint32_t num_bytes = info.byte_count; // TODO: make sure to get correct byte count for compressed image.
+		void *   bytes     = le_pixels_i.get_data( layer.pixels );
+
+		encoder.writeToImage( r.image_handle, write_info, bytes, num_bytes );
+
+		// writeToImage copies pixel data into a staging buffer - which means we may
+		// release our copy of the pixels right away.
+
+		le_pixels_i.destroy( layer.pixels );
+		layer.pixels = nullptr;
+		layer.state  = le_resource_manager_o::LayerState::eUploaded;
+	}
+
+	manager->uploads.clear();
+}
 
-		uint32_t const num_layers     = uint32_t( r.image_layers.size() );
-		uint32_t const image_width    = r.image_info.image.extent.width;
-		uint32_t const image_height   = r.image_info.image.extent.height;
-		uint32_t const image_depth    = r.image_info.image.extent.depth;
-		uint32_t const num_mip_levels = r.image_info.image.mipLevels;
+// ----------------------------------------------------------------------
+
+static void decode_request_run( le_resource_manager_o::decode_request_t *request ) {
+	request->result = le_pixels::le_pixels_i.create( request->path.c_str(), request->num_channels, request->pixels_type );
+	request->batch->num_pending.fetch_sub( 1, std::memory_order_release );
+}
+
+// ----------------------------------------------------------------------
+// Move decoded pixels from any completed decode batches into their layers.
+static void resource_manager_collect_decoded( le_resource_manager_o *self ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+	using State        = le_resource_manager_o::LayerState;
+
+	for ( auto it = self->decode_batches.begin(); it != self->decode_batches.end(); ) {
+
+		auto batch = *it;
+
+		if ( batch->num_pending.load( std::memory_order_acquire ) != 0 ) {
+			it++;
+			continue;
+		}
 
-		for ( uint32_t layer = 0; layer != num_layers; layer++ ) {
+		// --------| invariant: all requests in this batch have completed
 
-			// we can fill in the correct handling for mutliple mip levels later.
-			// for now, assert that there is exatcly one mip level.
-			if ( r.image_layers[ layer ].was_uploaded ) {
+#if ( LE_MT > 0 )
+		// All jobs have completed, this will not block, but frees the counter.
+		le_jobs::wait_for_counter_and_free( batch->counter, 0 );
+#endif
+
+		for ( auto &request : batch->requests ) {
+
+			auto &layer = self->resources[ request.resource_idx ].image_layers[ request.layer_idx ];
+
+			if ( layer.reload_requested ) {
+				// Source has changed since we started decoding - discard result, and decode again.
+				if ( request.result ) {
+					le_pixels::le_pixels_i.destroy( request.result );
+				}
+				layer.reload_requested = false;
+				layer.state            = State::eNeedsDecode;
 				continue;
 			}
 
-			// --------| invariant: layer was not yet uploaded.
+			if ( nullptr == request.result ) {
+				logger.error( "Could not decode image: '%s'", request.path.c_str() );
+				layer.state = State::eFailed;
+				continue;
+			}
 
-			for ( uint32_t mip_level = 0; mip_level != 1; mip_level++ ) {
+			auto info = le_pixels::le_pixels_i.get_info( request.result );
 
-				assert( mip_level == 0 && "mip level greater than 0 not implemented" );
-				uint32_t width  = image_width >> mip_level;
-				uint32_t height = image_height >> mip_level;
-				uint32_t depth  = image_depth;
+			auto const &extent = self->resources[ request.resource_idx ].image_info.image.extent;
 
-				le_write_to_image_settings_t write_info =
-				    le::WriteToImageSettingsBuilder()
-				        .setDstMiplevel( mip_level )
-				        .setNumMiplevels( num_mip_levels )
-				        .setArrayLayer( layer ) // faces are indexed: +x, -x, +y, -y, +z, -z
-				        .setImageH( height )
-				        .setImageW( width )
-				        .setImageD( depth )
-				        .build();
+			if ( info.width != extent.width || info.height != extent.height ) {
+				logger.error( "Image '%s' has extent %dx%d, but resource expects %dx%d.",
+				              request.path.c_str(), info.width, info.height, extent.width, extent.height );
+				le_pixels::le_pixels_i.destroy( request.result );
+				layer.state = State::eFailed;
+				continue;
+			}
 
-				auto     pixels    = r.image_layers[ layer ].pixels;
-				auto     info      = le_pixels_i.get_info( pixels );
-				uint32_t num_bytes = info.byte_count; // TODO: make sure to get correct byte count for mip level, or compressed image.
-				void *   bytes     = le_pixels_i.get_data( pixels );
+			layer.pixels = request.result;
+			layer.state  = State::eReady;
+		}
 
-				encoder.writeToImage( r.image_handle, write_info, bytes, num_bytes );
+		delete batch;
+		it = self->decode_batches.erase( it );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Estimate the number of bytes each layer of this resource will decode to.
+static uint64_t resource_item_estimate_layer_bytes( le_resource_manager_o::resource_item_t const &r ) {
+	return uint64_t( r.image_info.image.extent.width ) *
+	       uint64_t( r.image_info.image.extent.height ) *
+	       uint64_t( r.image_info.image.extent.depth ) *
+	       r.num_channels * ( 1u << ( uint32_t( r.pixels_type ) & 0x03 ) );
+}
+
+// ----------------------------------------------------------------------
+// Issue decode requests for layers which need decoding.
+//
+// Decoded pixels are kept in memory until they have been uploaded, and uploads
+// are limited by the upload budget - we therefore only issue as many decodes as
+// keep the bytes in flight (being decoded, or waiting for upload) within
+// LE_RESOURCE_MANAGER_DECODE_FRAMES_AHEAD times the upload budget. Remaining
+// layers get issued in later frames, as uploads retire bytes.
+//
+// If the job system is available, decoding happens on worker threads, and
+// results are collected during one of the next updates. Otherwise we decode
+// on the calling thread.
+static void resource_manager_issue_decode( le_resource_manager_o *self ) {
+
+	using State = le_resource_manager_o::LayerState;
+
+	uint64_t const max_bytes_in_flight = self->upload_budget * LE_RESOURCE_MANAGER_DECODE_FRAMES_AHEAD;
+
+	uint64_t bytes_in_flight = 0;
+
+	for ( auto const &r : self->resources ) {
+		uint64_t const layer_bytes = resource_item_estimate_layer_bytes( r );
+		for ( auto const &layer : r.image_layers ) {
+			if ( layer.state == State::eDecoding || layer.state == State::eReady ) {
+				bytes_in_flight += layer_bytes;
 			}
-			r.image_layers[ layer ].was_uploaded = true;
+		}
+	}
+
+	if ( bytes_in_flight >= max_bytes_in_flight ) {
+		return;
+	}
+
+	// --------| invariant: there is room for more decodes
+
+	auto batch = new le_resource_manager_o::decode_batch_t{};
+
+	for ( uint32_t i = 0; i != self->resources.size(); i++ ) {
+
+		auto &r = self->resources[ i ];
+
+		uint64_t const layer_bytes = resource_item_estimate_layer_bytes( r );
+
+		for ( uint32_t j = 0; j != r.image_layers.size(); j++ ) {
+
+			auto &layer = r.image_layers[ j ];
+
+			if ( layer.state != State::eNeedsDecode ) {
+				continue;
+			}
+
+			// We always admit at least one layer if nothing is in flight, so that
+			// layers which are larger than the budget still get decoded.
+			if ( bytes_in_flight != 0 && bytes_in_flight + layer_bytes > max_bytes_in_flight ) {
+				break;
+			}
+			bytes_in_flight += layer_bytes;
+
+			le_resource_manager_o::decode_request_t request{};
+			request.batch        = batch;
+			request.path         = layer.path;
+			request.num_channels = r.num_channels;
+			request.pixels_type  = r.pixels_type;
+			request.resource_idx = i;
+			request.layer_idx    = j;
+
+			batch->requests.emplace_back( std::move( request ) );
+
+			if ( layer.pixels ) {
+				// Layer may still hold pixels which were decoded but not yet uploaded
+				// before its source changed.
+				le_pixels::le_pixels_i.destroy( layer.pixels );
+				layer.pixels = nullptr;
+			}
+
+			layer.state = State::eDecoding;
+		}
+	}
+
+	if ( batch->requests.empty() ) {
+		delete batch;
+		return;
+	}
+
+	// --------| invariant: there are requests to decode
+
+	batch->num_pending = uint32_t( batch->requests.size() );
+
+#if ( LE_MT > 0 )
+	std::vector<le_jobs::job_t> jobs;
+	jobs.reserve( batch->requests.size() );
+
+	for ( auto &request : batch->requests ) {
+		jobs.push_back( { []( void *request ) { decode_request_run( static_cast<le_resource_manager_o::decode_request_t *>( request ) ); }, &request } );
+	}
+
+	le_jobs::run_jobs( jobs.data(), uint32_t( jobs.size() ), &batch->counter );
+#else
+	for ( auto &request : batch->requests ) {
+		decode_request_run( &request );
+	}
+#endif
+
+	self->decode_batches.push_back( batch );
+}
+
+// ----------------------------------------------------------------------
+// Select layers to upload with this frame, so that the number of bytes
+// uploaded per frame stays within the upload budget. We always allow at
+// least one layer, so that layers larger than the budget still get uploaded.
+static void resource_manager_schedule_uploads( le_resource_manager_o *self ) {
+
+	self->uploads.clear();
+
+	uint64_t bytes_scheduled = 0;
+
+	for ( uint32_t i = 0; i != self->resources.size(); i++ ) {
+
+		auto &r = self->resources[ i ];
+
+		for ( uint32_t j = 0; j != r.image_layers.size(); j++ ) {
+
+			auto &layer = r.image_layers[ j ];
+
+			if ( layer.state != le_resource_manager_o::LayerState::eReady ) {
+				continue;
+			}
+
+			uint64_t num_bytes = le_pixels::le_pixels_i.get_info( layer.pixels ).byte_count;
+
+			if ( !self->uploads.empty() && bytes_scheduled + num_bytes > self->upload_budget ) {
+				return;
+			}
+
+			bytes_scheduled += num_bytes;
+			self->uploads.push_back( { i, j } );
 		}
 	}
 }
@@ -128,7 +411,20 @@ static void execTransferPass( le_command_buffer_encoder_o *pEncoder, void *user_
 static void le_resource_manager_update( le_resource_manager_o *manager, le_render_module_o *module ) {
 	using namespace le_renderer;
 
-	// TODO: reload any images if you detect that their source on disk has changed.
+	// Check whether any source files have changed on disk - this will flag
+	// affected layers for reload via our file watcher callback.
+	le_file_watcher::le_file_watcher_i.poll_notifications( manager->file_watcher );
+
+	resource_manager_collect_decoded( manager );
+	resource_manager_issue_decode( manager );
+
+#if ( LE_MT == 0 )
+	// Without the job system, decoding has completed by now - we can collect
+	// results so that they are uploaded with this frame.
+	resource_manager_collect_decoded( manager );
+#endif
+
+	resource_manager_schedule_uploads( manager );
 
 	for ( auto &r : manager->resources ) {
 		render_module_i.declare_resource( module, r.image_handle, r.image_info );
@@ -143,6 +439,32 @@ static void le_resource_manager_update( le_resource_manager_o *manager, le_rende
 	render_module_i.add_renderpass( module, renderPassTransfer );
 }
 
+// ----------------------------------------------------------------------
+// Called via file watcher whenever a source image file changes on disk.
+static void le_resource_manager_file_watcher_on_callback( char const *path, void *user_data ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+	auto        self   = static_cast<le_resource_manager_o *>( user_data );
+	using State        = le_resource_manager_o::LayerState;
+
+	for ( auto &r : self->resources ) {
+		for ( auto &layer : r.image_layers ) {
+
+			if ( layer.path != path ) {
+				continue;
+			}
+
+			logger.info( "Reloading image: '%s'", path );
+
+			if ( layer.state == State::eDecoding ) {
+				layer.reload_requested = true;
+			} else {
+				layer.state = State::eNeedsDecode;
+			}
+		}
+	}
+}
+
 // ----------------------------------------------------------------------
 
 static void infer_from_le_format( le::Format const &format, uint32_t *num_channels, le_pixels_info::Type *pixels_type ) {
@@ -169,17 +491,25 @@ static void infer_from_le_format( le::Format const &format, uint32_t *num_channe
 // NOTE: You must provide an array of paths in image_paths, and the
 // array's size must match `image_info.image.arrayLayers`
 // Most meta-data about the image file is loaded via image_info
+//
+// Images are not decoded here - we only read image file headers if we
+// need to infer image extents. Decoding happens during `update`.
 static void le_resource_manager_add_item( le_resource_manager_o *       self,
                                           le_img_resource_handle const *image_handle,
                                           le_resource_info_t const *    image_info,
                                           char const *const *           image_paths ) {
 
+	static auto logger = LeLog( LOGGER_LABEL );
+
 	le_resource_manager_o::resource_item_t item{};
 
 	item.image_handle = *image_handle;
 	item.image_info   = *image_info;
 	item.image_layers.reserve( image_info->image.arrayLayers );
 
+	// we must find out the pixels type from image info format
+	infer_from_le_format( item.image_info.image.format, &item.num_channels, &item.pixels_type );
+
 	bool extents_inferred = false;
 	if ( item.image_info.image.extent.width == 0 ||
 	     item.image_info.image.extent.height == 0 ||
@@ -189,25 +519,30 @@ static void le_resource_manager_add_item( le_resource_manager_o *       self,
 
 	for ( size_t i = 0; i != item.image_info.image.arrayLayers; ++i ) {
 		le_resource_manager_o::image_data_layer_t layer_data{};
-		layer_data.path         = std::string{ image_paths[ i ] };
-		layer_data.was_uploaded = false;
-
-		// we must find out the pixels type from image info format
-		uint32_t             num_channels = 0;
-		le_pixels_info::Type pixels_type{};
-
-		infer_from_le_format( item.image_info.image.format, &num_channels, &pixels_type );
-
-		layer_data.pixels = le_pixels::le_pixels_i.create( layer_data.path.c_str(), num_channels, pixels_type );
+		layer_data.path  = std::string{ image_paths[ i ] };
+		layer_data.state = le_resource_manager_o::LayerState::eNeedsDecode;
 
 		if ( extents_inferred ) {
-			auto info                           = le_pixels::le_pixels_i.get_info( layer_data.pixels );
-			item.image_info.image.extent.depth  = std::max( item.image_info.image.extent.depth, info.depth );
-			item.image_info.image.extent.width  = std::max( item.image_info.image.extent.width, info.width );
-			item.image_info.image.extent.height = std::max( item.image_info.image.extent.height, info.height );
+			le_pixels_info info{};
+			if ( le_pixels::le_pixels_i.get_info_from_file( layer_data.path.c_str(), &info ) ) {
+				item.image_info.image.extent.depth  = std::max( item.image_info.image.extent.depth, info.depth );
+				item.image_info.image.extent.width  = std::max( item.image_info.image.extent.width, info.width );
+				item.image_info.image.extent.height = std::max( item.image_info.image.extent.height, info.height );
+			} else {
+				logger.error( "Could not read image info for file: '%s'", layer_data.path.c_str() );
+			}
+		}
+
+		// Watch source file for changes, so that we may reload the image.
+		if ( 0 == self->watch_ids.count( layer_data.path ) ) {
+			le_file_watcher_watch_settings settings;
+			settings.filePath                  = layer_data.path.c_str();
+			settings.callback_user_data        = self;
+			settings.callback_fun              = ( void ( * )( char const *, void * ) )( le_core_forward_callback( le_resource_manager_api_i->private_file_watcher_i.on_callback_addr ) );
+			self->watch_ids[ layer_data.path ] = le_file_watcher::le_file_watcher_i.add_watch( self->file_watcher, &settings );
 		}
 
-		item.image_layers.emplace_back( layer_data );
+		item.image_layers.emplace_back( std::move( layer_data ) );
 	}
 
 	assert( item.image_info.image.extent.width != 0 &&
@@ -215,13 +550,21 @@ static void le_resource_manager_add_item( le_resource_manager_o *       self,
 	        item.image_info.image.extent.depth != 0 &&
 	        "Image extents for resource are not valid." );
 
-	self->resources.emplace_back( item );
+	self->resources.emplace_back( std::move( item ) );
+}
+
+// ----------------------------------------------------------------------
+
+static void le_resource_manager_set_upload_budget( le_resource_manager_o *self, uint64_t num_bytes_per_frame ) {
+	self->upload_budget = num_bytes_per_frame;
 }
 
 // ----------------------------------------------------------------------
 
 static le_resource_manager_o *le_resource_manager_create() {
-	auto self = new le_resource_manager_o{};
+	auto self           = new le_resource_manager_o{};
+	self->upload_budget = LE_RESOURCE_MANAGER_DEFAULT_UPLOAD_BUDGET;
+	self->file_watcher  = le_file_watcher::le_file_watcher_i.create();
 	return self;
 }
 
@@ -231,6 +574,22 @@ static void le_resource_manager_destroy( le_resource_manager_o *self ) {
 
 	using namespace le_pixels;
 
+	// Wait for any decode operations which are still in flight.
+	for ( auto batch : self->decode_batches ) {
+#if ( LE_MT > 0 )
+		le_jobs::wait_for_counter_and_free( batch->counter, 0 );
+#endif
+		for ( auto &request : batch->requests ) {
+			if ( request.result ) {
+				le_pixels_i.destroy( request.result );
+			}
+		}
+		delete batch;
+	}
+	self->decode_batches.clear();
+
+	le_file_watcher::le_file_watcher_i.destroy( self->file_watcher );
+
 	for ( auto &r : self->resources ) {
 		for ( auto &l : r.image_layers ) {
 			if ( l.pixels ) {
@@ -247,8 +606,14 @@ static void le_resource_manager_destroy( le_resource_manager_o *self ) {
 LE_MODULE_REGISTER_IMPL( le_resource_manager, api ) {
 	auto &le_resource_manager_i = static_cast<le_resource_manager_api *>( api )->le_resource_manager_i;
 
-	le_resource_manager_i.create   = le_resource_manager_create;
-	le_resource_manager_i.destroy  = le_resource_manager_destroy;
-	le_resource_manager_i.update   = le_resource_manager_update;
-	le_resource_manager_i.add_item = le_resource_manager_add_item;
+	le_resource_manager_i.create            = le_resource_manager_create;
+	le_resource_manager_i.destroy           = le_resource_manager_destroy;
+	le_resource_manager_i.update            = le_resource_manager_update;
+	le_resource_manager_i.add_item          = le_resource_manager_add_item;
+	le_resource_manager_i.set_upload_budget = le_resource_manager_set_upload_budget;
+
+	// Store callback address with api so that callback gets automatically forwarded to the correct
+	// address when this module reloads : see le_core.h / callback forwarding
+	auto &i            = static_cast<le_resource_manager_api *>( api )->private_file_watcher_i;
+	i.on_callback_addr = ( void * )le_resource_manager_file_watcher_on_callback;
 }
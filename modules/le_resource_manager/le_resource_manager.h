@@ -12,6 +12,19 @@ image resources to a rendermodule.
 Once an image was uploaded, it will not be transferred again, ResourceManager
 keeps track of uploaded images.
 
+Images are decoded in the background (on worker threads if the job system is
+available), and uploaded as soon as their pixels are ready. To avoid frame
+hitches when many images become ready at once, ResourceManager uploads at most
+`upload_budget` bytes per frame (default: 64 MB) - see `set_upload_budget()`.
+Images become available to the renderer once they have been uploaded; until
+then their contents are undefined.
+
+If the image info specifies more than one mip level, ResourceManager uploads
+the base level, and the full mip chain is generated from it on the GPU.
+
+ResourceManager watches image source files: if a source file changes on disk,
+the image is decoded and uploaded again.
+
 ## Usage
 
     // In app definition:
@@ -89,9 +102,16 @@ struct le_resource_manager_api {
 		void                     ( * update    ) ( le_resource_manager_o* self, le_render_module_o* module );
         void                     ( * add_item  ) ( le_resource_manager_o* self, le_img_resource_handle const * image_handle, le_resource_info_t const * image_info, char const * const * arr_image_paths);
 
+		void                     ( * set_upload_budget ) ( le_resource_manager_o* self, uint64_t num_bytes_per_frame );
+
+	};
+
+	struct private_file_watcher_interface_t {
+		void * on_callback_addr;
 	};
 
 	le_resource_manager_interface_t       le_resource_manager_i;
+	private_file_watcher_interface_t      private_file_watcher_i;
 };
 // clang-format on
 
@@ -126,6 +146,10 @@ class LeResourceManager : NoCopy, NoMove {
 		le_resource_manager::le_resource_manager_i.add_item( self, &image_handle, &image_info, arr_image_paths );
 	}
 
+	void set_upload_budget( uint64_t num_bytes_per_frame ) {
+		le_resource_manager::le_resource_manager_i.set_upload_budget( self, num_bytes_per_frame );
+	}
+
 	operator auto() {
 		return self;
 	}
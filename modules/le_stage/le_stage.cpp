@@ -1,5 +1,6 @@
 #include "le_stage.h"
 #include "le_core.h"
+#include "le_hash_util.h"
 #include "le_log.h"
 
 #include "le_renderer.h"
@@ -7,9 +8,18 @@
 #include "le_pipeline_builder.h"
 
 #include "le_camera.h"
+#include "le_mesh.h"
 #include "le_pixels.h"
 #include "le_timebase.h"
 
+#ifndef LE_MT
+#	define LE_MT 0
+#endif
+
+#if ( LE_MT > 0 )
+#	include "le_jobs.h"
+#endif
+
 #include "3rdparty/src/spooky/SpookyV2.h"
 
 #include "string.h" // for memcpy
@@ -20,6 +30,20 @@
 #include <string>
 #include <unordered_map>
 #include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <filesystem> // for stage cache source fingerprints
+
+#ifndef _WIN32
+// On posix systems, we memory-map stage cache files.
+#	define LE_STAGE_CACHE_USE_MMAP 1
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#else
+#	define LE_STAGE_CACHE_USE_MMAP 0
+#endif
 
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE // vulkan clip space is from 0 to 1
 #define GLM_FORCE_RIGHT_HANDED      // glTF uses right handed coordinate system, and we're following its lead.
@@ -28,6 +52,7 @@
 #include "glm/ext/matrix_transform.hpp"
 #include "glm/gtx/quaternion.hpp"
 #include <glm/gtx/matrix_decompose.hpp>
+#include "glm/gtc/matrix_inverse.hpp"
 
 // It could be nice if le_mesh_o could live outside of the stage - so that
 // we could use it as a method to generate primitives for example, like spheres etc.
@@ -48,6 +73,12 @@
 static const auto     RTX_IMAGE_TARGET_HANDLE = LE_IMG_RESOURCE( "rtx_target_img" );
 static constexpr auto LOGGER_LABEL            = "le_backend";
 
+static constexpr uint32_t LE_STAGE_ANIMATION_BATCH_SIZE = 128; // number of animation channels to evaluate per job, at least
+static constexpr uint32_t LE_STAGE_ANIMATION_MAX_JOBS   = 64;  // maximum number of animation jobs in flight at any time
+static constexpr uint32_t LE_STAGE_MESHLET_MIN_TRIANGLES = 4096; // primitives with fewer triangles are always drawn whole
+static constexpr uint32_t LE_STAGE_LOD_MAX_LEVELS        = 8;    // maximum number of levels of detail per primitive, including the original
+static constexpr float    LE_STAGE_LOD_RATIO             = 0.5f; // ratio of triangles kept from one level of detail to the next
+
 // Wrappers so that we can pass data via opaque pointers across header boundaries
 
 struct glm_vec3_t {
@@ -72,6 +103,24 @@ struct stage_image_o {
 	le_resource_info_t     resource_info;
 
 	bool was_transferred;
+
+	// Only used for images which were created deferred, while decoding is pending:
+	// If source_file_path is empty, pixels get decoded from source_memory.
+	bool                 decode_pending;   // whether pixels still need to be decoded
+	std::string          source_file_path; // file to decode pixels from
+	unsigned char const *source_memory;    // non-owning, must stay valid until decoding has completed
+	size_t               source_memory_sz; //
+
+	unsigned char const *cached_pixels; // non-owning, optional: decoded pixels inside stage cache memory, used if pixels == nullptr
+};
+
+// A batch of deferred images which get decoded in parallel.
+struct le_image_decode_batch_o {
+	std::vector<stage_image_o *> images;          // non-owning
+	uint64_t                     max_round_bytes; // max number of bytes of pixels decoded in parallel in any one round, 0 means unlimited
+#if ( LE_MT > 0 )
+	le_jobs::counter_t *counter; // counter for job which drives decoding, nullptr once waited for
+#endif
 };
 
 struct le_texture_o {
@@ -85,11 +134,29 @@ struct le_buffer_o {
 	void *                 mem;    // nullptr if not owning
 	le_buf_resource_handle handle; // renderer resource handle
 	le_resource_info_t     resource_info;
-	uint32_t               size;            // number of bytes
-	bool                   was_transferred; // whether this buffer was transferred to gpu already
-	bool                   owns_mem;        // true if sole owner of memory pointed to in mem
+	uint32_t               size;              // number of bytes
+	bool                   was_transferred;   // whether this buffer was transferred to gpu already
+	bool                   owns_mem;          // true if sole owner of memory pointed to in mem
+	void ( *release_fun )( void * );          // optional, for external memory: called once mem is no longer needed
+	void *                 release_user_data; // parameter for release_fun
 };
 
+// ----------------------------------------------------------------------
+// Frees or releases memory held by buffer, depending on who owns it.
+static void le_buffer_release_mem( le_buffer_o *b ) {
+
+	if ( b->owns_mem && b->mem ) {
+		free( b->mem );
+	} else if ( b->release_fun ) {
+		b->release_fun( b->release_user_data );
+	}
+
+	b->mem               = nullptr;
+	b->owns_mem          = false;
+	b->release_fun       = nullptr;
+	b->release_user_data = nullptr;
+}
+
 struct le_buffer_view_o {
 	uint32_t            buffer_idx; // index of buffer in stage
 	uint32_t            byte_offset;
@@ -202,13 +269,27 @@ struct le_primitive_o {
 	le_resource_info_t      rtx_blas_info;
 	bool                    rtx_was_transferred;
 
+	glm::vec3 bounds_min; // object-space bounds, from position accessor min/max, only valid if has_bounds == true
+	glm::vec3 bounds_max; // object-space bounds, from position accessor min/max, only valid if has_bounds == true
+
+	std::vector<le_mesh_api::meshlet_t> meshlets;                 // clusters for culling, empty unless primitive is large, indexed, and not deformed
+	uint32_t                            meshlet_index_buffer_idx; // index into stage.buffers: uint32 indices in meshlet order, only valid if meshlets not empty
+
+	std::vector<le_mesh_api::lod_level_t> lod_levels;           // levels of detail, level 0 is the original primitive; empty unless primitive has meshlets
+	uint32_t                              lod_index_buffer_idx; // index into stage.buffers: uint32 indices for levels 1 and up, only valid if lod_levels.size() > 1
+
 	bool has_indices;
 	bool has_material;
+	bool has_bounds;
 };
 
 // has many primitives
 struct le_mesh_o {
 	std::vector<le_primitive_o> primitives;
+
+	glm::vec3 bounds_min; // union of bounds over all primitives, only valid if has_bounds == true
+	glm::vec3 bounds_max; // union of bounds over all primitives, only valid if has_bounds == true
+	bool      has_bounds; // false if any primitive has no bounds
 };
 
 struct le_node_o {
@@ -224,11 +305,14 @@ struct le_node_o {
 
 	char name[ 32 ];
 
-	bool local_transform_cached;   // whether local transform is accurate wrt local[translation|rotation|scale]
-	bool global_transform_chached; // whether global transform is current
+	bool local_transform_cached;         // whether local transform is accurate wrt local[translation|rotation|scale]
+	bool global_transform_chached;       // whether global transform is current
+	bool global_transform_updated;       // whether global transform was recalculated during most recent stage update
+	bool needs_inverse_global_transform; // whether inverse global transform is used (by camera, mesh, or skin), set by transform hierarchy
 
 	bool     has_mesh;
 	uint32_t mesh_idx;
+	uint32_t bounding_sphere_idx; // index into stage's bounding spheres, only valid if has_mesh == true
 
 	bool     has_camera;
 	uint32_t camera_idx;
@@ -236,7 +320,8 @@ struct le_node_o {
 	bool     has_light;
 	uint32_t light_idx;
 
-	struct le_skin_o *skin; // Optional, non-owning
+	struct le_skin_o *skin;                 // Optional, non-owning
+	uint32_t          joint_palette_offset; // index of first joint matrix in stage's joint palettes, only valid if skin != nullptr
 
 	// TODO: we could use the scene_bit_flags to express affinity,
 	// or whether a node should be used for raytracing for example.
@@ -251,33 +336,21 @@ struct le_skin_o {
 	std::vector<glm::mat4>   inverse_bind_matrices; // one per joint
 };
 
-struct le_keyframe_o {
-	enum class Type : uint32_t {
-		eLinear,
-		eStep,
-		eCubicSpline,
-	};
-	uint64_t             delta_ticks;       // given in units of 1/12000 seconds.
-	Type                 type;              //
-	le_num_type          num_type;          // numeric type
-	le_compound_num_type compound_num_type; // scalar, vec2, vec3, etc.
-	uint16_t             array_size;        // number of elements used, default must be 1
-	union {                                 //
-		glm::quat as_quat[ 3 ];             // used for spline       : xyzw quaternion
-		glm::vec4 as_vec4[ 3 ];             // used for spline
-		glm::vec3 as_vec3[ 3 ];             // used for spline
-		glm::vec2 as_vec2[ 3 ];             // used for spline
-		float     as_scalar[ 12 ];          // used for weights
-	} data;
-};
-
 /// A channel is a mapping from a sequence of keyframes to a node property
+///
+/// Keyframes are stored as structure of arrays: one array holds the time for
+/// each keyframe, another array holds keyframe values, tightly packed, with
+/// `key_values_stride` floats per keyframe.
 struct le_animation_channel_o {
 	uint64_t ticks_offset;   // Offset (in ticks) of first keyframe
 	uint64_t ticks_duration; // Offset (in ticks) of last keyframe, designating total duration in ticks for this channel, since keyframes are defined as: [0..n[
 	//
-	std::vector<le_keyframe_o> sampler;        // (non-owning) keyframes for this channel, their time is relative to this channel.
-	                                           //
+	std::vector<uint64_t> key_ticks;         // time for each keyframe, relative to this channel, given in units of 1/12000 seconds.
+	std::vector<float>    key_values;        // values for each keyframe, `key_values_stride` floats per keyframe
+	uint32_t              key_values_stride; // number of floats per keyframe: key_array_size * number of components per element
+	uint16_t              key_array_size;    // number of elements per keyframe, default must be 1, >1 for morph target weights, or cubic splines
+	uint32_t              key_cursor;        // index of first keyframe of interval which was most recently sampled
+	                                         //
 	le_compound_num_type target_compound_type; // numeric type for target - we keep this mostly because quaternion requires slerp rather than lerp.
 	le_node_o *          target_node;          // (non-owning) pointer to targeted node						 : how do we deal with deleted nodes?
 	void *               target_node_element;  // (non-owning) pointer to targeted node element (t, r, or s) : how do we deal with deleted nodes?
@@ -296,10 +369,17 @@ struct le_animation_o {
 
 	uint64_t ticks_offset;   // Given in ticks for first keyframe over all channels. number of ticks to wait before starting animation, default 0
 	uint64_t ticks_duration; // Given in ticks for last keyframe over all channels.  number of ticks this animation should run before resetting, default: duration of longest animation channel.
+	uint64_t ticks_current;  // Animation time for current frame, updated in le_stage_update.
 
 	std::vector<le_animation_channel_o> channels;
 };
 
+// Reference to an animation channel, used to schedule channel evaluation.
+struct le_animation_channel_ref_t {
+	uint32_t animation_idx; // index into stage.animations
+	uint32_t channel_idx;   // index into animation.channels
+};
+
 // A camera is only a camera if it is attached to a node - the same camera settings may be
 // attached to multiple nodes, therefore we name this camera_settings for lack of a better
 // name. Our interactive camera is held by a module, and that camera is called le_camera_o
@@ -363,26 +443,82 @@ struct le_scene_o {
 	std::vector<le_light_o> lights;
 };
 
+// Scene graph, flattened so that we can update global transforms without recursion.
+// Nodes are sorted topologically: a parent is always stored before any of its
+// children - this means that iterating front to back visits parents first.
+struct le_transform_hierarchy_o {
+	std::vector<le_node_o *> nodes;  // non-owning
+	std::vector<uint32_t>    parent; // index into nodes for parent of each node, LE_TRANSFORM_HIERARCHY_ROOT for root nodes
+};
+
+static constexpr uint32_t LE_TRANSFORM_HIERARCHY_ROOT = uint32_t( ~0u );
+
+// World-space bounding spheres for all nodes which have a mesh, stored as
+// structure of arrays so that we can test them against a frustum in bulk.
+// Updated once per frame in le_stage_update.
+struct le_bounding_spheres_o {
+	std::vector<float>   x;
+	std::vector<float>   y;
+	std::vector<float>   z;
+	std::vector<float>   radius;  // infinity for nodes which must never be culled
+	std::vector<uint8_t> visible; // result of most recent frustum test: 1 if visible, 0 if culled
+};
+
+// One entry per primitive to draw in the current frame. Draw items are sorted
+// so that items which share gpu state end up next to each other.
+struct le_draw_item_o {
+	le_gpso_handle        pipeline;     // non-owning
+	uint32_t              scene_idx;    // index into stage.scenes
+	uint32_t              material_idx; // index into stage.materials, ~0 if primitive has no material
+	le_primitive_o const *primitive;    // non-owning
+	le_node_o const *     node;         // non-owning
+	uint32_t              lod_level;    // index into primitive.lod_levels, 0 if primitive is drawn at full detail
+};
+
+// Per-instance data for instanced draws - this must match InstanceTransform in gltf.vert
+// and obey std140 packing rules.
+struct le_instance_transform_o {
+	glm::mat4 model_matrix;  // node global transform
+	glm::mat4 normal_matrix; // transpose(inverse(model_matrix))
+};
+
 // Owns all the data
 struct le_stage_o {
-	le_renderer_o *                     renderer;        // non-owning
-	le_timebase_o *                     timebase;        // non-owning, optional
-	std::vector<le_scene_o>             scenes;          //
-	std::vector<le_animation_o>         animations;      //
-	std::vector<le_node_o *>            nodes;           // owning
-	std::vector<le_camera_settings_o>   camera_settings; //
-	std::vector<le_mesh_o>              meshes;          //
-	std::vector<le_light_info>          lights;          //
-	std::vector<le_material_o>          materials;       //
-	std::vector<le_accessor_o>          accessors;       //
-	std::vector<le_buffer_view_o>       buffer_views;    //
-	std::vector<le_buffer_o *>          buffers;         // owning
-	std::vector<le_sampler_info_t>      samplers;        //
-	std::vector<le_buf_resource_handle> buffer_handles;  //
-	std::vector<le_texture_o>           textures;        //
-	std::vector<stage_image_o *>        images;          // owning
-	std::vector<le_img_resource_handle> image_handles;   //
-	std::vector<le_skin_o *>            skins;           // owning
+	le_renderer_o *                         renderer;                  // non-owning
+	le_timebase_o *                         timebase;                  // non-owning, optional
+	std::vector<le_scene_o>                 scenes;                    //
+	std::vector<le_animation_o>             animations;                //
+	std::vector<le_node_o *>                nodes;                     // owning
+	std::vector<le_camera_settings_o>       camera_settings;           //
+	std::vector<le_mesh_o>                  meshes;                    //
+	std::vector<le_light_info>              lights;                    //
+	std::vector<le_material_o>              materials;                 //
+	std::vector<le_accessor_o>              accessors;                 //
+	std::vector<le_buffer_view_o>           buffer_views;              //
+	std::vector<le_buffer_o *>              buffers;                   // owning
+	std::vector<le_sampler_info_t>          samplers;                  //
+	std::vector<le_buf_resource_handle>     buffer_handles;            //
+	std::vector<le_texture_o>               textures;                  //
+	std::vector<stage_image_o *>            images;                    // owning
+	std::vector<le_img_resource_handle>     image_handles;             //
+	le_image_decode_batch_o *               image_decode_batch;        // owning, optional: images currently being decoded
+	void *                                  cache_mem;                 // owning, optional: stage cache from which this stage was loaded
+	size_t                                  cache_mem_size;            // number of bytes in cache_mem
+	std::vector<le_skin_o *>                skins;                     // owning
+	le_transform_hierarchy_o                transform_hierarchy;       // flattened scene graph, rebuilt if transform_hierarchy_dirty
+	bool                                    transform_hierarchy_dirty; // whether nodes, scenes or skins were added since transform_hierarchy was last built
+	le_bounding_spheres_o                   bounding_spheres;          // one sphere per node with mesh
+	std::vector<le_draw_item_o>             draw_list;                 // scratch: rebuilt by pass_draw for every frame
+	std::vector<le_instance_transform_o>    draw_instances;            // scratch: instance transforms for current draw call
+	std::vector<uint32_t>                   visible_meshlets;          // scratch: meshlets which passed culling for current draw call
+	bool                                    cluster_culling_disabled;  // whether to draw primitives with meshlets whole
+	bool                                    cluster_cull_backfacing;   // whether to cull back-facing meshlets - off by default, as materials may be double-sided
+	float                                   lod_max_pixel_error;       // largest screen-space error in pixels allowed when selecting levels of detail, 0 disables
+	std::vector<glm::mat4>                  joint_palettes;            // joint matrices for all skinned nodes, updated once per frame
+	std::vector<glm::mat4>                  joint_normal_palettes;     // normal matrices matching joint_palettes
+	std::vector<le_animation_channel_ref_t> animation_channels;        // all animation channels, grouped by target node, rebuilt if animation_channels_dirty
+	std::vector<uint32_t>                   animation_batches;         // start index into animation_channels for each batch, followed by end index of last batch
+	bool                                    animation_channels_dirty;  // whether animations were added since animation_channels was last built
 };
 
 // clang-format off
@@ -398,26 +534,17 @@ struct le_stage_o {
 		        };
 // clang-format on
 
-/// \brief Create image by interpreting given memory as an image.
-/// \note  Image memory is decoded via stb_image.
-/// \param debug_name : (optional) name to remember the image by.
-/// \param mip_levels_: (optional) number of mip-levels to auto-generate:
-///        0 means generate the full mip chain, any other number limits
-///        the number of mip levels.
-static uint32_t le_stage_create_image_from_memory(
-    le_stage_o *         stage,
-    unsigned char const *image_file_memory,
-    uint32_t             image_file_sz,
-    char const *         debug_name,
-    uint32_t             mip_levels_ ) {
-
-	assert( image_file_memory && "must point to memory" );
-	assert( image_file_sz && "must have size > 0" );
+// ----------------------------------------------------------------------
+/// \brief Create image from pixel information, without decoding any pixels.
+/// \param header_info: pixel information as read from image file header.
+static uint32_t stage_create_image_from_info(
+    le_stage_o *          stage,
+    le_pixels_info const &header_info,
+    char const *          debug_name,
+    uint32_t              mip_levels_ ) {
 
 	assert( stage->images.size() == stage->image_handles.size() );
 
-	using namespace le_pixels;
-
 	le_img_resource_handle res = LE_IMG_RESOURCE( "" ); // force unique handle
 
 #if LE_RESOURCE_LABEL_LENGTH > 0
@@ -441,7 +568,7 @@ static uint32_t le_stage_create_image_from_memory(
 
 		// We want to find out whether this image uses a 16 bit type.
 		// further, if this image uses a single channel, we are fine with it,
-		le_pixels_i.get_info_from_memory( image_file_memory, image_file_sz, &img->info );
+		img->info = header_info;
 
 		// If image more than 1 channel, we will request 4 channels, as
 		// we cannot sample from RGB images (must be RGBA).
@@ -449,11 +576,6 @@ static uint32_t le_stage_create_image_from_memory(
 			img->info.num_channels = 4;
 		}
 
-		// update pixel information after load, since load hints/requests may have changed
-		// how image was decoded in the end.
-
-		img->pixels          = le_pixels_i.create_from_memory( image_file_memory, image_file_sz, img->info.num_channels, img->info.type );
-		img->info            = le_pixels_i.get_info( img->pixels );
 		img->handle          = res;
 		img->was_transferred = false;
 
@@ -488,6 +610,66 @@ static uint32_t le_stage_create_image_from_memory(
 	return image_handle_idx;
 }
 
+// ----------------------------------------------------------------------
+// Decode pixels for an image which was created deferred.
+// This may be called on any thread, as long as no other thread accesses the same image.
+static void stage_image_decode( stage_image_o *img ) {
+
+	if ( false == img->decode_pending ) {
+		return;
+	}
+
+	if ( !img->source_file_path.empty() ) {
+		img->pixels = le_pixels::le_pixels_i.create( img->source_file_path.c_str(), int( img->info.num_channels ), img->info.type );
+	} else {
+		img->pixels = le_pixels::le_pixels_i.create_from_memory( img->source_memory, img->source_memory_sz, int( img->info.num_channels ), img->info.type );
+	}
+
+	// update pixel information after load, since load hints/requests may have changed
+	// how image was decoded in the end.
+	if ( img->pixels ) {
+		img->info = le_pixels::le_pixels_i.get_info( img->pixels );
+	}
+
+	img->source_file_path.clear();
+	img->source_memory    = nullptr;
+	img->source_memory_sz = 0;
+	img->decode_pending   = false;
+}
+
+// ----------------------------------------------------------------------
+
+/// \brief Create image by interpreting given memory as an image.
+/// \note  Image memory is decoded via stb_image.
+/// \param debug_name : (optional) name to remember the image by.
+/// \param mip_levels_: (optional) number of mip-levels to auto-generate:
+///        0 means generate the full mip chain, any other number limits
+///        the number of mip levels.
+static uint32_t le_stage_create_image_from_memory(
+    le_stage_o *         stage,
+    unsigned char const *image_file_memory,
+    uint32_t             image_file_sz,
+    char const *         debug_name,
+    uint32_t             mip_levels_ ) {
+
+	assert( image_file_memory && "must point to memory" );
+	assert( image_file_sz && "must have size > 0" );
+
+	le_pixels_info header_info{};
+	le_pixels::le_pixels_i.get_info_from_memory( image_file_memory, image_file_sz, &header_info );
+
+	uint32_t       image_idx = stage_create_image_from_info( stage, header_info, debug_name, mip_levels_ );
+	stage_image_o *img       = stage->images[ image_idx ];
+
+	img->decode_pending   = true;
+	img->source_memory    = image_file_memory;
+	img->source_memory_sz = image_file_sz;
+
+	stage_image_decode( img );
+
+	return image_idx;
+}
+
 /// \brief create image by loading file at given filepath into memory,
 /// then handing over to `create_image_from_memory`
 static uint32_t le_stage_create_image_from_file_path( le_stage_o *stage, char const *image_file_path, char const *debug_name, uint32_t mip_levels ) {
@@ -527,6 +709,163 @@ static uint32_t le_stage_create_image_from_file_path( le_stage_o *stage, char co
 	return result;
 }
 
+// ----------------------------------------------------------------------
+/// \brief Create image from memory, but don't decode its pixels until `decode_deferred_images` is called.
+/// \note  `image_file_memory` must stay valid until `wait_for_deferred_images` returns.
+static uint32_t le_stage_create_image_from_memory_deferred( le_stage_o *stage, unsigned char const *image_file_memory, uint32_t image_file_sz, char const *debug_name, uint32_t mip_levels ) {
+
+	assert( image_file_memory && "must point to memory" );
+	assert( image_file_sz && "must have size > 0" );
+
+	le_pixels_info header_info{};
+
+	if ( false == le_pixels::le_pixels_i.get_info_from_memory( image_file_memory, image_file_sz, &header_info ) ) {
+		static auto logger = LeLog( LOGGER_LABEL );
+		logger.error( "Could not read image header from memory at address %p", image_file_memory );
+	}
+
+	uint32_t       image_idx = stage_create_image_from_info( stage, header_info, debug_name, mip_levels );
+	stage_image_o *img       = stage->images[ image_idx ];
+
+	img->decode_pending   = true;
+	img->source_memory    = image_file_memory;
+	img->source_memory_sz = image_file_sz;
+
+	return image_idx;
+}
+
+// ----------------------------------------------------------------------
+/// \brief Create image from file, but don't load or decode its pixels until `decode_deferred_images` is called.
+static uint32_t le_stage_create_image_from_file_path_deferred( le_stage_o *stage, char const *image_file_path, char const *debug_name, uint32_t mip_levels ) {
+
+	le_pixels_info header_info{};
+
+	if ( false == le_pixels::le_pixels_i.get_info_from_file( image_file_path, &header_info ) ) {
+		static auto logger = LeLog( LOGGER_LABEL );
+		logger.error( "Could not read image header from file: '%s'", image_file_path );
+	}
+
+	uint32_t       image_idx = stage_create_image_from_info( stage, header_info, debug_name, mip_levels );
+	stage_image_o *img       = stage->images[ image_idx ];
+
+	img->decode_pending   = true;
+	img->source_file_path = image_file_path;
+
+	return image_idx;
+}
+
+// ----------------------------------------------------------------------
+// Decodes all images in batch - in rounds, so that the estimated number of
+// bytes of decoded pixels in any round stays within the batch's max_round_bytes.
+// Each round decodes all its images in parallel if the job system is available.
+//
+// Note that this limits concurrency, not memory: pixels decoded in earlier rounds
+// stay resident until the stage uploads them.
+static void image_decode_batch_run( le_image_decode_batch_o *batch ) {
+
+	size_t const num_images = batch->images.size();
+
+#if ( LE_MT > 0 )
+	std::vector<le_jobs::job_t> jobs;
+	jobs.reserve( num_images );
+#endif
+
+	for ( size_t round_begin = 0; round_begin < num_images; ) {
+
+		// Find the end of this round: we stop before the next image would exceed
+		// max_round_bytes - but a round always contains at least one image.
+
+		size_t   round_end   = round_begin;
+		uint64_t round_bytes = 0;
+
+		for ( ; round_end != num_images; round_end++ ) {
+			le_pixels_info const &info        = batch->images[ round_end ]->info;
+			uint64_t const        image_bytes = uint64_t( info.width ) * info.height * info.depth * info.num_channels * ( 1u << ( info.type & 0x03 ) );
+
+			if ( round_end != round_begin && batch->max_round_bytes != 0 &&
+			     round_bytes + image_bytes > batch->max_round_bytes ) {
+				break;
+			}
+
+			round_bytes += image_bytes;
+		}
+
+#if ( LE_MT > 0 )
+		jobs.clear();
+
+		for ( size_t i = round_begin; i != round_end; i++ ) {
+			jobs.push_back( { []( void *img ) { stage_image_decode( static_cast<stage_image_o *>( img ) ); }, batch->images[ i ] } );
+		}
+
+		le_jobs::counter_t *counter;
+		le_jobs::run_jobs( jobs.data(), uint32_t( jobs.size() ), &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
+#else
+		for ( size_t i = round_begin; i != round_end; i++ ) {
+			stage_image_decode( batch->images[ i ] );
+		}
+#endif
+
+		round_begin = round_end;
+	}
+}
+
+// ----------------------------------------------------------------------
+/// \brief Wait until all images which are being decoded have been decoded.
+/// \note  You must call this before the stage gets updated or drawn if you called `decode_deferred_images`.
+static void le_stage_wait_for_deferred_images( le_stage_o *stage ) {
+
+	if ( nullptr == stage->image_decode_batch ) {
+		return;
+	}
+
+#if ( LE_MT > 0 )
+	if ( stage->image_decode_batch->counter ) {
+		le_jobs::wait_for_counter_and_free( stage->image_decode_batch->counter, 0 );
+		stage->image_decode_batch->counter = nullptr;
+	}
+#endif
+
+	delete stage->image_decode_batch;
+	stage->image_decode_batch = nullptr;
+}
+
+// ----------------------------------------------------------------------
+/// \brief Start decoding all images which were created deferred.
+///
+/// If the job system is available (LE_MT > 0), decoding happens on worker threads,
+/// and this method returns immediately - so that you may do other work while images
+/// are being decoded. Call `wait_for_deferred_images` to wait for decoding to complete.
+///
+/// \param max_round_bytes: (optional) max number of bytes of pixels to decode in parallel
+///        in any one round; 0 means unlimited. This limits concurrency, not memory:
+///        decoded pixels stay resident until the stage uploads them.
+static void le_stage_decode_deferred_images( le_stage_o *stage, uint64_t max_round_bytes ) {
+
+	// Only one batch may be in flight at any time.
+	le_stage_wait_for_deferred_images( stage );
+
+	auto batch             = new le_image_decode_batch_o{};
+	batch->max_round_bytes = max_round_bytes;
+
+	for ( stage_image_o *img : stage->images ) {
+		if ( img->decode_pending ) {
+			batch->images.push_back( img );
+		}
+	}
+
+	stage->image_decode_batch = batch;
+
+#if ( LE_MT > 0 )
+	// We run a single job which drives decoding - this job will in turn
+	// distribute decoding over worker threads, round by round.
+	le_jobs::job_t driver_job{ []( void *batch ) { image_decode_batch_run( static_cast<le_image_decode_batch_o *>( batch ) ); }, batch };
+	le_jobs::run_jobs( &driver_job, 1, &batch->counter );
+#else
+	image_decode_batch_run( batch );
+#endif
+}
+
 /// \brief add a sampler to stage, return index to sampler within this stage.
 ///
 static uint32_t le_stage_create_sampler( le_stage_o *stage, le_sampler_info_t const *info ) {
@@ -567,8 +906,9 @@ static uint32_t le_stage_create_texture( le_stage_o *stage, le_texture_info cons
 }
 
 /// \brief Add a buffer to stage, return index to buffer within this stage.
-///
-static uint32_t le_stage_create_buffer( le_stage_o *stage, void *mem, uint32_t sz, char const *debug_name ) {
+/// \param release_fun: if nullptr, memory gets copied into the stage, otherwise the stage
+///        refers to external memory `mem`, and calls `release_fun` once it doesn't need it anymore.
+static uint32_t stage_add_buffer( le_stage_o *stage, void *mem, uint32_t sz, char const *debug_name, void ( *release_fun )( void * ), void *release_user_data ) {
 
 	assert( mem && "must point to memory" );
 	assert( sz && "must have size > 0" );
@@ -602,9 +942,15 @@ static uint32_t le_stage_create_buffer( le_stage_o *stage, void *mem, uint32_t s
 		le_buffer_o *buffer = new le_buffer_o{};
 
 		buffer->handle = res;
-		buffer->mem    = malloc( sz );
 
-		if ( buffer->mem ) {
+		if ( release_fun ) {
+			// Refer to external memory - no copy necessary.
+			buffer->mem               = mem;
+			buffer->owns_mem          = false;
+			buffer->size              = sz;
+			buffer->release_fun       = release_fun;
+			buffer->release_user_data = release_user_data;
+		} else if ( ( buffer->mem = malloc( sz ) ) ) {
 			memcpy( buffer->mem, mem, sz );
 			buffer->owns_mem = true;
 			buffer->size     = sz;
@@ -638,6 +984,20 @@ static uint32_t le_stage_create_buffer( le_stage_o *stage, void *mem, uint32_t s
 	return buffer_handle_idx;
 }
 
+/// \brief Add a buffer to stage by copying memory, return index to buffer within this stage.
+///
+static uint32_t le_stage_create_buffer( le_stage_o *stage, void *mem, uint32_t sz, char const *debug_name ) {
+	return stage_add_buffer( stage, mem, sz, debug_name, nullptr, nullptr );
+}
+
+/// \brief Add a buffer to stage which refers to external memory without copying it, return index to buffer within this stage.
+/// \note  `mem` must stay valid until stage calls `release_fun( release_user_data )` - which
+///        happens once the buffer has been uploaded to the gpu, or when the stage gets destroyed.
+static uint32_t le_stage_create_buffer_from_external_memory( le_stage_o *stage, void *mem, uint32_t sz, char const *debug_name, void ( *release_fun )( void *user_data ), void *release_user_data ) {
+	assert( release_fun && "must specify release function for external memory" );
+	return stage_add_buffer( stage, mem, sz, debug_name, release_fun, release_user_data );
+}
+
 /// \brief add buffer view to stage, return index of added buffer view inside of stage
 static uint32_t le_stage_create_buffer_view( le_stage_o *self, le_buffer_view_info const *info ) {
 	le_buffer_view_o view{};
@@ -900,6 +1260,42 @@ static uint32_t le_stage_create_mesh( le_stage_o *self, le_mesh_info const *info
 				primitive.indices_accessor_idx = p->indices_accessor_idx;
 			}
 
+			{
+				// -- Calculate object-space bounds for this primitive from the min/max
+				// properties of its position accessor.
+				//
+				// Morph targets store position deltas - we grow bounds by the extents of
+				// these deltas, which is conservative as long as morph target weights are
+				// within [0..1]. Since attributes are sorted, the base position attribute
+				// comes before any morph target position attributes.
+
+				for ( auto const &attr : primitive.attributes ) {
+
+					if ( attr.type != le_primitive_attribute_info::Type::ePosition ) {
+						continue;
+					}
+
+					auto const &accessor = self->accessors[ attr.accessor_idx ];
+
+					if ( !accessor.has_min || !accessor.has_max ) {
+						primitive.has_bounds = false;
+						break;
+					}
+
+					glm::vec3 accessor_min{ accessor.min[ 0 ], accessor.min[ 1 ], accessor.min[ 2 ] };
+					glm::vec3 accessor_max{ accessor.max[ 0 ], accessor.max[ 1 ], accessor.max[ 2 ] };
+
+					if ( attr.morph.target.is_target ) {
+						primitive.bounds_min += glm::min( accessor_min, glm::vec3( 0 ) );
+						primitive.bounds_max += glm::max( accessor_max, glm::vec3( 0 ) );
+					} else {
+						primitive.bounds_min = accessor_min;
+						primitive.bounds_max = accessor_max;
+						primitive.has_bounds = true;
+					}
+				}
+			}
+
 			if ( p->has_material ) {
 				primitive.has_material = true;
 				primitive.material_idx = p->material_idx;
@@ -999,6 +1395,25 @@ static uint32_t le_stage_create_mesh( le_stage_o *self, le_mesh_info const *info
 		}
 	}
 
+	// -- Mesh bounds are the union of the bounds of all its primitives.
+	//    If any primitive has no bounds, the mesh has no bounds either.
+
+	mesh.has_bounds = !mesh.primitives.empty();
+
+	for ( auto const &primitive : mesh.primitives ) {
+		if ( !primitive.has_bounds ) {
+			mesh.has_bounds = false;
+			break;
+		}
+		if ( &primitive == &mesh.primitives.front() ) {
+			mesh.bounds_min = primitive.bounds_min;
+			mesh.bounds_max = primitive.bounds_max;
+		} else {
+			mesh.bounds_min = glm::min( mesh.bounds_min, primitive.bounds_min );
+			mesh.bounds_max = glm::max( mesh.bounds_max, primitive.bounds_max );
+		}
+	}
+
 	uint32_t idx = uint32_t( self->meshes.size() );
 	self->meshes.emplace_back( mesh );
 	return idx;
@@ -1066,6 +1481,8 @@ static uint32_t le_stage_create_nodes( le_stage_o *self, le_node_info const *inf
 		}
 	}
 
+	self->transform_hierarchy_dirty = true;
+
 	return idx;
 }
 
@@ -1136,10 +1553,12 @@ static void le_node_o_set_scene_bit( le_node_o *node, uint8_t bit ) {
 }
 
 // ----------------------------------------------------------------------
-// An animation sampler is a vector of keyframes. A keyframe contains a time-mapped
-// target value, together with two optional interpolation value parameters, and
-// an enum signaling the type of interpolation to apply.
-static std::vector<le_keyframe_o> le_stage_create_animation_sampler( le_stage_o *self, le_animation_sampler_info *info, LeAnimationTargetType const &target_type ) {
+// An animation sampler is a sequence of keyframes. A keyframe contains a time-mapped
+// target value, together with two optional interpolation value parameters.
+//
+// Keyframes are loaded into the channel's structure-of-arrays keyframe storage.
+// Returns the compound type of keyframe values.
+static le_compound_num_type le_stage_create_animation_sampler( le_stage_o *self, le_animation_sampler_info *info, LeAnimationTargetType const &target_type, le_animation_channel_o *channel ) {
 
 	// We must sample data from accessors and store it into keyframe so that we can
 	// apply it faster.
@@ -1158,10 +1577,7 @@ static std::vector<le_keyframe_o> le_stage_create_animation_sampler( le_stage_o
 	// Note that the interpolation type is the same for all
 	// elements within a channel.
 
-	std::vector<le_keyframe_o> keyframes;
-
-	// A le_sampler_o is a vector of keyframes
-	// we build the sampler by loading keyframe data by resolving accessors
+	// We build the sampler by loading keyframe data by resolving accessors
 
 	auto &input_accessor  = self->accessors[ info->input_accesstor_idx ];
 	auto &output_accessor = self->accessors[ info->output_accessor_idx ];
@@ -1223,56 +1639,41 @@ static std::vector<le_keyframe_o> le_stage_create_animation_sampler( le_stage_o
 	input += input_buffer_view.byte_offset;
 	output += output_buffer_view.byte_offset;
 
+	uint32_t const num_components = get_num_components( compound_type );
+
+	channel->key_array_size    = uint16_t( num_output_per_input );
+	channel->key_values_stride = num_components * num_output_per_input;
+
+	channel->key_ticks.clear();
+	channel->key_values.clear();
+	channel->key_ticks.reserve( input_accessor.count );
+	channel->key_values.reserve( size_t( input_accessor.count ) * channel->key_values_stride );
+
 	// TODO: check for overflow
 	for ( uint32_t ia = 0; ia != input_accessor.count; ia++ ) {
 		auto input_data  = input + input_accessor.byte_offset;
 		auto output_data = output + output_accessor.byte_offset;
 
-		le_keyframe_o keyframe{};
-		keyframe.compound_num_type = compound_type;
-		keyframe.num_type          = num_type;
-		keyframe.array_size        = uint16_t( num_output_per_input );
-
 		float input_time_seconds = *reinterpret_cast<float *>( input_data );
-		keyframe.delta_ticks     = uint64_t( lroundf( LE_TIME_TICKS_PER_SECOND * input_time_seconds ) );
+		channel->key_ticks.push_back( uint64_t( lroundf( LE_TIME_TICKS_PER_SECOND * input_time_seconds ) ) );
 
 		// For each element in output accessor: load data.
 		//
-		// This generalises to the case when there is just one accessor,
-		// as we assume that the 0 element of an array of type `T` within a union is at
-		// the same offset as the scalar version of type `T` within the union.
+		// Elements are stored one after another, each element taking
+		// `num_components` floats.
 		for ( uint32_t i = 0; i != num_output_per_input; i++ ) {
 
-			switch ( compound_type ) {
-			case le_compound_num_type::eScalar:
-				keyframe.data.as_scalar[ i ] = *reinterpret_cast<float *>( output_data );
-				break;
-			case le_compound_num_type::eVec2:
-				keyframe.data.as_vec2[ i ] = *reinterpret_cast<glm::vec2 *>( output_data );
-				break;
-			case le_compound_num_type::eVec3:
-				keyframe.data.as_vec3[ i ] = *reinterpret_cast<glm::vec3 *>( output_data );
-				break;
-			case le_compound_num_type::eVec4:
-				keyframe.data.as_vec4[ i ] = *reinterpret_cast<glm::vec4 *>( output_data );
-				break;
-			case le_compound_num_type::eQuat4:
-				keyframe.data.as_quat[ i ] = *reinterpret_cast<glm::quat *>( output_data );
-				break;
-			default:
-				assert( false ); //unreacahble
-			}
+			float const *element = reinterpret_cast<float *>( output_data );
+			channel->key_values.insert( channel->key_values.end(), element, element + num_components );
 
 			output_data += output_stride;
 		}
 
-		keyframes.emplace_back( keyframe );
-
 		input += input_stride;
 		output += output_stride * num_output_per_input;
 	}
 
-	return keyframes;
+	return compound_type;
 }
 
 // ----------------------------------------------------------------------
@@ -1291,7 +1692,9 @@ static uint32_t le_stage_create_animation( le_stage_o *self, le_animation_info c
 
 		assert( c->animation_sampler_idx < info->samplers_count );
 
-		channel.sampler     = le_stage_create_animation_sampler( self, info->samplers + c->animation_sampler_idx, c->animation_target_type );
+		le_compound_num_type key_compound_type =
+		    le_stage_create_animation_sampler( self, info->samplers + c->animation_sampler_idx, c->animation_target_type, &channel );
+
 		channel.target_node = self->nodes[ c->node_idx ];
 
 		switch ( c->animation_target_type ) {
@@ -1316,12 +1719,13 @@ static uint32_t le_stage_create_animation( le_stage_o *self, le_animation_info c
 			break;
 		}
 
-		if ( !channel.sampler.empty() ) {
+		if ( !channel.key_ticks.empty() ) {
 
-			assert( channel.target_compound_type == channel.sampler.front().compound_num_type );
+			assert( channel.target_compound_type == key_compound_type );
+			( void )key_compound_type;
 
-			channel.ticks_offset   = channel.sampler.front().delta_ticks;
-			channel.ticks_duration = channel.sampler.back().delta_ticks;
+			channel.ticks_offset   = channel.key_ticks.front();
+			channel.ticks_duration = channel.key_ticks.back();
 
 			// For each animation we must find out when it begins, and how long it lasts.
 			// we use this to skip over animations if they don't fall within our current
@@ -1337,6 +1741,9 @@ static uint32_t le_stage_create_animation( le_stage_o *self, le_animation_info c
 
 	uint32_t idx = uint32_t( self->animations.size() );
 	self->animations.emplace_back( animation );
+
+	self->animation_channels_dirty = true;
+
 	return idx;
 }
 
@@ -1392,6 +1799,7 @@ static uint32_t le_stage_create_skin( le_stage_o *self, le_skin_info const *info
 
 static void le_stage_node_set_skin( le_stage_o *self, uint32_t node_idx, uint32_t skin_idx ) {
 	self->nodes.at( node_idx )->skin = self->skins.at( skin_idx );
+	self->transform_hierarchy_dirty  = true;
 }
 
 // ----------------------------------------------------------------------
@@ -1414,6 +1822,8 @@ static uint32_t le_stage_create_scene( le_stage_o *self, uint32_t *node_idx, uin
 
 	self->scenes.emplace_back( scene );
 
+	self->transform_hierarchy_dirty = true;
+
 	return idx;
 }
 
@@ -1456,17 +1866,15 @@ static void pass_xfer_resources( le_command_buffer_encoder_o *encoder_, void *us
 			encoder.writeToBuffer( b->handle, 0, b->mem, b->size );
 
 			// we could possibly free mem once that's done.
-			free( b->mem );
-			b->mem             = nullptr;
-			b->owns_mem        = false;
+			le_buffer_release_mem( b );
 			b->was_transferred = true;
 		}
 	}
 
 	for ( auto &img : stage->images ) {
-		if ( !img->was_transferred && img->pixels ) {
+		if ( !img->was_transferred && ( img->pixels || img->cached_pixels ) ) {
 			using namespace le_pixels;
-			void *pix_data = le_pixels_i.get_data( img->pixels );
+			void const *pix_data = img->pixels ? le_pixels_i.get_data( img->pixels ) : img->cached_pixels;
 
 			auto write_info = le::WriteToImageSettingsBuilder()
 			                      .setImageW( img->info.width )
@@ -1476,8 +1884,11 @@ static void pass_xfer_resources( le_command_buffer_encoder_o *encoder_, void *us
 
 			encoder.writeToImage( img->handle, write_info, pix_data, img->info.byte_count );
 
-			le_pixels_i.destroy( img->pixels );
+			if ( img->pixels ) {
+				le_pixels_i.destroy( img->pixels );
+			}
 			img->pixels          = nullptr;
+			img->cached_pixels   = nullptr;
 			img->was_transferred = true;
 		}
 	}
@@ -1742,6 +2153,65 @@ static bool stage_get_camera( le_stage_o const *stage, uint32_t scene_idx, uint3
 	return true; // unreachable
 }
 
+// ----------------------------------------------------------------------
+// Extracts frustum planes in world space from a (projection * view) matrix.
+// Planes are normalised, so that dot( plane, vec4( p, 1 ) ) gives the signed
+// distance of point p to the plane, positive distances pointing inwards.
+static void frustum_planes_from_view_projection( glm::mat4 const &view_projection, glm::vec4 planes[ 6 ] ) {
+
+	// glm matrices are column-major, we transpose so that m[ i ] gives us row i.
+	glm::mat4 const m = glm::transpose( view_projection );
+
+	planes[ 0 ] = m[ 3 ] + m[ 0 ]; // left
+	planes[ 1 ] = m[ 3 ] - m[ 0 ]; // right
+	planes[ 2 ] = m[ 3 ] + m[ 1 ]; // bottom
+	planes[ 3 ] = m[ 3 ] - m[ 1 ]; // top
+	planes[ 4 ] = m[ 2 ];          // near - clip space depth is in [0..1]
+	planes[ 5 ] = m[ 3 ] - m[ 2 ]; // far
+
+	for ( size_t i = 0; i != 6; i++ ) {
+		planes[ i ] /= glm::length( glm::vec3( planes[ i ] ) );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Tests all bounding spheres against frustum planes, and stores the result
+// of each test in spheres.visible. A sphere which intersects the frustum
+// counts as visible.
+//
+// We test one plane at a time over all spheres; the inner loop is branch-free
+// and reads from contiguous arrays, so that the compiler can vectorise it,
+// testing a full SIMD register's worth of spheres per iteration.
+static void bounding_spheres_cull( le_bounding_spheres_o &spheres, glm::vec4 const planes[ 6 ] ) {
+
+	size_t const count = spheres.radius.size();
+
+	spheres.visible.resize( count );
+
+	float const *x = spheres.x.data();
+	float const *y = spheres.y.data();
+	float const *z = spheres.z.data();
+	float const *r = spheres.radius.data();
+	uint8_t *    v = spheres.visible.data();
+
+	for ( size_t i = 0; i != count; i++ ) {
+		v[ i ] = 1;
+	}
+
+	for ( size_t p = 0; p != 6; p++ ) {
+
+		float const px = planes[ p ].x;
+		float const py = planes[ p ].y;
+		float const pz = planes[ p ].z;
+		float const pw = planes[ p ].w;
+
+		for ( size_t i = 0; i != count; i++ ) {
+			float const signed_distance = px * x[ i ] + py * y[ i ] + pz * z[ i ] + pw;
+			v[ i ] &= uint8_t( signed_distance >= -r[ i ] );
+		}
+	}
+}
+
 // ----------------------------------------------------------------------
 
 static void pass_draw( le_command_buffer_encoder_o *encoder_, void *user_data ) {
@@ -1788,15 +2258,19 @@ static void pass_draw( le_command_buffer_encoder_o *encoder_, void *user_data )
 
 	struct UboMatrices {
 		glm::mat4 viewProjectionMatrix; // (projection * view) matrix
-		glm::mat4 normalMatrix;         // given in world-space, which means normalmatrix does not depend on camera, but is transpose(inverse(globalMatrix))
-		glm::mat4 modelMatrix;
-		glm::vec3 camera_position; // camera position in world space
+		glm::vec3 camera_position;      // camera position in world space
 	};
 
 	UboMatrices mvp_ubo;
 	mvp_ubo.viewProjectionMatrix = camera_projection_matrix * camera_view_matrix;
 	mvp_ubo.camera_position      = camera_in_world_space;
 
+	// -- Cull bounding spheres of all nodes with meshes against the camera frustum.
+
+	glm::vec4 frustum_planes[ 6 ];
+	frustum_planes_from_view_projection( mvp_ubo.viewProjectionMatrix, frustum_planes );
+	bounding_spheres_cull( stage->bounding_spheres, frustum_planes );
+
 	struct UboMaterialParams {
 		glm::vec4 base_color_factor{ 1, 1, 1, 1 }; // 4*4 = 16 byte alignment, which is largest alignment, and as such forms the struct's base alignment
 		float     metallic_factor{ 1 };            // 4 byte alignment, must be at mulitple of 4
@@ -1813,156 +2287,396 @@ static void pass_draw( le_command_buffer_encoder_o *encoder_, void *user_data )
 
 	UboPostProcessing post_processing_params{};
 
-	// We reserve pretty large amount of memory for joints data - so that we
-	// don't have to make allocations inside of the draw loop.
-	std::vector<glm::mat4> joints_data( 256 );
-	std::vector<glm::mat4> joints_normal_data( 256 );
+	// -- Levels of detail: we select levels so that simplification errors, projected
+	// onto the screen, stay below lod_max_pixel_error. One world unit at unit distance
+	// from the camera covers projection_scale pixels - for orthographic projections,
+	// this holds at any distance.
 
-	//if ( false )
-	for ( le_scene_o const &s : stage->scenes ) {
-		for ( le_node_o *n : stage->nodes ) {
+	bool const  is_orthographic  = camera_projection_matrix[ 3 ][ 3 ] == 1.f;
+	float const projection_scale = 0.5f * float( extents.height ) * std::abs( camera_projection_matrix[ 1 ][ 1 ] );
 
-			if ( ( n->scene_bit_flags & ( 1 << s.scene_id ) ) && n->has_mesh ) {
+	// -- Build draw list: one draw item for each primitive of each node
+	// which is visible, and which is included in a scene.
 
-				uint32_t joints_count = n->skin ? uint32_t( n->skin->joints.size() ) : 0;
+	auto &draw_list = stage->draw_list;
+	draw_list.clear();
 
-				if ( joints_count ) {
-					// Calculate joints matrices for all given joints.
-					//
-					// TODO: if skin has a skeleton, it should be possible to cache skin data -
-					// because it won't change based on what node it is associated to.
-					// A skin ideally only needs to be calculated once, and should be re-used.
-					//
-					// Q: What does GLTF specify must happen if a skin does not specify its skeleton property
-					// A: This is not really well defined.
-					//
-					glm::mat4 const &rootInv =
-					    n->skin->skeleton
-					        ? n->skin->skeleton->inverse_global_transform
-					        : n->inverse_global_transform;
-
-					for ( size_t i = 0; i != n->skin->joints.size(); i++ ) {
-						joints_data[ i ] =
-						    rootInv *
-						    n->skin->joints[ i ]->global_transform *
-						    n->skin->inverse_bind_matrices[ i ];
-					}
+	for ( uint32_t scene_idx = 0; scene_idx != uint32_t( stage->scenes.size() ); scene_idx++ ) {
 
-					// Calculate joints normals data - this is basically calculating the
-					// normal matrix for each of the world transform matrices in each joint.
-					for ( size_t i = 0; i != n->skin->joints.size(); i++ ) {
-						joints_normal_data[ i ] = transpose( inverse( joints_data[ i ] ) );
-					}
-				}
+		le_scene_o const &s = stage->scenes[ scene_idx ];
 
-				auto const &mesh = stage->meshes[ n->mesh_idx ];
-				for ( auto const &primitive : mesh.primitives ) {
+		for ( le_node_o const *n : stage->nodes ) {
 
-					if ( !primitive.pipeline_state_handle ) {
-						logger.error( "missing pipeline state object for primitive - did you call setup_pipelines on the stage after adding the mesh/primitive?" );
-						continue;
-					}
+			if ( 0 == ( n->scene_bit_flags & ( 1 << s.scene_id ) ) || !n->has_mesh ) {
+				continue;
+			}
 
-					mvp_ubo.modelMatrix  = n->global_transform;
-					mvp_ubo.normalMatrix = glm::transpose( n->inverse_global_transform );
+			if ( n->bounding_sphere_idx < stage->bounding_spheres.visible.size() &&
+			     0 == stage->bounding_spheres.visible[ n->bounding_sphere_idx ] ) {
+				continue; // node is outside of camera frustum
+			}
 
-					encoder
-					    .bindGraphicsPipeline( primitive.pipeline_state_handle )
-					    .setArgumentData( LE_ARGUMENT_NAME( "LightSSBO" ), s.lights.data(), sizeof( le_light_o ) * s.lights.size() )
-					    .setArgumentData( LE_ARGUMENT_NAME( "UboMatrices" ), &mvp_ubo, sizeof( UboMatrices ) )
-					    .setViewports( 0, 1, &viewports[ 0 ] );
+			// Distance is measured to the surface of the node's bounding sphere, and
+			// object-space errors are scaled by the node's largest scale factor.
 
-					if ( primitive.num_joints_sets && joints_count ) {
-						// we must apply joints matrices.
-						encoder.setArgumentData( LE_ARGUMENT_NAME( "UboJointMatrices" ), joints_data.data(), sizeof( glm::mat4 ) * joints_count );
-						encoder.setArgumentData( LE_ARGUMENT_NAME( "UboJointNormalMatrices" ), joints_normal_data.data(), sizeof( glm::mat4 ) * joints_count );
-					}
+			le_mesh_api::lod_select_params_t lod_params{};
 
-					if ( primitive.morph_target_count > 0 ) {
+			bool const select_lod = stage->lod_max_pixel_error > 0.f &&
+			                        n->bounding_sphere_idx < stage->bounding_spheres.radius.size() &&
+			                        stage->bounding_spheres.radius[ n->bounding_sphere_idx ] != std::numeric_limits<float>::infinity();
 
-						// This primitive has morph targets - we must upload the current weigths for the morph targets.
-						//
-						// NOTE: We upload the morph target weights tightly packed -
-						// this means the shader will receive them as vec4s, which
-						// every 4 floats (if available) grouped together into one vec4.
-						encoder.setArgumentData( LE_ARGUMENT_NAME( "UboMorphTargetWeights" ), n->morph_target_weights,
-						                         sizeof( glm::vec4 ) * ( ( primitive.morph_target_count + 3 ) / 4 ) );
-
-						if ( false ) {
-							std::ostringstream os;
-							os << "weights: " << std::dec;
-							for ( auto i = 0; i != primitive.morph_target_count; i++ ) {
-								os << std::setw( 8 ) << n->morph_target_weights[ i ] << ", ";
-							}
-							logger.info( os.str().c_str() );
-						}
-					}
+			if ( select_lod ) {
+				auto const &    spheres = stage->bounding_spheres;
+				glm::vec3 const centre{ spheres.x[ n->bounding_sphere_idx ], spheres.y[ n->bounding_sphere_idx ], spheres.z[ n->bounding_sphere_idx ] };
+				glm::mat4 const &m = n->global_transform;
 
-					if ( primitive.has_material ) {
+				lod_params.distance = is_orthographic
+				                          ? 1.f
+				                          : std::max( glm::length( centre - glm::vec3( camera_in_world_space ) ) - spheres.radius[ n->bounding_sphere_idx ], 0.f );
 
-						auto const &material = stage->materials[ primitive.material_idx ];
+				lod_params.object_scale     = std::max( { glm::length( glm::vec3( m[ 0 ] ) ),
+				                                          glm::length( glm::vec3( m[ 1 ] ) ),
+				                                          glm::length( glm::vec3( m[ 2 ] ) ) } );
+				lod_params.projection_scale = projection_scale;
+				lod_params.max_pixel_error  = stage->lod_max_pixel_error;
+			}
 
-						{
-							// bind all textures
-							uint32_t tex_id = 0;
-							for ( auto const &tex : material.texture_handles ) {
-								encoder.setArgumentTexture( LE_ARGUMENT_NAME( "src_tex_unit" ), tex, tex_id++ );
-							}
-						}
+			for ( auto const &primitive : stage->meshes[ n->mesh_idx ].primitives ) {
 
-						if ( !material.cached_texture_params.empty() ) {
-							// has cached texture parameters
-							encoder.setArgumentData( LE_ARGUMENT_NAME( "UboTextureParams" ),
-							                         material.cached_texture_params.data(),
-							                         sizeof( le_material_o::UboTextureParamsSlice ) * material.cached_texture_params.size() );
-						}
+				if ( !primitive.pipeline_state_handle ) {
+					logger.error( "missing pipeline state object for primitive - did you call setup_pipelines on the stage after adding the mesh/primitive?" );
+					continue;
+				}
 
-						if ( material.metallic_roughness ) {
-							auto &      mr         = material.metallic_roughness;
-							auto const &base_color = mr->base_color_factor;
+				le_draw_item_o item{};
+				item.pipeline     = primitive.pipeline_state_handle;
+				item.scene_idx    = scene_idx;
+				item.material_idx = primitive.has_material ? primitive.material_idx : uint32_t( ~0u );
+				item.primitive    = &primitive;
+				item.node         = n;
 
-							material_params_ubo.base_color_factor =
-							    glm::vec4( base_color[ 0 ],
-							               base_color[ 1 ],
-							               base_color[ 2 ],
-							               base_color[ 3 ] );
+				if ( select_lod && primitive.lod_levels.size() > 1 ) {
+					item.lod_level = le_mesh::le_mesh_lod_i.select_level( primitive.lod_levels.data(), primitive.lod_levels.size(), &lod_params );
+				}
 
-							material_params_ubo.metallic_factor  = mr->metallic_factor;
-							material_params_ubo.roughness_factor = mr->roughness_factor;
+				draw_list.push_back( item );
+			}
+		}
+	}
 
-							encoder.setArgumentData( LE_ARGUMENT_NAME( "UboMaterialParams" ),
-							                         &material_params_ubo, sizeof( UboMaterialParams ) );
-						}
-					}
+	// -- Sort draw list so that draw items which share state are next to each other.
+	//
+	// We sort by pipeline first, because binding a different pipeline invalidates
+	// all arguments, then by scene (which decides lights), then by material, then
+	// by vertex buffers, and finally by primitive and level of detail, so that all
+	// draw items for the same primitive at the same level of detail form a run
+	// which we may draw instanced.
+
+	std::sort( draw_list.begin(), draw_list.end(), []( le_draw_item_o const &lhs, le_draw_item_o const &rhs ) -> bool {
+		auto const &lhs_buffers = lhs.primitive->bindings_buffer_handles;
+		auto const &rhs_buffers = rhs.primitive->bindings_buffer_handles;
+
+		le_buf_resource_handle lhs_vertex_buffer = lhs_buffers.empty() ? nullptr : lhs_buffers.front();
+		le_buf_resource_handle rhs_vertex_buffer = rhs_buffers.empty() ? nullptr : rhs_buffers.front();
+
+		return ( lhs.pipeline != rhs.pipeline
+		             ? lhs.pipeline < rhs.pipeline
+		         : lhs.scene_idx != rhs.scene_idx
+		             ? lhs.scene_idx < rhs.scene_idx
+		         : lhs.material_idx != rhs.material_idx
+		             ? lhs.material_idx < rhs.material_idx
+		         : lhs_vertex_buffer != rhs_vertex_buffer
+		             ? lhs_vertex_buffer < rhs_vertex_buffer
+		         : lhs.primitive != rhs.primitive
+		             ? lhs.primitive < rhs.primitive
+		             : lhs.lod_level < rhs.lod_level );
+	} );
+
+	// A draw item may be merged with other draw items for the same primitive into
+	// an instanced draw only if the primitive does not depend on per-node data other
+	// than the node's transform - this rules out skinning, and morph targets.
+	auto is_instanceable = []( le_draw_item_o const &item ) -> bool {
+		return 0 == item.primitive->morph_target_count &&
+		       !( item.primitive->num_joints_sets && item.node->skin );
+	};
 
-					encoder.setArgumentData( LE_ARGUMENT_NAME( "UboPostProcessing" ),
-					                         &post_processing_params, sizeof( UboPostProcessing ) );
+	// -- Record draw list.
+	//
+	// We track which state is currently bound so that we only emit binds and
+	// argument updates when state actually changes between draws.
+
+	le_gpso_handle         current_pipeline     = nullptr;
+	bool                   joint_palettes_set   = false;
+	uint32_t               current_scene_idx    = uint32_t( ~0u );
+	uint32_t               current_material_idx = uint32_t( ~0u );
+	le_primitive_o const * current_vertex_input = nullptr; // primitive whose vertex buffers are currently bound
+	le_buf_resource_handle current_index_buffer = nullptr;
+	uint64_t               current_index_offset = 0;
+	le::IndexType          current_index_type   = le::IndexType::eUint16;
+	size_t                 draw_call_count      = 0;
+	size_t                 instance_count_total = 0;
+
+	auto &instances = stage->draw_instances;
+
+	for ( size_t i = 0; i != draw_list.size(); ) {
+
+		le_draw_item_o const &item      = draw_list[ i ];
+		le_primitive_o const &primitive = *item.primitive;
+		le_node_o const *     n         = item.node;
+
+		// -- Gather transforms for all draw items which we can draw as instances of this primitive.
+
+		instances.clear();
+
+		size_t j = i;
+		do {
+			le_node_o const *instance_node = draw_list[ j ].node;
+			instances.push_back( { instance_node->global_transform,
+			                       glm::transpose( instance_node->inverse_global_transform ) } );
+			j++;
+		} while ( j != draw_list.size() &&
+		          is_instanceable( item ) &&
+		          is_instanceable( draw_list[ j ] ) &&
+		          draw_list[ j ].primitive == item.primitive &&
+		          draw_list[ j ].lod_level == item.lod_level &&
+		          draw_list[ j ].scene_idx == item.scene_idx );
+
+		// ---------| invariant: draw items [i..j[ are drawn with one draw call.
+
+		if ( item.pipeline != current_pipeline ) {
+
+			encoder
+			    .bindGraphicsPipeline( item.pipeline )
+			    .setViewports( 0, 1, &viewports[ 0 ] )
+			    .setArgumentData( LE_ARGUMENT_NAME( "UboMatrices" ), &mvp_ubo, sizeof( UboMatrices ) )
+			    .setArgumentData( LE_ARGUMENT_NAME( "UboPostProcessing" ), &post_processing_params, sizeof( UboPostProcessing ) );
+
+			current_pipeline = item.pipeline;
+
+			// Binding a different pipeline resets all arguments, which means
+			// that we must set arguments again for the next draw.
+			current_scene_idx    = uint32_t( ~0u );
+			current_material_idx = uint32_t( ~0u );
+			joint_palettes_set   = false;
+		}
 
-					// ---- invariant: primitive has pipeline, bindings.
+		if ( item.scene_idx != current_scene_idx ) {
+			auto const &lights = stage->scenes[ item.scene_idx ].lights;
+			encoder.setArgumentData( LE_ARGUMENT_NAME( "LightSSBO" ), lights.data(), sizeof( le_light_o ) * lights.size() );
+			current_scene_idx = item.scene_idx;
+		}
 
-					encoder.bindVertexBuffers( 0, uint32_t( primitive.bindings_buffer_handles.size() ),
-					                           primitive.bindings_buffer_handles.data(),
-					                           primitive.bindings_buffer_offsets.data() );
+		encoder.setArgumentData( LE_ARGUMENT_NAME( "InstanceTransforms" ), instances.data(), sizeof( le_instance_transform_o ) * instances.size() );
 
-					if ( primitive.has_indices ) {
+		if ( primitive.num_joints_sets && n->skin ) {
 
-						auto &indices_accessor = stage->accessors[ primitive.indices_accessor_idx ];
-						auto &buffer_view      = stage->buffer_views[ indices_accessor.buffer_view_idx ];
-						auto &buffer           = stage->buffers[ buffer_view.buffer_idx ];
+			// Joint palettes for all skinned nodes were calculated in le_stage_update -
+			// we upload them once per pipeline, and tell each draw where its own
+			// joint matrices start via a push constant.
 
-						encoder.bindIndexBuffer( buffer->handle,
-						                         buffer_view.byte_offset,
-						                         index_type_from_num_type( indices_accessor.component_type ) );
+			if ( !joint_palettes_set ) {
+				encoder.setArgumentData( LE_ARGUMENT_NAME( "UboJointMatrices" ), stage->joint_palettes.data(), sizeof( glm::mat4 ) * stage->joint_palettes.size() );
+				encoder.setArgumentData( LE_ARGUMENT_NAME( "UboJointNormalMatrices" ), stage->joint_normal_palettes.data(), sizeof( glm::mat4 ) * stage->joint_normal_palettes.size() );
+				joint_palettes_set = true;
+			}
 
-						encoder.drawIndexed( primitive.index_count );
-					} else {
+			encoder.setPushConstantData( &n->joint_palette_offset, sizeof( uint32_t ) );
+		}
+
+		if ( primitive.morph_target_count > 0 ) {
+
+			// This primitive has morph targets - we must upload the current weigths for the morph targets.
+			//
+			// NOTE: We upload the morph target weights tightly packed -
+			// this means the shader will receive them as vec4s, which
+			// every 4 floats (if available) grouped together into one vec4.
+			encoder.setArgumentData( LE_ARGUMENT_NAME( "UboMorphTargetWeights" ), n->morph_target_weights,
+			                         sizeof( glm::vec4 ) * ( ( primitive.morph_target_count + 3 ) / 4 ) );
+
+			if ( false ) {
+				std::ostringstream os;
+				os << "weights: " << std::dec;
+				for ( auto k = 0; k != primitive.morph_target_count; k++ ) {
+					os << std::setw( 8 ) << n->morph_target_weights[ k ] << ", ";
+				}
+				logger.info( os.str().c_str() );
+			}
+		}
+
+		if ( primitive.has_material && item.material_idx != current_material_idx ) {
+
+			auto const &material = stage->materials[ primitive.material_idx ];
+
+			{
+				// bind all textures
+				uint32_t tex_id = 0;
+				for ( auto const &tex : material.texture_handles ) {
+					encoder.setArgumentTexture( LE_ARGUMENT_NAME( "src_tex_unit" ), tex, tex_id++ );
+				}
+			}
+
+			if ( !material.cached_texture_params.empty() ) {
+				// has cached texture parameters
+				encoder.setArgumentData( LE_ARGUMENT_NAME( "UboTextureParams" ),
+				                         material.cached_texture_params.data(),
+				                         sizeof( le_material_o::UboTextureParamsSlice ) * material.cached_texture_params.size() );
+			}
+
+			if ( material.metallic_roughness ) {
+				auto &      mr         = material.metallic_roughness;
+				auto const &base_color = mr->base_color_factor;
+
+				material_params_ubo.base_color_factor =
+				    glm::vec4( base_color[ 0 ],
+				               base_color[ 1 ],
+				               base_color[ 2 ],
+				               base_color[ 3 ] );
+
+				material_params_ubo.metallic_factor  = mr->metallic_factor;
+				material_params_ubo.roughness_factor = mr->roughness_factor;
+
+				encoder.setArgumentData( LE_ARGUMENT_NAME( "UboMaterialParams" ),
+				                         &material_params_ubo, sizeof( UboMaterialParams ) );
+			}
+
+			current_material_idx = item.material_idx;
+		}
+
+		// ---- invariant: primitive has pipeline, bindings.
+
+		// Vertex and index buffer bindings are not affected by pipeline binds,
+		// we only need to re-bind these if they differ from what's currently bound.
+
+		if ( current_vertex_input != &primitive &&
+		     ( nullptr == current_vertex_input ||
+		       current_vertex_input->bindings_buffer_handles != primitive.bindings_buffer_handles ||
+		       current_vertex_input->bindings_buffer_offsets != primitive.bindings_buffer_offsets ) ) {
 
-						encoder.draw( primitive.vertex_count );
+			encoder.bindVertexBuffers( 0, uint32_t( primitive.bindings_buffer_handles.size() ),
+			                           primitive.bindings_buffer_handles.data(),
+			                           primitive.bindings_buffer_offsets.data() );
+		}
+
+		current_vertex_input = &primitive;
+
+		if ( primitive.has_indices ) {
+
+			le_buf_resource_handle index_buffer;
+			uint64_t               index_offset;
+			le::IndexType          index_type;
+
+			if ( item.lod_level > 0 ) {
+				// Simplified levels of detail draw from their own index buffer.
+				index_buffer = stage->buffers[ primitive.lod_index_buffer_idx ]->handle;
+				index_offset = 0;
+				index_type   = le::IndexType::eUint32;
+			} else if ( primitive.meshlets.empty() ) {
+				auto &indices_accessor = stage->accessors[ primitive.indices_accessor_idx ];
+				auto &buffer_view      = stage->buffer_views[ indices_accessor.buffer_view_idx ];
+
+				index_buffer = stage->buffers[ buffer_view.buffer_idx ]->handle;
+				index_offset = buffer_view.byte_offset;
+				index_type   = index_type_from_num_type( indices_accessor.component_type );
+			} else {
+				// Primitives with meshlets draw from indices in meshlet order.
+				index_buffer = stage->buffers[ primitive.meshlet_index_buffer_idx ]->handle;
+				index_offset = 0;
+				index_type   = le::IndexType::eUint32;
+			}
+
+			if ( index_buffer != current_index_buffer ||
+			     index_offset != current_index_offset ||
+			     index_type != current_index_type ) {
+
+				encoder.bindIndexBuffer( index_buffer, index_offset, index_type );
+
+				current_index_buffer = index_buffer;
+				current_index_offset = index_offset;
+				current_index_type   = index_type;
+			}
+
+			if ( item.lod_level > 0 ) {
+				// The level of detail index buffer starts with level 1.
+				auto const &level = primitive.lod_levels[ item.lod_level ];
+				encoder.drawIndexed( level.index_count, uint32_t( instances.size() ), level.index_offset - primitive.lod_levels[ 1 ].index_offset );
+			} else if ( primitive.meshlets.empty() || instances.size() != 1 || stage->cluster_culling_disabled ) {
+				encoder.drawIndexed( primitive.index_count, uint32_t( instances.size() ) );
+			} else {
+
+				// -- Cull meshlets in object space: we transform frustum planes by the
+				// transpose of the node's transform, so that plane distances stay in
+				// world units, which means meshlet radii must be scaled by the node's
+				// largest scale factor.
+
+				glm::mat4 const &m = n->global_transform;
+
+				float const scale_x   = glm::length( glm::vec3( m[ 0 ] ) );
+				float const scale_y   = glm::length( glm::vec3( m[ 1 ] ) );
+				float const scale_z   = glm::length( glm::vec3( m[ 2 ] ) );
+				float const max_scale = std::max( scale_x, std::max( scale_y, scale_z ) );
+				float const min_scale = std::min( scale_x, std::min( scale_y, scale_z ) );
+
+				le_mesh_api::meshlet_cull_params_t cull_params{};
+
+				for ( size_t p = 0; p != 6; p++ ) {
+					glm::vec4 const plane = glm::transpose( m ) * frustum_planes[ p ];
+					for ( int k = 0; k != 4; k++ ) {
+						cull_params.planes[ p ][ k ] = plane[ k ];
+					}
+				}
+
+				glm::vec4 const camera_in_object_space = n->inverse_global_transform * camera_in_world_space;
+
+				cull_params.camera_position[ 0 ] = camera_in_object_space.x;
+				cull_params.camera_position[ 1 ] = camera_in_object_space.y;
+				cull_params.camera_position[ 2 ] = camera_in_object_space.z;
+				cull_params.radius_scale         = max_scale;
+
+				// Normal cones are only valid in object space if the transform keeps angles and winding.
+				cull_params.cull_backfacing = stage->cluster_cull_backfacing &&
+				                              max_scale <= min_scale * 1.001f &&
+				                              glm::determinant( glm::mat3( m ) ) > 0.f;
+
+				auto &visible_meshlets = stage->visible_meshlets;
+				visible_meshlets.resize( primitive.meshlets.size() );
+
+				size_t const num_visible =
+				    le_mesh::le_meshlets_i.cull( primitive.meshlets.data(), primitive.meshlets.size(), &cull_params, visible_meshlets.data() );
+
+				// -- Draw runs of consecutive visible meshlets - triangles of consecutive
+				// meshlets are stored back-to-back, which means we can draw each run with
+				// a single draw call.
+
+				size_t num_runs = 0;
+
+				for ( size_t k = 0; k != num_visible; num_runs++ ) {
+					auto const &first_meshlet  = primitive.meshlets[ visible_meshlets[ k ] ];
+					uint32_t    triangle_count = first_meshlet.triangle_count;
+
+					for ( k++; k != num_visible && visible_meshlets[ k ] == visible_meshlets[ k - 1 ] + 1; k++ ) {
+						triangle_count += primitive.meshlets[ visible_meshlets[ k ] ].triangle_count;
 					}
 
-				} // end for all mesh.primitives
+					encoder.drawIndexed( triangle_count * 3, 1, first_meshlet.triangle_offset * 3 );
+				}
+
+				if ( num_runs > 1 ) {
+					draw_call_count += num_runs - 1; // first run is counted with all other draws
+				}
 			}
+		} else {
+
+			encoder.draw( primitive.vertex_count, uint32_t( instances.size() ) );
 		}
+
+		draw_call_count++;
+		instance_count_total += instances.size();
+
+		i = j;
+	}
+
+	if ( /* DISABLES CODE */ ( false ) ) {
+		logger.info( "Stage draw: %zu draw items, %zu draw calls, %zu instances", draw_list.size(), draw_call_count, instance_count_total );
 	}
 }
 
@@ -2155,6 +2869,167 @@ static void le_stage_draw_into_render_module( le_stage_api::draw_params_t *draw_
 	render_module_i.add_renderpass( module, stage_draw_pass );
 }
 
+// ----------------------------------------------------------------------
+// Builds meshlets, and levels of detail for all primitives which are large
+// enough to benefit from cluster culling. Meshlets are only built for primitives
+// which are indexed, and not deformed by morph targets, or skinning, as their
+// object-space bounds must stay valid.
+//
+// Each such primitive receives an additional index buffer which holds its
+// triangles in meshlet order, so that any run of consecutive visible meshlets
+// may be drawn with a single indexed draw call - and, if levels of detail are
+// enabled, another index buffer which holds all its simplified levels of detail
+// back-to-back.
+static void stage_build_meshlets_and_lods( le_stage_o *stage ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	using namespace le_mesh;
+
+	le_meshlets_o *meshlets = le_meshlets_i.create();
+	le_mesh_lod_o *lod      = le_mesh_lod_i.create();
+
+	std::vector<uint32_t> indices;
+	size_t                num_meshlets_total   = 0;
+	size_t                num_lod_levels_total = 0;
+
+	for ( auto &mesh : stage->meshes ) {
+		for ( auto &primitive : mesh.primitives ) {
+
+			if ( !primitive.meshlets.empty() ||
+			     !primitive.has_indices ||
+			     primitive.morph_target_count > 0 ||
+			     primitive.num_joints_sets > 0 ||
+			     primitive.attributes.empty() ) {
+				continue;
+			}
+
+			auto const &index_accessor = stage->accessors[ primitive.indices_accessor_idx ];
+
+			if ( index_accessor.count / 3 < LE_STAGE_MESHLET_MIN_TRIANGLES ) {
+				continue;
+			}
+
+			// Attributes are sorted by type, which means that position comes first.
+			auto const &position_attribute = primitive.attributes.front();
+			auto const &position_accessor  = stage->accessors[ position_attribute.accessor_idx ];
+
+			if ( position_attribute.type != le_primitive_attribute_info::Type::ePosition ||
+			     position_accessor.component_type != le_num_type::eF32 ||
+			     position_accessor.type != le_compound_num_type::eVec3 ) {
+				continue;
+			}
+
+			auto const &position_view   = stage->buffer_views[ position_accessor.buffer_view_idx ];
+			auto const &position_buffer = stage->buffers[ position_view.buffer_idx ];
+			auto const &index_view      = stage->buffer_views[ index_accessor.buffer_view_idx ];
+			auto const &index_buffer    = stage->buffers[ index_view.buffer_idx ];
+
+			if ( nullptr == position_buffer->mem || nullptr == index_buffer->mem ) {
+				continue; // buffer memory was already released after upload
+			}
+
+			// --------| invariant: positions and indices are available in memory
+
+			float const *positions = reinterpret_cast<float const *>(
+			    static_cast<char const *>( position_buffer->mem ) + position_view.byte_offset + position_accessor.byte_offset );
+
+			uint32_t const position_stride = position_view.byte_stride ? position_view.byte_stride : uint32_t( sizeof( float ) * 3 );
+
+			// -- Convert indices to uint32
+
+			char const *index_data = static_cast<char const *>( index_buffer->mem ) + index_view.byte_offset + index_accessor.byte_offset;
+
+			indices.resize( index_accessor.count );
+
+			for ( uint32_t i = 0; i != index_accessor.count; i++ ) {
+				switch ( index_accessor.component_type ) {
+				case le_num_type::eU8:
+					indices[ i ] = reinterpret_cast<uint8_t const *>( index_data )[ i ];
+					break;
+				case le_num_type::eU16:
+					indices[ i ] = reinterpret_cast<uint16_t const *>( index_data )[ i ];
+					break;
+				case le_num_type::eU32:
+					indices[ i ] = reinterpret_cast<uint32_t const *>( index_data )[ i ];
+					break;
+				default:
+					assert( false && "invalid index type" );
+				}
+			}
+
+			le_meshlets_i.build( meshlets, positions, position_stride, position_accessor.count,
+			                     indices.data(), indices.size(),
+			                     le_mesh_api::MESHLET_MAX_VERTICES, le_mesh_api::MESHLET_MAX_TRIANGLES );
+
+			le_mesh_api::meshlet_t const *meshlets_data         = nullptr;
+			size_t                        meshlets_count        = 0;
+			uint32_t const *              meshlet_indices       = nullptr;
+			size_t                        meshlet_indices_count = 0;
+
+			le_meshlets_i.get_meshlets( meshlets, meshlets_count, &meshlets_data );
+			le_meshlets_i.get_indices( meshlets, meshlet_indices_count, &meshlet_indices );
+
+			if ( meshlets_count == 0 ) {
+				continue; // indices were invalid
+			}
+
+			primitive.meshlets.assign( meshlets_data, meshlets_data + meshlets_count );
+			primitive.meshlet_index_buffer_idx =
+			    stage_add_buffer( stage, const_cast<uint32_t *>( meshlet_indices ), uint32_t( meshlet_indices_count * sizeof( uint32_t ) ),
+			                      "meshlet_indices", nullptr, nullptr );
+
+			num_meshlets_total += meshlets_count;
+
+			// -- Build levels of detail - these share the primitive's vertex buffers.
+
+			if ( stage->lod_max_pixel_error <= 0.f ) {
+				continue; // levels of detail are disabled
+			}
+
+			le_mesh_lod_i.build( lod, positions, position_stride, position_accessor.count,
+			                     indices.data(), indices.size(),
+			                     LE_STAGE_LOD_MAX_LEVELS, LE_STAGE_LOD_RATIO );
+
+			le_mesh_api::lod_level_t const *lod_levels        = nullptr;
+			size_t                          lod_levels_count  = 0;
+			uint32_t const *                lod_indices       = nullptr;
+			size_t                          lod_indices_count = 0;
+
+			le_mesh_lod_i.get_levels( lod, lod_levels_count, &lod_levels );
+			le_mesh_lod_i.get_indices( lod, lod_indices_count, &lod_indices );
+
+			if ( lod_levels_count < 2 ) {
+				continue; // primitive could not be simplified
+			}
+
+			// --------| invariant: there is at least one simplified level
+
+			// We only upload simplified levels: level 0 is drawn from the primitive's own indices.
+			uint32_t const first_simplified_index = lod_levels[ 1 ].index_offset;
+
+			primitive.lod_levels.assign( lod_levels, lod_levels + lod_levels_count );
+			primitive.lod_index_buffer_idx =
+			    stage_add_buffer( stage, const_cast<uint32_t *>( lod_indices + first_simplified_index ),
+			                      uint32_t( ( lod_indices_count - first_simplified_index ) * sizeof( uint32_t ) ),
+			                      "lod_indices", nullptr, nullptr );
+
+			num_lod_levels_total += lod_levels_count - 1;
+		}
+	}
+
+	le_mesh_lod_i.destroy( lod );
+	le_meshlets_i.destroy( meshlets );
+
+	if ( num_meshlets_total ) {
+		logger.info( "Built %zu meshlets for cluster culling", num_meshlets_total );
+	}
+
+	if ( num_lod_levels_total ) {
+		logger.info( "Built %zu simplified levels of detail", num_lod_levels_total );
+	}
+}
+
 /// \brief initialises pipeline state objects associated with each primitive
 /// \details pipeline contains materials, vertex and index binding information on each primitive.
 /// this will also cache handles for vertex and index data with each primitive.
@@ -2546,6 +3421,8 @@ static void le_stage_setup_pipelines( le_stage_o *stage ) {
 		} // end for all mesh.primitives
 	}     // end for all meshes
 
+	stage_build_meshlets_and_lods( stage );
+
 	logger.info( "Pipelines in use:" );
 	for ( auto &p : pipelineCount ) {
 		logger.info( "%x : %d", p.first, p.second );
@@ -2620,26 +3497,54 @@ void lerp_animation_target<glm::quat>( glm::quat *target, glm::quat const &val_p
 
 // ----------------------------------------------------------------------
 
-static void apply_animation_channel( le_animation_channel_o const &channel, uint64_t ticks ) {
+// Returns index of the first keyframe of the interval [key, key+1] which contains `ticks`.
+//
+// Sequential playback usually stays within the interval which was sampled most
+// recently, or advances into the next interval, which we test for first, so that
+// playback is O(1) per frame. Only if that fails - because playback looped, or
+// seeked - we fall back to a binary search over all keyframes.
+static uint32_t animation_channel_find_interval( le_animation_channel_o &channel, uint64_t ticks ) {
+
+	uint64_t const *key_ticks = channel.key_ticks.data();
+	uint32_t const  key_count = uint32_t( channel.key_ticks.size() );
 
-	if ( channel.sampler.size() < 2 ) {
-		return;
+	uint32_t cursor = channel.key_cursor;
+
+	if ( cursor + 1 < key_count &&
+	     key_ticks[ cursor ] <= ticks && ticks <= key_ticks[ cursor + 1 ] ) {
+		return cursor; // still within the same interval
 	}
 
-	// -------- invariant: sampler has at least two elements.
+	if ( cursor + 2 < key_count &&
+	     key_ticks[ cursor + 1 ] <= ticks && ticks <= key_ticks[ cursor + 2 ] ) {
+		channel.key_cursor = cursor + 1; // advanced into next interval
+		return channel.key_cursor;
+	}
+
+	// ---------| invariant: ticks is not in current, or next interval.
+
+	// Find first keyframe which comes after ticks, the keyframe before that starts our interval.
+	uint64_t const *key_after = std::upper_bound( key_ticks, key_ticks + key_count, ticks );
+
+	cursor = key_after == key_ticks ? 0 : uint32_t( key_after - key_ticks ) - 1;
+	cursor = std::min( cursor, key_count - 2 );
 
-	le_keyframe_o const *sampler_begin = channel.sampler.data();
-	le_keyframe_o const *sampler_end   = sampler_begin + channel.sampler.size();
+	channel.key_cursor = cursor;
 
-	le_keyframe_o const *previous_key = sampler_begin;
-	le_keyframe_o const *next_key     = sampler_begin + 1;
+	return cursor;
+}
+
+// ----------------------------------------------------------------------
+
+static void apply_animation_channel( le_animation_channel_o &channel, uint64_t ticks ) {
 
-	while ( ( next_key->delta_ticks < ticks ) && ( next_key + 1 != sampler_end ) ) {
-		std::swap( previous_key, next_key );
-		next_key++;
+	if ( channel.key_ticks.size() < 2 ) {
+		return;
 	}
 
-	if ( ticks > next_key->delta_ticks ) {
+	// -------- invariant: sampler has at least two elements.
+
+	if ( ticks > channel.key_ticks.back() ) {
 		// we're done here.
 
 		// TODO:
@@ -2650,48 +3555,56 @@ static void apply_animation_channel( le_animation_channel_o const &channel, uint
 		return;
 	}
 
+	uint32_t const key = animation_channel_find_interval( channel, ticks );
+
+	uint64_t const previous_key_ticks = channel.key_ticks[ key ];
+	uint64_t const next_key_ticks     = channel.key_ticks[ key + 1 ];
+
+	float const *previous_key = channel.key_values.data() + size_t( key ) * channel.key_values_stride;
+	float const *next_key     = previous_key + channel.key_values_stride;
+
 	float norm_t = 0.f; // normalised time in domain [previous_key..[next_key
 
 	// -- calculate normalised time.
 
-	norm_t = ( ticks - previous_key->delta_ticks ) /
-	         float( next_key->delta_ticks - previous_key->delta_ticks );
+	if ( ticks > previous_key_ticks && next_key_ticks > previous_key_ticks ) {
+		norm_t = ( ticks - previous_key_ticks ) /
+		         float( next_key_ticks - previous_key_ticks );
+	}
 
 	norm_t = glm::clamp( norm_t, 0.f, 1.f );
 
 	// apply data to node pointed in channel, based on type.
 
-	assert( previous_key->array_size == next_key->array_size && "keys must have same array size" );
-
 	switch ( channel.target_compound_type ) {
 	case ( le_compound_num_type::eScalar ): {
-		for ( size_t i = 0; i != previous_key->array_size; i++ ) {
+		for ( size_t i = 0; i != channel.key_array_size; i++ ) {
 			// If more than one scalar element, this most likely means that
 			// we're updating weights.
 			lerp_animation_target<float>( static_cast<float *>( channel.target_node_element ) + i,
-			                              previous_key->data.as_scalar[ i ], next_key->data.as_scalar[ i ], norm_t );
+			                              previous_key[ i ], next_key[ i ], norm_t );
 		}
 		break;
 	}
 	case ( le_compound_num_type::eVec2 ): {
 		lerp_animation_target<glm::vec2>( static_cast<glm::vec2 *>( channel.target_node_element ),
-		                                  previous_key->data.as_vec2[ 0 ], next_key->data.as_vec2[ 0 ], norm_t );
+		                                  *reinterpret_cast<glm::vec2 const *>( previous_key ), *reinterpret_cast<glm::vec2 const *>( next_key ), norm_t );
 		break;
 	}
 	case ( le_compound_num_type::eVec3 ): {
 		lerp_animation_target<glm::vec3>( static_cast<glm::vec3 *>( channel.target_node_element ),
-		                                  previous_key->data.as_vec3[ 0 ], next_key->data.as_vec3[ 0 ], norm_t );
+		                                  *reinterpret_cast<glm::vec3 const *>( previous_key ), *reinterpret_cast<glm::vec3 const *>( next_key ), norm_t );
 		break;
 	}
 	case ( le_compound_num_type::eVec4 ): {
 		lerp_animation_target<glm::vec4>( static_cast<glm::vec4 *>( channel.target_node_element ),
-		                                  previous_key->data.as_vec4[ 0 ], next_key->data.as_vec4[ 0 ], norm_t );
+		                                  *reinterpret_cast<glm::vec4 const *>( previous_key ), *reinterpret_cast<glm::vec4 const *>( next_key ), norm_t );
 		break;
 	}
 	case ( le_compound_num_type::eQuat4 ): {
 		// note that we distinguish between quat and vec, because interpolation type is different
 		lerp_animation_target<glm::quat>( static_cast<glm::quat *>( channel.target_node_element ),
-		                                  previous_key->data.as_quat[ 0 ], next_key->data.as_quat[ 0 ], norm_t );
+		                                  *reinterpret_cast<glm::quat const *>( previous_key ), *reinterpret_cast<glm::quat const *>( next_key ), norm_t );
 		break;
 	}
 	default:
@@ -2702,13 +3615,166 @@ static void apply_animation_channel( le_animation_channel_o const &channel, uint
 }
 
 // ----------------------------------------------------------------------
+// Groups all animation channels by their target node, and splits them into
+// batches, so that all channels which write to the same node end up in the
+// same batch. This means that batches may be evaluated in parallel without
+// any two batches ever writing to the same node.
+static void stage_build_animation_batches( le_stage_o *self ) {
+
+	auto &channels = self->animation_channels;
+	auto &batches  = self->animation_batches;
+
+	channels.clear();
+	batches.clear();
+
+	for ( uint32_t a = 0; a != uint32_t( self->animations.size() ); a++ ) {
+		for ( uint32_t c = 0; c != uint32_t( self->animations[ a ].channels.size() ); c++ ) {
+			channels.push_back( { a, c } );
+		}
+	}
+
+	auto target_node = [ self ]( le_animation_channel_ref_t const &ref ) -> le_node_o const * {
+		return self->animations[ ref.animation_idx ].channels[ ref.channel_idx ].target_node;
+	};
+
+	// Stable sort, so that channels which target the same node keep the
+	// order in which they were evaluated before.
+	std::stable_sort( channels.begin(), channels.end(),
+	                  [ & ]( le_animation_channel_ref_t const &lhs, le_animation_channel_ref_t const &rhs ) -> bool {
+		                  return std::less<le_node_o const *>()( target_node( lhs ), target_node( rhs ) );
+	                  } );
+
+	uint32_t const channels_count = uint32_t( channels.size() );
+
+	for ( uint32_t batch_begin = 0; batch_begin < channels_count; ) {
+
+		batches.push_back( batch_begin );
+
+		uint32_t batch_end = std::min( batch_begin + LE_STAGE_ANIMATION_BATCH_SIZE, channels_count );
+
+		// Extend batch until target node changes
+		while ( batch_end < channels_count &&
+		        target_node( channels[ batch_end ] ) == target_node( channels[ batch_end - 1 ] ) ) {
+			batch_end++;
+		}
+
+		batch_begin = batch_end;
+	}
+
+	batches.push_back( channels_count ); // end marker for last batch
+
+	self->animation_channels_dirty = false;
+}
+
+// ----------------------------------------------------------------------
+
+static void stage_evaluate_animation_batch( le_stage_o *self, uint32_t batch_idx ) {
+
+	uint32_t const begin = self->animation_batches[ batch_idx ];
+	uint32_t const end   = self->animation_batches[ batch_idx + 1 ];
+
+	for ( uint32_t i = begin; i != end; i++ ) {
+		le_animation_channel_ref_t const &ref       = self->animation_channels[ i ];
+		le_animation_o &                  animation = self->animations[ ref.animation_idx ];
+		apply_animation_channel( animation.channels[ ref.channel_idx ], animation.ticks_current );
+	}
+}
+
+// ----------------------------------------------------------------------
+
+// Flattens scene graph into stage's transform hierarchy, starting with the root
+// nodes of each scene. Nodes which are reachable via more than one path are
+// only added once - for the first path by which they are reached.
+static void stage_build_transform_hierarchy( le_stage_o *self ) {
+
+	auto &hierarchy = self->transform_hierarchy;
+
+	hierarchy.nodes.clear();
+	hierarchy.parent.clear();
+
+	for ( le_node_o *n : self->nodes ) {
+		n->needs_inverse_global_transform = n->has_camera || n->has_mesh;
+		n->global_transform_chached       = false; // force recalculation of global transforms
+	}
+
+	for ( le_skin_o *skin : self->skins ) {
+		if ( skin->skeleton ) {
+			skin->skeleton->needs_inverse_global_transform = true;
+		}
+	}
+
+	std::unordered_map<le_node_o const *, uint32_t> node_indices;
+
+	for ( le_scene_o const &s : self->scenes ) {
+		for ( le_node_o *root : s.root_nodes ) {
+
+			if ( false == node_indices.emplace( root, uint32_t( hierarchy.nodes.size() ) ).second ) {
+				continue;
+			}
+
+			// Breadth-first: each node's children get appended to the end of the
+			// array, which means they will always be placed after their parent.
+
+			size_t i = hierarchy.nodes.size();
+
+			hierarchy.nodes.push_back( root );
+			hierarchy.parent.push_back( LE_TRANSFORM_HIERARCHY_ROOT );
+
+			for ( ; i != hierarchy.nodes.size(); i++ ) {
+				for ( le_node_o *c : hierarchy.nodes[ i ]->children ) {
+					if ( node_indices.emplace( c, uint32_t( hierarchy.nodes.size() ) ).second ) {
+						hierarchy.nodes.push_back( c );
+						hierarchy.parent.push_back( uint32_t( i ) );
+					}
+				}
+			}
+		}
+	}
+
+	self->transform_hierarchy_dirty = false;
+}
+
+// ----------------------------------------------------------------------
+// Recalculates global transforms for all nodes in the transform hierarchy which
+// are out of date - either because their local transform has changed, or
+// because the global transform of one of their ancestors has changed.
+static void stage_update_global_transforms( le_stage_o *self ) {
+
+	auto &hierarchy = self->transform_hierarchy;
+
+	size_t const      num_nodes = hierarchy.nodes.size();
+	le_node_o *const *nodes     = hierarchy.nodes.data();
+	uint32_t const *  parents   = hierarchy.parent.data();
+
+	for ( size_t i = 0; i != num_nodes; i++ ) {
+
+		le_node_o *n = nodes[ i ];
+
+		// Since parents are stored before their children, the parent's flag
+		// for this frame has already been set by the time we get here.
+		bool const parent_updated =
+		    parents[ i ] != LE_TRANSFORM_HIERARCHY_ROOT &&
+		    nodes[ parents[ i ] ]->global_transform_updated;
+
+		n->global_transform_updated = parent_updated || false == n->global_transform_chached;
+
+		if ( false == n->global_transform_updated ) {
+			continue;
+		}
+
+		if ( parents[ i ] == LE_TRANSFORM_HIERARCHY_ROOT ) {
+			n->global_transform = n->local_transform;
+		} else {
+			n->global_transform = nodes[ parents[ i ] ]->global_transform * n->local_transform;
+		}
 
-static void traverse_node( le_node_o *parent ) {
-	for ( le_node_o *c : parent->children ) {
-		c->global_transform         = parent->global_transform * c->local_transform;
-		c->inverse_global_transform = glm::inverse( c->global_transform );
-		traverse_node( c );
-		c->global_transform_chached = true;
+		if ( n->needs_inverse_global_transform ) {
+			// Node transforms are composed of translation, rotation, and scale only,
+			// which means they are affine, and we can use the cheaper affine inverse.
+			n->inverse_global_transform = glm::affineInverse( n->global_transform );
+		}
+
+		n->global_transform_chached = true;
 	}
 }
 
@@ -2726,9 +3792,9 @@ static void le_stage_update( le_stage_o *self ) {
 		uint64_t current_ticks = le_timebase_i.get_current_ticks( self->timebase );
 
 		if ( !self->animations.empty() ) {
-			// for each animation: find current keyframe
+			// for each animation: find current animation time
 
-			for ( auto const &a : self->animations ) {
+			for ( auto &a : self->animations ) {
 
 				uint64_t animation_time = current_ticks - a.ticks_offset;
 
@@ -2740,19 +3806,64 @@ static void le_stage_update( le_stage_o *self ) {
 				case le_animation_o::PlaybackMode::eForward:
 					break;
 				case le_animation_o::PlaybackMode::eLoop:
-					animation_time = ( animation_time ) % a.ticks_duration;
+					animation_time = a.ticks_duration ? ( animation_time ) % a.ticks_duration : 0;
 					break;
 				case le_animation_o::PlaybackMode::eBounce:
 					animation_time = a.ticks_duration - ( animation_time % ( 2 * a.ticks_duration ) - a.ticks_duration );
 					break;
 				}
 
-				for ( auto const &c : a.channels ) {
-					apply_animation_channel( c, animation_time );
-				}
+				a.ticks_current = animation_time;
+			}
+
+			// apply keyframe values to nodes.
+
+			if ( self->animation_channels_dirty ) {
+				stage_build_animation_batches( self );
 			}
 
-			// apply keyframe value to node.
+			uint32_t const batches_count = uint32_t( self->animation_batches.size() ) - 1;
+
+#if ( LE_MT > 0 )
+			if ( batches_count > 1 ) {
+
+				// Batches never share target nodes, which means that we can
+				// evaluate them in parallel. We submit at most LE_STAGE_ANIMATION_MAX_JOBS
+				// batches at a time so that we don't have to allocate job parameters.
+
+				struct batch_params_t {
+					le_stage_o *stage;
+					uint32_t    batch_idx;
+				};
+
+				auto evaluate_batch_fun = []( void *param_ ) {
+					auto p = static_cast<batch_params_t *>( param_ );
+					stage_evaluate_animation_batch( p->stage, p->batch_idx );
+				};
+
+				batch_params_t params[ LE_STAGE_ANIMATION_MAX_JOBS ];
+				le_jobs::job_t jobs[ LE_STAGE_ANIMATION_MAX_JOBS ];
+
+				for ( uint32_t first_batch = 0; first_batch < batches_count; first_batch += LE_STAGE_ANIMATION_MAX_JOBS ) {
+
+					uint32_t const jobs_count = std::min<uint32_t>( LE_STAGE_ANIMATION_MAX_JOBS, batches_count - first_batch );
+
+					for ( uint32_t i = 0; i != jobs_count; i++ ) {
+						params[ i ] = { self, first_batch + i };
+						jobs[ i ]   = { evaluate_batch_fun, &params[ i ] };
+					}
+
+					le_jobs::counter_t *counter;
+					le_jobs::run_jobs( jobs, jobs_count, &counter );
+					le_jobs::wait_for_counter_and_free( counter, 0 );
+				}
+			} else
+#endif
+			{
+				for ( uint32_t i = 0; i != batches_count; i++ ) {
+					stage_evaluate_animation_batch( self, i );
+				}
+			}
 		}
 	}
 
@@ -2769,33 +3880,147 @@ static void le_stage_update( le_stage_o *self ) {
 
 			n->local_transform = m;
 
-			n->local_transform_cached = true;
+			n->local_transform_cached   = true;
+			n->global_transform_chached = false;
 		}
 	}
 
 	// -- Update global transform matrices.
-	// -- while we are at it, we also calculate inverse global transforms.
-	// -- recurse over nodes, starting with root nodes of scene.
-
-	for ( le_scene_o const &s : self->scenes ) {
-		for ( le_node_o *n : s.root_nodes ) {
-			n->global_transform         = n->local_transform;
-			n->inverse_global_transform = glm::inverse( n->global_transform );
-			traverse_node( n );
-		}
-	}
+	// -- while we are at it, we also calculate inverse global transforms,
+	// -- but only for nodes which need them.
+	// -- only nodes which changed, or whose ancestors changed, are updated.
 
-	// -- Update all lights.
-	// -- TODO: it would be nice to have a way to cache this, so that only lights
-	// which have changed need updating.
+	bool const hierarchy_rebuilt = self->transform_hierarchy_dirty;
 
-	for ( auto &s : self->scenes ) {
-		s.lights.clear();
+	if ( hierarchy_rebuilt ) {
+		stage_build_transform_hierarchy( self );
 	}
 
-	size_t num_scenes = self->scenes.size();
+	stage_update_global_transforms( self );
 
-	for ( auto const &n : self->nodes ) {
+	// -- Update world-space bounding spheres for all nodes which have a mesh,
+	// and whose global transform has changed.
+	//
+	// Skinned nodes, and nodes whose mesh has no bounds, receive an infinite
+	// radius, so that they always pass the frustum test: joints may move
+	// vertices arbitrarily far away from their object-space bounds.
+
+	{
+		auto &spheres = self->bounding_spheres;
+
+		if ( hierarchy_rebuilt ) {
+
+			// Re-assign sphere indices, and force an update for all spheres.
+
+			uint32_t num_spheres = 0;
+
+			for ( le_node_o *n : self->nodes ) {
+				if ( n->has_mesh ) {
+					n->bounding_sphere_idx = num_spheres++;
+				}
+			}
+
+			spheres.x.resize( num_spheres );
+			spheres.y.resize( num_spheres );
+			spheres.z.resize( num_spheres );
+			spheres.radius.resize( num_spheres );
+		}
+
+		for ( le_node_o *n : self->nodes ) {
+
+			if ( !n->has_mesh || !( hierarchy_rebuilt || n->global_transform_updated ) ) {
+				continue;
+			}
+
+			auto const &mesh = self->meshes[ n->mesh_idx ];
+
+			glm::vec3 centre{ 0 };
+			float     radius = std::numeric_limits<float>::infinity();
+
+			if ( mesh.has_bounds && nullptr == n->skin ) {
+
+				glm::mat4 const &m = n->global_transform;
+
+				centre = m * glm::vec4( ( mesh.bounds_min + mesh.bounds_max ) * 0.5f, 1.f );
+
+				// Non-uniform scale stretches the sphere - we use the largest scale
+				// factor over all axes so that the sphere still contains the mesh.
+				float const max_scale = std::max( { glm::length( glm::vec3( m[ 0 ] ) ),
+				                                    glm::length( glm::vec3( m[ 1 ] ) ),
+				                                    glm::length( glm::vec3( m[ 2 ] ) ) } );
+
+				radius = 0.5f * glm::length( mesh.bounds_max - mesh.bounds_min ) * max_scale;
+			}
+
+			spheres.x[ n->bounding_sphere_idx ]      = centre.x;
+			spheres.y[ n->bounding_sphere_idx ]      = centre.y;
+			spheres.z[ n->bounding_sphere_idx ]      = centre.z;
+			spheres.radius[ n->bounding_sphere_idx ] = radius;
+		}
+	}
+
+	// -- Update joint palettes for all skinned nodes.
+	//
+	// Each skinned node receives a contiguous range of joint matrices inside
+	// the stage's joint palettes - these get uploaded in one go when drawing.
+	//
+	// Q: What does GLTF specify must happen if a skin does not specify its skeleton property
+	// A: This is not really well defined - we use the skinned node's transform in that case.
+
+	{
+		uint32_t palettes_size = 0;
+
+		for ( le_node_o *n : self->nodes ) {
+			if ( n->skin && n->has_mesh ) {
+				n->joint_palette_offset = palettes_size;
+				palettes_size += uint32_t( n->skin->joints.size() );
+			}
+		}
+
+		self->joint_palettes.resize( palettes_size );
+		self->joint_normal_palettes.resize( palettes_size );
+
+		for ( le_node_o const *n : self->nodes ) {
+
+			if ( nullptr == n->skin || !n->has_mesh ) {
+				continue;
+			}
+
+			le_skin_o const *skin = n->skin;
+
+			glm::mat4 const &rootInv =
+			    skin->skeleton
+			        ? skin->skeleton->inverse_global_transform
+			        : n->inverse_global_transform;
+
+			glm::mat4 *joints        = self->joint_palettes.data() + n->joint_palette_offset;
+			glm::mat4 *joint_normals = self->joint_normal_palettes.data() + n->joint_palette_offset;
+
+			size_t const joints_count = skin->joints.size();
+
+			for ( size_t i = 0; i != joints_count; i++ ) {
+				joints[ i ] =
+				    rootInv *
+				    skin->joints[ i ]->global_transform *
+				    skin->inverse_bind_matrices[ i ];
+
+				// Normal matrix for each joint matrix.
+				joint_normals[ i ] = glm::transpose( glm::affineInverse( joints[ i ] ) );
+			}
+		}
+	}
+
+	// -- Update all lights.
+	// -- TODO: it would be nice to have a way to cache this, so that only lights
+	// which have changed need updating.
+
+	for ( auto &s : self->scenes ) {
+		s.lights.clear();
+	}
+
+	size_t num_scenes = self->scenes.size();
+
+	for ( auto const &n : self->nodes ) {
 
 		if ( n->has_light ) {
 			// fetch light, calculate light value
@@ -2850,19 +4075,1029 @@ static void le_stage_update( le_stage_o *self ) {
 	}
 }
 
+// ----------------------------------------------------------------------
+// Stage cache
+//
+// A stage cache is a binary snapshot of a fully imported stage: buffers,
+// accessors, meshes, materials, nodes, skins, animations, and decoded images.
+// Loading a cache means that no assets need to be parsed or decoded - large
+// blobs (buffer data, pixels) are aligned so that the stage may refer to them
+// in-place, straight from the cache's memory mapping.
+//
+// Pipelines are not stored with the cache, as pipeline state objects are owned
+// by the renderer's pipeline cache: call `setup_pipelines` after loading a cache,
+// just as you would after importing a scene.
+
+static constexpr char     LE_STAGE_CACHE_MAGIC[ 8 ] = { 'L', 'E', 'S', 'T', 'A', 'G', 'E', '\0' };
+static constexpr uint32_t LE_STAGE_CACHE_VERSION    = 2;           // increment this whenever the cache layout changes
+static constexpr size_t   LE_STAGE_CACHE_ALIGNMENT  = 16;          // alignment for blobs within cache
+static constexpr uint32_t LE_STAGE_CACHE_NO_INDEX   = uint32_t( ~0u ); // stored in place of an index for optional references
+
+// Identifies the file a cache was created from. A cache is out of date as soon as
+// its source file is moved, or changes size or modification time. Note that only
+// the source file itself is fingerprinted - not any files it refers to, such as
+// external glTF buffers or images.
+struct le_stage_cache_source_t {
+	uint64_t path_hash;  // fnv1a hash of absolute, normalised source path
+	uint64_t byte_count; // size of source file
+	int64_t  mtime;      // last write time of source file, in ticks of the file clock
+};
+
+struct le_stage_cache_header_t {
+	char                    magic[ 8 ];        // must be LE_STAGE_CACHE_MAGIC
+	uint32_t                version;           // must be LE_STAGE_CACHE_VERSION
+	uint32_t                struct_sizes[ 8 ]; // sizes of structs which are stored verbatim - must match, otherwise cache is invalid
+	uint64_t                file_size;         // total number of bytes in cache, including header
+	le_stage_cache_source_t source;            // all zero if cache was saved without a source path
+};
+
+static void stage_cache_get_struct_sizes( uint32_t ( &sizes )[ 8 ] ) {
+	sizes[ 0 ] = uint32_t( sizeof( le_buffer_view_o ) );
+	sizes[ 1 ] = uint32_t( sizeof( le_accessor_o ) );
+	sizes[ 2 ] = uint32_t( sizeof( le_sampler_info_t ) );
+	sizes[ 3 ] = uint32_t( sizeof( le_pixels_info ) );
+	sizes[ 4 ] = uint32_t( sizeof( le_texture_view_o ) );
+	sizes[ 5 ] = uint32_t( sizeof( le_camera_settings_o ) );
+	sizes[ 6 ] = uint32_t( sizeof( le_light_info ) );
+	sizes[ 7 ] = uint32_t( sizeof( le_node_o ) );
+}
+
+// ----------------------------------------------------------------------
+// Returns false if source file could not be found.
+static bool stage_cache_get_source( char const *source_path, le_stage_cache_source_t *source ) {
+
+	std::error_code ec;
+
+	std::filesystem::path const path       = std::filesystem::absolute( source_path, ec ).lexically_normal();
+	uintmax_t const             byte_count = ec ? 0 : std::filesystem::file_size( path, ec );
+	auto const                  mtime      = ec ? std::filesystem::file_time_type{} : std::filesystem::last_write_time( path, ec );
+
+	if ( ec ) {
+		return false;
+	}
+
+	source->path_hash  = hash_64_fnv1a( path.string().c_str() );
+	source->byte_count = uint64_t( byte_count );
+	source->mtime      = int64_t( mtime.time_since_epoch().count() );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+struct stage_cache_writer_t {
+	FILE *   file;
+	uint64_t offset; // number of bytes written so far
+	bool     ok;     // false once any write has failed
+};
+
+static void cache_write_bytes( stage_cache_writer_t &w, void const *data, size_t num_bytes ) {
+	if ( num_bytes && w.ok ) {
+		w.ok = ( num_bytes == fwrite( data, 1, num_bytes, w.file ) );
+	}
+	w.offset += num_bytes;
+}
+
+static void cache_write_align( stage_cache_writer_t &w ) {
+	static constexpr char zeroes[ LE_STAGE_CACHE_ALIGNMENT ]{};
+	cache_write_bytes( w, zeroes, ( LE_STAGE_CACHE_ALIGNMENT - w.offset % LE_STAGE_CACHE_ALIGNMENT ) % LE_STAGE_CACHE_ALIGNMENT );
+}
+
+template <typename T>
+static void cache_write( stage_cache_writer_t &w, T const &value ) {
+	static_assert( std::is_trivially_copyable<T>::value, "only trivially copyable types may be stored verbatim" );
+	cache_write_bytes( w, &value, sizeof( T ) );
+}
+
+template <typename T>
+static void cache_write_vector( stage_cache_writer_t &w, std::vector<T> const &values ) {
+	static_assert( std::is_trivially_copyable<T>::value, "only trivially copyable types may be stored verbatim" );
+	cache_write( w, uint64_t( values.size() ) );
+	cache_write_bytes( w, values.data(), sizeof( T ) * values.size() );
+}
+
+static void cache_write_string( stage_cache_writer_t &w, std::string const &str ) {
+	cache_write( w, uint64_t( str.size() ) );
+	cache_write_bytes( w, str.data(), str.size() );
+}
+
+// Blobs are aligned, so that they may be referenced in-place when loading.
+static void cache_write_blob( stage_cache_writer_t &w, void const *data, uint64_t num_bytes ) {
+	cache_write( w, num_bytes );
+	cache_write_align( w );
+	cache_write_bytes( w, data, num_bytes );
+}
+
+// ----------------------------------------------------------------------
+
+struct stage_cache_reader_t {
+	char const *begin;
+	char const *pos;
+	char const *end;
+	bool        ok; // false once any read went past the end of the cache, or found invalid data
+};
+
+static void const *cache_read_bytes( stage_cache_reader_t &r, uint64_t num_bytes ) {
+	if ( !r.ok || uint64_t( r.end - r.pos ) < num_bytes ) {
+		r.ok = false;
+		return nullptr;
+	}
+	void const *result = r.pos;
+	r.pos += num_bytes;
+	return result;
+}
+
+static void cache_read_align( stage_cache_reader_t &r ) {
+	size_t offset = size_t( r.pos - r.begin );
+	cache_read_bytes( r, ( LE_STAGE_CACHE_ALIGNMENT - offset % LE_STAGE_CACHE_ALIGNMENT ) % LE_STAGE_CACHE_ALIGNMENT );
+}
+
+template <typename T>
+static T cache_read( stage_cache_reader_t &r ) {
+	static_assert( std::is_trivially_copyable<T>::value, "only trivially copyable types may be stored verbatim" );
+	T value{};
+	if ( void const *src = cache_read_bytes( r, sizeof( T ) ) ) {
+		memcpy( &value, src, sizeof( T ) );
+	}
+	return value;
+}
+
+template <typename T, size_t N>
+static void cache_read_array( stage_cache_reader_t &r, T ( &values )[ N ] ) {
+	static_assert( std::is_trivially_copyable<T>::value, "only trivially copyable types may be stored verbatim" );
+	if ( void const *src = cache_read_bytes( r, sizeof( values ) ) ) {
+		memcpy( values, src, sizeof( values ) );
+	}
+}
+
+// Reads a number of elements, and checks that the cache may actually contain
+// this many elements, assuming each element takes up at least `min_element_size` bytes.
+static uint64_t cache_read_count( stage_cache_reader_t &r, size_t min_element_size ) {
+	uint64_t count = cache_read<uint64_t>( r );
+	if ( count > uint64_t( r.end - r.pos ) / min_element_size ) {
+		r.ok = false;
+		return 0;
+	}
+	return count;
+}
+
+template <typename T>
+static void cache_read_vector( stage_cache_reader_t &r, std::vector<T> &values ) {
+	static_assert( std::is_trivially_copyable<T>::value, "only trivially copyable types may be stored verbatim" );
+	uint64_t    count = cache_read_count( r, sizeof( T ) );
+	void const *src   = cache_read_bytes( r, sizeof( T ) * count );
+	values.resize( count );
+	if ( count && src ) {
+		memcpy( values.data(), src, sizeof( T ) * count );
+	}
+}
+
+static std::string cache_read_string( stage_cache_reader_t &r ) {
+	uint64_t    count = cache_read_count( r, 1 );
+	char const *src   = static_cast<char const *>( cache_read_bytes( r, count ) );
+	return src ? std::string( src, count ) : std::string();
+}
+
+// Returns pointer to blob in-place, or nullptr if blob is empty.
+static void const *cache_read_blob( stage_cache_reader_t &r, uint64_t *num_bytes ) {
+	*num_bytes = cache_read<uint64_t>( r );
+	cache_read_align( r );
+	void const *result = cache_read_bytes( r, *num_bytes );
+	return *num_bytes ? result : nullptr;
+}
+
+// ----------------------------------------------------------------------
+// Map cache file into memory - falls back to reading the file in one go
+// on platforms where we don't use mmap.
+static void *stage_cache_map_file( char const *file_path, size_t *num_bytes ) {
+#if ( LE_STAGE_CACHE_USE_MMAP )
+	int fd = open( file_path, O_RDONLY );
+
+	if ( fd < 0 ) {
+		return nullptr;
+	}
+
+	struct stat file_stat {};
+
+	if ( fstat( fd, &file_stat ) != 0 || file_stat.st_size <= 0 ) {
+		close( fd );
+		return nullptr;
+	}
+
+	// Mapping is private so that any changes to buffer data are never written back to the cache.
+	void *addr = mmap( nullptr, size_t( file_stat.st_size ), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+	close( fd );
+
+	if ( addr == MAP_FAILED ) {
+		return nullptr;
+	}
+
+	*num_bytes = size_t( file_stat.st_size );
+	return addr;
+#else
+	FILE *file = fopen( file_path, "rb" );
+
+	if ( nullptr == file ) {
+		return nullptr;
+	}
+
+	fseek( file, 0, SEEK_END );
+	long tell_sz = ftell( file );
+	rewind( file );
+
+	void *mem = tell_sz > 0 ? malloc( size_t( tell_sz ) ) : nullptr;
+
+	if ( mem && size_t( tell_sz ) != fread( mem, 1, size_t( tell_sz ), file ) ) {
+		free( mem );
+		mem = nullptr;
+	}
+
+	fclose( file );
+
+	*num_bytes = size_t( tell_sz );
+	return mem;
+#endif
+}
+
+static void stage_cache_unmap_file( void *mem, size_t num_bytes ) {
+#if ( LE_STAGE_CACHE_USE_MMAP )
+	munmap( mem, num_bytes );
+#else
+	free( mem );
+#endif
+}
+
+// Cache memory is owned by the stage, and released once the stage gets destroyed,
+// which means that buffers referring to cache memory don't need to release anything.
+static void stage_cache_release_noop( void * ) {
+}
+
+// ----------------------------------------------------------------------
+/// \brief Save stage to a binary cache file, so that it may be loaded quickly via `load_cache`.
+/// \note  Must be called after importing, but before the stage is uploaded to the gpu for
+///        the first time, since the stage releases buffer and pixel data once uploaded.
+/// \param source_path file the stage was imported from, optional - the cache stores its fingerprint,
+///        so that `load_cache` may tell when the cache is out of date.
+static bool le_stage_save_cache( le_stage_o *self, char const *file_path, char const *source_path ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	// We want to store decoded pixels, which means we must wait for any images being decoded.
+	le_stage_wait_for_deferred_images( self );
+
+	for ( le_buffer_o const *b : self->buffers ) {
+		if ( nullptr == b->mem ) {
+			logger.error( "Could not save stage cache: buffer data was already released. Save cache before first uploading the stage." );
+			return false;
+		}
+	}
+
+	for ( stage_image_o const *img : self->images ) {
+		if ( img->was_transferred ) {
+			logger.error( "Could not save stage cache: pixel data was already released. Save cache before first uploading the stage." );
+			return false;
+		}
+	}
+
+	// ----------| invariant: all buffer and pixel data is available
+
+	le_stage_cache_source_t source{};
+
+	if ( source_path && !stage_cache_get_source( source_path, &source ) ) {
+		logger.error( "Could not save stage cache: source file not found: '%s'", source_path );
+		return false;
+	}
+
+	FILE *file = fopen( file_path, "wb" );
+
+	if ( nullptr == file ) {
+		logger.error( "Could not open stage cache file for writing: '%s'", file_path );
+		return false;
+	}
+
+	stage_cache_writer_t w{ file, 0, true };
+
+	le_stage_cache_header_t header{};
+	memcpy( header.magic, LE_STAGE_CACHE_MAGIC, sizeof( header.magic ) );
+	header.version = LE_STAGE_CACHE_VERSION;
+	header.source  = source;
+	stage_cache_get_struct_sizes( header.struct_sizes );
+
+	cache_write( w, header ); // we will patch file size once we know it.
+
+	// Pointers are stored as indices.
+
+	std::unordered_map<le_node_o const *, uint32_t> node_indices;
+	std::unordered_map<le_skin_o const *, uint32_t> skin_indices;
+
+	for ( uint32_t i = 0; i != uint32_t( self->nodes.size() ); i++ ) {
+		node_indices[ self->nodes[ i ] ] = i;
+	}
+
+	for ( uint32_t i = 0; i != uint32_t( self->skins.size() ); i++ ) {
+		skin_indices[ self->skins[ i ] ] = i;
+	}
+
+	auto node_index = [ & ]( le_node_o const *n ) -> uint32_t {
+		return n ? node_indices.at( n ) : LE_STAGE_CACHE_NO_INDEX;
+	};
+
+	// -- Buffers, buffer views, accessors, samplers
+
+	cache_write( w, uint64_t( self->buffers.size() ) );
+
+	for ( le_buffer_o const *b : self->buffers ) {
+		cache_write_blob( w, b->mem, b->size );
+	}
+
+	cache_write_vector( w, self->buffer_views );
+	cache_write_vector( w, self->accessors );
+	cache_write_vector( w, self->samplers );
+
+	// -- Images: we store decoded pixels
+
+	cache_write( w, uint64_t( self->images.size() ) );
+
+	for ( stage_image_o const *img : self->images ) {
+
+		void const *pixels =
+		    img->pixels
+		        ? le_pixels::le_pixels_i.get_data( img->pixels )
+		        : img->cached_pixels;
+
+		cache_write( w, img->info );
+		cache_write( w, img->resource_info.image.mipLevels );
+		cache_write_blob( w, pixels, pixels ? img->info.byte_count : 0 );
+	}
+
+	// -- Textures
+
+	cache_write( w, uint64_t( self->textures.size() ) );
+
+	for ( le_texture_o const &t : self->textures ) {
+		cache_write( w, t.image_idx );
+		cache_write( w, t.sampler_idx );
+		cache_write_string( w, t.name );
+	}
+
+	// -- Materials
+
+	auto write_texture_view = [ & ]( le_texture_view_o const *view ) {
+		cache_write( w, uint8_t( view != nullptr ) );
+		if ( view ) {
+			cache_write( w, *view );
+		}
+	};
+
+	cache_write( w, uint64_t( self->materials.size() ) );
+
+	for ( le_material_o const &m : self->materials ) {
+		cache_write_string( w, m.name );
+		write_texture_view( m.normal_texture );
+		write_texture_view( m.occlusion_texture );
+		write_texture_view( m.emissive_texture );
+		cache_write( w, m.emissive_factor );
+		cache_write( w, uint8_t( m.metallic_roughness != nullptr ) );
+		if ( m.metallic_roughness ) {
+			write_texture_view( m.metallic_roughness->base_color );
+			write_texture_view( m.metallic_roughness->metallic_roughness );
+			cache_write( w, m.metallic_roughness->base_color_factor );
+			cache_write( w, m.metallic_roughness->metallic_factor );
+			cache_write( w, m.metallic_roughness->roughness_factor );
+		}
+	}
+
+	// -- Meshes: we store primitive attributes - anything else gets re-derived when loading.
+
+	cache_write( w, uint64_t( self->meshes.size() ) );
+
+	for ( le_mesh_o const &mesh : self->meshes ) {
+		cache_write( w, uint64_t( mesh.primitives.size() ) );
+		for ( le_primitive_o const &p : mesh.primitives ) {
+			cache_write( w, uint64_t( p.attributes.size() ) );
+			for ( le_attribute_o const &attr : p.attributes ) {
+				cache_write( w, attr.type );
+				cache_write( w, attr.index );
+				cache_write( w, attr.accessor_idx );
+				cache_write( w, attr.morph.target_data );
+				cache_write_string( w, attr.name );
+			}
+			cache_write( w, p.morph_target_count );
+			cache_write( w, p.indices_accessor_idx );
+			cache_write( w, p.material_idx );
+			cache_write( w, uint8_t( p.has_indices ) );
+			cache_write( w, uint8_t( p.has_material ) );
+		}
+	}
+
+	// -- Cameras, lights
+
+	cache_write_vector( w, self->camera_settings );
+
+	cache_write( w, uint64_t( self->lights.size() ) );
+
+	for ( le_light_info light : self->lights ) {
+		light.name = nullptr; // we don't store names for lights, as these are non-owning.
+		cache_write( w, light );
+	}
+
+	// -- Nodes
+
+	cache_write( w, uint64_t( self->nodes.size() ) );
+
+	for ( le_node_o const *n : self->nodes ) {
+		cache_write( w, n->local_transform );
+		cache_write( w, n->local_translation );
+		cache_write( w, n->local_rotation );
+		cache_write( w, n->local_scale );
+		cache_write( w, n->morph_target_weights );
+		cache_write( w, n->name );
+		cache_write( w, uint8_t( n->local_transform_cached ) );
+		cache_write( w, n->has_mesh ? n->mesh_idx : LE_STAGE_CACHE_NO_INDEX );
+		cache_write( w, n->has_camera ? n->camera_idx : LE_STAGE_CACHE_NO_INDEX );
+		cache_write( w, n->has_light ? n->light_idx : LE_STAGE_CACHE_NO_INDEX );
+		cache_write( w, n->skin ? skin_indices.at( n->skin ) : LE_STAGE_CACHE_NO_INDEX );
+
+		cache_write( w, uint64_t( n->children.size() ) );
+		for ( le_node_o const *c : n->children ) {
+			cache_write( w, node_index( c ) );
+		}
+	}
+
+	// -- Skins
+
+	cache_write( w, uint64_t( self->skins.size() ) );
+
+	for ( le_skin_o const *s : self->skins ) {
+		cache_write( w, uint64_t( s->joints.size() ) );
+		for ( le_node_o const *j : s->joints ) {
+			cache_write( w, node_index( j ) );
+		}
+		cache_write( w, node_index( s->skeleton ) );
+		cache_write_vector( w, s->inverse_bind_matrices );
+	}
+
+	// -- Animations
+
+	cache_write( w, uint64_t( self->animations.size() ) );
+
+	for ( le_animation_o const &a : self->animations ) {
+		cache_write( w, a.playback_mode );
+		cache_write( w, a.ticks_offset );
+		cache_write( w, a.ticks_duration );
+		cache_write( w, uint64_t( a.channels.size() ) );
+		for ( le_animation_channel_o const &c : a.channels ) {
+			cache_write( w, c.ticks_offset );
+			cache_write( w, c.ticks_duration );
+			cache_write_vector( w, c.key_ticks );
+			cache_write_vector( w, c.key_values );
+			cache_write( w, c.key_values_stride );
+			cache_write( w, c.key_array_size );
+			cache_write( w, c.target_compound_type );
+			cache_write( w, node_index( c.target_node ) );
+			// target element is stored as a byte offset into its node.
+			cache_write( w, uint32_t( static_cast<char const *>( c.target_node_element ) - reinterpret_cast<char const *>( c.target_node ) ) );
+		}
+	}
+
+	// -- Scenes
+
+	cache_write( w, uint64_t( self->scenes.size() ) );
+
+	for ( le_scene_o const &s : self->scenes ) {
+		cache_write( w, uint64_t( s.root_nodes.size() ) );
+		for ( le_node_o const *n : s.root_nodes ) {
+			cache_write( w, node_index( n ) );
+		}
+	}
+
+	// -- Patch header with total file size
+
+	header.file_size = w.offset;
+
+	if ( w.ok ) {
+		w.ok = ( 0 == fseek( file, 0, SEEK_SET ) ) &&
+		       ( 1 == fwrite( &header, sizeof( header ), 1, file ) );
+	}
+
+	w.ok &= ( 0 == fclose( file ) );
+
+	if ( !w.ok ) {
+		logger.error( "Could not write stage cache file: '%s'", file_path );
+		remove( file_path );
+		return false;
+	}
+
+	logger.info( "Saved stage cache: '%s' (%zu bytes)", file_path, size_t( header.file_size ) );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/// \brief Load stage from a binary cache file which was previously written via `save_cache`.
+/// \note  Stage must be empty. Returns false if cache could not be loaded, if it was
+///        written by an incompatible version, or if `source_path` is given and the cache was
+///        not saved from this source in its current state - in which case you should import
+///        the scene from its source, and write a new cache.
+static bool le_stage_load_cache( le_stage_o *self, char const *file_path, char const *source_path ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	if ( !self->buffers.empty() || !self->images.empty() || !self->nodes.empty() || self->cache_mem ) {
+		logger.error( "Could not load stage cache: stage must be empty." );
+		return false;
+	}
+
+	le_stage_cache_source_t source{};
+
+	if ( source_path && !stage_cache_get_source( source_path, &source ) ) {
+		logger.warn( "Could not load stage cache: source file not found: '%s'", source_path );
+		return false;
+	}
+
+	size_t cache_size = 0;
+	void * cache_mem  = stage_cache_map_file( file_path, &cache_size );
+
+	if ( nullptr == cache_mem ) {
+		logger.warn( "Could not open stage cache file: '%s'", file_path );
+		return false;
+	}
+
+	stage_cache_reader_t r{ static_cast<char const *>( cache_mem ),
+	                        static_cast<char const *>( cache_mem ),
+	                        static_cast<char const *>( cache_mem ) + cache_size,
+	                        true };
+
+	{
+		le_stage_cache_header_t header = cache_read<le_stage_cache_header_t>( r );
+
+		uint32_t struct_sizes[ 8 ];
+		stage_cache_get_struct_sizes( struct_sizes );
+
+		if ( !r.ok ||
+		     0 != memcmp( header.magic, LE_STAGE_CACHE_MAGIC, sizeof( header.magic ) ) ||
+		     header.version != LE_STAGE_CACHE_VERSION ||
+		     0 != memcmp( header.struct_sizes, struct_sizes, sizeof( struct_sizes ) ) ||
+		     header.file_size != cache_size ||
+		     ( source_path && 0 != memcmp( &header.source, &source, sizeof( source ) ) ) ) {
+			logger.warn( "Stage cache is invalid or out of date: '%s'", file_path );
+			stage_cache_unmap_file( cache_mem, cache_size );
+			return false;
+		}
+	}
+
+	// ----------| invariant: cache header is valid - stage now owns cache memory.
+
+	self->cache_mem      = cache_mem;
+	self->cache_mem_size = cache_size;
+
+	auto check_index = [ & ]( uint32_t idx, size_t count ) -> bool {
+		r.ok &= ( idx < count );
+		return r.ok;
+	};
+
+	// -- Buffers, buffer views, accessors, samplers
+
+	for ( uint64_t i = 0, count = cache_read_count( r, sizeof( uint64_t ) ); i != count && r.ok; i++ ) {
+		uint64_t    num_bytes = 0;
+		void const *data      = cache_read_blob( r, &num_bytes );
+		if ( data ) {
+			// Buffer data is referenced in-place.
+			stage_add_buffer( self, const_cast<void *>( data ), uint32_t( num_bytes ), nullptr, stage_cache_release_noop, nullptr );
+		} else {
+			r.ok = false;
+		}
+	}
+
+	cache_read_vector( r, self->buffer_views );
+	cache_read_vector( r, self->accessors );
+	cache_read_vector( r, self->samplers );
+
+	// Buffer views and accessors are stored verbatim, and get dereferenced without further
+	// checks once the stage is set up - we must make sure they stay within their buffers.
+
+	for ( le_buffer_view_o const &view : self->buffer_views ) {
+		if ( check_index( view.buffer_idx, self->buffers.size() ) ) {
+			r.ok &= ( uint64_t( view.byte_offset ) + view.byte_length <= self->buffers[ view.buffer_idx ]->size );
+		}
+	}
+
+	for ( le_accessor_o const &accessor : self->accessors ) {
+		if ( check_index( accessor.buffer_view_idx, self->buffer_views.size() ) && accessor.count ) {
+			le_buffer_view_o const &view         = self->buffer_views[ accessor.buffer_view_idx ];
+			uint64_t const          element_size = uint64_t( size_of( accessor.component_type ) ) * get_num_components( accessor.type );
+			uint64_t const          stride       = view.byte_stride ? view.byte_stride : element_size;
+			r.ok &= ( element_size != 0 && accessor.byte_offset + stride * ( accessor.count - 1 ) + element_size <= view.byte_length );
+		}
+	}
+
+	// -- Images: pixels are referenced in-place.
+
+	for ( uint64_t i = 0, count = cache_read_count( r, sizeof( le_pixels_info ) ); i != count && r.ok; i++ ) {
+		le_pixels_info info       = cache_read<le_pixels_info>( r );
+		uint32_t       mip_levels = cache_read<uint32_t>( r );
+		uint64_t       num_bytes  = 0;
+		void const *   pixels     = cache_read_blob( r, &num_bytes );
+
+		r.ok &= ( num_bytes == info.byte_count );
+
+		if ( !r.ok ) {
+			break;
+		}
+
+		uint32_t image_idx = stage_create_image_from_info( self, info, nullptr, mip_levels );
+
+		self->images[ image_idx ]->cached_pixels = static_cast<unsigned char const *>( pixels );
+	}
+
+	// -- Textures
+
+	for ( uint64_t i = 0, count = cache_read_count( r, 2 * sizeof( uint32_t ) ); i != count && r.ok; i++ ) {
+		le_texture_info info{};
+		info.image_idx   = cache_read<uint32_t>( r );
+		info.sampler_idx = cache_read<uint32_t>( r );
+
+		std::string name = cache_read_string( r );
+		info.name        = name.empty() ? nullptr : name.data();
+
+		if ( check_index( info.image_idx, self->images.size() ) &&
+		     check_index( info.sampler_idx, self->samplers.size() ) ) {
+			le_stage_create_texture( self, &info );
+		}
+	}
+
+	// -- Materials
+
+	auto read_texture_view = [ & ]() -> le_texture_view_o * {
+		if ( cache_read<uint8_t>( r ) ) {
+			auto view = new le_texture_view_o( cache_read<le_texture_view_o>( r ) );
+			check_index( view->texture_id, self->textures.size() );
+			return view;
+		}
+		return nullptr;
+	};
+
+	for ( uint64_t i = 0, count = cache_read_count( r, sizeof( uint64_t ) ); i != count && r.ok; i++ ) {
+		le_material_o material{};
+		material.name              = cache_read_string( r );
+		material.normal_texture    = read_texture_view();
+		material.occlusion_texture = read_texture_view();
+		material.emissive_texture  = read_texture_view();
+		material.emissive_factor   = cache_read<glm::vec3>( r );
+
+		if ( cache_read<uint8_t>( r ) ) {
+			material.metallic_roughness = new le_material_pbr_metallic_roughness_o{};
+
+			auto &mr              = *material.metallic_roughness;
+			mr.base_color         = read_texture_view();
+			mr.metallic_roughness = read_texture_view();
+			cache_read_array( r, mr.base_color_factor );
+			mr.metallic_factor  = cache_read<float>( r );
+			mr.roughness_factor = cache_read<float>( r );
+		}
+
+		self->materials.emplace_back( material );
+	}
+
+	// -- Meshes: we re-create meshes from their attributes, so that anything
+	// derived from attributes gets re-calculated just as when importing.
+
+	for ( uint64_t i = 0, count = cache_read_count( r, sizeof( uint64_t ) ); i != count && r.ok; i++ ) {
+
+		uint64_t const primitives_count = cache_read_count( r, sizeof( uint64_t ) );
+
+		std::vector<std::vector<le_attribute_o>>              attributes( primitives_count );
+		std::vector<std::vector<le_primitive_attribute_info>> attribute_infos( primitives_count );
+		std::vector<std::vector<le_morph_target_info_t>>      morph_target_infos( primitives_count );
+		std::vector<le_primitive_info>                        primitive_infos( primitives_count );
+
+		for ( uint64_t p = 0; p != primitives_count && r.ok; p++ ) {
+
+			attributes[ p ].resize( cache_read_count( r, sizeof( le_primitive_attribute_info::Type ) ) );
+
+			for ( le_attribute_o &attr : attributes[ p ] ) {
+				attr.type              = cache_read<le_primitive_attribute_info::Type>( r );
+				attr.index             = cache_read<uint32_t>( r );
+				attr.accessor_idx      = cache_read<uint32_t>( r );
+				attr.morph.target_data = cache_read<uint32_t>( r );
+				attr.name              = cache_read_string( r );
+				check_index( attr.accessor_idx, self->accessors.size() );
+				r.ok &= ( attr.type <= le_primitive_attribute_info::Type::eJointWeights );
+			}
+
+			// Every set of joints needs a matching set of joint weights.
+
+			auto count_attributes_of_type = [ & ]( le_primitive_attribute_info::Type type ) {
+				return std::count_if( attributes[ p ].begin(), attributes[ p ].end(), [ type ]( le_attribute_o const &attr ) {
+					return attr.type == type;
+				} );
+			};
+
+			r.ok &= ( count_attributes_of_type( le_primitive_attribute_info::Type::eJoints ) ==
+			          count_attributes_of_type( le_primitive_attribute_info::Type::eJointWeights ) );
+
+			le_primitive_info &info   = primitive_infos[ p ];
+			info.morph_targets_count  = cache_read<uint32_t>( r );
+			info.indices_accessor_idx = cache_read<uint32_t>( r );
+			info.material_idx         = cache_read<uint32_t>( r );
+			info.has_indices          = cache_read<uint8_t>( r );
+			info.has_material         = cache_read<uint8_t>( r );
+
+			if ( info.has_indices ) {
+				check_index( info.indices_accessor_idx, self->accessors.size() );
+			}
+
+			if ( info.has_material ) {
+				check_index( info.material_idx, self->materials.size() );
+			}
+
+			r.ok &= ( info.morph_targets_count <= attributes[ p ].size() );
+
+			// Group attribute infos so that base attributes come first, followed by
+			// attributes for each morph target, in order.
+
+			auto &attr_infos = attribute_infos[ p ];
+			attr_infos.reserve( attributes[ p ].size() );
+
+			for ( uint32_t target = 0; target <= info.morph_targets_count && r.ok; target++ ) {
+
+				size_t const first_attribute = attr_infos.size();
+
+				for ( le_attribute_o &attr : attributes[ p ] ) {
+					bool const belongs_to_target =
+					    target == 0
+					        ? !attr.morph.target.is_target
+					        : ( attr.morph.target.is_target && attr.morph.target.idx == target - 1 );
+
+					if ( belongs_to_target ) {
+						attr_infos.push_back( { attr.accessor_idx, attr.index, attr.type, attr.name.empty() ? nullptr : attr.name.data() } );
+					}
+				}
+
+				if ( target == 0 ) {
+					info.attributes_count = uint32_t( attr_infos.size() );
+				} else {
+					morph_target_infos[ p ].push_back( { nullptr, uint32_t( attr_infos.size() - first_attribute ) } );
+				}
+			}
+
+			// Each attribute must belong to the base primitive, or to one of its morph targets.
+
+			r.ok &= ( attr_infos.size() == attributes[ p ].size() );
+
+			// Now that all attribute infos are in place, we can point at them.
+
+			info.attributes = attr_infos.data();
+
+			le_primitive_attribute_info *next_attribute = attr_infos.data() + info.attributes_count;
+
+			for ( le_morph_target_info_t &mti : morph_target_infos[ p ] ) {
+				mti.attributes = next_attribute;
+				next_attribute += mti.attributes_count;
+			}
+
+			info.morph_targets = morph_target_infos[ p ].data();
+		}
+
+		if ( r.ok ) {
+			le_mesh_info mesh_info{ primitive_infos.data(), uint32_t( primitives_count ) };
+			le_stage_create_mesh( self, &mesh_info );
+		}
+	}
+
+	// -- Cameras, lights
+
+	cache_read_vector( r, self->camera_settings );
+	cache_read_vector( r, self->lights );
+
+	for ( le_light_info &light : self->lights ) {
+		light.name = nullptr; // names were not stored, pointer is meaningless.
+	}
+
+	// -- Nodes: we allocate all nodes first, so that nodes may refer to each other.
+
+	uint64_t const nodes_count = cache_read_count( r, sizeof( glm::mat4 ) );
+
+	self->nodes.reserve( nodes_count );
+
+	for ( uint64_t i = 0; i != nodes_count; i++ ) {
+		self->nodes.push_back( new le_node_o{} );
+	}
+
+	std::vector<uint32_t> node_skin_indices( nodes_count, LE_STAGE_CACHE_NO_INDEX );
+
+	auto read_node = [ & ]() -> le_node_o * {
+		uint32_t idx = cache_read<uint32_t>( r );
+		if ( idx == LE_STAGE_CACHE_NO_INDEX ) {
+			return nullptr;
+		}
+		return check_index( idx, self->nodes.size() ) ? self->nodes[ idx ] : nullptr;
+	};
+
+	for ( uint64_t i = 0; i != nodes_count && r.ok; i++ ) {
+
+		le_node_o *n = self->nodes[ i ];
+
+		n->local_transform   = cache_read<glm::mat4>( r );
+		n->local_translation = cache_read<glm::vec3>( r );
+		n->local_rotation    = cache_read<glm::quat>( r );
+		n->local_scale       = cache_read<glm::vec3>( r );
+		cache_read_array( r, n->morph_target_weights );
+		cache_read_array( r, n->name );
+		n->local_transform_cached = cache_read<uint8_t>( r );
+
+		n->mesh_idx   = cache_read<uint32_t>( r );
+		n->camera_idx = cache_read<uint32_t>( r );
+		n->light_idx  = cache_read<uint32_t>( r );
+		n->has_mesh   = ( n->mesh_idx != LE_STAGE_CACHE_NO_INDEX ) && check_index( n->mesh_idx, self->meshes.size() );
+		n->has_camera = ( n->camera_idx != LE_STAGE_CACHE_NO_INDEX ) && check_index( n->camera_idx, self->camera_settings.size() );
+		n->has_light  = ( n->light_idx != LE_STAGE_CACHE_NO_INDEX ) && check_index( n->light_idx, self->lights.size() );
+
+		node_skin_indices[ i ] = cache_read<uint32_t>( r );
+
+		n->children.resize( cache_read_count( r, sizeof( uint32_t ) ) );
+
+		for ( le_node_o *&c : n->children ) {
+			c = read_node();
+			r.ok &= ( c != nullptr );
+		}
+	}
+
+	// Nodes must form a forest, otherwise traversing the scene graph would never end:
+	// each node may have at most one parent, and following parents must never lead
+	// back to where we started.
+
+	if ( r.ok ) {
+		std::unordered_map<le_node_o const *, uint32_t> node_indices;
+		std::vector<uint32_t>                           parents( nodes_count, LE_STAGE_CACHE_NO_INDEX );
+		std::vector<uint32_t>                           visited_by( nodes_count, LE_STAGE_CACHE_NO_INDEX );
+
+		for ( uint32_t i = 0; i != uint32_t( nodes_count ); i++ ) {
+			node_indices[ self->nodes[ i ] ] = i;
+		}
+
+		for ( uint32_t i = 0; i != uint32_t( nodes_count ) && r.ok; i++ ) {
+			for ( le_node_o const *c : self->nodes[ i ]->children ) {
+				uint32_t &parent = parents[ node_indices[ c ] ];
+				r.ok &= ( parent == LE_STAGE_CACHE_NO_INDEX );
+				parent = i;
+			}
+		}
+
+		for ( uint32_t i = 0; i != uint32_t( nodes_count ) && r.ok; i++ ) {
+			for ( uint32_t n = i; n != LE_STAGE_CACHE_NO_INDEX && visited_by[ n ] == LE_STAGE_CACHE_NO_INDEX; n = parents[ n ] ) {
+				visited_by[ n ] = i;
+				r.ok &= ( parents[ n ] == LE_STAGE_CACHE_NO_INDEX || visited_by[ parents[ n ] ] != i );
+			}
+		}
+	}
+
+	// -- Skins
+
+	for ( uint64_t i = 0, count = cache_read_count( r, sizeof( uint64_t ) ); i != count && r.ok; i++ ) {
+
+		le_skin_o *skin = new le_skin_o{};
+		self->skins.push_back( skin );
+
+		skin->joints.resize( cache_read_count( r, sizeof( uint32_t ) ) );
+
+		for ( le_node_o *&j : skin->joints ) {
+			j = read_node();
+			r.ok &= ( j != nullptr );
+		}
+
+		skin->skeleton = read_node();
+		cache_read_vector( r, skin->inverse_bind_matrices );
+
+		r.ok &= ( skin->inverse_bind_matrices.size() == skin->joints.size() );
+	}
+
+	for ( uint64_t i = 0; i != nodes_count && r.ok; i++ ) {
+		if ( node_skin_indices[ i ] != LE_STAGE_CACHE_NO_INDEX && check_index( node_skin_indices[ i ], self->skins.size() ) ) {
+			self->nodes[ i ]->skin = self->skins[ node_skin_indices[ i ] ];
+		}
+	}
+
+	// -- Animations
+
+	for ( uint64_t i = 0, count = cache_read_count( r, sizeof( uint64_t ) ); i != count && r.ok; i++ ) {
+
+		le_animation_o animation{};
+
+		animation.playback_mode  = cache_read<le_animation_o::PlaybackMode>( r );
+		animation.ticks_offset   = cache_read<uint64_t>( r );
+		animation.ticks_duration = cache_read<uint64_t>( r );
+
+		animation.channels.resize( cache_read_count( r, 2 * sizeof( uint64_t ) ) );
+
+		for ( le_animation_channel_o &c : animation.channels ) {
+			c.ticks_offset   = cache_read<uint64_t>( r );
+			c.ticks_duration = cache_read<uint64_t>( r );
+			cache_read_vector( r, c.key_ticks );
+			cache_read_vector( r, c.key_values );
+			c.key_values_stride    = cache_read<uint32_t>( r );
+			c.key_array_size       = cache_read<uint16_t>( r );
+			c.target_compound_type = cache_read<le_compound_num_type>( r );
+			c.target_node          = read_node();
+
+			uint32_t element_offset = cache_read<uint32_t>( r );
+
+			// Target element must be one of the node elements which animation channels may
+			// target, and must be large enough for the values which the channel writes.
+
+			size_t const bytes_written =
+			    c.target_compound_type == le_compound_num_type::eScalar
+			        ? sizeof( float ) * c.key_array_size
+			        : sizeof( float ) * get_num_components( c.target_compound_type );
+
+			if ( le_node_o *n = c.target_node ) {
+				char *dst = reinterpret_cast<char *>( n ) + element_offset;
+
+				size_t const bytes_available =
+				    dst == reinterpret_cast<char *>( &n->local_translation )     ? sizeof( n->local_translation )
+				    : dst == reinterpret_cast<char *>( &n->local_scale )         ? sizeof( n->local_scale )
+				    : dst == reinterpret_cast<char *>( &n->local_rotation )      ? sizeof( n->local_rotation )
+				    : dst == reinterpret_cast<char *>( n->morph_target_weights ) ? sizeof( n->morph_target_weights )
+				                                                                 : 0;
+
+				r.ok &= ( bytes_written != 0 && bytes_written <= bytes_available );
+				c.target_node_element = dst;
+			} else {
+				r.ok = false;
+			}
+
+			// Keyframe data must be consistent, as channels get evaluated without further checks.
+			r.ok &= ( !c.key_ticks.empty() && sizeof( float ) * c.key_values_stride >= bytes_written );
+			r.ok &= ( c.key_values.size() == c.key_ticks.size() * c.key_values_stride );
+		}
+
+		self->animations.emplace_back( std::move( animation ) );
+	}
+
+	self->animation_channels_dirty = true;
+
+	// -- Scenes: each scene is tracked by a bit in its nodes' `scene_bit_flags`.
+
+	uint64_t const scenes_count = cache_read_count( r, sizeof( uint64_t ) );
+
+	r.ok &= ( scenes_count <= sizeof( le_node_o::scene_bit_flags ) * 8 );
+
+	for ( uint64_t i = 0; i != scenes_count && r.ok; i++ ) {
+
+		std::vector<uint32_t> root_node_indices( cache_read_count( r, sizeof( uint32_t ) ) );
+
+		for ( uint32_t &idx : root_node_indices ) {
+			idx = cache_read<uint32_t>( r );
+			check_index( idx, self->nodes.size() );
+		}
+
+		if ( r.ok ) {
+			le_stage_create_scene( self, root_node_indices.data(), uint32_t( root_node_indices.size() ) );
+		}
+	}
+
+	if ( !r.ok ) {
+		// The cache header was valid, which means that the cache was written by
+		// a compatible version - if we end up here, the cache must be corrupt.
+		logger.error( "Stage cache is corrupt: '%s' - stage is now in an undefined state and must be destroyed.", file_path );
+		return false;
+	}
+
+	logger.info( "Loaded stage cache: '%s' (%zu bytes)", file_path, cache_size );
+
+	return true;
+}
+
 // ----------------------------------------------------------------------
 
 static le_stage_o *le_stage_create( le_renderer_o *renderer, le_timebase_o *timebase ) {
-	auto self      = new le_stage_o{};
-	self->renderer = renderer;
-	self->timebase = timebase;
+	auto self                 = new le_stage_o{};
+	self->renderer            = renderer;
+	self->timebase            = timebase;
+	self->lod_max_pixel_error = 0.f; // levels of detail are opt-in
 	return self;
 }
 
 // ----------------------------------------------------------------------
 
+static void le_stage_set_cluster_culling( le_stage_o *self, bool enabled, bool cull_backfacing ) {
+	self->cluster_culling_disabled = !enabled;
+	self->cluster_cull_backfacing  = cull_backfacing;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_stage_set_lod_max_pixel_error( le_stage_o *self, float max_pixel_error ) {
+	self->lod_max_pixel_error = std::max( max_pixel_error, 0.f );
+}
+
+// ----------------------------------------------------------------------
+
 static void le_stage_destroy( le_stage_o *self ) {
 
+	// We must not free any images while they are being decoded.
+	le_stage_wait_for_deferred_images( self );
+
 	for ( auto &img : self->images ) {
 		if ( img->pixels ) {
 			le_pixels::le_pixels_i.destroy( img->pixels );
@@ -2872,9 +5107,7 @@ static void le_stage_destroy( le_stage_o *self ) {
 	}
 
 	for ( auto &b : self->buffers ) {
-		if ( b->owns_mem && b->mem && b->size ) {
-			free( b->mem );
-		}
+		le_buffer_release_mem( b );
 		delete b;
 	}
 
@@ -2900,6 +5133,11 @@ static void le_stage_destroy( le_stage_o *self ) {
 	self->buffers.clear();
 	self->buffer_handles.clear();
 
+	// Cache memory must be released last, as buffers and images may refer to it.
+	if ( self->cache_mem ) {
+		stage_cache_unmap_file( self->cache_mem, self->cache_mem_size );
+	}
+
 	delete self;
 }
 
@@ -2916,15 +5154,27 @@ LE_MODULE_REGISTER_IMPL( le_stage, api ) {
 	le_stage_i.update_rendermodule = le_stage_update_render_module;
 	le_stage_i.draw_into_module    = le_stage_draw_into_render_module;
 
-	le_stage_i.setup_pipelines = le_stage_setup_pipelines;
+	le_stage_i.setup_pipelines         = le_stage_setup_pipelines;
+	le_stage_i.set_cluster_culling     = le_stage_set_cluster_culling;
+	le_stage_i.set_lod_max_pixel_error = le_stage_set_lod_max_pixel_error;
 
 	le_stage_i.create_image_from_memory    = le_stage_create_image_from_memory;
 	le_stage_i.create_image_from_file_path = le_stage_create_image_from_file_path;
 
+	le_stage_i.create_image_from_memory_deferred    = le_stage_create_image_from_memory_deferred;
+	le_stage_i.create_image_from_file_path_deferred = le_stage_create_image_from_file_path_deferred;
+	le_stage_i.decode_deferred_images               = le_stage_decode_deferred_images;
+	le_stage_i.wait_for_deferred_images             = le_stage_wait_for_deferred_images;
+
 	le_stage_i.create_texture         = le_stage_create_texture;
 	le_stage_i.create_sampler         = le_stage_create_sampler;
 	le_stage_i.create_buffer          = le_stage_create_buffer;
 	le_stage_i.create_buffer_view     = le_stage_create_buffer_view;
+
+	le_stage_i.create_buffer_from_external_memory = le_stage_create_buffer_from_external_memory;
+
+	le_stage_i.save_cache = le_stage_save_cache;
+	le_stage_i.load_cache = le_stage_load_cache;
 	le_stage_i.create_accessor        = le_stage_create_accessor;
 	le_stage_i.create_material        = le_stage_create_material;
 	le_stage_i.create_mesh            = le_stage_create_mesh;
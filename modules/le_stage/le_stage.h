@@ -66,14 +66,46 @@ struct le_stage_api {
 
 		void     (* setup_pipelines)(le_stage_o* self);
 
+		// Large primitives which are not deformed are split into meshlets by setup_pipelines, and
+		// meshlets outside the camera frustum are skipped when drawing. Cluster culling is enabled by
+		// default; back-facing meshlets are only culled if you opt in, as materials may be double-sided.
+		void     (* set_cluster_culling)( le_stage_o* self, bool enabled, bool cull_backfacing );
+
+		// If max_pixel_error is greater than 0 when you call setup_pipelines, setup_pipelines also builds
+		// simplified levels of detail for these primitives, and each node draws the coarsest level whose
+		// error on screen stays below max_pixel_error. Defaults to 0: primitives are drawn at full detail.
+		void     (* set_lod_max_pixel_error)( le_stage_o* self, float max_pixel_error );
+
+		// Binary stage cache: save a fully imported stage (before it is first uploaded), and load it
+		// back into an empty stage. Call setup_pipelines after loading, just as after importing.
+		// source_path is optional: if given, the cache records the size and modification time of the
+		// file the stage was imported from, and load_cache rejects the cache once that file changes.
+		bool     (* save_cache)( le_stage_o* self, char const * file_path, char const * source_path );
+		bool     (* load_cache)( le_stage_o* self, char const * file_path, char const * source_path ); // returns false if cache is missing, invalid, or out of date
+
 		uint32_t (* create_image_from_memory)( le_stage_o* stage, unsigned char const * image_file_memory, uint32_t image_file_sz, char const * debug_name, uint32_t mip_levels);
 		uint32_t (* create_image_from_file_path)( le_stage_o* stage, char const * image_file_path, char const * debug_name, uint32_t mip_levels);
 
+		// Deferred images: image headers are read immediately, but pixels are only decoded once
+		// `decode_deferred_images` is called - in parallel, if the job system is available.
+		// Memory given to `create_image_from_memory_deferred` must stay valid until decoding completes.
+		// You must call `wait_for_deferred_images` before updating or drawing the stage.
+		// Images are decoded in rounds: max_round_bytes limits the bytes of pixels decoded in parallel
+		// in any one round (0 means unlimited). This is not a memory cap: decoded pixels stay resident
+		// until the stage uploads them.
+		uint32_t (* create_image_from_memory_deferred)( le_stage_o* stage, unsigned char const * image_file_memory, uint32_t image_file_sz, char const * debug_name, uint32_t mip_levels);
+		uint32_t (* create_image_from_file_path_deferred)( le_stage_o* stage, char const * image_file_path, char const * debug_name, uint32_t mip_levels);
+		void     (* decode_deferred_images)( le_stage_o* stage, uint64_t max_round_bytes );
+		void     (* wait_for_deferred_images)( le_stage_o* stage );
+
 		uint32_t (* create_sampler)(le_stage_o* stage, le_sampler_info_t const * info);
 		uint32_t (* create_texture)(le_stage_o* stage, le_texture_info const * info);
 
 		uint32_t (* create_buffer      )( le_stage_o* self, void *mem, uint32_t sz, char const *debug_name );
 		uint32_t (* create_buffer_view )( le_stage_o* self, le_buffer_view_info const *info );
+
+		// Refers to `mem` without copying - stage calls `release_fun(release_user_data)` once it no longer needs `mem`.
+		uint32_t (* create_buffer_from_external_memory)( le_stage_o* self, void *mem, uint32_t sz, char const *debug_name, void (*release_fun)(void* user_data), void* release_user_data );
 		uint32_t (* create_accessor    )( le_stage_o* self, le_accessor_info const *info );
 		uint32_t (* create_material    )( le_stage_o* self, le_material_info const * info);
 		uint32_t (* create_mesh        )( le_stage_o* self, le_mesh_info const * info);
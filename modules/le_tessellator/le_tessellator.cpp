@@ -6,9 +6,36 @@
 
 #include <string.h> // memcpy
 #include <glm/vec2.hpp>
-
-using Point     = glm::vec2;
-using IndexType = le_tessellator_api::IndexType;
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#ifndef LE_MT
+#	define LE_MT 0
+#endif
+
+#if ( LE_MT > 0 )
+#	include "le_jobs.h"
+#endif
+
+/*
+ * Tessellation state which is expensive to set up - a memory arena for libtess,
+ * and an earcut instance, which keeps its node pool - lives in a context. Contexts
+ * are reused: each le_tessellator_o owns one context, and each batch owns one
+ * context per parallel task.
+ *
+ * Contours are stored as one flat array of points, plus an array of contour
+ * bounds: contour i spans points [bounds[i] .. bounds[i+1]).
+ *
+ */
+
+using Point      = glm::vec2;
+using IndexType  = le_tessellator_api::IndexType;
+using ShapeRange = le_tessellator_api::ShapeRange;
+
+static constexpr size_t LE_TESSELLATOR_ARENA_BLOCK_SIZE = 1 << 16; // minimum size for arena memory blocks, in bytes
+static constexpr size_t LE_TESSELLATOR_ARENA_ALIGNMENT  = 16;      // alignment for arena allocations, also size of allocation header
+static constexpr size_t LE_TESSELLATOR_SHAPES_PER_TASK  = 16;      // minimum number of shapes per parallel task for batches
 
 namespace mapbox {
 namespace util {
@@ -29,87 +56,294 @@ struct nth<1, Point> {
 } // namespace util
 } // namespace mapbox
 
+// A contour, as seen by earcut: a view into our flat array of points.
+struct le_tessellator_contour_view_t {
+	using value_type = Point;
+
+	Point const *points;
+	size_t       num_points;
+
+	size_t size() const {
+		return num_points;
+	}
+	bool empty() const {
+		return num_points == 0;
+	}
+	Point const &operator[]( size_t i ) const {
+		return points[ i ];
+	}
+	Point const *begin() const {
+		return points;
+	}
+	Point const *end() const {
+		return points + num_points;
+	}
+};
+
+// Memory arena for libtess. libtess makes many small allocations for each
+// tessellation, which it frees all at once when we are done - an arena turns
+// these into pointer bumps. Free is a no-op, memory is reclaimed on reset.
+struct le_tessellator_arena_o {
+	std::vector<char *> blocks;      // memory blocks, in order of use
+	std::vector<size_t> block_sizes; // capacity of each block, in bytes
+	size_t              block_idx;   // current block
+	size_t              offset;      // offset of first free byte in current block
+	size_t              total_used;  // number of bytes used since last reset, over all blocks
+};
+
+struct le_tessellator_context_o {
+	le_tessellator_arena_o                     arena;
+	TESSalloc                                  tess_alloc;    // allocates from arena
+	mapbox::detail::Earcut<IndexType>          earcut;        // keeps its node pool across tessellations
+	std::vector<le_tessellator_contour_view_t> contour_views; // scratch: contours as seen by earcut
+};
+
 struct le_tessellator_o {
-	std::vector<std::vector<Point>> contours;
-	std::vector<IndexType>          indices;
-	std::vector<Point>              vertices;
-	uint64_t                        options;
+	std::vector<Point>        points;         // points for all contours
+	std::vector<uint32_t>     contour_bounds; // first point per contour, followed by total number of points
+	std::vector<IndexType>    indices;
+	std::vector<Point>        vertices;
+	uint64_t                  options;
+	le_tessellator_context_o *context;
+};
+
+struct le_tessellator_batch_shape_t {
+	uint64_t options;
+	uint32_t contours_begin; // first contour for this shape
+	uint32_t contours_end;   // one past last contour for this shape
+};
+
+// Results for a range of shapes which are tessellated together as one parallel task.
+struct le_tessellator_batch_task_t {
+	le_tessellator_batch_o *  batch;
+	le_tessellator_context_o *context; // owned by this task, reused across batches
+	size_t                    shapes_begin;
+	size_t                    shapes_end;
+	std::vector<Point>        vertices;      // reused across batches
+	std::vector<IndexType>    indices;       // reused across batches
+	size_t                    vertex_offset; // where vertices go in the batch vertex stream
+	size_t                    index_offset;  // where indices go in the batch index stream
+	bool                      success;
+};
+
+struct le_tessellator_batch_o {
+	std::vector<Point>                         points;         // points for all contours
+	std::vector<uint32_t>                      contour_bounds; // first point per contour, followed by total number of points
+	std::vector<le_tessellator_batch_shape_t>  shapes;
+	std::vector<ShapeRange>                    ranges; // per shape: where to find its vertices and indices
+	std::vector<Point>                         vertices;
+	std::vector<IndexType>                     indices;
+	std::vector<le_tessellator_batch_task_t *> tasks; // reused across batches
 };
 
 // ----------------------------------------------------------------------
 
-static le_tessellator_o *le_tessellator_create() {
-	auto self = new le_tessellator_o();
-	return self;
+static void *le_tessellator_arena_alloc( void *user_data, unsigned int size ) {
+	auto arena = static_cast<le_tessellator_arena_o *>( user_data );
+
+	// Each allocation is preceded by a header which stores its size, so that we can realloc.
+	size_t const num_bytes = ( ( size + LE_TESSELLATOR_ARENA_ALIGNMENT - 1 ) & ~( LE_TESSELLATOR_ARENA_ALIGNMENT - 1 ) ) + LE_TESSELLATOR_ARENA_ALIGNMENT;
+
+	while ( arena->block_idx == arena->blocks.size() ||
+	        arena->offset + num_bytes > arena->block_sizes[ arena->block_idx ] ) {
+
+		if ( arena->block_idx < arena->blocks.size() && arena->offset != 0 ) {
+			// Current block is full - move on to the next block.
+			arena->block_idx++;
+			arena->offset = 0;
+			continue;
+		}
+
+		// Block is either missing, or too small even when empty: replace it.
+
+		size_t const block_size = std::max( LE_TESSELLATOR_ARENA_BLOCK_SIZE, num_bytes );
+
+		if ( arena->block_idx < arena->blocks.size() ) {
+			delete[] arena->blocks[ arena->block_idx ];
+			arena->blocks[ arena->block_idx ]      = new char[ block_size ];
+			arena->block_sizes[ arena->block_idx ] = block_size;
+		} else {
+			arena->blocks.push_back( new char[ block_size ] );
+			arena->block_sizes.push_back( block_size );
+		}
+	}
+
+	char *header = arena->blocks[ arena->block_idx ] + arena->offset;
+	arena->offset += num_bytes;
+	arena->total_used += num_bytes;
+
+	*reinterpret_cast<size_t *>( header ) = size;
+
+	return header + LE_TESSELLATOR_ARENA_ALIGNMENT;
 }
 
 // ----------------------------------------------------------------------
 
-static void le_tessellator_destroy( le_tessellator_o *self ) {
-	delete self;
+static void *le_tessellator_arena_realloc( void *user_data, void *ptr, unsigned int size ) {
+	if ( ptr == nullptr ) {
+		return le_tessellator_arena_alloc( user_data, size );
+	}
+
+	size_t const old_size = *reinterpret_cast<size_t *>( static_cast<char *>( ptr ) - LE_TESSELLATOR_ARENA_ALIGNMENT );
+
+	if ( size <= old_size ) {
+		return ptr;
+	}
+
+	void *result = le_tessellator_arena_alloc( user_data, size );
+	memcpy( result, ptr, old_size );
+	return result;
 }
 
 // ----------------------------------------------------------------------
 
-static void le_tessellator_add_polyline( le_tessellator_o *self, Point const *const pPoints, size_t const &pointCount ) {
-	// Add new contour
-	self->contours.insert( self->contours.end(), { pPoints, pPoints + pointCount } );
+static void le_tessellator_arena_free( void *, void * ) {
+	// Memory is reclaimed when the arena is reset.
+}
+
+// ----------------------------------------------------------------------
+// Makes all memory in the arena available again. If the last round of allocations
+// needed more than one block, we replace all blocks by one block which is large
+// enough to hold all of them, so that next time we don't need to hop blocks.
+static void le_tessellator_arena_reset( le_tessellator_arena_o *arena ) {
+
+	if ( arena->block_idx > 0 ) {
+		size_t const block_size = std::max( arena->total_used, LE_TESSELLATOR_ARENA_BLOCK_SIZE );
 
-	// append to vertices
-	self->vertices.insert( self->vertices.end(), pPoints, pPoints + pointCount );
+		for ( auto b : arena->blocks ) {
+			delete[] b;
+		}
+
+		arena->blocks      = { new char[ block_size ] };
+		arena->block_sizes = { block_size };
+	}
+
+	arena->block_idx  = 0;
+	arena->offset     = 0;
+	arena->total_used = 0;
 }
 
 // ----------------------------------------------------------------------
 
-static bool le_tessellator_tessellate( le_tessellator_o *self ) {
+static le_tessellator_context_o *le_tessellator_context_create() {
+	auto self = new le_tessellator_context_o{};
 
-	// Run tessellation
-	if ( self->options & le_tessellator::Options::bitUseEarcutTessellator ) {
-		// Use earcut tessellator
-		self->indices = mapbox::earcut<IndexType>( self->contours );
-	} else {
-		// Use libtess
-		TESStesselator *tess;
-		tess = tessNewTess( nullptr );
+	self->tess_alloc            = {};
+	self->tess_alloc.memalloc   = le_tessellator_arena_alloc;
+	self->tess_alloc.memrealloc = le_tessellator_arena_realloc;
+	self->tess_alloc.memfree    = le_tessellator_arena_free;
+	self->tess_alloc.userData   = &self->arena;
 
-		tessSetOption( tess, TessOption::TESS_CONSTRAINED_DELAUNAY_TRIANGULATION,
-		               self->options & le_tessellator::Options::bitConstrainedDelaunayTriangulation );
+	return self;
+}
 
-		tessSetOption( tess, TessOption::TESS_REVERSE_CONTOURS,
-		               self->options & le_tessellator::Options::bitReverseContours );
+// ----------------------------------------------------------------------
 
-		for ( auto const &contour : self->contours ) {
-			tessAddContour( tess, Point::type::length(), contour.data(), sizeof( Point ), int( contour.size() ) );
-		}
+static void le_tessellator_context_destroy( le_tessellator_context_o *self ) {
+	for ( auto b : self->arena.blocks ) {
+		delete[] b;
+	}
+	delete self;
+}
 
-		tessTesselate( tess,
-		               int( self->options >> le_tessellator_api::le_tessellator_interface_t::OptionsWindingsOffset ),
-		               TessElementType::TESS_POLYGONS,
-		               3, // max number of vertices per polygon - we want triangles.
-		               Point::length(),
-		               nullptr );
+// ----------------------------------------------------------------------
+// Tessellates one shape, made up of `num_contours` contours, and appends
+// its vertices and indices to `vertices` and `indices`. Indices are relative
+// to the first vertex of the shape.
+//
+// Contour i spans points [contour_bounds[i] .. contour_bounds[i+1]).
+static bool le_tessellator_tessellate_shape( le_tessellator_context_o *ctx,
+                                             uint64_t                  options,
+                                             Point const *             points,
+                                             uint32_t const *          contour_bounds,
+                                             size_t                    num_contours,
+                                             std::vector<Point> &      vertices,
+                                             std::vector<IndexType> &  indices ) {
+
+	if ( num_contours == 0 ) {
+		return true;
+	}
 
-		self->indices.clear();
-		self->vertices.clear();
+	uint32_t const points_begin = contour_bounds[ 0 ];
+	uint32_t const points_end   = contour_bounds[ num_contours ];
 
-		size_t numVertices = size_t( tessGetVertexCount( tess ) );
-		auto   pVertices   = tessGetVertices( tess );
-		self->vertices.resize( numVertices );
-		memcpy( self->vertices.data(), pVertices, sizeof( Point ) * numVertices );
+	if ( options & le_tessellator::Options::bitUseEarcutTessellator ) {
 
-		size_t numIndices = size_t( tessGetElementCount( tess ) ) * 3; // each element has 3 vertices, as we requested triangles when tessellating
-		self->indices.reserve( numIndices );
+		// Use earcut tessellator - output vertices are the same as input points.
 
-		TESSindex const *      pIndex     = tessGetElements( tess );
-		TESSindex const *const pIndex_end = pIndex + numIndices;
+		if ( points_end - points_begin > size_t( std::numeric_limits<IndexType>::max() ) + 1 ) {
+			return false;
+		}
 
-		// we must copy manually since indices are int, but we want uint16_t
+		ctx->contour_views.clear();
 
-		for ( auto idx = pIndex; idx != pIndex_end; idx++ ) {
-			self->indices.emplace_back( *idx );
+		for ( size_t i = 0; i != num_contours; i++ ) {
+			ctx->contour_views.push_back( { points + contour_bounds[ i ], contour_bounds[ i + 1 ] - contour_bounds[ i ] } );
 		}
 
-		tessDeleteTess( tess );
+		ctx->earcut( ctx->contour_views );
+
+		vertices.insert( vertices.end(), points + points_begin, points + points_end );
+		indices.insert( indices.end(), ctx->earcut.indices.begin(), ctx->earcut.indices.end() );
+
+		return true;
+	}
+
+	// Use libtess - the tessellator object itself lives in the arena,
+	// which means that we can drop it on the floor once we're done.
+
+	le_tessellator_arena_reset( &ctx->arena );
+
+	TESStesselator *tess = tessNewTess( &ctx->tess_alloc );
+
+	if ( nullptr == tess ) {
+		return false;
+	}
+
+	tessSetOption( tess, TessOption::TESS_CONSTRAINED_DELAUNAY_TRIANGULATION,
+	               options & le_tessellator::Options::bitConstrainedDelaunayTriangulation );
+
+	tessSetOption( tess, TessOption::TESS_REVERSE_CONTOURS,
+	               options & le_tessellator::Options::bitReverseContours );
+
+	for ( size_t i = 0; i != num_contours; i++ ) {
+		tessAddContour( tess, Point::length(), points + contour_bounds[ i ], sizeof( Point ), int( contour_bounds[ i + 1 ] - contour_bounds[ i ] ) );
+	}
+
+	int result = tessTesselate( tess,
+	                            int( options >> le_tessellator_api::le_tessellator_interface_t::OptionsWindingsOffset ),
+	                            TessElementType::TESS_POLYGONS,
+	                            3, // max number of vertices per polygon - we want triangles.
+	                            Point::length(),
+	                            nullptr );
+
+	if ( !result ) {
+		return false;
+	}
+
+	size_t const numVertices = size_t( tessGetVertexCount( tess ) );
+
+	if ( numVertices > size_t( std::numeric_limits<IndexType>::max() ) + 1 ) {
+		return false; // indices would not fit into IndexType
+	}
+
+	auto pVertices = tessGetVertices( tess );
+
+	size_t const vertices_begin = vertices.size();
+	vertices.resize( vertices_begin + numVertices );
+	memcpy( vertices.data() + vertices_begin, pVertices, sizeof( Point ) * numVertices );
+
+	size_t const numIndices = size_t( tessGetElementCount( tess ) ) * 3; // each element has 3 vertices, as we requested triangles when tessellating
+
+	TESSindex const *      pIndex     = tessGetElements( tess );
+	TESSindex const *const pIndex_end = pIndex + numIndices;
+
+	// we must copy manually since indices are int, but we want uint16_t
+
+	indices.reserve( indices.size() + numIndices );
+
+	for ( auto idx = pIndex; idx != pIndex_end; idx++ ) {
+		indices.emplace_back( *idx );
 	}
 
 	return true;
@@ -117,6 +351,43 @@ static bool le_tessellator_tessellate( le_tessellator_o *self ) {
 
 // ----------------------------------------------------------------------
 
+static le_tessellator_o *le_tessellator_create() {
+	auto self     = new le_tessellator_o();
+	self->context = le_tessellator_context_create();
+	self->contour_bounds.push_back( 0 ); // first contour starts at point 0
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_destroy( le_tessellator_o *self ) {
+	le_tessellator_context_destroy( self->context );
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_add_polyline( le_tessellator_o *self, Point const *const pPoints, size_t const &pointCount ) {
+	self->points.insert( self->points.end(), pPoints, pPoints + pointCount );
+	self->contour_bounds.push_back( uint32_t( self->points.size() ) );
+}
+
+// ----------------------------------------------------------------------
+
+static bool le_tessellator_tessellate( le_tessellator_o *self ) {
+
+	self->indices.clear();
+	self->vertices.clear();
+
+	return le_tessellator_tessellate_shape( self->context, self->options,
+	                                        self->points.data(),
+	                                        self->contour_bounds.data(),
+	                                        self->contour_bounds.size() - 1,
+	                                        self->vertices, self->indices );
+}
+
+// ----------------------------------------------------------------------
+
 static void le_tessellator_get_indices( le_tessellator_o *self, IndexType const **pIndices, size_t *indexCount ) {
 	*pIndices   = self->indices.data();
 	*indexCount = self->indices.size();
@@ -132,7 +403,8 @@ static void le_tessellator_get_vertices( le_tessellator_o *self, Point const **p
 // ----------------------------------------------------------------------
 
 static void le_tessellator_reset( le_tessellator_o *self ) {
-	self->contours.clear();
+	self->points.clear();
+	self->contour_bounds.resize( 1 );
 	self->indices.clear();
 	self->vertices.clear();
 }
@@ -145,6 +417,253 @@ static void le_tessellator_set_options( le_tessellator_o *self, uint64_t options
 
 // ----------------------------------------------------------------------
 
+static le_tessellator_batch_o *le_tessellator_batch_create() {
+	auto self = new le_tessellator_batch_o();
+	self->contour_bounds.push_back( 0 ); // first contour starts at point 0
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_batch_destroy( le_tessellator_batch_o *self ) {
+	for ( auto t : self->tasks ) {
+		le_tessellator_context_destroy( t->context );
+		delete t;
+	}
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+// Removes all shapes and results - keeps memory allocated so that it
+// can be reused for the next batch.
+static void le_tessellator_batch_reset( le_tessellator_batch_o *self ) {
+	self->points.clear();
+	self->contour_bounds.resize( 1 );
+	self->shapes.clear();
+	self->ranges.clear();
+	self->vertices.clear();
+	self->indices.clear();
+}
+
+// ----------------------------------------------------------------------
+// Starts a new shape - all subsequent polylines are added to this shape.
+static uint32_t le_tessellator_batch_add_shape( le_tessellator_batch_o *self, uint64_t options ) {
+	uint32_t contours_begin = uint32_t( self->contour_bounds.size() - 1 );
+	self->shapes.push_back( { options, contours_begin, contours_begin } );
+	return uint32_t( self->shapes.size() - 1 );
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_batch_add_polyline( le_tessellator_batch_o *self, Point const *const pPoints, size_t const &pointCount ) {
+
+	if ( self->shapes.empty() ) {
+		le_tessellator_batch_add_shape( self, 0 );
+	}
+
+	self->points.insert( self->points.end(), pPoints, pPoints + pointCount );
+	self->contour_bounds.push_back( uint32_t( self->points.size() ) );
+	self->shapes.back().contours_end = uint32_t( self->contour_bounds.size() - 1 );
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_batch_run_task( le_tessellator_batch_task_t *task ) {
+
+	le_tessellator_batch_o *self = task->batch;
+
+	task->vertices.clear();
+	task->indices.clear();
+	task->success = true;
+
+	for ( size_t s = task->shapes_begin; s != task->shapes_end; s++ ) {
+
+		auto const &shape = self->shapes[ s ];
+		auto &      range = self->ranges[ s ];
+
+		size_t const vertices_begin = task->vertices.size();
+		size_t const indices_begin  = task->indices.size();
+
+		bool result = le_tessellator_tessellate_shape( task->context, shape.options,
+		                                               self->points.data(),
+		                                               self->contour_bounds.data() + shape.contours_begin,
+		                                               shape.contours_end - shape.contours_begin,
+		                                               task->vertices, task->indices );
+
+		if ( !result ) {
+			// Drop anything which this shape may have added, so that it ends up empty.
+			task->vertices.resize( vertices_begin );
+			task->indices.resize( indices_begin );
+			task->success = false;
+		}
+
+		// Offsets are relative to this task for now - we fix them up once we
+		// know where this task's results go in the batch streams.
+
+		range.vertex_offset = uint32_t( vertices_begin );
+		range.vertex_count  = uint32_t( task->vertices.size() - vertices_begin );
+		range.index_offset  = uint32_t( indices_begin );
+		range.index_count   = uint32_t( task->indices.size() - indices_begin );
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_batch_copy_task_results( le_tessellator_batch_task_t *task ) {
+
+	le_tessellator_batch_o *self = task->batch;
+
+	std::copy( task->vertices.begin(), task->vertices.end(), self->vertices.begin() + ptrdiff_t( task->vertex_offset ) );
+	std::copy( task->indices.begin(), task->indices.end(), self->indices.begin() + ptrdiff_t( task->index_offset ) );
+
+	for ( size_t s = task->shapes_begin; s != task->shapes_end; s++ ) {
+		self->ranges[ s ].vertex_offset += uint32_t( task->vertex_offset );
+		self->ranges[ s ].index_offset += uint32_t( task->index_offset );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Tessellates all shapes in the batch - in parallel, if the job system is available.
+// Returns false if any shape could not be tessellated; these shapes have empty ranges.
+static bool le_tessellator_batch_tessellate( le_tessellator_batch_o *self ) {
+
+	size_t const num_shapes = self->shapes.size();
+
+	self->ranges.resize( num_shapes );
+	self->vertices.clear();
+	self->indices.clear();
+
+	if ( num_shapes == 0 ) {
+		return true;
+	}
+
+	// -- Split shapes into tasks, so that each task gets roughly the same number of points.
+
+#if ( LE_MT > 0 )
+	size_t const max_tasks = LE_MT * 4;
+#else
+	size_t const max_tasks = 1;
+#endif
+
+	size_t const num_tasks = std::max<size_t>( 1, std::min( max_tasks, num_shapes / LE_TESSELLATOR_SHAPES_PER_TASK ) );
+
+	while ( self->tasks.size() < num_tasks ) {
+		auto task     = new le_tessellator_batch_task_t{};
+		task->context = le_tessellator_context_create();
+		self->tasks.push_back( task );
+	}
+
+	size_t const points_per_task = ( self->points.size() + num_tasks - 1 ) / num_tasks;
+
+	for ( size_t t = 0, s = 0; t != num_tasks; t++ ) {
+		auto task          = self->tasks[ t ];
+		task->batch        = self;
+		task->shapes_begin = s;
+
+		size_t const points_limit = std::min( self->points.size(), points_per_task * ( t + 1 ) );
+
+		if ( t + 1 == num_tasks ) {
+			s = num_shapes; // last task takes all remaining shapes
+		} else {
+			while ( s != num_shapes && self->contour_bounds[ self->shapes[ s ].contours_end ] <= points_limit ) {
+				s++;
+			}
+		}
+
+		task->shapes_end = s;
+	}
+
+	// -- Tessellate
+
+#if ( LE_MT > 0 )
+	std::vector<le_jobs::job_t> jobs;
+	jobs.reserve( num_tasks );
+
+	// --------| invariant: each task owns its context, no two tasks share a context.
+
+	for ( size_t t = 0; t != num_tasks; t++ ) {
+		jobs.push_back( { []( void *param ) {
+			                 le_tessellator_batch_run_task( static_cast<le_tessellator_batch_task_t *>( param ) );
+		                 },
+		                  self->tasks[ t ] } );
+	}
+
+	{
+		le_jobs::counter_t *counter;
+		le_jobs::run_jobs( jobs.data(), uint32_t( jobs.size() ), &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
+	}
+#else
+	for ( size_t t = 0; t != num_tasks; t++ ) {
+		le_tessellator_batch_run_task( self->tasks[ t ] );
+	}
+#endif
+
+	// -- Find where each task's results go, then concatenate results
+
+	bool   success        = true;
+	size_t total_vertices = 0;
+	size_t total_indices  = 0;
+
+	for ( size_t t = 0; t != num_tasks; t++ ) {
+		auto task           = self->tasks[ t ];
+		task->vertex_offset = total_vertices;
+		task->index_offset  = total_indices;
+		total_vertices += task->vertices.size();
+		total_indices += task->indices.size();
+		success &= task->success;
+	}
+
+	self->vertices.resize( total_vertices );
+	self->indices.resize( total_indices );
+
+#if ( LE_MT > 0 )
+	jobs.clear();
+
+	for ( size_t t = 0; t != num_tasks; t++ ) {
+		jobs.push_back( { []( void *param ) {
+			                 le_tessellator_batch_copy_task_results( static_cast<le_tessellator_batch_task_t *>( param ) );
+		                 },
+		                  self->tasks[ t ] } );
+	}
+
+	{
+		le_jobs::counter_t *counter;
+		le_jobs::run_jobs( jobs.data(), uint32_t( jobs.size() ), &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
+	}
+#else
+	for ( size_t t = 0; t != num_tasks; t++ ) {
+		le_tessellator_batch_copy_task_results( self->tasks[ t ] );
+	}
+#endif
+
+	return success;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_batch_get_vertices( le_tessellator_batch_o *self, Point const **pVertices, size_t *vertexCount ) {
+	*pVertices   = self->vertices.data();
+	*vertexCount = self->vertices.size();
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_batch_get_indices( le_tessellator_batch_o *self, IndexType const **pIndices, size_t *indexCount ) {
+	*pIndices   = self->indices.data();
+	*indexCount = self->indices.size();
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_batch_get_shape_ranges( le_tessellator_batch_o *self, ShapeRange const **pRanges, size_t *rangeCount ) {
+	*pRanges    = self->ranges.data();
+	*rangeCount = self->ranges.size();
+}
+
+// ----------------------------------------------------------------------
+
 LE_MODULE_REGISTER_IMPL( le_tessellator, api ) {
 	auto &le_tessellator_i = static_cast<le_tessellator_api *>( api )->le_tessellator_i;
 
@@ -156,4 +675,16 @@ LE_MODULE_REGISTER_IMPL( le_tessellator, api ) {
 	le_tessellator_i.get_vertices = le_tessellator_get_vertices;
 	le_tessellator_i.reset        = le_tessellator_reset;
 	le_tessellator_i.set_options  = le_tessellator_set_options;
+
+	auto &le_tessellator_batch_i = static_cast<le_tessellator_api *>( api )->le_tessellator_batch_i;
+
+	le_tessellator_batch_i.create           = le_tessellator_batch_create;
+	le_tessellator_batch_i.destroy          = le_tessellator_batch_destroy;
+	le_tessellator_batch_i.reset            = le_tessellator_batch_reset;
+	le_tessellator_batch_i.add_shape        = le_tessellator_batch_add_shape;
+	le_tessellator_batch_i.add_polyline     = le_tessellator_batch_add_polyline;
+	le_tessellator_batch_i.tessellate       = le_tessellator_batch_tessellate;
+	le_tessellator_batch_i.get_vertices     = le_tessellator_batch_get_vertices;
+	le_tessellator_batch_i.get_indices      = le_tessellator_batch_get_indices;
+	le_tessellator_batch_i.get_shape_ranges = le_tessellator_batch_get_shape_ranges;
 }
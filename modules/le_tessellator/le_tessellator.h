@@ -8,12 +8,22 @@
 #endif
 
 struct le_tessellator_o;
+struct le_tessellator_batch_o;
 
 // clang-format off
 struct le_tessellator_api {
 
 	typedef uint16_t IndexType;
 
+	// Where to find results for one shape of a batch.
+	// Indices are relative to the first vertex of their shape: draw with vertex_offset as base vertex.
+	struct ShapeRange {
+		uint32_t vertex_offset; // first vertex in batch vertex stream
+		uint32_t vertex_count;
+		uint32_t index_offset;  // first index in batch index stream
+		uint32_t index_count;   // 0 if shape could not be tessellated
+	};
+
 	struct le_tessellator_interface_t {
 
 		static constexpr auto OptionsWindingsOffset = 3;
@@ -47,7 +57,31 @@ struct le_tessellator_api {
 
 	};
 
+	// A batch tessellates many independent shapes in one go - in parallel, if le_jobs is available.
+	// Results for all shapes are concatenated into one vertex, and one index stream.
+	struct le_tessellator_batch_interface_t {
+
+		le_tessellator_batch_o * ( * create           ) ( );
+		void                     ( * destroy          ) ( le_tessellator_batch_o* self );
+
+		// Removes all shapes and results, but keeps memory for reuse.
+		void                     ( * reset            ) ( le_tessellator_batch_o* self );
+
+		// Starts a new shape, and returns its index. Options as for le_tessellator_interface_t.
+		uint32_t                 ( * add_shape        ) ( le_tessellator_batch_o* self, uint64_t options );
+		// Adds a contour to the most recently added shape.
+		void                     ( * add_polyline     ) ( le_tessellator_batch_o* self, glm::vec2 const * const pPoints, size_t const& pointCount );
+
+		// Returns false if any shape could not be tessellated.
+		bool                     ( * tessellate       ) ( le_tessellator_batch_o* self );
+
+		void                     ( * get_vertices     ) ( le_tessellator_batch_o* self, glm::vec2 const ** pVertices, size_t * vertexCount );
+		void                     ( * get_indices      ) ( le_tessellator_batch_o* self, IndexType const ** pIndices, size_t * indexCount );
+		void                     ( * get_shape_ranges ) ( le_tessellator_batch_o* self, ShapeRange const ** pRanges, size_t * rangeCount );
+	};
+
 	le_tessellator_interface_t       le_tessellator_i;
+	le_tessellator_batch_interface_t le_tessellator_batch_i;
 };
 // clang-format on
 
@@ -57,9 +91,10 @@ LE_MODULE_LOAD_DEFAULT( le_tessellator );
 #ifdef __cplusplus
 
 namespace le_tessellator {
-static const auto &api              = le_tessellator_api_i;
-static const auto &le_tessellator_i = api -> le_tessellator_i;
-using Options                       = le_tessellator_api::le_tessellator_interface_t::Options;
+static const auto &api                    = le_tessellator_api_i;
+static const auto &le_tessellator_i       = api -> le_tessellator_i;
+static const auto &le_tessellator_batch_i = api -> le_tessellator_batch_i;
+using Options                             = le_tessellator_api::le_tessellator_interface_t::Options;
 } // namespace le_tessellator
 
 class LeTessellator : NoCopy, NoMove {
@@ -80,6 +115,24 @@ class LeTessellator : NoCopy, NoMove {
 	}
 };
 
+class LeTessellatorBatch : NoCopy, NoMove {
+
+	le_tessellator_batch_o *self;
+
+  public:
+	LeTessellatorBatch()
+	    : self( le_tessellator::le_tessellator_batch_i.create() ) {
+	}
+
+	~LeTessellatorBatch() {
+		le_tessellator::le_tessellator_batch_i.destroy( self );
+	}
+
+	operator auto() {
+		return self;
+	}
+};
+
 #endif // __cplusplus
 
 #endif
@@ -2,15 +2,104 @@
 #include "le_core.h"
 
 #include <vector>
+#include <limits>
+#include <algorithm>
+#include <cmath>
 #include "glm/glm.hpp"
 
+#ifndef LE_MT
+#	define LE_MT 0
+#endif
+
+#if ( LE_MT > 0 )
+#	include "le_jobs.h"
+#endif
+
+/*
+ * Two solvers are available:
+ *
+ * The sequential solver (default) visits constraints one by one, and evaluates
+ * each constraint num_steps times before it moves on to the next constraint.
+ *
+ * The parallel solver iterates the other way round: each of num_steps iterations
+ * visits all constraints. Springs are sorted into colour groups, so that no two
+ * springs within a group share a particle - all springs within a group may
+ * therefore be solved at the same time, which we do on le_jobs, if available.
+ * Coloured springs are stored as structure of arrays, and solved in batches of
+ * LE_VERLET_SPRING_LANES springs: we gather the positions of a batch, compute
+ * its forces lane by lane in a loop which the compiler vectorises, and scatter
+ * the results. Gathers and scatters stay scalar, as particle indices are only
+ * known at runtime. Positions stay interleaved, so that a gather touches one
+ * cache line per particle, not two.
+ * Integration runs over positions as flat arrays of floats, so that it may be
+ * vectorised, and split into chunks which run in parallel.
+ *
+ * Optionally, particles collide with each other once collision parameters have
+ * been set. Each update, particles are sorted into the cells of a spatial hash
+ * with a counting sort - cells are as wide as a particle, so that collision
+ * candidates for any particle may only be found in its own, or in one of the
+ * eight neighbouring cells. The spatial hash is a grid which wraps around, so
+ * that neighbouring cells stay close to each other in memory, while particles
+ * far away from each other may share cells. Each particle then resolves its collisions by
+ * moving only itself, based on a copy of all positions and velocities, which
+ * means that particles may be processed in parallel.
+ *
+ */
+
 typedef le_verlet_api::Constraint Constraint;
 static constexpr float            cSTIFFNESS = 0.01445f;
 
+static constexpr uint32_t LE_VERLET_MAX_COLOURS        = 64;      // springs which don't fit into any colour group are solved serially
+static constexpr uint8_t  LE_VERLET_NO_COLOUR          = 0xff;    // colour for constraints which are solved serially
+static constexpr size_t   LE_VERLET_SPRINGS_PER_TASK   = 1 << 14; // number of springs solved by one parallel task - must be a multiple of LE_VERLET_SPRING_LANES
+static constexpr size_t   LE_VERLET_SPRING_LANES       = 8;       // number of springs solved as one batch
+static constexpr size_t   LE_VERLET_PARTICLES_PER_TASK = 1 << 16; // number of particles integrated by one parallel task
+static constexpr size_t   LE_VERLET_CELL_RANGES        = LE_MT > 0 ? LE_MT : 1; // number of chunks of particles, and of ranges of cells, sorted into the spatial hash in parallel
+static constexpr size_t   LE_VERLET_COLLIDERS_PER_TASK = 1 << 12; // number of particles tested for collisions by one parallel task
+
+static_assert( sizeof( glm::vec2 ) == sizeof( float ) * 2, "parallel integration treats positions as flat arrays of floats" );
+
+static_assert( LE_VERLET_SPRINGS_PER_TASK % LE_VERLET_SPRING_LANES == 0, "batches of springs must not straddle tasks" );
+
+#if ( LE_MT > 0 )
+struct le_verlet_task_param_t {
+	void *user_data;
+	void ( *fun )( void *user_data, size_t task_idx );
+	size_t task_idx;
+};
+#endif
+
 struct le_verlet_particle_system_o {
 	std::vector<glm::vec2>  pos;
 	std::vector<glm::vec2>  prev_pos;
 	std::vector<Constraint> constraints;
+
+	le_verlet_api::SolverMode solver_mode = le_verlet_api::eSolverSequential;
+
+	// Parallel solver only: springs sorted by colour group, rebuilt if colouring_dirty.
+	bool                  colouring_dirty = true;
+	std::vector<uint32_t> spring_a;            // per coloured spring: index of first particle; springs are grouped by colour
+	std::vector<uint32_t> spring_b;            // per coloured spring: index of second particle
+	std::vector<float>    spring_distance_sqr; // per coloured spring: squared resting distance
+	std::vector<uint32_t> colour_offsets;      // index of first spring for each colour group, followed by total number of coloured springs
+	std::vector<uint32_t> serial_constraints;  // indices into constraints for constraints which must be solved serially
+
+	// Collisions - disabled while collision_radius is 0.
+	float                  collision_radius      = 0.f;
+	float                  collision_restitution = 0.f;
+	uint32_t               cell_mask             = 0; // number of cells in spatial hash - 1; number of cells is a power of two
+	uint32_t               cell_row_shift        = 0; // log2 of number of cells per row in spatial hash
+	std::vector<uint32_t>  cell_start;                // per cell: first slot, followed by total number of particles
+	std::vector<uint32_t>  cell_cursor;               // per chunk of particles, per cell: number of particles, then: next free slot
+	std::vector<uint32_t>  particle_cell;             // per particle: cell index
+	std::vector<uint32_t>  sorted_idx;                // per slot: particle index, sorted by cell
+	std::vector<glm::vec2> sorted_pos;                // per slot: particle position
+	std::vector<glm::vec2> sorted_vel;                // per slot: particle velocity
+
+#if ( LE_MT > 0 )
+	std::vector<le_jobs::job_t>         jobs;        // scratch: reused for each batch of parallel tasks
+	std::vector<le_verlet_task_param_t> task_params; // scratch: one per job
+#endif
 };
 
 // ----------------------------------------------------------------------
@@ -28,6 +117,46 @@ static void le_verlet_destroy( le_verlet_particle_system_o *self ) {
 
 // ----------------------------------------------------------------------
 
+static void le_verlet_set_solver_mode( le_verlet_particle_system_o *self, le_verlet_api::SolverMode mode ) {
+	self->solver_mode = mode;
+}
+
+// ----------------------------------------------------------------------
+// Evaluates constraint c once, scaled by stepCoeff.
+static void le_verlet_solve_constraint( glm::vec2 *pos, Constraint const &c, float stepCoeff ) {
+	switch ( c.type ) {
+	case ( Constraint::eFollow ): {
+		glm::vec2 AnchorToB        = glm::normalize( pos[ c.follow.b ] - pos[ c.follow.anchor ] );
+		float     length2AnchorToB = dot( AnchorToB, AnchorToB );
+		// We test against 0 so that there cannot be a division by zero
+		if ( length2AnchorToB > std::numeric_limits<float>::epsilon() ) {
+			AnchorToB /= sqrtf( length2AnchorToB );
+			glm::vec2 unitNormal{ c.follow.bCCW ? -AnchorToB.y : +AnchorToB.y,
+			                      c.follow.bCCW ? +AnchorToB.x : -AnchorToB.x };
+			pos[ c.follow.a ] = pos[ c.follow.b ] + c.follow.distance * unitNormal;
+		} else {
+			// Length anchorToB is 0 -> leave unchanged, as we can't calculate unit normal
+		}
+
+	} break;
+	case ( Constraint::eSpring ): {
+		glm::vec2 force       = pos[ c.spring.a ] - pos[ c.spring.b ];
+		float     fMagnitude2 = glm::dot( force, force );
+		if ( fMagnitude2 > std::numeric_limits<float>::epsilon() ) {
+			//force *= ((mDistance * mDistance - fMagnitude2) / fMagnitude2) * mStiffness * stepCoeff;
+			force *= ( ( c.spring.distance * c.spring.distance - fMagnitude2 ) / fMagnitude2 ) * cSTIFFNESS * stepCoeff;
+			pos[ c.spring.a ] += force;
+			pos[ c.spring.b ] -= force;
+		}
+	} break;
+	default:
+		assert( false );
+		break;
+	}
+}
+
+// ----------------------------------------------------------------------
+
 static void le_verlet_apply_constraints( le_verlet_particle_system_o *self, size_t numSteps ) {
 	float stepCoeff = 1.f / float( numSteps );
 	auto &pos       = self->pos;
@@ -35,37 +164,488 @@ static void le_verlet_apply_constraints( le_verlet_particle_system_o *self, size
 	for ( auto const &c : self->constraints ) {
 		for ( size_t i = 0; i != numSteps; ++i ) {
 			// Each constraint is evaluated numSteps times, and thus numerically integrated over n discrete steps
-			switch ( c.type ) {
-			case ( Constraint::eFollow ): {
-				glm::vec2 AnchorToB        = glm::normalize( pos[ c.follow.b ] - pos[ c.follow.anchor ] );
-				float     length2AnchorToB = dot( AnchorToB, AnchorToB );
-				// We test against 0 so that there cannot be a division by zero
-				if ( length2AnchorToB > std::numeric_limits<float>::epsilon() ) {
-					AnchorToB /= sqrtf( length2AnchorToB );
-					glm::vec2 unitNormal{ c.follow.bCCW ? -AnchorToB.y : +AnchorToB.y,
-					                      c.follow.bCCW ? +AnchorToB.x : -AnchorToB.x };
-					pos[ c.follow.a ] = pos[ c.follow.b ] + c.follow.distance * unitNormal;
-				} else {
-					// Length anchorToB is 0 -> leave unchanged, as we can't calculate unit normal
+			le_verlet_solve_constraint( pos.data(), c, stepCoeff );
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Calls `fun` for each task index in [0..num_tasks) - in parallel if the job system is available.
+static void le_verlet_run_tasks( le_verlet_particle_system_o *self, size_t num_tasks, void *user_data, void ( *fun )( void *user_data, size_t task_idx ) ) {
+
+#if ( LE_MT > 0 )
+	if ( num_tasks > 1 ) {
+
+		auto &params = self->task_params;
+		auto &jobs   = self->jobs;
+
+		params.resize( num_tasks );
+		jobs.clear();
+
+		for ( size_t i = 0; i != num_tasks; i++ ) {
+			params[ i ] = { user_data, fun, i };
+			jobs.push_back( { []( void *param ) {
+				                 auto p = static_cast<le_verlet_task_param_t *>( param );
+				                 p->fun( p->user_data, p->task_idx );
+			                 },
+			                  &params[ i ] } );
+		}
+
+		le_jobs::counter_t *counter;
+		le_jobs::run_jobs( jobs.data(), uint32_t( jobs.size() ), &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
+		return;
+	}
+#endif
+
+	for ( size_t i = 0; i != num_tasks; i++ ) {
+		fun( user_data, i );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Sorts springs into colour groups so that no two springs within the same group
+// share a particle. We colour greedily: each spring takes the first colour which
+// neither of its particles uses yet. Follow constraints, and springs for which
+// we run out of colours are solved serially.
+static void le_verlet_colour_constraints( le_verlet_particle_system_o *self ) {
+
+	std::vector<uint64_t> used_colours( self->pos.size(), 0 ); // bit c is set if particle belongs to a spring of colour c
+	std::vector<uint8_t>  colour( self->constraints.size(), LE_VERLET_NO_COLOUR );
+	uint32_t              colour_count[ LE_VERLET_MAX_COLOURS ] = {};
+
+	self->serial_constraints.clear();
+
+	for ( size_t i = 0; i != self->constraints.size(); i++ ) {
+		auto const &c = self->constraints[ i ];
+
+		if ( c.type != Constraint::eSpring ) {
+			self->serial_constraints.push_back( uint32_t( i ) );
+			continue;
+		}
+
+		uint64_t const used = used_colours[ c.spring.a ] | used_colours[ c.spring.b ];
+
+		if ( used == ~uint64_t( 0 ) ) {
+			self->serial_constraints.push_back( uint32_t( i ) );
+			continue;
+		}
+
+		uint32_t k = 0;
+		while ( used & ( uint64_t( 1 ) << k ) ) {
+			k++;
+		}
+
+		used_colours[ c.spring.a ] |= uint64_t( 1 ) << k;
+		used_colours[ c.spring.b ] |= uint64_t( 1 ) << k;
+
+		colour[ i ] = uint8_t( k );
+		colour_count[ k ]++;
+	}
+
+	// -- Prefix sum over colour counts gives us the first spring for each colour group.
+
+	self->colour_offsets.assign( LE_VERLET_MAX_COLOURS + 1, 0 );
+
+	for ( uint32_t k = 0; k != LE_VERLET_MAX_COLOURS; k++ ) {
+		self->colour_offsets[ k + 1 ] = self->colour_offsets[ k ] + colour_count[ k ];
+	}
+
+	// Remove trailing empty colour groups.
+	while ( self->colour_offsets.size() > 1 &&
+	        self->colour_offsets[ self->colour_offsets.size() - 1 ] == self->colour_offsets[ self->colour_offsets.size() - 2 ] ) {
+		self->colour_offsets.pop_back();
+	}
+
+	self->spring_a.resize( self->colour_offsets.back() );
+	self->spring_b.resize( self->colour_offsets.back() );
+	self->spring_distance_sqr.resize( self->colour_offsets.back() );
+
+	std::vector<uint32_t> cursor( self->colour_offsets.begin(), self->colour_offsets.end() - 1 );
+
+	for ( size_t i = 0; i != self->constraints.size(); i++ ) {
+		auto const &c = self->constraints[ i ];
+		if ( colour[ i ] == LE_VERLET_NO_COLOUR ) {
+			continue;
+		}
+		uint32_t const j               = cursor[ colour[ i ] ]++;
+		self->spring_a[ j ]            = c.spring.a;
+		self->spring_b[ j ]            = c.spring.b;
+		self->spring_distance_sqr[ j ] = c.spring.distance * c.spring.distance;
+	}
+
+	self->colouring_dirty = false;
+}
+
+// ----------------------------------------------------------------------
+// Solves coloured springs [begin..end) - no two of these springs may share a particle.
+static void le_verlet_solve_springs( glm::vec2 *pos, uint32_t const *spring_a, uint32_t const *spring_b, float const *spring_distance_sqr, size_t begin, size_t end, float stepCoeff ) {
+
+	float const epsilon = std::numeric_limits<float>::epsilon();
+
+	size_t j = begin;
+
+	for ( ; j + LE_VERLET_SPRING_LANES <= end; j += LE_VERLET_SPRING_LANES ) {
+
+		uint32_t const *a = spring_a + j;
+		uint32_t const *b = spring_b + j;
+
+		float force_x[ LE_VERLET_SPRING_LANES ];
+		float force_y[ LE_VERLET_SPRING_LANES ];
+
+		for ( size_t l = 0; l != LE_VERLET_SPRING_LANES; l++ ) {
+			force_x[ l ] = pos[ a[ l ] ].x - pos[ b[ l ] ].x;
+			force_y[ l ] = pos[ a[ l ] ].y - pos[ b[ l ] ].y;
+		}
+
+		// Branch-free, so that lanes are computed side by side.
+		for ( size_t l = 0; l != LE_VERLET_SPRING_LANES; l++ ) {
+			float const fMagnitude2 = force_x[ l ] * force_x[ l ] + force_y[ l ] * force_y[ l ];
+			float const divisor     = fMagnitude2 > epsilon ? fMagnitude2 : 1.f;
+			float const scale       = fMagnitude2 > epsilon ? ( ( spring_distance_sqr[ j + l ] - fMagnitude2 ) / divisor ) * cSTIFFNESS * stepCoeff : 0.f;
+			force_x[ l ] *= scale;
+			force_y[ l ] *= scale;
+		}
+
+		for ( size_t l = 0; l != LE_VERLET_SPRING_LANES; l++ ) {
+			pos[ a[ l ] ].x += force_x[ l ];
+			pos[ a[ l ] ].y += force_y[ l ];
+			pos[ b[ l ] ].x -= force_x[ l ];
+			pos[ b[ l ] ].y -= force_y[ l ];
+		}
+	}
+
+	// Remaining springs which don't fill a batch.
+
+	for ( ; j != end; j++ ) {
+		glm::vec2 force       = pos[ spring_a[ j ] ] - pos[ spring_b[ j ] ];
+		float     fMagnitude2 = glm::dot( force, force );
+		if ( fMagnitude2 > epsilon ) {
+			force *= ( ( spring_distance_sqr[ j ] - fMagnitude2 ) / fMagnitude2 ) * cSTIFFNESS * stepCoeff;
+			pos[ spring_a[ j ] ] += force;
+			pos[ spring_b[ j ] ] -= force;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void le_verlet_apply_constraints_parallel( le_verlet_particle_system_o *self, size_t numSteps ) {
+
+	if ( self->colouring_dirty ) {
+		le_verlet_colour_constraints( self );
+	}
+
+	struct colour_task_t {
+		glm::vec2 *     pos;
+		uint32_t const *spring_a;
+		uint32_t const *spring_b;
+		float const *   spring_distance_sqr;
+		size_t          num_springs;
+		float           stepCoeff;
+	};
+
+	colour_task_t task{};
+	task.pos       = self->pos.data();
+	task.stepCoeff = 1.f / float( numSteps );
+
+	size_t const num_colours = self->colour_offsets.size() - 1;
+
+	for ( size_t i = 0; i != numSteps; ++i ) {
+
+		for ( size_t k = 0; k != num_colours; k++ ) {
+
+			task.spring_a            = self->spring_a.data() + self->colour_offsets[ k ];
+			task.spring_b            = self->spring_b.data() + self->colour_offsets[ k ];
+			task.spring_distance_sqr = self->spring_distance_sqr.data() + self->colour_offsets[ k ];
+			task.num_springs         = self->colour_offsets[ k + 1 ] - self->colour_offsets[ k ];
+
+			size_t const num_tasks = ( task.num_springs + LE_VERLET_SPRINGS_PER_TASK - 1 ) / LE_VERLET_SPRINGS_PER_TASK;
+
+			// --------| invariant: no two springs within this group share a particle
+
+			le_verlet_run_tasks( self, num_tasks, &task, []( void *user_data, size_t task_idx ) {
+				auto         t     = static_cast<colour_task_t const *>( user_data );
+				size_t const begin = task_idx * LE_VERLET_SPRINGS_PER_TASK;
+				size_t const end   = std::min( begin + LE_VERLET_SPRINGS_PER_TASK, t->num_springs );
+				le_verlet_solve_springs( t->pos, t->spring_a, t->spring_b, t->spring_distance_sqr, begin, end, t->stepCoeff );
+			} );
+		}
+
+		for ( uint32_t c : self->serial_constraints ) {
+			le_verlet_solve_constraint( self->pos.data(), self->constraints[ c ], task.stepCoeff );
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void le_verlet_set_collision_parameters( le_verlet_particle_system_o *self, float radius, float restitution ) {
+	self->collision_radius      = std::max( radius, 0.f );
+	self->collision_restitution = glm::clamp( restitution, 0.f, 1.f );
+}
+
+// ----------------------------------------------------------------------
+
+static inline int32_t le_verlet_cell_coord( float v, float inv_cell_size ) {
+	// Clamp so that particles which have flown off far away can't overflow the cast.
+	return int32_t( glm::clamp( std::floor( v * inv_cell_size ), -float( 1 << 30 ), float( 1 << 30 ) ) );
+}
+
+// ----------------------------------------------------------------------
+
+// Maps cell coordinates onto a grid of 2^row_shift cells per row, which wraps around.
+static inline uint32_t le_verlet_cell_hash( int32_t x, int32_t y, uint32_t row_shift, uint32_t mask ) {
+	return ( ( uint32_t( y ) << row_shift ) | ( uint32_t( x ) & ( ( 1u << row_shift ) - 1 ) ) ) & mask;
+}
+
+// ----------------------------------------------------------------------
+// Sorts particles into cells of the spatial hash. This is a counting sort:
+// we count particles per cell, turn counts into first slots via a prefix sum,
+// then scatter particle indices into their slots.
+//
+// Particles are split into LE_VERLET_CELL_RANGES contiguous chunks, and each
+// chunk counts into its own histogram, so that counting and scattering visit
+// each particle exactly once, and tasks never write to the same counter. The
+// prefix sum runs over chunks within each cell, and over cells - which means
+// that each chunk scatters through its own cursors, and that particles within
+// a cell are always in the same order as particles in the particle system.
+static void le_verlet_build_spatial_hash( le_verlet_particle_system_o *self, float cell_size ) {
+
+	size_t const num_particles = self->pos.size();
+
+	// Number of cells is the next power of two so that there are at least
+	// twice as many cells as there are particles. We want at least 4x4 cells
+	// so that the 3x3 cells around any particle never wrap onto each other.
+	uint32_t num_cells      = 16;
+	uint32_t num_cells_log2 = 4;
+	while ( num_cells < num_particles * 2 ) {
+		num_cells <<= 1;
+		num_cells_log2++;
+	}
+
+	self->cell_mask      = num_cells - 1;
+	self->cell_row_shift = ( num_cells_log2 + 1 ) / 2;
+
+	self->cell_start.resize( num_cells + 1 );
+	self->cell_cursor.resize( num_cells * LE_VERLET_CELL_RANGES );
+	self->particle_cell.resize( num_particles );
+	self->sorted_idx.resize( num_particles );
+	self->sorted_pos.resize( num_particles );
+	self->sorted_vel.resize( num_particles );
+
+	struct hash_task_t {
+		le_verlet_particle_system_o *self;
+		float                        inv_cell_size;
+		size_t                       num_particles;
+		size_t                       num_cells;
+		size_t                       particles_per_chunk;
+		uint32_t                     range_shift;                                                  // log2 of number of cells per range of cells
+		uint32_t                     range_count[ LE_VERLET_CELL_RANGES ][ LE_VERLET_CELL_RANGES ]; // per chunk, per range of cells: number of particles
+		uint32_t                     range_first_slot[ LE_VERLET_CELL_RANGES ];                    // per range of cells: first slot
+	};
+
+	hash_task_t task{};
+	task.self                = self;
+	task.inv_cell_size       = 1.f / cell_size;
+	task.num_particles       = num_particles;
+	task.num_cells           = num_cells;
+	task.particles_per_chunk = ( num_particles + LE_VERLET_CELL_RANGES - 1 ) / LE_VERLET_CELL_RANGES;
+
+	// Ranges of cells have a power-of-two size, so that there are at most LE_VERLET_CELL_RANGES ranges.
+	while ( ( num_cells >> task.range_shift ) > LE_VERLET_CELL_RANGES ) {
+		task.range_shift++;
+	}
+
+	// -- Find cell for each particle, and count particles per cell, and per range of cells, per chunk
+
+	le_verlet_run_tasks( self, LE_VERLET_CELL_RANGES, &task, []( void *user_data, size_t task_idx ) {
+		auto         t     = static_cast<hash_task_t *>( user_data );
+		auto         self  = t->self;
+		size_t const begin = std::min( task_idx * t->particles_per_chunk, t->num_particles );
+		size_t const end   = std::min( begin + t->particles_per_chunk, t->num_particles );
+		uint32_t *   count = self->cell_cursor.data() + task_idx * t->num_cells;
+
+		uint32_t range_count[ LE_VERLET_CELL_RANGES ] = {};
+
+		std::fill( count, count + t->num_cells, 0 );
+
+		for ( size_t i = begin; i != end; i++ ) {
+			glm::vec2 const &p    = self->pos[ i ];
+			uint32_t const   cell = le_verlet_cell_hash( le_verlet_cell_coord( p.x, t->inv_cell_size ),
+			                                             le_verlet_cell_coord( p.y, t->inv_cell_size ),
+			                                             self->cell_row_shift, self->cell_mask );
+
+			self->particle_cell[ i ] = cell;
+			count[ cell ]++;
+			range_count[ cell >> t->range_shift ]++;
+		}
+
+		std::copy( range_count, range_count + LE_VERLET_CELL_RANGES, t->range_count[ task_idx ] );
+	} );
+
+	// -- Prefix sum over ranges of cells: first slot per range
+
+	uint32_t slot = 0;
+	for ( size_t range = 0; range != LE_VERLET_CELL_RANGES; range++ ) {
+		task.range_first_slot[ range ] = slot;
+		for ( size_t chunk = 0; chunk != LE_VERLET_CELL_RANGES; chunk++ ) {
+			slot += task.range_count[ chunk ][ range ];
+		}
+	}
+	self->cell_start[ num_cells ] = slot;
+
+	// -- Prefix sum within each range of cells: first slot per cell, and per chunk within each cell
+
+	le_verlet_run_tasks( self, LE_VERLET_CELL_RANGES, &task, []( void *user_data, size_t task_idx ) {
+		auto         t      = static_cast<hash_task_t const *>( user_data );
+		auto         self   = t->self;
+		uint32_t *   cursor = self->cell_cursor.data();
+		size_t const begin  = std::min( task_idx << t->range_shift, t->num_cells );
+		size_t const end    = std::min( ( task_idx + 1 ) << t->range_shift, t->num_cells );
+		uint32_t     slot   = t->range_first_slot[ task_idx ];
+
+		for ( size_t cell = begin; cell != end; cell++ ) {
+			self->cell_start[ cell ] = slot;
+			for ( size_t chunk = 0; chunk != LE_VERLET_CELL_RANGES; chunk++ ) {
+				uint32_t count                        = cursor[ chunk * t->num_cells + cell ];
+				cursor[ chunk * t->num_cells + cell ] = slot;
+				slot += count;
+			}
+		}
+	} );
+
+	// -- Scatter particle indices into slots - each chunk through its own cursors
+
+	le_verlet_run_tasks( self, LE_VERLET_CELL_RANGES, &task, []( void *user_data, size_t task_idx ) {
+		auto         t      = static_cast<hash_task_t const *>( user_data );
+		auto         self   = t->self;
+		size_t const begin  = std::min( task_idx * t->particles_per_chunk, t->num_particles );
+		size_t const end    = std::min( begin + t->particles_per_chunk, t->num_particles );
+		uint32_t *   cursor = self->cell_cursor.data() + task_idx * t->num_cells;
+
+		for ( size_t i = begin; i != end; i++ ) {
+			self->sorted_idx[ cursor[ self->particle_cell[ i ] ]++ ] = uint32_t( i );
+		}
+	} );
+
+	// -- Copy positions and velocities into slots
+
+	size_t const num_particle_tasks = ( num_particles + LE_VERLET_PARTICLES_PER_TASK - 1 ) / LE_VERLET_PARTICLES_PER_TASK;
+
+	le_verlet_run_tasks( self, num_particle_tasks, &task, []( void *user_data, size_t task_idx ) {
+		auto         t     = static_cast<hash_task_t const *>( user_data );
+		auto         self  = t->self;
+		size_t const begin = task_idx * LE_VERLET_PARTICLES_PER_TASK;
+		size_t const end   = std::min( begin + LE_VERLET_PARTICLES_PER_TASK, t->num_particles );
+		for ( size_t slot = begin; slot != end; slot++ ) {
+			uint32_t const i         = self->sorted_idx[ slot ];
+			self->sorted_pos[ slot ] = self->pos[ i ];
+			self->sorted_vel[ slot ] = self->pos[ i ] - self->prev_pos[ i ];
+		}
+	} );
+}
+
+// ----------------------------------------------------------------------
+// Pushes apart any two particles which are closer than twice the collision radius.
+// Positions are corrected without adding velocity; velocities along the contact
+// normal are then reflected, scaled by restitution.
+static void le_verlet_resolve_collisions( le_verlet_particle_system_o *self ) {
+
+	float const diameter = self->collision_radius * 2.f;
+
+	le_verlet_build_spatial_hash( self, diameter );
+
+	struct collide_task_t {
+		le_verlet_particle_system_o *self;
+		float                        diameter;
+		float                        inv_cell_size;
+		float                        restitution;
+	};
+
+	collide_task_t task{ self, diameter, 1.f / diameter, self->collision_restitution };
+
+	size_t const num_tasks = ( self->sorted_idx.size() + LE_VERLET_COLLIDERS_PER_TASK - 1 ) / LE_VERLET_COLLIDERS_PER_TASK;
+
+	// --------| invariant: sorted_pos, sorted_vel hold a copy of all particles, which we read from;
+	//                     each slot writes only to its own particle in pos, prev_pos.
+
+	le_verlet_run_tasks( self, num_tasks, &task, []( void *user_data, size_t task_idx ) {
+		auto         t     = static_cast<collide_task_t const *>( user_data );
+		auto         self  = t->self;
+		size_t const begin = task_idx * LE_VERLET_COLLIDERS_PER_TASK;
+		size_t const end   = std::min( begin + LE_VERLET_COLLIDERS_PER_TASK, self->sorted_idx.size() );
+
+		float const diameter_sqr = t->diameter * t->diameter;
+
+		uint32_t const   row_shift  = self->cell_row_shift;
+		uint32_t const   row_mask   = ~( ( 1u << row_shift ) - 1 );
+		uint32_t const * cell_start = self->cell_start.data();
+		glm::vec2 const *sorted_pos = self->sorted_pos.data();
+		glm::vec2 const *sorted_vel = self->sorted_vel.data();
+
+		for ( size_t k = begin; k != end; k++ ) {
+
+			glm::vec2 const p = sorted_pos[ k ];
+			glm::vec2 const v = sorted_vel[ k ];
+
+			glm::vec2 correction{ 0 };
+			glm::vec2 delta_v{ 0 };
+
+			auto collide_slots = [ & ]( uint32_t slot_begin, uint32_t slot_end ) {
+				for ( uint32_t m = slot_begin; m != slot_end; m++ ) {
+					if ( m == k ) {
+						continue;
+					}
+
+					glm::vec2 d     = p - sorted_pos[ m ];
+					float     d_sqr = glm::dot( d, d );
+
+					if ( d_sqr >= diameter_sqr || d_sqr <= std::numeric_limits<float>::epsilon() ) {
+						continue; // not touching, or on top of each other, in which case there is no normal
+					}
+
+					float     dist   = sqrtf( d_sqr );
+					glm::vec2 normal = d / dist;
+
+					// Each particle of a pair moves half-way.
+					correction += normal * ( ( t->diameter - dist ) * 0.5f );
+
+					float approach = glm::dot( v - sorted_vel[ m ], normal );
+					if ( approach < 0.f ) {
+						delta_v -= normal * ( approach * ( 1.f + t->restitution ) * 0.5f );
+					}
 				}
+			};
 
-			} break;
-			case ( Constraint::eSpring ): {
-				glm::vec2 force       = pos[ c.spring.a ] - pos[ c.spring.b ];
-				float     fMagnitude2 = glm::dot( force, force );
-				if ( fMagnitude2 > std::numeric_limits<float>::epsilon() ) {
-					//force *= ((mDistance * mDistance - fMagnitude2) / fMagnitude2) * mStiffness * stepCoeff;
-					force *= ( ( c.spring.distance * c.spring.distance - fMagnitude2 ) / fMagnitude2 ) * cSTIFFNESS * stepCoeff;
-					pos[ c.spring.a ] += force;
-					pos[ c.spring.b ] -= force;
+			int32_t const cx = le_verlet_cell_coord( p.x, t->inv_cell_size );
+			int32_t const cy = le_verlet_cell_coord( p.y, t->inv_cell_size );
+
+			// Left, centre, and right neighbour cells are next to each other within their
+			// row, which means that their particles occupy one contiguous range of slots -
+			// unless the row wraps around between left and right cell.
+
+			for ( int32_t dy = -1; dy <= 1; dy++ ) {
+				uint32_t const first = le_verlet_cell_hash( cx - 1, cy + dy, row_shift, self->cell_mask );
+				uint32_t const last  = le_verlet_cell_hash( cx + 1, cy + dy, row_shift, self->cell_mask );
+
+				if ( first <= last ) {
+					collide_slots( cell_start[ first ], cell_start[ last + 1 ] );
+				} else {
+					uint32_t const row_begin = first & row_mask;
+					uint32_t const row_end   = row_begin + ( 1u << row_shift );
+					collide_slots( cell_start[ first ], cell_start[ row_end ] );
+					collide_slots( cell_start[ row_begin ], cell_start[ last + 1 ] );
 				}
-			} break;
-			default:
-				assert( false );
-				break;
 			}
+
+			uint32_t const i = self->sorted_idx[ k ];
+
+			glm::vec2 const new_pos = p + correction;
+			self->pos[ i ]          = new_pos;
+			self->prev_pos[ i ]     = new_pos - ( v + delta_v );
 		}
-	}
+	} );
 }
 
 // ----------------------------------------------------------------------
@@ -96,6 +676,7 @@ static void le_verlet_add_constraint( le_verlet_particle_system_o *self, Constra
 	}
 
 	self->constraints.emplace_back( std::move( c ) );
+	self->colouring_dirty = true;
 }
 
 // ----------------------------------------------------------------------
@@ -108,24 +689,63 @@ static void le_verlet_update( le_verlet_particle_system_o *self, size_t num_step
 
 	size_t const num_elements = self->pos.size();
 
-	for ( size_t i = 0; i != num_elements; ++i ) {
-		auto &p        = self->pos[ i ];
-		auto &pp       = self->prev_pos[ i ];
-		auto  velocity = ( p - pp );
+	if ( self->solver_mode == le_verlet_api::eSolverParallel ) {
 
-		// Store current pos as previous pos
-		pp = p;
+		// Components are independent of each other, which means that we may integrate
+		// positions as flat arrays of floats.
 
-		// Apply friction
-		velocity *= 0.995;
+		struct integrate_task_t {
+			float *pos;
+			float *prev_pos;
+			size_t num_floats;
+		};
 
-		// Apply inertia
-		p += velocity;
-	}
+		integrate_task_t task{ &self->pos.data()->x, &self->prev_pos.data()->x, num_elements * 2 };
+
+		size_t const num_tasks = ( num_elements + LE_VERLET_PARTICLES_PER_TASK - 1 ) / LE_VERLET_PARTICLES_PER_TASK;
 
-	// Then update constraints, iterate each by step
+		le_verlet_run_tasks( self, num_tasks, &task, []( void *user_data, size_t task_idx ) {
+			auto         t     = static_cast<integrate_task_t const *>( user_data );
+			size_t const begin = task_idx * LE_VERLET_PARTICLES_PER_TASK * 2;
+			size_t const end   = std::min( begin + LE_VERLET_PARTICLES_PER_TASK * 2, t->num_floats );
+
+			float *__restrict p  = t->pos;
+			float *__restrict pp = t->prev_pos;
+
+			for ( size_t i = begin; i != end; ++i ) {
+				float const velocity = ( p[ i ] - pp[ i ] ) * 0.995f; // apply friction
+				pp[ i ]              = p[ i ];                       // store current pos as previous pos
+				p[ i ] += velocity;                                  // apply inertia
+			}
+		} );
 
-	le_verlet_apply_constraints( self, num_steps );
+		le_verlet_apply_constraints_parallel( self, num_steps );
+
+	} else {
+
+		for ( size_t i = 0; i != num_elements; ++i ) {
+			auto &p        = self->pos[ i ];
+			auto &pp       = self->prev_pos[ i ];
+			auto  velocity = ( p - pp );
+
+			// Store current pos as previous pos
+			pp = p;
+
+			// Apply friction
+			velocity *= 0.995;
+
+			// Apply inertia
+			p += velocity;
+		}
+
+		// Then update constraints, iterate each by step
+
+		le_verlet_apply_constraints( self, num_steps );
+	}
+
+	if ( self->collision_radius > 0.f && num_elements > 1 ) {
+		le_verlet_resolve_collisions( self );
+	}
 }
 
 // ----------------------------------------------------------------------
@@ -159,12 +779,14 @@ static size_t le_verlet_get_particle_count( le_verlet_particle_system_o *self )
 LE_MODULE_REGISTER_IMPL( le_verlet, api ) {
 	auto &le_verlet_i = static_cast<le_verlet_api *>( api )->le_verlet_i;
 
-	le_verlet_i.create             = le_verlet_create;
-	le_verlet_i.destroy            = le_verlet_destroy;
-	le_verlet_i.update             = le_verlet_update;
-	le_verlet_i.add_particles      = le_verlet_add_particles;
-	le_verlet_i.add_constraint     = le_verlet_add_constraint;
-	le_verlet_i.get_particles      = le_verlet_get_particles;
-	le_verlet_i.get_particle_count = le_verlet_get_particle_count;
-	le_verlet_i.set_particle       = le_verlet_set_particle;
+	le_verlet_i.create                   = le_verlet_create;
+	le_verlet_i.destroy                  = le_verlet_destroy;
+	le_verlet_i.update                   = le_verlet_update;
+	le_verlet_i.add_particles            = le_verlet_add_particles;
+	le_verlet_i.add_constraint           = le_verlet_add_constraint;
+	le_verlet_i.get_particles            = le_verlet_get_particles;
+	le_verlet_i.get_particle_count       = le_verlet_get_particle_count;
+	le_verlet_i.set_particle             = le_verlet_set_particle;
+	le_verlet_i.set_solver_mode          = le_verlet_set_solver_mode;
+	le_verlet_i.set_collision_parameters = le_verlet_set_collision_parameters;
 }
@@ -77,6 +77,11 @@ struct le_verlet_api {
 		    , spring( spring ) {
 		}
 	};
+
+	enum SolverMode : uint32_t {
+		eSolverSequential = 0, // default: constraints are solved one after another, each num_steps times
+		eSolverParallel,       // springs are solved in colour groups, and in parallel if le_jobs is available
+	};
 	// clang-format off
 
 	struct le_verl_particle_system_interface_t{
@@ -88,6 +93,11 @@ struct le_verlet_api {
 		void                       ( * add_constraint     ) ( le_verlet_particle_system_o* self, Constraint const & constraint);
 		void                       ( * update             ) ( le_verlet_particle_system_o* self, size_t num_steps );
 		void                       ( * set_particle       ) ( le_verlet_particle_system_o* self, size_t idx, Vertex const & vertex );
+		void                       ( * set_solver_mode    ) ( le_verlet_particle_system_o* self, SolverMode mode );
+
+		// Particles collide with each other if radius > 0 (default: 0, no collisions).
+		// Restitution is clamped to [0..1]: 0 means particles stop when they meet, 1 means they bounce off fully.
+		void                       ( * set_collision_parameters ) ( le_verlet_particle_system_o* self, float radius, float restitution );
 	};
 
 	le_verl_particle_system_interface_t  le_verlet_i;
@@ -6,18 +6,18 @@ mat4 getSkinningMatrix()
 
     #if (NUM_JOINT_WEIGHTS_SET == NUM_JOINT_SETS) && (NUM_JOINT_SETS > 0)
     skin +=
-        a_Weight[0].x * u_jointMatrix[a_Joint[0].x] +
-        a_Weight[0].y * u_jointMatrix[a_Joint[0].y] +
-        a_Weight[0].z * u_jointMatrix[a_Joint[0].z] +
-        a_Weight[0].w * u_jointMatrix[a_Joint[0].w];
+        a_Weight[0].x * u_jointMatrix[joint_palette_offset + a_Joint[0].x] +
+        a_Weight[0].y * u_jointMatrix[joint_palette_offset + a_Joint[0].y] +
+        a_Weight[0].z * u_jointMatrix[joint_palette_offset + a_Joint[0].z] +
+        a_Weight[0].w * u_jointMatrix[joint_palette_offset + a_Joint[0].w];
     #endif
 
     #if (NUM_JOINT_WEIGHTS_SET == NUM_JOINT_SETS) && (NUM_JOINT_SETS > 1)
     skin +=
-        a_Weight[1].x * u_jointMatrix[a_Joint[1].x] +
-        a_Weight[1].y * u_jointMatrix[a_Joint[1].y] +
-        a_Weight[1].z * u_jointMatrix[a_Joint[1].z] +
-        a_Weight[1].w * u_jointMatrix[a_Joint[1].w];
+        a_Weight[1].x * u_jointMatrix[joint_palette_offset + a_Joint[1].x] +
+        a_Weight[1].y * u_jointMatrix[joint_palette_offset + a_Joint[1].y] +
+        a_Weight[1].z * u_jointMatrix[joint_palette_offset + a_Joint[1].z] +
+        a_Weight[1].w * u_jointMatrix[joint_palette_offset + a_Joint[1].w];
     #endif
 
     return skin;
@@ -29,18 +29,18 @@ mat4 getSkinningNormalMatrix()
 
     #if (NUM_JOINT_WEIGHTS_SET == NUM_JOINT_SETS) && (NUM_JOINT_SETS > 0)
     skin +=
-        a_Weight[0].x * u_jointNormalMatrix[a_Joint[0].x] +
-        a_Weight[0].y * u_jointNormalMatrix[a_Joint[0].y] +
-        a_Weight[0].z * u_jointNormalMatrix[a_Joint[0].z] +
-        a_Weight[0].w * u_jointNormalMatrix[a_Joint[0].w];
+        a_Weight[0].x * u_jointNormalMatrix[joint_palette_offset + a_Joint[0].x] +
+        a_Weight[0].y * u_jointNormalMatrix[joint_palette_offset + a_Joint[0].y] +
+        a_Weight[0].z * u_jointNormalMatrix[joint_palette_offset + a_Joint[0].z] +
+        a_Weight[0].w * u_jointNormalMatrix[joint_palette_offset + a_Joint[0].w];
     #endif
 
     #if (NUM_JOINT_WEIGHTS_SET == NUM_JOINT_SETS) && (NUM_JOINT_SETS > 1)
     skin +=
-        a_Weight[1].x * u_jointNormalMatrix[a_Joint[1].x] +
-        a_Weight[1].y * u_jointNormalMatrix[a_Joint[1].y] +
-        a_Weight[1].z * u_jointNormalMatrix[a_Joint[1].z] +
-        a_Weight[1].w * u_jointNormalMatrix[a_Joint[1].w];
+        a_Weight[1].x * u_jointNormalMatrix[joint_palette_offset + a_Joint[1].x] +
+        a_Weight[1].y * u_jointNormalMatrix[joint_palette_offset + a_Joint[1].y] +
+        a_Weight[1].z * u_jointNormalMatrix[joint_palette_offset + a_Joint[1].z] +
+        a_Weight[1].w * u_jointNormalMatrix[joint_palette_offset + a_Joint[1].w];
     #endif
 
     return skin;
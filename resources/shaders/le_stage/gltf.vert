@@ -29,11 +29,20 @@ layout (location = LOC_POSITIONS ) in vec3 a_pos[NUM_POSITIONS];
 // Uniform Arguments
 layout (std140, set = 0, binding = 0) uniform UboMatrices {
 	mat4 viewProjectionMatrix; // (projection * view) matrix
-	mat4 normalMatrix;
-	mat4 modelMatrix;
 	vec3 camera_position; // camera position in world space
 };
 
+// Per-instance transforms, one element per instance, indexed by gl_InstanceIndex.
+// normalMatrix is transpose(inverse(modelMatrix)), given in world-space.
+struct InstanceTransform {
+	mat4 modelMatrix;
+	mat4 normalMatrix;
+};
+
+layout (std140, set = 2, binding = 1) readonly buffer InstanceTransforms {
+	InstanceTransform instances[];
+};
+
 layout (std140, set = 0, binding = 1) uniform UboPostProcessing {
 	float exposure;
 } postProcessing;
@@ -64,6 +73,14 @@ layout (std140, set = 0, binding = 1) uniform UboPostProcessing {
 #	endif
 #endif
 
+#ifdef NUM_JOINT_SETS
+	// Joint matrices for all skinned nodes are packed into shared palettes,
+	// this gives us the index of the first joint matrix for the current draw.
+	layout (push_constant) uniform PushConstants {
+		uint joint_palette_offset;
+	};
+#endif
+
 #include "animation.glsl"
 
 #if defined(MATERIAL_SPECULARGLOSSINESS) || defined(MATERIAL_METALLICROUGHNESS)
@@ -146,6 +163,9 @@ vec4 getTangent(){
 
 void main() {
 
+	mat4 modelMatrix  = instances[gl_InstanceIndex].modelMatrix;
+	mat4 normalMatrix = instances[gl_InstanceIndex].normalMatrix;
+
     vec4 pos = modelMatrix * getPosition(); 	// world position
     v_position = vec3(pos.xyz) / pos.w; 		// un-project 
 	